@@ -0,0 +1,127 @@
+// Nautilus Boot Trace - per-stage timing of the startup sequence
+
+#include "boot_trace.h"
+#include "peripheral/peripheral.h"
+
+static BootTraceStage boot_stages[BOOT_TRACE_MAX_STAGES];
+static int boot_stage_count = 0;
+static portMUX_TYPE boot_trace_mux = portMUX_INITIALIZER_UNLOCKED;
+
+int boot_trace_begin(const char *name)
+{
+    uint32_t now = micros();
+    int handle = -1;
+
+    portENTER_CRITICAL(&boot_trace_mux);
+    if (boot_stage_count < BOOT_TRACE_MAX_STAGES) {
+        handle = boot_stage_count++;
+        boot_stages[handle].name = name;
+        boot_stages[handle].start_us = now;
+        boot_stages[handle].end_us = 0;
+        boot_stages[handle].core = xPortGetCoreID();
+    }
+    portEXIT_CRITICAL(&boot_trace_mux);
+
+    return handle;
+}
+
+void boot_trace_end(int handle)
+{
+    if (handle < 0 || handle >= BOOT_TRACE_MAX_STAGES) {
+        return;
+    }
+    uint32_t now = micros();
+
+    portENTER_CRITICAL(&boot_trace_mux);
+    boot_stages[handle].end_us = now;
+    portEXIT_CRITICAL(&boot_trace_mux);
+}
+
+void boot_trace_mark(const char *name)
+{
+    boot_trace_end(boot_trace_begin(name));
+}
+
+void boot_trace_lazy(const char *name, uint32_t start_us)
+{
+    int handle = boot_trace_begin(name);
+    if (handle < 0) {
+        return;
+    }
+
+    portENTER_CRITICAL(&boot_trace_mux);
+    boot_stages[handle].start_us = start_us;
+    portEXIT_CRITICAL(&boot_trace_mux);
+
+    boot_trace_end(handle);
+    Serial.printf("[BOOT] stage=%s core=%d start_us=%lu dur_us=%lu\n",
+                  name, xPortGetCoreID(), (unsigned long)start_us,
+                  (unsigned long)(micros() - start_us));
+}
+
+// Snapshot under the lock so a stage finishing on the other core can't tear a line
+static int boot_trace_snapshot(BootTraceStage *out)
+{
+    portENTER_CRITICAL(&boot_trace_mux);
+    int count = boot_stage_count;
+    memcpy(out, boot_stages, sizeof(BootTraceStage) * count);
+    portEXIT_CRITICAL(&boot_trace_mux);
+    return count;
+}
+
+static int boot_trace_format(const BootTraceStage &s, char *buf, size_t len)
+{
+    uint32_t dur = (s.end_us >= s.start_us) ? (s.end_us - s.start_us) : 0;
+    if (s.end_us == 0) {
+        return snprintf(buf, len, "[BOOT] stage=%s core=%d start_us=%lu dur_us=running\n",
+                        s.name, s.core, (unsigned long)s.start_us);
+    }
+    return snprintf(buf, len, "[BOOT] stage=%s core=%d start_us=%lu dur_us=%lu\n",
+                    s.name, s.core, (unsigned long)s.start_us, (unsigned long)dur);
+}
+
+void boot_trace_dump(void)
+{
+    static BootTraceStage snap[BOOT_TRACE_MAX_STAGES];
+    int count = boot_trace_snapshot(snap);
+    char line[96];
+
+    Serial.println("*************** boot trace ***************");
+    for (int i = 0; i < count; i++) {
+        boot_trace_format(snap[i], line, sizeof(line));
+        Serial.print(line);
+    }
+    Serial.println("******************************************");
+}
+
+bool boot_trace_save(const char *path)
+{
+    static BootTraceStage snap[BOOT_TRACE_MAX_STAGES];
+    int count = boot_trace_snapshot(snap);
+    char line[96];
+
+    if (!sd_is_valid()) {
+        return false;
+    }
+
+    // SD shares the SPI bus with the display and radios
+    if (xSemaphoreTake(radioLock, portMAX_DELAY) != pdTRUE) {
+        return false;
+    }
+
+    File file = SD.open(path, FILE_WRITE);
+    if (!file) {
+        xSemaphoreGive(radioLock);
+        Serial.printf("[BOOT] Failed to open %s\n", path);
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        int n = boot_trace_format(snap[i], line, sizeof(line));
+        file.write((const uint8_t *)line, min(n, (int)sizeof(line) - 1));
+    }
+    file.close();
+    xSemaphoreGive(radioLock);
+
+    return true;
+}
@@ -0,0 +1,57 @@
+// Nautilus Boot Trace - per-stage timing of the startup sequence
+//
+// Stages may run on either core; each entry records the core it started on
+// so the parallel bring-up can be read back from the log.
+
+#pragma once
+
+#include <Arduino.h>
+
+#define BOOT_TRACE_MAX_STAGES 32
+#define BOOT_TRACE_LOG_PATH   "/boot_trace.log"
+
+typedef struct {
+    const char *name;      // Static string, not copied
+    uint32_t start_us;     // micros() at stage start
+    uint32_t end_us;       // micros() at stage end, 0 while running
+    uint8_t core;          // Core the stage ran on
+} BootTraceStage;
+
+/**
+ * Begin timing a boot stage
+ * @param name Static stage name
+ * @return Stage handle for boot_trace_end(), or -1 if the table is full
+ */
+int boot_trace_begin(const char *name);
+
+/**
+ * Finish timing a boot stage
+ * @param handle Handle returned by boot_trace_begin()
+ */
+void boot_trace_end(int handle);
+
+/**
+ * Record a zero-length marker (e.g. "setup_done")
+ * @param name Static marker name
+ */
+void boot_trace_mark(const char *name);
+
+/**
+ * Record a stage that ran outside the boot sequence (lazy init on first use)
+ * @param name Static stage name
+ * @param start_us micros() when the work started
+ */
+void boot_trace_lazy(const char *name, uint32_t start_us);
+
+/**
+ * Print all recorded stages to Serial, one parseable line per stage:
+ *   [BOOT] stage=<name> core=<n> start_us=<t> dur_us=<d>
+ */
+void boot_trace_dump(void);
+
+/**
+ * Write the trace to the SD card (caller must ensure SD is mounted)
+ * @param path Destination file, overwritten
+ * @return true on success
+ */
+bool boot_trace_save(const char *path = BOOT_TRACE_LOG_PATH);
@@ -9,6 +9,7 @@
  *      INCLUDES
  *********************/
 #include "port_disp.h"
+#include "port_indev.h"
 #include <stdbool.h>
 
 /*********************
@@ -27,10 +28,12 @@ TFT_eSPI tft;
 static void disp_init(void);
 
 static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void disp_monitor(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_port_disp_stats_t disp_stats;
 
 /**********************
  *      MACROS
@@ -76,6 +79,7 @@ void lv_port_disp_init(void)
 
     /*Used to copy the buffer's content to the display*/
     disp_drv.flush_cb = disp_flush;
+    disp_drv.monitor_cb = disp_monitor;
     
     /*Set a display buffer*/
     disp_drv.draw_buf = &draw_buf_dsc;
@@ -122,15 +126,52 @@ void disp_disable_update(void)
 static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
 {
     if(disp_flush_enabled) {
+        uint32_t t0 = micros();
         if(xSemaphoreTake(radioLock, portMAX_DELAY) == pdTRUE){
+            uint32_t t1 = micros();
             uint32_t w = (area->x2 - area->x1 + 1);
             uint32_t h = (area->y2 - area->y1 + 1);
 
+            bool last = lv_disp_flush_is_last(disp_drv);
+
             tft.setAddrWindow( area->x1, area->y1, w, h );
             tft.pushColors( ( uint16_t * )&color_p->full, w * h, true );
 
             lv_disp_flush_ready(disp_drv);
             xSemaphoreGive(radioLock);
+
+            uint32_t t2 = micros();
+            disp_stats.lock_wait_last_us = t1 - t0;
+            disp_stats.lock_wait_total_us += t1 - t0;
+            if(t1 - t0 > disp_stats.lock_wait_max_us) {
+                disp_stats.lock_wait_max_us = t1 - t0;
+            }
+            disp_stats.flush_last_us = t2 - t1;
+            if(t2 - t1 > disp_stats.flush_max_us) {
+                disp_stats.flush_max_us = t2 - t1;
+            }
+
+            if(last) {
+                disp_stats.frames++;
+                lv_port_indev_frame_flushed();
+            }
         }
     }
 }
+
+/*Called by LVGL after every refresh with the time spent rendering and flushing it*/
+static void disp_monitor(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px)
+{
+    disp_stats.refr_last_ms = time;
+}
+
+void lv_port_disp_get_stats(lv_port_disp_stats_t *out)
+{
+    *out = disp_stats;
+}
+
+void lv_port_disp_reset_max(void)
+{
+    disp_stats.flush_max_us = 0;
+    disp_stats.lock_wait_max_us = 0;
+}
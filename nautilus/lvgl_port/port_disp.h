@@ -22,6 +22,17 @@
 extern TFT_eSPI tft;
 extern SemaphoreHandle_t radioLock;
 
+/* Frame and flush timing, written from the LVGL thread only */
+typedef struct {
+    uint32_t frames;             /* Refreshes whose last area reached the panel */
+    uint32_t refr_last_ms;       /* Render + flush time of the last refresh */
+    uint32_t flush_last_us;      /* Last disp_flush() panel push, lock wait excluded */
+    uint32_t flush_max_us;
+    uint32_t lock_wait_last_us;  /* Time disp_flush() blocked on radioLock */
+    uint32_t lock_wait_max_us;
+    uint32_t lock_wait_total_us; /* Running sum, for a duty figure over a window */
+} lv_port_disp_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -36,6 +47,10 @@ void disp_enable_update(void);
  */
 void disp_disable_update(void);
 
+void lv_port_disp_get_stats(lv_port_disp_stats_t *out);
+/* Clear the max fields so the next read covers a fresh window */
+void lv_port_disp_reset_max(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -13,11 +13,24 @@
 /*********************
  *      DEFINES
  *********************/
+#define ENC_RING_SIZE           64      // Detent events buffered between LVGL reads (power of 2)
+#define ENC_KEY_DEBOUNCE_MS     20      // Key level must be stable this long to be accepted
+
+// Velocity curve: the gap between consecutive detents picks the step multiplier
+#define ENC_ACCEL_FAST_US       25000
+#define ENC_ACCEL_FAST_STEPS    4
+#define ENC_ACCEL_MED_US        60000
+#define ENC_ACCEL_MED_STEPS     2
+
+#define ENC_LATENCY_MAX_US      1000000 // Longer gaps mean the input caused no redraw
 
 /**********************
  *      TYPEDEFS
  **********************/
-RotaryEncoder encoder(ENCODER_INA, ENCODER_INB, RotaryEncoder::LatchMode::TWO03);
+typedef struct {
+    uint32_t t_us;      // micros() at the detent
+    int8_t dir;         // +1 / -1 in RotaryEncoder position sense
+} enc_event_t;
 
 volatile bool indev_encoder_enabled = true;
 volatile bool indev_keypad_enabled = true;
@@ -33,6 +46,7 @@ static uint32_t keypad_get_key(void);
 static void encoder_init(void);
 static void encoder_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
 static void encoder_handler(void);
+static void encoder_key_handler(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -43,6 +57,33 @@ lv_indev_t * indev_encoder;
 static int32_t encoder_diff;
 static lv_indev_state_t encoder_state;
 
+// Quadrature state, written only by encoder_handler()
+static const int8_t enc_knobdir[] = {
+    0, -1, 1, 0,
+    1, 0, 0, -1,
+    -1, 0, 0, 1,
+    0, 1, -1, 0};
+static volatile int8_t enc_old_state;
+static volatile int32_t enc_raw_pos;
+static volatile int32_t enc_detent_pos;
+
+// Single producer (ISR) / single consumer (encoder_read) ring
+static enc_event_t enc_ring[ENC_RING_SIZE];
+static volatile uint32_t enc_ring_head;
+static volatile uint32_t enc_ring_tail;
+static volatile uint32_t enc_ring_dropped;
+static uint32_t enc_last_detent_us;
+static int8_t enc_last_dir;
+
+// Key debounce: ISR records the last edge, encoder_read accepts a level once stable
+static volatile uint32_t enc_key_edge_ms;
+static volatile uint32_t enc_key_edge_us;
+static bool enc_key_pressed;
+
+// Input-to-pixel latency
+static volatile uint32_t enc_input_pending_us;
+static lv_port_indev_latency_t enc_latency;
+
 /**********************
  *      MACROS
  **********************/
@@ -127,42 +168,123 @@ static uint32_t keypad_get_key(void)
 int indev_encoder_pos = 0;
 static void encoder_init(void)
 {
+    // Pull-ups the RotaryEncoder constructor used to set; the quadrature pins float without them
+    pinMode(ENCODER_INA, INPUT_PULLUP);
+    pinMode(ENCODER_INB, INPUT_PULLUP);
     pinMode(ENCODER_KEY, INPUT);
+    enc_old_state = digitalRead(ENCODER_INA) | (digitalRead(ENCODER_INB) << 1);
+    enc_key_pressed = (digitalRead(ENCODER_KEY) == LOW);
     attachInterrupt(ENCODER_INA, encoder_handler, CHANGE);
     attachInterrupt(ENCODER_INB, encoder_handler, CHANGE);
+    attachInterrupt(ENCODER_KEY, encoder_key_handler, CHANGE);
+}
+
+// Pull queued detents, applying the velocity curve. Returns steps in position sense.
+static int32_t encoder_drain(uint32_t *first_us)
+{
+    int32_t steps = 0;
+    uint32_t tail = enc_ring_tail;
+    uint32_t head = enc_ring_head;
+
+    *first_us = 0;
+    while (tail != head) {
+        const enc_event_t &ev = enc_ring[tail & (ENC_RING_SIZE - 1)];
+        uint32_t gap = ev.t_us - enc_last_detent_us;
+        int32_t mult = 1;
+
+        // Reversing always moves a single step so overshoot can be corrected
+        if (ev.dir == enc_last_dir) {
+            if (gap < ENC_ACCEL_FAST_US) {
+                mult = ENC_ACCEL_FAST_STEPS;
+            } else if (gap < ENC_ACCEL_MED_US) {
+                mult = ENC_ACCEL_MED_STEPS;
+            }
+        }
+        if (*first_us == 0) {
+            *first_us = ev.t_us;
+        }
+
+        steps += ev.dir * mult;
+        enc_last_detent_us = ev.t_us;
+        enc_last_dir = ev.dir;
+        tail++;
+    }
+    enc_ring_tail = tail;
+
+    return steps;
 }
 
 /*Will be called by the library to read the encoder*/
 static void encoder_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
 {
-    // Always update position for volume control during playback
-    indev_encoder_pos = encoder.getPosition();
+    uint32_t first_us;
+    int32_t steps = encoder_drain(&first_us);
+
+    // Always update position for volume control during playback (raw detents, no acceleration)
+    indev_encoder_pos = enc_detent_pos;
 
     if(indev_encoder_enabled){
-        int encoder_dir = (int16_t)encoder.getDirection();
-        if(encoder_dir != 0){
-            data->enc_diff = -encoder_dir;
+        if(steps != 0){
+            data->enc_diff = -steps;
+            if(enc_input_pending_us == 0) {
+                enc_input_pending_us = first_us;
+            }
         }
     } else {
         data->enc_diff = 0;
         data->state = LV_INDEV_STATE_REL;
     }
 
-    if (digitalRead(ENCODER_KEY) == LOW) {
-        data->state = LV_INDEV_STATE_PR;
-    } else if (digitalRead(ENCODER_KEY) == HIGH) {
-        data->state = LV_INDEV_STATE_REL;
+    // One read of the key; accept a new level only once it has been stable
+    bool level_pressed = (digitalRead(ENCODER_KEY) == LOW);
+    if (level_pressed != enc_key_pressed && (millis() - enc_key_edge_ms) >= ENC_KEY_DEBOUNCE_MS) {
+        enc_key_pressed = level_pressed;
+        if(enc_input_pending_us == 0) {
+            enc_input_pending_us = enc_key_edge_us;
+        }
     }
+    data->state = enc_key_pressed ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
     // Serial.printf("enc_diff:%d, sta:%d\n",data->enc_diff, data->state);
 }
 
 /*Call this function in an interrupt to process encoder events (turn, press)*/
-static void encoder_handler(void)
+static void IRAM_ATTR encoder_handler(void)
 {
-    /*Your code comes here*/
-    // Always tick the encoder to track position, even when LVGL input is disabled
+    // Always track position, even when LVGL input is disabled
     // This allows volume control during music playback
-    encoder.tick();
+    int8_t state = digitalRead(ENCODER_INA) | (digitalRead(ENCODER_INB) << 1);
+    if (state == enc_old_state) {
+        return;
+    }
+    enc_raw_pos += enc_knobdir[state | (enc_old_state << 2)];
+    enc_old_state = state;
+
+    // Two steps per detent, latched on states 0 and 3 (RotaryEncoder TWO03)
+    if (state != 0 && state != 3) {
+        return;
+    }
+    int32_t detent = enc_raw_pos >> 1;
+    if (detent == enc_detent_pos) {
+        return;
+    }
+
+    int8_t dir = (detent > enc_detent_pos) ? 1 : -1;
+    enc_detent_pos = detent;
+
+    uint32_t head = enc_ring_head;
+    if (head - enc_ring_tail >= ENC_RING_SIZE) {
+        enc_ring_dropped++;
+        return;
+    }
+    enc_ring[head & (ENC_RING_SIZE - 1)].t_us = micros();
+    enc_ring[head & (ENC_RING_SIZE - 1)].dir = dir;
+    enc_ring_head = head + 1;
+}
+
+static void IRAM_ATTR encoder_key_handler(void)
+{
+    enc_key_edge_ms = millis();
+    enc_key_edge_us = micros();
 }
 
 void lv_port_indev_enabled(bool en)
@@ -176,4 +298,35 @@ int lv_port_indev_get_pos(void)
     return indev_encoder_pos;
 }
 
+void lv_port_indev_frame_flushed(void)
+{
+    uint32_t t_in = enc_input_pending_us;
+    if (t_in == 0) {
+        return;
+    }
+    enc_input_pending_us = 0;
+
+    uint32_t lat = micros() - t_in;
+    if (lat > ENC_LATENCY_MAX_US) {
+        return;
+    }
+
+    enc_latency.last_us = lat;
+    if (lat > enc_latency.max_us) {
+        enc_latency.max_us = lat;
+    }
+    // Exponential average, 1/8 weight per sample
+    enc_latency.avg_us = enc_latency.samples ? (enc_latency.avg_us * 7 + lat) / 8 : lat;
+    enc_latency.samples++;
+    enc_latency.dropped = enc_ring_dropped;
+}
+
+void lv_port_indev_get_latency(lv_port_indev_latency_t *out)
+{
+    *out = enc_latency;
+}
 
+void lv_port_indev_reset_latency(void)
+{
+    memset(&enc_latency, 0, sizeof(enc_latency));
+}
@@ -12,7 +12,6 @@
  *      INCLUDES
  *********************/
 #include "lvgl.h"
-#include "RotaryEncoder.h"
 
 /*********************
  *      DEFINES
@@ -21,13 +20,26 @@
 /**********************
  *      TYPEDEFS
  **********************/
-extern RotaryEncoder encoder;
+/* Time from an encoder detent or key edge to the end of the next flushed frame */
+typedef struct {
+    uint32_t last_us;
+    uint32_t avg_us;
+    uint32_t max_us;
+    uint32_t samples;
+    uint32_t dropped;   /* Detents lost to a full event ring */
+} lv_port_indev_latency_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 void lv_port_indev_init(void);
 void lv_port_indev_enabled(bool en);
 int lv_port_indev_get_pos(void);
+
+/* Called by the display driver when the last area of a frame has been flushed */
+void lv_port_indev_frame_flushed(void);
+void lv_port_indev_get_latency(lv_port_indev_latency_t *out);
+void lv_port_indev_reset_latency(void);
 /**********************
  *      MACROS
  **********************/
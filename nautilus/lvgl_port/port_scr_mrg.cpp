@@ -1,14 +1,18 @@
+
 #include "port_scr_mrg.h"
 
-/* 记录所有的屏幕卡片 */ 
-scr_card_t *scr_mgr_head;
-scr_card_t *scr_mgr_top;
+/* 记录所有的屏幕卡片, 按 id 索引 */
+static scr_card_t *scr_mgr_table[SCR_MGR_MAX_ID];
 
 /* 被调用屏幕栈 */
 scr_card_t *scr_stack_root;
 scr_card_t *scr_stack_top;
 
-uint32_t scr_anim_time = SCR_MGR_ANIM_TIME; 
+/* Hidden screens kept alive, oldest first */
+static scr_card_t *scr_retained[SCR_MGR_RETAIN_MAX];
+static uint8_t scr_retained_cnt = 0;
+
+uint32_t scr_anim_time = SCR_MGR_ANIM_TIME;
 lv_scr_load_anim_t scr_anim_sw = SCR_MGR_SCR_SWITCH_ANIM;
 lv_scr_load_anim_t scr_anim_push = SCR_MGR_SCR_PUSH_ANIM;
 lv_scr_load_anim_t scr_anim_pop = SCR_MGR_SCR_POP_ANIM;
@@ -34,25 +38,11 @@ static lv_obj_t *scr_mgr_default_style(scr_card_t *card)
     return obj;
 }
 
-static scr_card_t *scr_mgr_find_by_id(int id) 
+static scr_card_t *scr_mgr_find_by_id(int id)
 {
-    scr_card_t *p = scr_mgr_head->next;
-    while(p != NULL){
-        if(id == p->id)
-            return p;
-        p = p->next;
-    }
-    return NULL;
-}
-
-static scr_card_t *scr_mgr_get_top(scr_card_t *head) 
-{
-    scr_card_t *p = head;
-
-    while(p->next != NULL){
-        p = p->next;
-    }
-    return p;
+    if(id < 0 || id >= SCR_MGR_MAX_ID)
+        return NULL;
+    return scr_mgr_table[id];
 }
 
 static void scr_mgr_active(scr_card_t *card)
@@ -87,28 +77,215 @@ static void scr_mgr_remove(scr_card_t *card)
     }
 }
 
+static void scr_mgr_free_card(scr_card_t *card)
+{
+    if(card->keep){
+        if(card->keep->group_objs)
+            lv_mem_free((void *)card->keep->group_objs);
+        lv_mem_free((void *)card->keep);
+    }
+    lv_mem_free((void *)card);
+}
+
+// A screen's destroy() may have deleted a timer behind our back
+static bool scr_mgr_timer_alive(lv_timer_t *timer)
+{
+    for(lv_timer_t *t = lv_timer_get_next(NULL); t != NULL; t = lv_timer_get_next(t)){
+        if(t == timer)
+            return true;
+    }
+    return false;
+}
+
+/* Build a fresh stack card. Retained screens also record the timers their
+ * create() made: lv_timer_create() inserts at the head of the timer list, so
+ * they are exactly the entries in front of the old head. */
+static scr_card_t *scr_mgr_build(scr_card_t *tgt_card)
+{
+    scr_card_t *card = (scr_card_t *)lv_mem_alloc(sizeof(scr_card_t));
+    card->id = tgt_card->id;
+    card->st = SCR_MGR_STATE_CREATED;
+    card->life = tgt_card->life;
+    card->retain = tgt_card->retain;
+    card->keep = NULL;
+    card->prev = NULL;
+    card->next = NULL;
+
+    if(!card->retain){
+        card->obj = scr_mgr_default_style(tgt_card);
+        return card;
+    }
+
+    scr_mgr_trim();
+
+    lv_timer_t *old_head = lv_timer_get_next(NULL);
+    card->obj = scr_mgr_default_style(tgt_card);
+
+    card->keep = (scr_keep_t *)lv_mem_alloc(sizeof(scr_keep_t));
+    lv_memset_00(card->keep, sizeof(scr_keep_t));
+    for(lv_timer_t *t = lv_timer_get_next(NULL); t != NULL && t != old_head; t = lv_timer_get_next(t)){
+        if(card->keep->timer_cnt >= SCR_MGR_KEEP_TIMERS){
+            Serial.printf("[SCR] Screen %d has more than %d timers, extras keep running while hidden\n",
+                          card->id, SCR_MGR_KEEP_TIMERS);
+            break;
+        }
+        card->keep->timers[card->keep->timer_cnt++] = t;
+    }
+    return card;
+}
+
+/* Park an exited screen: pause its running timers and take its objects out of
+ * the default group so the encoder cannot wander into a hidden screen. */
+static void scr_mgr_hide(scr_card_t *card)
+{
+    scr_keep_t *keep = card->keep;
+    lv_group_t *g = lv_group_get_default();
+
+    keep->paused_mask = 0;
+    for(uint8_t i = 0; i < keep->timer_cnt; i++){
+        lv_timer_t *t = keep->timers[i];
+        if(scr_mgr_timer_alive(t) && !t->paused){
+            lv_timer_pause(t);
+            keep->paused_mask |= (1 << i);
+        }
+    }
+
+    keep->group_cnt = 0;
+    keep->focused = NULL;
+    if(g == NULL)
+        return;
+
+    uint32_t n = lv_group_get_obj_count(g);
+    keep->group_objs = (lv_obj_t **)lv_mem_realloc(keep->group_objs, (n ? n : 1) * sizeof(lv_obj_t *));
+
+    // Collect first: removing while walking the group list would skip entries
+    lv_obj_t **obj_p;
+    _LV_LL_READ(&g->obj_ll, obj_p){
+        if(lv_obj_get_screen(*obj_p) == card->obj){
+            keep->group_objs[keep->group_cnt++] = *obj_p;
+        }
+    }
+
+    lv_obj_t *focused = lv_group_get_focused(g);
+    for(uint16_t i = 0; i < keep->group_cnt; i++){
+        if(keep->group_objs[i] == focused)
+            keep->focused = focused;
+        lv_group_remove_obj(keep->group_objs[i]);
+    }
+}
+
+static void scr_mgr_show(scr_card_t *card)
+{
+    scr_keep_t *keep = card->keep;
+    lv_group_t *g = lv_group_get_default();
+
+    if(g){
+        for(uint16_t i = 0; i < keep->group_cnt; i++){
+            lv_group_add_obj(g, keep->group_objs[i]);
+        }
+        if(keep->focused)
+            lv_group_focus_obj(keep->focused);
+    }
+    keep->group_cnt = 0;
+    keep->focused = NULL;
+
+    for(uint8_t i = 0; i < keep->timer_cnt; i++){
+        if((keep->paused_mask & (1 << i)) && scr_mgr_timer_alive(keep->timers[i])){
+            lv_timer_resume(keep->timers[i]);
+        }
+    }
+    keep->paused_mask = 0;
+}
+
+static void scr_mgr_evict(uint8_t idx)
+{
+    scr_card_t *card = scr_retained[idx];
+    lv_obj_t *obj = card->obj;
+
+    for(uint8_t i = idx; i + 1 < scr_retained_cnt; i++){
+        scr_retained[i] = scr_retained[i + 1];
+    }
+    scr_retained_cnt--;
+
+    scr_mgr_remove(card);
+    scr_mgr_free_card(card);
+    if(obj)
+        lv_obj_del(obj);
+}
+
+static void scr_mgr_retain(scr_card_t *card)
+{
+    if(scr_retained_cnt >= SCR_MGR_RETAIN_MAX){
+        scr_mgr_evict(0);
+    }
+    scr_retained[scr_retained_cnt++] = card;
+}
+
+// Take a screen out of the retained set, or build it if it is not there
+static scr_card_t *scr_mgr_take(scr_card_t *tgt_card)
+{
+    for(uint8_t i = 0; i < scr_retained_cnt; i++){
+        scr_card_t *card = scr_retained[i];
+        if(card->id != tgt_card->id)
+            continue;
+        for(; i + 1 < scr_retained_cnt; i++){
+            scr_retained[i] = scr_retained[i + 1];
+        }
+        scr_retained_cnt--;
+        scr_mgr_show(card);
+        return card;
+    }
+    return scr_mgr_build(tgt_card);
+}
+
+/* Leave a stack card. Returns the screen object the caller still has to
+ * delete, or NULL when the screen was retained. */
+static lv_obj_t *scr_mgr_drop(scr_card_t *card)
+{
+    lv_obj_t *obj = card->obj;
+
+    if(card->keep){
+        scr_mgr_inactive(card);
+        scr_mgr_hide(card);
+        card->prev = NULL;
+        card->next = NULL;
+        scr_mgr_retain(card);
+        return NULL;
+    }
+
+    scr_mgr_remove(card);
+    scr_mgr_free_card(card);
+    return obj;
+}
+
+static bool scr_mgr_low_mem(void)
+{
+    return heap_caps_get_free_size(MALLOC_CAP_SPIRAM) < SCR_MGR_EVICT_FREE ||
+           heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM) < SCR_MGR_EVICT_BLOCK;
+}
+
+static void scr_mgr_trim_timer_cb(lv_timer_t *t)
+{
+    scr_mgr_trim();
+}
+
 /*********************************************************************************
  *                              GLOBAL FUNCTION
  *********************************************************************************/
 void scr_mgr_init(void)
 {
-    scr_mgr_head = (scr_card_t *)lv_mem_alloc(sizeof(scr_card_t));
-    scr_mgr_head->id = -1;
-    scr_mgr_head->obj = NULL;
-    scr_mgr_head->st = SCR_MGR_STATE_IDLE;
-    scr_mgr_head->life = NULL;
-    scr_mgr_head->next = NULL;
-    scr_mgr_head->prev = NULL;
-    
-    scr_mgr_top = scr_mgr_head;
+    lv_memset_00(scr_mgr_table, sizeof(scr_mgr_table));
+    scr_retained_cnt = 0;
 
     scr_stack_root = NULL;
     scr_stack_top = NULL;
+
+    lv_timer_create(scr_mgr_trim_timer_cb, SCR_MGR_TRIM_PERIOD, NULL);
 }
 
 bool scr_mgr_register(int id, scr_lifecycle_t *card_life)
 {
-    if(scr_mgr_find_by_id(id)){
+    if(id < 0 || id >= SCR_MGR_MAX_ID || scr_mgr_table[id]){
         return false;
     }
 
@@ -117,11 +294,12 @@ bool scr_mgr_register(int id, scr_lifecycle_t *card_life)
     new_card->obj = NULL;
     new_card->st = SCR_MGR_STATE_IDLE;
     new_card->life = card_life;
+    new_card->retain = false;
+    new_card->keep = NULL;
     new_card->next = NULL;
-    new_card->prev = scr_mgr_top;
+    new_card->prev = NULL;
 
-    scr_mgr_top->next = new_card;
-    scr_mgr_top = new_card;
+    scr_mgr_table[id] = new_card;
 
     return true;
 }
@@ -130,44 +308,35 @@ bool scr_mgr_switch(int id, bool anim)
 {
     scr_card_t *tgt_card = scr_mgr_find_by_id(id);
     scr_card_t *stack_scr = NULL;
-    lv_obj_t *curr_obj = NULL;
+    lv_obj_t *act_obj = lv_scr_act();
+    bool del_act = false;
 
     if(tgt_card == NULL)
         return false;
 
-    if(scr_stack_top != NULL) {
-        curr_obj = scr_stack_top->obj;
-        stack_scr = scr_stack_top->prev;
-        scr_mgr_remove(scr_stack_top);
-        lv_mem_free((void *)scr_stack_top);
-        scr_stack_top = stack_scr;
-    }
     while(scr_stack_top != NULL) {
         stack_scr = scr_stack_top->prev;
-        curr_obj = scr_stack_top->obj;
-        scr_mgr_remove(scr_stack_top);
-        lv_mem_free((void *)scr_stack_top);
+        lv_obj_t *obj = scr_mgr_drop(scr_stack_top);
+        // The visible screen goes once the new one is loaded, the rest right away
+        if(obj == act_obj)
+            del_act = true;
+        else if(obj)
+            lv_obj_del(obj);
         scr_stack_top = stack_scr;
     }
 
-    stack_scr = (scr_card_t *)lv_mem_alloc(sizeof(scr_card_t));
-    stack_scr->id = tgt_card->id;
-    stack_scr->obj = scr_mgr_default_style(tgt_card);
-    stack_scr->st = SCR_MGR_STATE_CREATED;
-    stack_scr->life = tgt_card->life;
-    stack_scr->prev = NULL;
-    stack_scr->next = NULL;
+    stack_scr = scr_mgr_take(tgt_card);
     scr_stack_root = stack_scr;
     scr_stack_top = stack_scr;
 
     scr_mgr_active(stack_scr);
 
     if(scr_anim_sw != LV_SCR_LOAD_ANIM_NONE && anim){
-        lv_scr_load_anim(stack_scr->obj, scr_anim_sw, scr_anim_time, 0, true);
+        lv_scr_load_anim(stack_scr->obj, scr_anim_sw, scr_anim_time, 0, del_act);
     } else{
         lv_scr_load(stack_scr->obj);
-        if(curr_obj)
-            lv_obj_del(curr_obj);
+        if(del_act)
+            lv_obj_del(act_obj);
     }
     return true;
 }
@@ -185,11 +354,7 @@ bool scr_mgr_push(int id, bool anim)
         return false;
     }
 
-    stack_scr = (scr_card_t *)lv_mem_alloc(sizeof(scr_card_t));
-    stack_scr->id = tgt_card->id;
-    stack_scr->obj = scr_mgr_default_style(tgt_card);
-    stack_scr->st = SCR_MGR_STATE_CREATED;
-    stack_scr->life = tgt_card->life;
+    stack_scr = scr_mgr_take(tgt_card);
     if(scr_stack_top == NULL){
         stack_scr->prev = NULL;
         stack_scr->next = NULL;
@@ -199,7 +364,7 @@ bool scr_mgr_push(int id, bool anim)
         scr_mgr_inactive(scr_stack_top);
         scr_stack_top->next = stack_scr;
         stack_scr->prev = scr_stack_top;
-        scr_stack_top->next = NULL;
+        stack_scr->next = NULL;
         scr_stack_top = stack_scr;
     }
 
@@ -222,16 +387,15 @@ bool scr_mgr_pop(bool anim)
         return false;
     }
 
-    cur_obj = scr_stack_top->obj;
     dst_item = scr_stack_top->prev;
-    scr_mgr_remove(scr_stack_top);
-    lv_mem_free((void *)scr_stack_top);
+    cur_obj = scr_mgr_drop(scr_stack_top);
     scr_stack_top = dst_item;
+    scr_stack_top->next = NULL;
 
     scr_mgr_active(dst_item);
 
     if(scr_anim_pop != LV_SCR_LOAD_ANIM_NONE && anim){
-        lv_scr_load_anim(dst_item->obj, scr_anim_pop, scr_anim_time, 0, true);
+        lv_scr_load_anim(dst_item->obj, scr_anim_pop, scr_anim_time, 0, cur_obj != NULL);
     } else{
         lv_scr_load(dst_item->obj);
         if (cur_obj) {
@@ -241,6 +405,72 @@ bool scr_mgr_pop(bool anim)
     return true;
 }
 
+/**
+ * Keep a screen alive when it is left. It is hidden instead of destroyed and
+ * comes back without running create() again. Only for screens whose entry()
+ * fully restores their visible state.
+ */
+bool scr_mgr_set_retain(int id, bool retain)
+{
+    scr_card_t *card = scr_mgr_find_by_id(id);
+
+    if(card == NULL)
+        return false;
+
+    card->retain = retain;
+    if(!retain){
+        for(uint8_t i = 0; i < scr_retained_cnt; i++){
+            if(scr_retained[i]->id == id){
+                scr_mgr_evict(i);
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+// Build a retained screen ahead of its first use so even that entry is instant
+bool scr_mgr_prebuild(int id)
+{
+    scr_card_t *tgt_card = scr_mgr_find_by_id(id);
+
+    if(tgt_card == NULL || !tgt_card->retain)
+        return false;
+
+    for(scr_card_t *p = scr_stack_top; p != NULL; p = p->prev){
+        if(p->id == id)
+            return false;
+    }
+    for(uint8_t i = 0; i < scr_retained_cnt; i++){
+        if(scr_retained[i]->id == id)
+            return true;
+    }
+    if(scr_retained_cnt >= SCR_MGR_RETAIN_MAX)
+        return false;
+
+    scr_card_t *card = scr_mgr_build(tgt_card);
+    scr_mgr_hide(card);
+    scr_mgr_retain(card);
+    return true;
+}
+
+// Memory-pressure hook: drop retained screens, oldest first, until the heap recovers
+void scr_mgr_trim(void)
+{
+    while(scr_retained_cnt > 0 && scr_mgr_low_mem()){
+        Serial.printf("[SCR] Low memory, evicting retained screen %d\n", scr_retained[0]->id);
+        scr_mgr_evict(0);
+    }
+}
+
+// Drop every retained screen, e.g. after a change their entry() cannot reapply
+void scr_mgr_evict_all(void)
+{
+    while(scr_retained_cnt > 0){
+        scr_mgr_evict(0);
+    }
+}
+
 // set anim
 void scr_mgr_set_anim(lv_scr_load_anim_t sw, lv_scr_load_anim_t push, lv_scr_load_anim_t pop)
 {
@@ -261,4 +491,3 @@ void scr_mgr_set_bg_color(uint32_t c)
     default_bg_color = c;
 }
 
-
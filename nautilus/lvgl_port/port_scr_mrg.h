@@ -8,6 +8,15 @@
 #define SCR_MGR_SCR_PUSH_ANIM      LV_SCR_LOAD_ANIM_MOVE_LEFT
 #define SCR_MGR_SCR_POP_ANIM       LV_SCR_LOAD_ANIM_MOVE_RIGHT
 
+#define SCR_MGR_MAX_ID        SCREEN_ID_MAX   // Screen ids index scr_mgr_table directly
+#define SCR_MGR_RETAIN_MAX    3               // Hidden screens kept alive for a one-frame return
+#define SCR_MGR_KEEP_TIMERS   8               // Timers per retained screen paused while hidden
+// The LVGL heap is PSRAM (LV_MEM_CUSTOM -> ps_malloc); retained screens are
+// evicted oldest-first while either figure is below its threshold
+#define SCR_MGR_EVICT_FREE    (512 * 1024)
+#define SCR_MGR_EVICT_BLOCK   (64 * 1024)
+#define SCR_MGR_TRIM_PERIOD   2000
+
 typedef enum scr_mgr_state {
     SCR_MGR_STATE_IDLE = 0,  /* Not in use */
     SCR_MGR_STATE_DESTROYED, /* Not active and having been destroyed */
@@ -24,11 +33,23 @@ typedef struct scr_lifecycle {
     void (*destroy)(void);
 } scr_lifecycle_t;
 
+/* State a retained screen needs to be hidden and shown again without a rebuild */
+typedef struct scr_keep {
+    lv_timer_t *timers[SCR_MGR_KEEP_TIMERS]; /* Timers created by create() */
+    uint8_t     timer_cnt;
+    uint8_t     paused_mask;                 /* Timers this manager paused on hide */
+    lv_obj_t  **group_objs;                  /* Default group members detached on hide */
+    uint16_t    group_cnt;
+    lv_obj_t   *focused;
+} scr_keep_t;
+
 typedef struct scr_card {
     int id;
     lv_obj_t        *obj;
     scr_mgr_state_e  st;
     scr_lifecycle_t *life;
+    bool             retain;  /* Hide instead of destroy when leaving */
+    scr_keep_t      *keep;    /* Only allocated for retained screens */
     struct scr_card *next;
     struct scr_card *prev;
 } scr_card_t;
@@ -42,6 +63,12 @@ bool scr_mgr_switch(int id, bool anim);
 bool scr_mgr_push(int id, bool anim);
 bool scr_mgr_pop(bool anim);
 
+// retained screens
+bool scr_mgr_set_retain(int id, bool retain);
+bool scr_mgr_prebuild(int id);
+void scr_mgr_trim(void);
+void scr_mgr_evict_all(void);
+
 // set anim
 void scr_mgr_set_anim(lv_scr_load_anim_t sw, lv_scr_load_anim_t push, lv_scr_load_anim_t pop);
 // set bg color
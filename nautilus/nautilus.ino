@@ -11,6 +11,7 @@
 #include <IRutils.h>
 #include <vector>
 #include "portal.h"
+#include "boot_trace.h"
 
 const uint16_t kIrLed = 2;  // ESP8266 GPIO pin to use. Recommended: 4 (D2).
 const uint16_t kRecvPin = 1;
@@ -30,6 +31,14 @@ uint64_t IR_recv_value = 0x10000000UL;
 #define WS2812_PRIORITY  (configMAX_PRIORITIES - 3)
 #define NRF24_PRIORITY   (configMAX_PRIORITIES - 5)
 
+// I2C-side bring-up runs on core 1 while core 0 does the SPI-side work
+#define BOOT_IO_PRIORITY (configMAX_PRIORITIES - 1)
+#define BOOT_IO_CORE     1
+
+// Set to 1 to scan the whole I2C bus / list SPIFFS at boot (diagnostics only)
+#define BOOT_FULL_I2C_SCAN  0
+#define BOOT_LIST_SPIFFS    0
+
 /*********************************************************************************
  *                              EXTERN
  *********************************************************************************/
@@ -60,6 +69,10 @@ TaskHandle_t sghz_handle;
 TaskHandle_t ws2812_handle;
 TaskHandle_t nrf24_handle;
 
+// boot
+static SemaphoreHandle_t boot_io_done;
+static bool boot_pmu_ret = false;
+
 // wifi
 // char wifi_ssid[WIFI_SSID_MAX_LEN] = "xinyuandianzi";
 // char wifi_password[WIFI_PSWD_MAX_LEN] = "AA15994823428";
@@ -76,11 +89,6 @@ static uint32_t last_tick;
 uint8_t eeprom_ssid[WIFI_SSID_MAX_LEN];
 uint8_t eeprom_pswd[WIFI_PSWD_MAX_LEN];
 
-// mic
-int16_t i2s_readraw_buff[SAMPLE_SIZE] = {0};
-size_t bytes_read = 0;
-int i2s_mic_cnt = 0;
-
 // BOARD_USER_KEY (GPIO 6) - Back/Sleep Button
 volatile unsigned long userKeyPressStart = 0;
 volatile bool userKeyPressed = false;
@@ -106,7 +114,7 @@ extern void ui_scr1_set_mode(int mode);
 // Helper function to stop music playback and update state
 void stop_music_playback() {
     if (music_is_running) {
-        audio.stopSong();
+        audio_stop();
         music_is_running = false;
         Serial.println("Stopped music playback");
     }
@@ -217,8 +225,8 @@ void multi_thread_create(void)
 {
     xTaskCreate(nfc_task, "nfc_task", 1024 * 3, NULL, NFC_PRIORITY, &nfc_handle);
     xTaskCreate(sghz_task, "sghz_task", 1024 * 2, NULL, SGHZ_PRIORITY, &sghz_handle);
-    xTaskCreate(ws2812_task, "ws2812_task", 1024 * 2, NULL, WS2812_PRIORITY, &ws2812_handle);
-    xTaskCreate(nrf24_task, "nrf24_task", 1024 * 10, NULL, NRF24_PRIORITY, &nrf24_handle);
+    xTaskCreatePinnedToCore(ws2812_task, "ws2812_task", 1024 * 2, NULL, WS2812_PRIORITY, &ws2812_handle, WS2812_TASK_CORE);
+    xTaskCreate(nrf24_task, "nrf24_task", 1024 * 4, NULL, NRF24_PRIORITY, &nrf24_handle);
 }
 
 void wifi_init(void)
@@ -314,48 +322,6 @@ void listDir(fs::FS &fs, const char * dirname, uint8_t levels){
     }
 }
 
-extern int music_idx;
-extern std::vector<String> music_list;
-extern TFT_eSPI tft;
-
-void scr8_read_music_from_SD(void)
-{
-    // Try /music first, fall back to root if it doesn't exist
-    File root = SD.open("/music");
-    if(!root){
-        Serial.println("/music not found, trying root directory");
-        root = SD.open("/");
-        if(!root) {
-            Serial.println("Failed to open directory");
-            return;
-        }
-    }
-
-    music_list.clear();  // Clear any existing entries
-
-    File file = root.openNextFile();
-    // Load all music files - no artificial limit!
-    // Add watchdog reset to prevent timeout with many files
-    while(file) {
-        if(!file.isDirectory()) {
-            char *file_name = (char *)file.name();
-            // Only add .mp3 files
-            if(strlen(file_name) > 4 && strcmp(file_name + strlen(file_name) - 4, ".mp3") == 0) {
-                music_list.push_back(String(file_name));
-                Serial.println(file_name);
-            }
-        }
-        file.close();
-
-        // Yield to prevent watchdog timeout when scanning large directories
-        delay(1);
-
-        file = root.openNextFile();
-    }
-    root.close();
-    Serial.printf("Loaded %d music files\n", music_list.size());
-}
-
 /*********************************************************************************
  *                   BOARD_USER_KEY (Back/Sleep Button) Functions
  *********************************************************************************/
@@ -458,8 +424,8 @@ void handle_back_button() {
 void handle_sleep_request() {
     Serial.println("Entering sleep mode...");
 
-    // Save configuration before sleeping
-    if (config_save()) {
+    // Write any pending configuration before sleeping
+    if (config_is_dirty() && config_flush()) {
         Serial.println("[CONFIG] Saved configuration before sleep");
     }
 
@@ -572,11 +538,101 @@ void monitor_user_key() {
     lastKeyState = currentKeyState;
 }
 
+static void boot_pmu_init(void)
+{
+    boot_pmu_ret = PPM.init(Wire, BOARD_I2C_SDA, BOARD_I2C_SCL, BQ25896_SLAVE_ADDRESS);
+    if(boot_pmu_ret) {
+        // PPM.setSysPowerDownVoltage(3300);
+        // PPM.setInputCurrentLimit(3250);
+        // Serial.printf("getInputCurrentLimit: %d mA\n",PPM.getInputCurrentLimit());
+        // PPM.disableCurrentLimitPin();
+        PPM.setChargeTargetVoltage(4208);
+        // PPM.setPrechargeCurr(64);
+        // PPM.setChargerConstantCurr(832);
+        // PPM.getChargerConstantCurr();
+        // Serial.printf("getChargerConstantCurr: %d mA\n",PPM.getChargerConstantCurr());
+        PPM.enableMeasure();
+        // PPM.enableCharge();
+        // Turn off charging function
+        // If USB is used as the only power input, it is best to turn off the charging function,
+        // otherwise the VSYS power supply will have a sawtooth wave, affecting the discharge output capability.
+        // PPM.disableCharge();
+
+
+        // The OTG function needs to enable OTG, and set the OTG control pin to HIGH
+        // After OTG is enabled, if an external power supply is plugged in, OTG will be turned off
+
+        // PPM.enableOTG();
+        // PPM.disableOTG();
+        // pinMode(OTG_ENABLE_PIN, OUTPUT);
+        // digitalWrite(OTG_ENABLE_PIN, HIGH);
+    }
+}
+
+static void boot_i2c_probe(void)
+{
+    Wire.begin(BOARD_I2C_SDA, BOARD_I2C_SCL);
+
+#if BOOT_FULL_I2C_SCAN
+    int nDevices = 0;
+    Serial.println("Scanning for I2C devices ...");
+    for(byte address = 0x01; address < 0x7F; address++){
+        Wire.beginTransmission(address);
+        if(Wire.endTransmission() == 0){ // 0: success.
+            nDevices++;
+            log_i("I2C device found at address 0x%x\n", address);
+        }
+    }
+    if (nDevices == 0){
+        Serial.println("No I2C devices found");
+    }
+#else
+    // Only the three known devices matter; probing them skips ~120 NACK round trips
+    static const uint8_t known[] = { BOARD_I2C_ADDR_1, BOARD_I2C_ADDR_2, BOARD_I2C_ADDR_3 };
+    static const char *names[] = { "PN532", "BQ27220", "BQ25896" };
+    for(int i = 0; i < 3; i++){
+        Wire.beginTransmission(known[i]);
+        if(Wire.endTransmission() == 0){
+            log_i("I2C device found %s at address 0x%x\n", names[i], known[i]);
+        }
+    }
+#endif
+}
+
+// Core 1: everything on the I2C bus plus the PDM mic. Nothing here touches
+// SPI, so it overlaps with the display/SD bring-up on core 0.
+static void boot_io_task(void *param)
+{
+    int t;
+
+    t = boot_trace_begin("i2c_probe");
+    boot_i2c_probe();
+    boot_trace_end(t);
+
+    t = boot_trace_begin("pmu_init");
+    boot_pmu_init();
+    boot_trace_end(t);
+
+    t = boot_trace_begin("bq27220_init");
+    bq27220.init();
+    boot_trace_end(t);
+
+    // First snapshot is taken here, so the status bar has it once we join
+    t = boot_trace_begin("power_service");
+    power_service_init();
+    boot_trace_end(t);
+
+    t = boot_trace_begin("mic_init");
+    init_microphone();
+    boot_trace_end(t);
+
+    xSemaphoreGive(boot_io_done);
+    vTaskDelete(NULL);
+}
+
 void setup(void)
 {
-    bool pmu_ret = false;
-    bool nfc_ret = false;
-    bool sghz_ret = false;
+    int t;
 
     // SGHZ、SD and LCD use the same spi, in order to avoid mutual influence; 
     // before powering on, all CS signals should be pulled high and in an unselected state;
@@ -625,105 +681,65 @@ void setup(void)
     assert(radioLock);
     xSemaphoreGive(radioLock);
 
-    init_microphone();
+    boot_trace_mark("setup_start");
 
-    // iic scan
-    byte error, address;
-    int nDevices = 0;
-    Serial.println("Scanning for I2C devices ...");
-    Wire.begin(BOARD_I2C_SDA, BOARD_I2C_SCL);
-    for(address = 0x01; address < 0x7F; address++){
-        Wire.beginTransmission(address);
-        // 0: success.
-        // 1: data too long to fit in transmit buffer.
-        // 2: received NACK on transmit of address.
-        // 3: received NACK on transmit of data.
-        // 4: other error.
-        // 5: timeout
-        error = Wire.endTransmission();
-        if(error == 0){ // 0: success.
-            nDevices++;
-            if(address == BOARD_I2C_ADDR_1) {
-                nfc_ret = true;
-                log_i("I2C device found PN532 at address 0x%x\n", address);
-            } else if(address == BOARD_I2C_ADDR_2) {
-                pmu_ret = true;
-                log_i("I2C device found at BQ27220 address 0x%x\n", address);
-            } else if(address == BOARD_I2C_ADDR_3) {
-                sghz_ret = true;
-                log_i("I2C device found at BQ25896 address 0x%x\n", address);
-            }
-        }
-    }
-    if (nDevices == 0){
-        Serial.println("No I2C devices found");
-    }
+    // Start the I2C-side bring-up on the other core
+    boot_io_done = xSemaphoreCreateBinary();
+    assert(boot_io_done);
+    xTaskCreatePinnedToCore(boot_io_task, "boot_io", 1024 * 4, NULL, BOOT_IO_PRIORITY, NULL, BOOT_IO_CORE);
 
+    t = boot_trace_begin("spiffs_mount");
     if(!SPIFFS.begin(FORMAT_SPIFFS_IF_FAILED)){
         Serial.println("SPIFFS Mount Failed");
         return;
     }
+    boot_trace_end(t);
 
+#if BOOT_LIST_SPIFFS
     Serial.println("*************** SPIFFS ****************");
     listDir(SPIFFS, "/", 0);
     Serial.println("**************************************");
+#endif
 
+    t = boot_trace_begin("eeprom_init");
     eeprom_init();
+    boot_trace_end(t);
 
     // wifi_init();
     configTime(8 * 3600, 0, ntpServer1, ntpServer2);
 
-    pmu_ret = PPM.init(Wire, BOARD_I2C_SDA, BOARD_I2C_SCL, BQ25896_SLAVE_ADDRESS);
-    if(pmu_ret) {
-        // PPM.setSysPowerDownVoltage(3300);
-        // PPM.setInputCurrentLimit(3250);
-        // Serial.printf("getInputCurrentLimit: %d mA\n",PPM.getInputCurrentLimit());
-        // PPM.disableCurrentLimitPin();
-        PPM.setChargeTargetVoltage(4208);
-        // PPM.setPrechargeCurr(64);
-        // PPM.setChargerConstantCurr(832);
-        // PPM.getChargerConstantCurr();
-        // Serial.printf("getChargerConstantCurr: %d mA\n",PPM.getChargerConstantCurr());
-        PPM.enableMeasure();
-        // PPM.enableCharge();
-        // Turn off charging function
-        // If USB is used as the only power input, it is best to turn off the charging function,
-        // otherwise the VSYS power supply will have a sawtooth wave, affecting the discharge output capability.
-        // PPM.disableCharge();
-
-
-        // The OTG function needs to enable OTG, and set the OTG control pin to HIGH
-        // After OTG is enabled, if an external power supply is plugged in, OTG will be turned off
-
-        // PPM.enableOTG();
-        // PPM.disableOTG();
-        // pinMode(OTG_ENABLE_PIN, OUTPUT);
-        // digitalWrite(OTG_ENABLE_PIN, HIGH);
-    }
-
-    bq27220.init();
-   
-    sghz_init(); 
-
-    if(nfc_ret)
-        nfc_init();
+    // CC1101 and PN532 are brought up on first use (sghz_ensure_init / nfc_ensure_init).
+    // NRF24 is still probed here: the main menu only lists it when present.
 
+    t = boot_trace_begin("ws2812_init");
     ws2812_init();
+    boot_trace_end(t);
 
     // infared_init();
 
+    t = boot_trace_begin("nrf24_init");
     nrf24_init();
+    boot_trace_end(t);
 
     multi_thread_create();
 
-    audio.setPinout(BOARD_VOICE_BCLK, BOARD_VOICE_LRCLK, BOARD_VOICE_DIN);
-    audio.setVolume(21); // 0...21
-    audio.connecttoFS(SPIFFS, "/001.mp3");
+    t = boot_trace_begin("audio_init");
+    audio_service_init();
+    audio_play(SPIFFS, "/001.mp3");
+    boot_trace_end(t);
 
     // audio.connecttoFS(SD, "/music/My Anata.mp3");
 
+    // The UI reads the power snapshot while building the status bar
+    t = boot_trace_begin("wait_boot_io");
+    xSemaphoreTake(boot_io_done, portMAX_DELAY);
+    vSemaphoreDelete(boot_io_done);
+    boot_trace_end(t);
+
     // init UI and display
+    t = boot_trace_begin("ui_entry");
     ui_entry(); 
+    boot_trace_end(t);
     lv_timer_create(msg_send_event, 5000, NULL);
     // lvgl msg
     lv_msg_subsribe(MSG_UI_ROTATION_ST, msg_subsribe_event, NULL);
@@ -731,9 +747,12 @@ void setup(void)
 
     digitalWrite(TFT_BL, HIGH);
 
+    t = boot_trace_begin("sd_init");
     sd_init();
+    boot_trace_end(t);
 
     // Load configuration from nautilus.json on SD card
+    t = boot_trace_begin("config_load");
     Serial.println("\n========== Loading Configuration ==========");
     if (config_load()) {
         Serial.println("[CONFIG] Applying loaded settings...");
@@ -751,7 +770,7 @@ void setup(void)
 
         // Apply audio settings
         current_volume = g_config.audio.volume;
-        audio.setVolume(current_volume);
+        audio_set_volume(current_volume);
 
         // Apply WS2812 settings
         CRGB color;
@@ -760,7 +779,7 @@ void setup(void)
         color.blue = g_config.ws2812.color & 0xFF;
         ws2812_set_color(color);
         ws2812_set_light(g_config.ws2812.brightness);
-        // Use ui_scr1_set_mode instead of ws2812_set_mode to properly resume the task
+        // Use ui_scr1_set_mode so UI and LED state go through the same path
         ui_scr1_set_mode(g_config.ws2812.mode);
         Serial.printf("[CONFIG] Applied WS2812: color=0x%06X, brightness=%d, mode=%d\n",
                       g_config.ws2812.color, g_config.ws2812.brightness, g_config.ws2812.mode);
@@ -770,6 +789,14 @@ void setup(void)
         Serial.println("[CONFIG] Using default settings");
     }
     Serial.println("===========================================\n");
+    boot_trace_end(t);
+
+    // Background writer for debounced config saves
+    config_service_init();
+
+    boot_trace_mark("setup_done");
+    boot_trace_dump();
+    boot_trace_save();
 
     // Music loading moved to entry8() to avoid blocking boot
 
@@ -806,29 +833,27 @@ void handle_volume_control()
             }
         }
 
-        audio.setVolume(current_volume);
+        audio_set_volume(current_volume);
         last_encoder_pos = indev_encoder_pos;
         volume_changed_during_playback = true;
     }
 }
 
 // Audio library callback - called when song finishes
+// Runs in audio_task (see peri_audio.cpp), so UI work is deferred to loop()
 void audio_eof_mp3(const char *info)
 {
     Serial.println("Song finished!");
-    delay(5);
     if(music_is_running) {
         extern int music_idx;
-        extern std::vector<String> music_list;
 
         // Auto-advance to next song
-        if(music_idx + 1 < music_list.size()) {
+        char buf[MUSIC_INDEX_NAME_LEN + 32];
+        if(music_index_get_path(music_idx + 1, buf, sizeof(buf))) {
             music_idx++;
-            Serial.printf("Auto-playing next song: %s\n", music_list[music_idx].c_str());
+            Serial.printf("Auto-playing next song: %s\n", buf);
 
-            char buf[64];
-            lv_snprintf(buf, 64, "/music/%s", music_list[music_idx].c_str());
-            audio.connecttoFS(SD, buf);
+            audio_play(SD, buf);
 
             // Signal that UI needs update (will be handled in main loop)
             extern volatile bool music_label_needs_update;
@@ -847,7 +872,7 @@ void audio_eof_mp3(const char *info)
 
 void loop(void)
 {
-    audio.loop();
+    // MP3 decode runs in audio_task
 
     // Process spectrum analyzer updates (must be before lv_timer_handler)
     spectrum_process_update();
@@ -865,12 +890,12 @@ void loop(void)
         extern lv_obj_t *music_lab;
         extern lv_obj_t *pause_btn;
         extern int music_idx;
-        extern std::vector<String> music_list;
+        char name[MUSIC_INDEX_NAME_LEN];
 
         if(music_is_running) {
             // Update label for new song
-            if(music_lab && music_idx < music_list.size()) {
-                Serial.printf("Updating label: '%s'\n", music_list[music_idx].c_str());
+            if(music_lab && music_index_get_name(music_idx, name, sizeof(name))) {
+                Serial.printf("Updating label: '%s'\n", name);
                 Serial.printf("Label visible: %d, hidden: %d\n",
                     lv_obj_is_visible(music_lab),
                     lv_obj_has_flag(music_lab, LV_OBJ_FLAG_HIDDEN));
@@ -882,7 +907,7 @@ void loop(void)
                     parent, active_scr, (parent == active_scr));
 
                 // Update label text
-                lv_label_set_text(music_lab, music_list[music_idx].c_str());
+                lv_label_set_text(music_lab, name);
                 lv_obj_invalidate(music_lab);
 
                 // CRITICAL: Same fix as spectrum analyzer (see spectrum-troubleshooting.txt)
@@ -913,10 +938,7 @@ void loop(void)
             extern uint8_t current_volume;
             if(volume_changed_during_playback) {
                 g_config.audio.volume = current_volume;
-                if(config_sd_available()) {
-                    config_save();
-                    Serial.printf("[CONFIG] Saved volume: %d\n", current_volume);
-                }
+                config_mark_dirty(CONFIG_DIRTY_AUDIO);
                 volume_changed_during_playback = false;
             }
         }
@@ -951,31 +973,11 @@ void loop(void)
                 }
             }
 
-            audio.setVolume(current_volume);
+            audio_set_volume(current_volume);
             fb_audio_last_encoder_pos = indev_encoder_pos;
             volume_changed_during_playback = true;
         }
     }
 
-    if(music_is_running == false) {
-        // IR decode moved to IR screen lifecycle - only active when on IR screen
-        // if (irrecv.decode(&results)) {
-        //     // print() & println() can't handle printing long longs. (uint64_t)
-        //     serialPrintUint64(results.value, HEX);
-        //     IR_recv_value = results.value;
-        //     Serial.println("");
-        //     irrecv.resume();  // Receive the next value
-        // }
-
-        i2s_read((i2s_port_t)EXAMPLE_I2S_CH, (char *)i2s_readraw_buff, SAMPLE_SIZE, &bytes_read, 100);
-        for(int i = 0; i < 10; i++) {
-            // Serial.printf("%d  ", i2s_readraw_buff[i]);
-            // if(i == 9) {
-            //     Serial.println(" ");
-            // }
-            if(i2s_readraw_buff[i] > 0) i2s_mic_cnt++;
-        }
-    }
-
     delay(1);
 }
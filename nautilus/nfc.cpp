@@ -1,9 +1,25 @@
 #include "nfc.h"
 #include "peripheral/peripheral.h"
 #include <lvgl.h>
+#include <map>
+#include <algorithm>
 
 extern Adafruit_PN532 nfc;
 
+// Serializes PN532 access between tag reads and the emulation task. Binary
+// rather than a mutex: nfcEmulationStart() takes it and the task gives it back.
+static SemaphoreHandle_t nfc_pn532_mutex = NULL;
+
+static SemaphoreHandle_t nfcPn532Lock(void)
+{
+    if (!nfc_pn532_mutex) {
+        nfc_pn532_mutex = xSemaphoreCreateBinary();
+        assert(nfc_pn532_mutex);
+        xSemaphoreGive(nfc_pn532_mutex);
+    }
+    return nfc_pn532_mutex;
+}
+
 // Parse hex byte string to byte array
 int parseHexBytes(const String& hex_str, uint8_t* output, int max_len) {
     String trimmed = hex_str;
@@ -183,7 +199,7 @@ bool parseFlipperNFCFile(const char* filepath, NFCTag& tag) {
         }
         // Parse Pages total
         else if (parseLineInt(line, "Pages total:", tag.pages_total)) {
-            // Parsed successfully
+            tag.allocPages(tag.pages_total);
         }
         // Parse Pages read
         else if (parseLineInt(line, "Pages read:", tag.pages_read)) {
@@ -215,7 +231,8 @@ bool parseFlipperNFCFile(const char* filepath, NFCTag& tag) {
         else if (line.startsWith("Page ")) {
             int page_num = atoi(line.substring(5).c_str());
             int colon_pos = line.indexOf(':');
-            if (colon_pos > 0 && page_num < MAX_NFC_PAGES) {
+            if (colon_pos > 0 && page_num >= 0 && page_num < MAX_NFC_PAGES &&
+                (page_num < tag.page_capacity || tag.allocPages(page_num + 1))) {
                 String page_str = line.substring(colon_pos + 1);
                 parseHexBytes(page_str, tag.page_data[page_num], NFC_PAGE_SIZE);
             }
@@ -231,6 +248,166 @@ bool parseFlipperNFCFile(const char* filepath, NFCTag& tag) {
     return true;
 }
 
+// Parse only the Device type / UID lines of a Flipper Zero .nfc file
+bool parseFlipperNFCHeader(const char* filepath, NFCTagInfo& info) {
+    File file = SD.open(filepath, FILE_READ);
+    if (!file) {
+        return false;
+    }
+
+    info.file_size = file.size();
+    info.mtime = file.getLastWrite();
+    info.device_type[0] = '\0';
+    info.uid_len = 0;
+
+    String line;
+    String device_type;
+    bool valid_header = false;
+    bool have_type = false;
+    bool have_uid = false;
+
+    // Device type and UID precede all page data, so stop as soon as both are seen
+    while (file.available() && !(have_type && have_uid)) {
+        line = file.readStringUntil('\n');
+        line.trim();
+
+        if (line.length() == 0 || line.startsWith("#")) {
+            continue;
+        }
+
+        if (line.startsWith("Filetype:")) {
+            valid_header = (line.indexOf("Flipper NFC device") != -1);
+        }
+        else if (parseLineString(line, "Device type:", device_type)) {
+            strncpy(info.device_type, device_type.c_str(), sizeof(info.device_type) - 1);
+            info.device_type[sizeof(info.device_type) - 1] = '\0';
+            have_type = true;
+        }
+        else if (parseLineHexBytesWithLen(line, "UID:", info.uid, sizeof(info.uid), info.uid_len)) {
+            have_uid = true;
+        }
+        else if (line.startsWith("Page ")) {
+            break;
+        }
+    }
+
+    file.close();
+    return valid_header;
+}
+
+static String nfcIndexPath(const char* dirpath) {
+    String path = dirpath;
+    if (!path.endsWith("/")) path += "/";
+    path += NFC_INDEX_FILENAME;
+    return path;
+}
+
+// Index format, one tag per line: name<TAB>size<TAB>mtime<TAB>device type<TAB>UID
+static void readNFCIndex(const char* dirpath, std::map<String, NFCTagInfo>& cached) {
+    File file = SD.open(nfcIndexPath(dirpath).c_str(), FILE_READ);
+    if (!file) {
+        return;
+    }
+
+    while (file.available()) {
+        String line = file.readStringUntil('\n');
+        if (line.length() == 0 || line.startsWith("#")) {
+            continue;
+        }
+
+        int t1 = line.indexOf('\t');
+        int t2 = line.indexOf('\t', t1 + 1);
+        int t3 = line.indexOf('\t', t2 + 1);
+        int t4 = line.indexOf('\t', t3 + 1);
+        if (t1 <= 0 || t2 < 0 || t3 < 0 || t4 < 0) {
+            continue;
+        }
+
+        NFCTagInfo info;
+        info.name = line.substring(0, t1);
+        info.file_size = strtoul(line.substring(t1 + 1, t2).c_str(), NULL, 10);
+        info.mtime = (time_t)strtoul(line.substring(t2 + 1, t3).c_str(), NULL, 10);
+        String device_type = line.substring(t3 + 1, t4);
+        strncpy(info.device_type, device_type.c_str(), sizeof(info.device_type) - 1);
+        info.device_type[sizeof(info.device_type) - 1] = '\0';
+        info.uid_len = parseHexBytes(line.substring(t4 + 1), info.uid, sizeof(info.uid));
+
+        cached[info.name] = info;
+    }
+
+    file.close();
+}
+
+static void writeNFCIndex(const char* dirpath, const std::vector<NFCTagInfo>& infos) {
+    File file = SD.open(nfcIndexPath(dirpath).c_str(), FILE_WRITE);
+    if (!file) {
+        return;
+    }
+
+    file.println("# Nautilus NFC index v1");
+    for (const auto& info : infos) {
+        file.printf("%s\t%lu\t%lu\t%s\t", info.name.c_str(), (unsigned long)info.file_size,
+                    (unsigned long)info.mtime, info.device_type);
+        file.println(bytesToHexString(info.uid, info.uid_len));
+    }
+
+    file.close();
+}
+
+// List .nfc files with header metadata, reusing the directory index when valid
+int loadNFCDirectoryInfo(const char* dirpath, std::vector<NFCTagInfo>& infos, bool use_index) {
+    infos.clear();
+
+    std::map<String, NFCTagInfo> cached;
+    if (use_index) {
+        readNFCIndex(dirpath, cached);
+    }
+
+    File root = SD.open(dirpath);
+    if (!root || !root.isDirectory()) {
+        return 0;
+    }
+
+    bool index_dirty = false;
+
+    File file = root.openNextFile();
+    while (file) {
+        const char *fname = file.name();
+        size_t len = strlen(fname);
+
+        if (!file.isDirectory() && fname[0] != '.' && len > 4 && strcmp(fname + len - 4, ".nfc") == 0) {
+            NFCTagInfo info;
+            info.name = String(fname).substring(0, len - 4);
+
+            auto it = cached.find(info.name);
+            if (it != cached.end() && it->second.file_size == file.size() &&
+                it->second.mtime == file.getLastWrite()) {
+                info = it->second;
+            } else {
+                String path = String(dirpath) + "/" + fname;
+                parseFlipperNFCHeader(path.c_str(), info);
+                index_dirty = true;
+            }
+            infos.push_back(info);
+        }
+
+        file.close();
+        file = root.openNextFile();
+    }
+    root.close();
+
+    std::sort(infos.begin(), infos.end(), [](const NFCTagInfo& a, const NFCTagInfo& b) {
+        return a.name < b.name;
+    });
+
+    // Rewrite the index when entries were added, changed or removed
+    if (use_index && (index_dirty || cached.size() != infos.size())) {
+        writeNFCIndex(dirpath, infos);
+    }
+
+    return infos.size();
+}
+
 // Write Flipper Zero .nfc file
 bool writeFlipperNFCFile(const char* filepath, const NFCTag& tag) {
     File file = SD.open(filepath, FILE_WRITE);
@@ -327,7 +504,7 @@ bool writeFlipperNFCFile(const char* filepath, const NFCTag& tag) {
             }
 
             int pages_to_write = (tag.pages_read > 0) ? tag.pages_read : tag.pages_total;
-            for (int i = 0; i < pages_to_write && i < MAX_NFC_PAGES; i++) {
+            for (int i = 0; i < pages_to_write && i < tag.page_capacity; i++) {
                 file.printf("Page %d: ", i);
                 file.println(bytesToHexString(tag.page_data[i], NFC_PAGE_SIZE));
             }
@@ -338,8 +515,19 @@ bool writeFlipperNFCFile(const char* filepath, const NFCTag& tag) {
     return true;
 }
 
-// Read NFC tag from PN532 hardware
+static bool readNFCTagLocked(NFCTag& tag, uint16_t timeout_ms);
+
+// Read NFC tag from PN532 hardware; refused while emulation owns the PN532
 bool readNFCTag(NFCTag& tag, uint16_t timeout_ms) {
+    if (xSemaphoreTake(nfcPn532Lock(), 0) != pdTRUE) {
+        return false;
+    }
+    bool success = readNFCTagLocked(tag, timeout_ms);
+    xSemaphoreGive(nfc_pn532_mutex);
+    return success;
+}
+
+static bool readNFCTagLocked(NFCTag& tag, uint16_t timeout_ms) {
     uint8_t uid_buffer[7];
     uint8_t uid_length;
 
@@ -369,8 +557,9 @@ bool readNFCTag(NFCTag& tag, uint16_t timeout_ms) {
 
         tag.pages_total = 231;
         tag.pages_read = 0;
+        tag.allocPages(tag.pages_total);
 
-        for (int page = 0; page < 231 && page < MAX_NFC_PAGES; page++) {
+        for (int page = 0; page < tag.page_capacity; page++) {
             if (nfc.mifareultralight_ReadPage(page, page_buffer)) {
                 memcpy(tag.page_data[page], page_buffer, 4);
                 tag.pages_read++;
@@ -388,41 +577,260 @@ bool readNFCTag(NFCTag& tag, uint16_t timeout_ms) {
     return true;
 }
 
-bool emulateNFCTagUID(const NFCTag& tag, uint16_t timeout_ms) {
+// PN532 TgSetData command byte, prepended to every prebuilt response frame
+#define PN532_TG_SET_DATA       0x8E
+#define NFC_EMU_READ_FRAME_LEN  (1 + 4 * NFC_PAGE_SIZE)
+
+// Prebuilt NTAG/Ultralight response frames, built once when emulation starts
+struct NFCEmuTable {
+    uint8_t *read_frames;    // One READ response per start page (read_count entries)
+    uint16_t read_count;
+    uint8_t read_zero[NFC_EMU_READ_FRAME_LEN];
+    uint8_t version[1 + 8];
+    uint8_t signature[1 + 32];
+    uint8_t counter[1 + 3];
+    uint8_t ack[1 + 1];
+    uint8_t nack[1 + 1];
+};
+
+struct NFCEmuParams {
+    NFCEmuTable table;
+    bool full;
+    uint16_t timeout_ms;
+};
+
+static TaskHandle_t nfc_emu_handle = NULL;
+static QueueHandle_t nfc_emu_queue = NULL;
+static volatile bool nfc_emu_running = false;
+static volatile bool nfc_emu_stop_req = false;
+
+static uint32_t nfc_emu_commands = 0;
+static uint32_t nfc_emu_total_us = 0;
+static uint32_t nfc_emu_max_us = 0;
+
+static void nfcEmuPost(NFCEmuEventType type, uint8_t cmd = 0, uint32_t turnaround_us = 0, bool success = false)
+{
+    if (!nfc_emu_queue) return;
+
+    NFCEmuEvent evt;
+    evt.type = type;
+    evt.cmd = cmd;
+    evt.success = success;
+    evt.commands = nfc_emu_commands;
+    evt.turnaround_us = turnaround_us;
+    evt.max_turnaround_us = nfc_emu_max_us;
+    // Never block the emulation loop on a slow UI; progress events may drop
+    xQueueSend(nfc_emu_queue, &evt, 0);
+}
+
+static void nfcEmuResetTarget(void)
+{
+    nfc.begin();
+    vTaskDelay(pdMS_TO_TICKS(100));  // Give PN532 time to reset
+    nfc.SAMConfig();
+}
+
+static bool nfcEmuBuildTable(const NFCTag& tag, NFCEmuTable& table)
+{
+    static const uint8_t default_version[] = {0x00, 0x04, 0x04, 0x02, 0x01, 0x00, 0x13, 0x03};
+
+    table.read_count = min(tag.pages_read, tag.page_capacity);
+    table.read_frames = NULL;
+    if (table.read_count > 0) {
+        table.read_frames = (uint8_t *)ps_malloc(table.read_count * NFC_EMU_READ_FRAME_LEN);
+        if (!table.read_frames) {
+            return false;
+        }
+    }
+
+    // READ (0x30): 4 pages from the start page, pages past the dump read as zero
+    for (int start = 0; start < table.read_count; start++) {
+        uint8_t *frame = table.read_frames + start * NFC_EMU_READ_FRAME_LEN;
+        frame[0] = PN532_TG_SET_DATA;
+        for (int i = 0; i < 4; i++) {
+            int page = start + i;
+            if (page < table.read_count) {
+                memcpy(frame + 1 + i * NFC_PAGE_SIZE, tag.page_data[page], NFC_PAGE_SIZE);
+            } else {
+                memset(frame + 1 + i * NFC_PAGE_SIZE, 0, NFC_PAGE_SIZE);
+            }
+        }
+    }
+    memset(table.read_zero, 0, sizeof(table.read_zero));
+    table.read_zero[0] = PN532_TG_SET_DATA;
+
+    // GET_VERSION (0x60)
+    table.version[0] = PN532_TG_SET_DATA;
+    memcpy(table.version + 1, tag.mifare_version[0] != 0 ? tag.mifare_version : default_version, 8);
+
+    // READ_SIG (0x3C), zeros when the dump has no signature
+    table.signature[0] = PN532_TG_SET_DATA;
+    memcpy(table.signature + 1, tag.signature, 32);
+
+    // READ_CNT (0x39), counter 0 little endian
+    table.counter[0] = PN532_TG_SET_DATA;
+    table.counter[1] = tag.counters[0] & 0xFF;
+    table.counter[2] = (tag.counters[0] >> 8) & 0xFF;
+    table.counter[3] = (tag.counters[0] >> 16) & 0xFF;
+
+    // WRITE (0xA2) is acknowledged but not applied; anything else is NACKed
+    table.ack[0] = PN532_TG_SET_DATA;
+    table.ack[1] = 0x0A;
+    table.nack[0] = PN532_TG_SET_DATA;
+    table.nack[1] = 0x00;
 
+    return true;
+}
+
+static void nfcEmuFreeTable(NFCEmuTable& table)
+{
+    if (table.read_frames) {
+        free(table.read_frames);
+        table.read_frames = NULL;
+    }
+    table.read_count = 0;
+}
+
+// Look up the prebuilt response for a reader command, NULL ends the session
+static const uint8_t *nfcEmuLookup(const NFCEmuTable& table, const uint8_t *rx, uint8_t rx_len, uint8_t& frame_len)
+{
+    switch (rx[0]) {
+        case 0x30:  // READ
+            if (rx_len < 2) return NULL;
+            frame_len = NFC_EMU_READ_FRAME_LEN;
+            if (rx[1] < table.read_count) {
+                return table.read_frames + rx[1] * NFC_EMU_READ_FRAME_LEN;
+            }
+            return table.read_zero;
+
+        case 0xA2:  // WRITE
+            if (rx_len < 6) return NULL;
+            frame_len = sizeof(table.ack);
+            return table.ack;
+
+        case 0x60:  // GET_VERSION
+            frame_len = sizeof(table.version);
+            return table.version;
+
+        case 0x3C:  // READ_SIG
+            frame_len = sizeof(table.signature);
+            return table.signature;
+
+        case 0x39:  // READ_CNT (Read Counter)
+            frame_len = sizeof(table.counter);
+            return table.counter;
+
+        default:
+            frame_len = sizeof(table.nack);
+            return table.nack;
+    }
+}
+
+static bool nfcEmuRunUID(uint16_t timeout_ms)
+{
     bool reader_detected = false;
     unsigned long start_time = millis();
 
-    while (timeout_ms == 0 || (millis() - start_time) < timeout_ms) {
-        uint8_t result = nfc.AsTarget();
+    nfcEmuPost(NFC_EMU_EVT_WAITING);
 
-        if (result) {
+    while (!nfc_emu_stop_req && (timeout_ms == 0 || (millis() - start_time) < timeout_ms)) {
+        if (nfc.AsTarget()) {
             reader_detected = true;
+            nfcEmuPost(NFC_EMU_EVT_READER);
 
             unsigned long session_start = millis();
-            while (millis() - session_start < 3000) {
-                lv_task_handler();
-                delay(10);
+            while (!nfc_emu_stop_req && millis() - session_start < 3000) {
+                vTaskDelay(pdMS_TO_TICKS(10));
             }
 
-            nfc.begin();
-            delay(100);
-            nfc.SAMConfig();
+            nfcEmuPost(NFC_EMU_EVT_SESSION_END);
+            nfcEmuResetTarget();
         } else {
-            lv_task_handler();
-            delay(10);
+            vTaskDelay(pdMS_TO_TICKS(10));
         }
     }
 
-    if (!reader_detected && timeout_ms > 0) {
-    }
+    // Final reset to clean state
+    nfcEmuResetTarget();
+
+    return reader_detected;
+}
+
+static bool nfcEmuRunFull(const NFCEmuTable& table, uint16_t timeout_ms)
+{
+    bool reader_detected = false;
+    unsigned long start_time = millis();
+
+    uint8_t rx_buffer[64];
+    uint8_t tx_buffer[64];
+    uint8_t rx_len;
+
+    nfc_emu_commands = 0;
+    nfc_emu_total_us = 0;
+    nfc_emu_max_us = 0;
+
+    nfcEmuPost(NFC_EMU_EVT_WAITING);
 
+    while (!nfc_emu_stop_req && (timeout_ms == 0 || (millis() - start_time) < timeout_ms)) {
+        if (!nfc.AsTarget()) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
+
+        reader_detected = true;
+        nfcEmuPost(NFC_EMU_EVT_READER);
+
+        while (!nfc_emu_stop_req) {
+            if (!nfc.getDataTarget(rx_buffer, &rx_len)) {
+                break;
+            }
+
+            if (rx_len == 0) {
+                vTaskDelay(1);
+                continue;
+            }
+
+            uint32_t rx_time = micros();
+
+            uint8_t frame_len = 0;
+            const uint8_t *frame = nfcEmuLookup(table, rx_buffer, rx_len, frame_len);
+            if (!frame) {
+                break;
+            }
+
+            // setDataTarget() writes the PN532 status back into the buffer,
+            // so send from a scratch copy rather than from the table itself
+            memcpy(tx_buffer, frame, frame_len);
+            if (!nfc.setDataTarget(tx_buffer, frame_len)) {
+                break;
+            }
+
+            uint32_t turnaround = micros() - rx_time;
+            nfc_emu_commands++;
+            nfc_emu_total_us += turnaround;
+            if (turnaround > nfc_emu_max_us) {
+                nfc_emu_max_us = turnaround;
+            }
+            nfcEmuPost(NFC_EMU_EVT_COMMAND, rx_buffer[0], turnaround);
+        }
+
+        nfcEmuPost(NFC_EMU_EVT_SESSION_END);
+
+        // Reset for next reader - full hardware reset
+        nfcEmuResetTarget();
+    }
 
     // Final reset to clean state
-    nfc.begin();
-    delay(100);
-    nfc.SAMConfig();
+    nfcEmuResetTarget();
+
+    return reader_detected;
+}
 
+// Blocking variants, for callers that already run outside the UI thread
+bool emulateNFCTagUID(const NFCTag& tag, uint16_t timeout_ms) {
+    xSemaphoreTake(nfcPn532Lock(), portMAX_DELAY);
+    bool reader_detected = nfcEmuRunUID(timeout_ms);
+    xSemaphoreGive(nfc_pn532_mutex);
     return reader_detected;
 }
 
@@ -434,149 +842,120 @@ bool emulateNFCTagFull(const NFCTag& tag, uint16_t timeout_ms) {
         return false;
     }
 
+    NFCEmuTable table;
+    if (!nfcEmuBuildTable(tag, table)) {
+        return false;
+    }
 
-    bool reader_detected = false;
-    unsigned long start_time = millis();
+    xSemaphoreTake(nfcPn532Lock(), portMAX_DELAY);
+    bool reader_detected = nfcEmuRunFull(table, timeout_ms);
+    xSemaphoreGive(nfc_pn532_mutex);
+    nfcEmuFreeTable(table);
 
-    while (timeout_ms == 0 || (millis() - start_time) < timeout_ms) {
-        uint8_t result = nfc.AsTarget();
+    return reader_detected;
+}
 
-        if (result) {
-            reader_detected = true;
+static void nfc_emu_task(void *param)
+{
+    NFCEmuParams *p = (NFCEmuParams *)param;
+    bool reader_detected;
 
-            bool session_active = true;
-            uint8_t rx_buffer[64];
-            uint8_t tx_buffer[64];
-            uint8_t rx_len;
-            uint8_t status;
+    // Held by nfcEmulationStart() on the task's behalf
+    if (p->full) {
+        reader_detected = nfcEmuRunFull(p->table, p->timeout_ms);
+    } else {
+        reader_detected = nfcEmuRunUID(p->timeout_ms);
+    }
+    xSemaphoreGive(nfc_pn532_mutex);
 
-            while (session_active) {
-                status = nfc.getDataTarget(rx_buffer, &rx_len);
+    uint32_t avg_us = nfc_emu_commands ? nfc_emu_total_us / nfc_emu_commands : 0;
 
-                if (status == 0) {
-                    break;
-                }
+    nfcEmuFreeTable(p->table);
+    delete p;
+    nfc_emu_running = false;
 
-                if (rx_len == 0) {
-                    lv_task_handler();
-                    delay(5);
-                    continue;
-                }
+    nfcEmuPost(NFC_EMU_EVT_DONE, 0, avg_us, reader_detected);
 
-                uint8_t cmd = rx_buffer[0];
-                uint8_t response_len = 0;
-
-                switch (cmd) {
-                    case 0x30:
-                        {
-                            if (rx_len < 2) {
-                                session_active = false;
-                                break;
-                            }
-
-                            uint8_t start_page = rx_buffer[1];
-
-                            for (int i = 0; i < 4; i++) {
-                                uint8_t page = start_page + i;
-                                if (page < MAX_NFC_PAGES && page < tag.pages_read) {
-                                    memcpy(tx_buffer + i * 4, tag.page_data[page], 4);
-                                } else {
-                                    memset(tx_buffer + i * 4, 0, 4);
-                                }
-                            }
-                            response_len = 16;
-                        }
-                        break;
-
-                    case 0xA2:
-                        {
-                            if (rx_len < 6) {
-                                session_active = false;
-                                break;
-                            }
-
-                            uint8_t page = rx_buffer[1];
-
-                            tx_buffer[0] = 0x0A;
-                            response_len = 1;
-                        }
-                        break;
-
-                    case 0x60:
-                        {
-                            if (tag.mifare_version[0] != 0) {
-                                memcpy(tx_buffer, tag.mifare_version, 8);
-                                response_len = 8;
-                            } else {
-                                uint8_t default_version[] = {0x00, 0x04, 0x04, 0x02, 0x01, 0x00, 0x13, 0x03};
-                                memcpy(tx_buffer, default_version, 8);
-                                response_len = 8;
-                            }
-                        }
-                        break;
-
-                    case 0x3C:
-                        {
-                            if (tag.signature[0] != 0) {
-                                memcpy(tx_buffer, tag.signature, 32);
-                                response_len = 32;
-                            } else {
-                                // Return zeros
-                                memset(tx_buffer, 0, 32);
-                                response_len = 32;
-                            }
-                        }
-                        break;
-
-                    case 0x39:  // READ_CNT (Read Counter)
-                        {
-
-                            // Return counter 0 value (3 bytes)
-                            tx_buffer[0] = tag.counters[0] & 0xFF;
-                            tx_buffer[1] = (tag.counters[0] >> 8) & 0xFF;
-                            tx_buffer[2] = (tag.counters[0] >> 16) & 0xFF;
-                            response_len = 3;
-                        }
-                        break;
-
-                    default:
-                        // Send NACK
-                        tx_buffer[0] = 0x00;
-                        response_len = 1;
-                        break;
-                }
+    // Cleared last: nfcEmulationStop() waits on it, and a new session must
+    // not reset the queue before DONE has been posted
+    nfc_emu_handle = NULL;
+    vTaskDelete(NULL);
+}
 
-                // Send response
-                if (response_len > 0) {
-                    status = nfc.setDataTarget(tx_buffer, response_len);
-                    if (status == 0) {
-                        session_active = false;
-                    }
-                }
-            }
+bool nfcEmulationStart(const NFCTag& tag, bool full, uint16_t timeout_ms) {
+    if (nfc_emu_running || nfc_emu_handle) {
+        return false;
+    }
 
+    if (full && tag.getTagType() != NFC_TAG_NTAG_ULTRALIGHT) {
+        return false;
+    }
 
-            // Reset for next reader - full hardware reset
-            nfc.begin();
-            delay(100);  // Give PN532 time to reset
-            nfc.SAMConfig();
-        } else {
-            // No reader yet, keep UI responsive while waiting
-            lv_task_handler();
-            delay(10);
+    if (!nfc_emu_queue) {
+        nfc_emu_queue = xQueueCreate(NFC_EMU_QUEUE_LEN, sizeof(NFCEmuEvent));
+        if (!nfc_emu_queue) {
+            return false;
         }
     }
+    xQueueReset(nfc_emu_queue);
+
+    NFCEmuParams *p = new NFCEmuParams();
+    p->full = full;
+    p->timeout_ms = timeout_ms;
+    p->table.read_frames = NULL;
+    p->table.read_count = 0;
 
-    if (!reader_detected && timeout_ms > 0) {
+    if (full && !nfcEmuBuildTable(tag, p->table)) {
+        delete p;
+        return false;
     }
 
+    // Taken here rather than in the task, so a failed take leaves nothing running
+    if (xSemaphoreTake(nfcPn532Lock(), 0) != pdTRUE) {
+        nfcEmuFreeTable(p->table);
+        delete p;
+        return false;
+    }
 
-    // Final reset to clean state
-    nfc.begin();
-    delay(100);
-    nfc.SAMConfig();
+    nfc_emu_commands = 0;
+    nfc_emu_total_us = 0;
+    nfc_emu_max_us = 0;
+    nfc_emu_stop_req = false;
+    nfc_emu_running = true;
+
+    if (xTaskCreatePinnedToCore(nfc_emu_task, "nfc_emu_task", NFC_EMU_TASK_STACK, p,
+                                NFC_EMU_TASK_PRIORITY, &nfc_emu_handle, NFC_EMU_TASK_CORE) != pdPASS) {
+        xSemaphoreGive(nfc_pn532_mutex);
+        nfcEmuFreeTable(p->table);
+        delete p;
+        nfc_emu_handle = NULL;
+        nfc_emu_running = false;
+        return false;
+    }
 
-    return reader_detected;
+    return true;
+}
+
+bool nfcEmulationPoll(NFCEmuEvent& evt) {
+    if (!nfc_emu_queue) {
+        return false;
+    }
+    return xQueueReceive(nfc_emu_queue, &evt, 0) == pdTRUE;
+}
+
+void nfcEmulationStop() {
+    if (!nfc_emu_handle) {
+        return;
+    }
+    nfc_emu_stop_req = true;
+    // The task finishes its current PN532 exchange and resets the target first
+    while (nfc_emu_handle) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+bool nfcEmulationIsRunning() {
+    return nfc_emu_running;
 }
 
 // Generate sequential NFC filename
@@ -618,7 +997,8 @@ int parseNDEFRecords(const NFCTag& tag, std::vector<NDEFRecord>& records) {
     int ndef_length = 0;
     int ndef_data_start = 0;
 
-    for (; page < tag.pages_read; page++) {
+    int pages_avail = min(tag.pages_read, tag.page_capacity);
+    for (; page < pages_avail; page++) {
         if (tag.page_data[page][0] == 0x03) {  // NDEF Message TLV
             found_ndef = true;
             ndef_length = tag.page_data[page][1];
@@ -642,9 +1022,11 @@ int parseNDEFRecords(const NFCTag& tag, std::vector<NDEFRecord>& records) {
     int offset = ndef_data_start;
     int max_offset = ndef_data_start + ndef_length;
 
-    uint8_t *data = new uint8_t[MAX_NFC_PAGES * NFC_PAGE_SIZE];
-    for (int i = 0; i < tag.pages_read && i < MAX_NFC_PAGES; i++) {
-        memcpy(data + i * NFC_PAGE_SIZE, tag.page_data[i], NFC_PAGE_SIZE);
+    // Pages are one contiguous block, so NDEF can be walked in place
+    const uint8_t *data = (const uint8_t *)tag.page_data;
+    int data_len = pages_avail * NFC_PAGE_SIZE;
+    if (max_offset > data_len) {
+        max_offset = data_len;
     }
 
     while (offset < max_offset) {
@@ -656,6 +1038,11 @@ int parseNDEFRecords(const NFCTag& tag, std::vector<NDEFRecord>& records) {
         bool il = (header & 0x08) != 0;
         uint8_t tnf = header & 0x07;
 
+        // Record header must fit inside the page data
+        if (offset + (sr ? 3 : 6) + (il ? 1 : 0) > data_len) {
+            break;
+        }
+
         offset++;
 
         uint8_t type_length = data[offset++];
@@ -674,6 +1061,10 @@ int parseNDEFRecords(const NFCTag& tag, std::vector<NDEFRecord>& records) {
             id_length = data[offset++];
         }
 
+        if (offset + type_length + id_length > data_len) {
+            break;
+        }
+
         String type_str;
         for (int i = 0; i < type_length; i++) {
             type_str += (char)data[offset++];
@@ -681,6 +1072,10 @@ int parseNDEFRecords(const NFCTag& tag, std::vector<NDEFRecord>& records) {
 
         offset += id_length;
 
+        if (offset + payload_length > (uint32_t)data_len) {
+            break;
+        }
+
         NDEFRecord record;
 
         if (tnf == 0x01) {
@@ -752,7 +1147,5 @@ int parseNDEFRecords(const NFCTag& tag, std::vector<NDEFRecord>& records) {
         if (me) break;  // Message End
     }
 
-    delete[] data;
-
     return records.size();
 }
@@ -24,6 +24,8 @@ enum NFCTagType {
 
 /**
  * Single NFC tag data (from .nfc file)
+ * Page memory lives in a separately allocated block sized to the tag
+ * (PSRAM when available), so tags without page data stay small.
  */
 struct NFCTag {
     String filepath;
@@ -46,21 +48,79 @@ struct NFCTag {
     uint8_t mifare_version[8];
     uint16_t pages_total;
     uint16_t pages_read;
-    uint8_t page_data[MAX_NFC_PAGES][NFC_PAGE_SIZE];  // Page memory
+    uint8_t (*page_data)[NFC_PAGE_SIZE];  // Page memory (page_capacity pages, or NULL)
+    uint16_t page_capacity;
     uint8_t counters[3];     // Counter values
     uint8_t tearing[3];      // Tearing flags
 
     // Constructor
     NFCTag() : filepath(""), device_type(""), uid_len(0), atqa(0), sak(0),
-               t0(0), ta1(0), tb1(0), tc1(0), pages_total(0), pages_read(0) {
+               t0(0), ta1(0), tb1(0), tc1(0), pages_total(0), pages_read(0),
+               page_data(NULL), page_capacity(0) {
         memset(uid, 0, sizeof(uid));
         memset(signature, 0, sizeof(signature));
         memset(mifare_version, 0, sizeof(mifare_version));
-        memset(page_data, 0, sizeof(page_data));
         memset(counters, 0, sizeof(counters));
         memset(tearing, 0, sizeof(tearing));
     }
 
+    NFCTag(const NFCTag& other) : page_data(NULL), page_capacity(0) {
+        *this = other;
+    }
+
+    NFCTag& operator=(const NFCTag& other) {
+        if (this == &other) return *this;
+        filepath = other.filepath;
+        device_type = other.device_type;
+        memcpy(uid, other.uid, sizeof(uid));
+        uid_len = other.uid_len;
+        atqa = other.atqa;
+        sak = other.sak;
+        t0 = other.t0;
+        ta1 = other.ta1;
+        tb1 = other.tb1;
+        tc1 = other.tc1;
+        memcpy(signature, other.signature, sizeof(signature));
+        memcpy(mifare_version, other.mifare_version, sizeof(mifare_version));
+        pages_total = other.pages_total;
+        pages_read = other.pages_read;
+        memcpy(counters, other.counters, sizeof(counters));
+        memcpy(tearing, other.tearing, sizeof(tearing));
+        freePages();
+        if (other.page_data && allocPages(other.page_capacity)) {
+            memcpy(page_data, other.page_data, other.page_capacity * NFC_PAGE_SIZE);
+        }
+        return *this;
+    }
+
+    ~NFCTag() {
+        freePages();
+    }
+
+    // Allocate (or grow) zeroed page memory for at least count pages
+    bool allocPages(uint16_t count) {
+        if (count > MAX_NFC_PAGES) count = MAX_NFC_PAGES;
+        if (count <= page_capacity) return true;
+
+        uint8_t (*pages)[NFC_PAGE_SIZE] = (uint8_t (*)[NFC_PAGE_SIZE])ps_calloc(count, NFC_PAGE_SIZE);
+        if (!pages) return false;
+        if (page_data) {
+            memcpy(pages, page_data, page_capacity * NFC_PAGE_SIZE);
+            free(page_data);
+        }
+        page_data = pages;
+        page_capacity = count;
+        return true;
+    }
+
+    void freePages() {
+        if (page_data) {
+            free(page_data);
+            page_data = NULL;
+        }
+        page_capacity = 0;
+    }
+
     // Helper: Get tag type enum from device_type string
     NFCTagType getTagType() const {
         if (device_type.indexOf("ISO14443-3A") >= 0) return NFC_TAG_ISO14443_3A;
@@ -94,6 +154,44 @@ struct NFCTag {
  */
 bool parseFlipperNFCFile(const char* filepath, NFCTag& tag);
 
+/**
+ * Lightweight .nfc metadata for directory listings
+ */
+struct NFCTagInfo {
+    String name;             // Filename without .nfc extension
+    char device_type[24];
+    uint8_t uid[10];
+    uint8_t uid_len;
+    uint32_t file_size;      // Used to validate cached index entries
+    time_t mtime;
+
+    NFCTagInfo() : name(""), uid_len(0), file_size(0), mtime(0) {
+        device_type[0] = '\0';
+        memset(uid, 0, sizeof(uid));
+    }
+};
+
+// Per-directory cache of NFCTagInfo entries, rebuilt when files change
+#define NFC_INDEX_FILENAME ".nfc_index"
+
+/**
+ * Read only the "Device type" and "UID" lines of a Flipper Zero .nfc file
+ * Stops as soon as both are found, without touching page data
+ * @param filepath Path to .nfc file
+ * @param info NFCTagInfo structure to populate (name is left untouched)
+ * @return true if the file has a valid Flipper NFC header
+ */
+bool parseFlipperNFCHeader(const char* filepath, NFCTagInfo& info);
+
+/**
+ * List the .nfc files in a directory with their header metadata
+ * @param dirpath Directory path on SD (e.g. "/nfc")
+ * @param infos Vector to populate, sorted by name
+ * @param use_index Reuse/refresh the directory's NFC_INDEX_FILENAME cache
+ * @return Number of tags listed
+ */
+int loadNFCDirectoryInfo(const char* dirpath, std::vector<NFCTagInfo>& infos, bool use_index = true);
+
 /**
  * Write a Flipper Zero .nfc file
  * @param filepath Path to .nfc file
@@ -125,7 +223,7 @@ String bytesToHexString(const uint8_t* bytes, int len);
  * Read NFC tag from PN532 hardware
  * @param tag NFCTag structure to populate
  * @param timeout_ms Timeout in milliseconds (0 = no timeout, blocks forever)
- * @return true if tag read successfully
+ * @return true if tag read successfully; false at once while emulation runs
  */
 bool readNFCTag(NFCTag& tag, uint16_t timeout_ms = 0);
 
@@ -133,6 +231,7 @@ bool readNFCTag(NFCTag& tag, uint16_t timeout_ms = 0);
  * Emulate NFC tag UID only using PN532 hardware
  * Only responds to anti-collision protocol with UID/ATQA/SAK
  * Reader can detect the card but cannot read data
+ * Blocks until timeout; UI code should use nfcEmulationStart() instead
  * @param tag NFCTag structure to emulate (uses UID, ATQA, SAK)
  * @param timeout_ms Timeout in milliseconds (0 = no timeout)
  * @return true if a reader detected the tag, false on timeout
@@ -143,12 +242,70 @@ bool emulateNFCTagUID(const NFCTag& tag, uint16_t timeout_ms = 0);
  * Emulate full NFC tag using PN532 hardware
  * Responds to all commands including page reads (NTAG/Ultralight only)
  * Reader can fully interact with the emulated tag data
+ * Blocks until timeout; UI code should use nfcEmulationStart() instead
  * @param tag NFCTag structure to emulate (full page data)
  * @param timeout_ms Timeout in milliseconds (0 = no timeout)
  * @return true if emulation session completed, false on timeout/error
  */
 bool emulateNFCTagFull(const NFCTag& tag, uint16_t timeout_ms = 0);
 
+/**
+ * Background NFC emulation
+ * Emulation runs in a dedicated high-priority task pinned to the core that
+ * does not run LVGL, so reader frame timeouts are not affected by UI work.
+ * READ / GET_VERSION / READ_SIG / READ_CNT responses are prebuilt into a
+ * table when emulation starts; the session loop only indexes into it.
+ */
+#define NFC_EMU_TASK_PRIORITY  (configMAX_PRIORITIES - 1)
+#define NFC_EMU_TASK_CORE      1
+#define NFC_EMU_TASK_STACK     (1024 * 4)
+#define NFC_EMU_QUEUE_LEN      16
+
+enum NFCEmuEventType {
+    NFC_EMU_EVT_WAITING,     // Waiting for a reader to select the target
+    NFC_EMU_EVT_READER,      // Reader selected the target, session started
+    NFC_EMU_EVT_COMMAND,     // Command answered (cmd, turnaround_us valid)
+    NFC_EMU_EVT_SESSION_END, // Reader released the target
+    NFC_EMU_EVT_DONE         // Emulation finished (success valid)
+};
+
+struct NFCEmuEvent {
+    NFCEmuEventType type;
+    uint8_t cmd;             // Last command byte (COMMAND)
+    bool success;            // Reader was detected at least once (DONE)
+    uint32_t commands;       // Commands answered so far
+    uint32_t turnaround_us;  // Command turnaround (COMMAND) or average (DONE)
+    uint32_t max_turnaround_us;
+};
+
+/**
+ * Start emulating a tag in the background
+ * Response frames are built from the tag here, so the tag may be modified
+ * or reloaded once this returns.
+ * @param tag NFCTag structure to emulate
+ * @param full true for full NTAG/Ultralight emulation, false for UID only
+ * @param timeout_ms Timeout in milliseconds (0 = until stopped)
+ * @return true if the emulation task was started
+ */
+bool nfcEmulationStart(const NFCTag& tag, bool full, uint16_t timeout_ms = 0);
+
+/**
+ * Fetch the next progress event posted by the emulation task (non-blocking)
+ * @param evt Event to populate
+ * @return true if an event was available
+ */
+bool nfcEmulationPoll(NFCEmuEvent& evt);
+
+/**
+ * Stop the emulation task and wait for it to exit; a DONE event follows
+ */
+void nfcEmulationStop();
+
+/**
+ * @return true while the emulation task is running
+ */
+bool nfcEmulationIsRunning();
+
 /**
  * Generate sequential NFC filename (NFC_0.nfc, NFC_1.nfc, etc.)
  * @return String with available filename (not full path, just filename)
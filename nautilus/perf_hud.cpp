@@ -0,0 +1,181 @@
+// Nautilus Perf HUD - frame, heap, stack and lock figures on lv_layer_top()
+
+#include "perf_hud.h"
+#include "ui.h"
+
+extern TaskHandle_t nfc_handle;
+extern TaskHandle_t sghz_handle;
+extern TaskHandle_t ws2812_handle;
+extern TaskHandle_t nrf24_handle;
+
+typedef struct {
+    const char *name;
+    TaskHandle_t *handle;
+} PerfHudTask;
+
+// Handles are read on every sample: the tasks are created after the HUD timer
+static const PerfHudTask perf_hud_tasks[] = {
+    { "nfc",    &nfc_handle },
+    { "sghz",   &sghz_handle },
+    { "ws2812", &ws2812_handle },
+    { "nrf24",  &nrf24_handle },
+};
+#define PERF_HUD_TASK_COUNT (sizeof(perf_hud_tasks) / sizeof(perf_hud_tasks[0]))
+
+static lv_timer_t *perf_hud_timer = NULL;
+static lv_obj_t *perf_hud_label = NULL;
+static PerfHudMode perf_hud_mode = PERF_HUD_OFF;
+
+// Previous sample, for per-window rates
+static uint32_t perf_hud_last_ms = 0;
+static uint32_t perf_hud_last_frames = 0;
+static uint32_t perf_hud_last_wait_us = 0;
+
+static void perf_hud_sample(lv_timer_t *t)
+{
+    uint32_t now = millis();
+    uint32_t dt = now - perf_hud_last_ms;
+    if (dt == 0) {
+        return;
+    }
+
+    lv_port_disp_stats_t disp;
+    lv_port_disp_get_stats(&disp);
+    lv_port_disp_reset_max();
+
+    lv_port_indev_latency_t in;
+    lv_port_indev_get_latency(&in);
+
+    uint32_t fps_x10 = (disp.frames - perf_hud_last_frames) * 10000 / dt;
+    // Share of the window the display flush spent blocked on radioLock
+    uint32_t lock_pm = (disp.lock_wait_total_us - perf_hud_last_wait_us) / dt;
+    perf_hud_last_ms = now;
+    perf_hud_last_frames = disp.frames;
+    perf_hud_last_wait_us = disp.lock_wait_total_us;
+
+    // LV_MEM_CUSTOM routes the LVGL heap to PSRAM, so the PSRAM figures are the LVGL heap
+    uint32_t heap_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    uint32_t heap_blk = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+    uint32_t psram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    uint32_t psram_blk = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+
+    // High-water marks are in bytes on ESP-IDF; -1 means the task is not running
+    int32_t stack_hwm[PERF_HUD_TASK_COUNT];
+    for (size_t i = 0; i < PERF_HUD_TASK_COUNT; i++) {
+        TaskHandle_t h = *perf_hud_tasks[i].handle;
+        stack_hwm[i] = h ? (int32_t)uxTaskGetStackHighWaterMark(h) : -1;
+    }
+
+    if (perf_hud_mode == PERF_HUD_SHOW_LOG) {
+        Serial.printf("[PERF] t_ms=%lu fps_x10=%lu refr_ms=%lu flush_us=%lu flush_max_us=%lu "
+                      "lock_wait_max_us=%lu lock_pm=%lu heap_free=%lu heap_blk=%lu "
+                      "psram_free=%lu psram_blk=%lu",
+                      (unsigned long)now, (unsigned long)fps_x10, (unsigned long)disp.refr_last_ms,
+                      (unsigned long)disp.flush_last_us, (unsigned long)disp.flush_max_us,
+                      (unsigned long)disp.lock_wait_max_us, (unsigned long)lock_pm,
+                      (unsigned long)heap_free, (unsigned long)heap_blk,
+                      (unsigned long)psram_free, (unsigned long)psram_blk);
+        for (size_t i = 0; i < PERF_HUD_TASK_COUNT; i++) {
+            Serial.printf(" stk_%s=%ld", perf_hud_tasks[i].name, (long)stack_hwm[i]);
+        }
+        Serial.printf(" in_avg_us=%lu in_max_us=%lu\n",
+                      (unsigned long)in.avg_us, (unsigned long)in.max_us);
+    }
+
+    if (perf_hud_label == NULL) {
+        return;
+    }
+
+    char stk[48];
+    int n = 0;
+    for (size_t i = 0; i < PERF_HUD_TASK_COUNT; i++) {
+        n += snprintf(stk + n, sizeof(stk) - n, "%c%ld ", perf_hud_tasks[i].name[0], (long)stack_hwm[i]);
+    }
+
+    lv_label_set_text_fmt(perf_hud_label,
+                          "FPS %lu.%lu refr %lums\n"
+                          "flush %lu/%luus\n"
+                          "lock %lu/%luus %lu.%lu%%\n"
+                          "heap %luk/%luk\n"
+                          "psram %luk/%luk\n"
+                          "stk %s\n"
+                          "in %lu/%lums",
+                          (unsigned long)(fps_x10 / 10), (unsigned long)(fps_x10 % 10),
+                          (unsigned long)disp.refr_last_ms,
+                          (unsigned long)disp.flush_last_us, (unsigned long)disp.flush_max_us,
+                          (unsigned long)disp.lock_wait_last_us, (unsigned long)disp.lock_wait_max_us,
+                          (unsigned long)(lock_pm / 10), (unsigned long)(lock_pm % 10),
+                          (unsigned long)(heap_free / 1024), (unsigned long)(heap_blk / 1024),
+                          (unsigned long)(psram_free / 1024), (unsigned long)(psram_blk / 1024),
+                          stk,
+                          (unsigned long)(in.avg_us / 1000), (unsigned long)(in.max_us / 1000));
+}
+
+static void perf_hud_show(bool show)
+{
+    if (show && perf_hud_label == NULL) {
+        perf_hud_label = lv_label_create(lv_layer_top());
+        lv_obj_set_style_text_font(perf_hud_label, FONT_BOLD_14, LV_PART_MAIN);
+        lv_obj_set_style_text_color(perf_hud_label, lv_color_hex(0x00FF00), LV_PART_MAIN);
+        lv_obj_set_style_bg_color(perf_hud_label, lv_color_hex(0x000000), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(perf_hud_label, LV_OPA_70, LV_PART_MAIN);
+        lv_obj_set_style_pad_all(perf_hud_label, 2, LV_PART_MAIN);
+        lv_obj_align(perf_hud_label, LV_ALIGN_TOP_LEFT, 0, 0);
+        lv_label_set_text(perf_hud_label, "");
+    } else if (!show && perf_hud_label != NULL) {
+        lv_obj_del(perf_hud_label);
+        perf_hud_label = NULL;
+    }
+}
+
+void perf_hud_init(void)
+{
+    if (perf_hud_timer) {
+        return;
+    }
+    perf_hud_timer = lv_timer_create(perf_hud_sample, PERF_HUD_PERIOD_MS, NULL);
+    lv_timer_pause(perf_hud_timer);
+}
+
+void perf_hud_set_mode(PerfHudMode mode)
+{
+    if (mode >= PERF_HUD_MODE_COUNT || perf_hud_timer == NULL) {
+        return;
+    }
+    perf_hud_mode = mode;
+    perf_hud_show(mode != PERF_HUD_OFF);
+
+    if (mode == PERF_HUD_OFF) {
+        lv_timer_pause(perf_hud_timer);
+        return;
+    }
+
+    // Start a fresh window so the first figures are not averaged over the idle time
+    lv_port_disp_stats_t disp;
+    lv_port_disp_get_stats(&disp);
+    lv_port_disp_reset_max();
+    perf_hud_last_ms = millis();
+    perf_hud_last_frames = disp.frames;
+    perf_hud_last_wait_us = disp.lock_wait_total_us;
+    lv_timer_resume(perf_hud_timer);
+}
+
+PerfHudMode perf_hud_get_mode(void)
+{
+    return perf_hud_mode;
+}
+
+PerfHudMode perf_hud_cycle(void)
+{
+    perf_hud_set_mode((PerfHudMode)((perf_hud_mode + 1) % PERF_HUD_MODE_COUNT));
+    return perf_hud_mode;
+}
+
+const char *perf_hud_mode_name(PerfHudMode mode)
+{
+    switch (mode) {
+        case PERF_HUD_SHOW:     return "ON";
+        case PERF_HUD_SHOW_LOG: return "LOG";
+        default:                return "OFF";
+    }
+}
@@ -0,0 +1,45 @@
+// Nautilus Perf HUD - frame, heap, stack and lock figures on lv_layer_top()
+//
+// A single LVGL timer samples everything once per period, so the HUD costs
+// one label update (and with full_refresh, one extra frame) per second.
+// FPS counts frames actually pushed to the panel: an idle UI reads ~1.
+
+#pragma once
+
+#include <Arduino.h>
+
+#define PERF_HUD_PERIOD_MS 1000
+
+typedef enum {
+    PERF_HUD_OFF = 0,
+    PERF_HUD_SHOW,          // Overlay only
+    PERF_HUD_SHOW_LOG,      // Overlay plus one [PERF] line per sample on Serial
+    PERF_HUD_MODE_COUNT,
+} PerfHudMode;
+
+/**
+ * Create the (paused) sampling timer. Call once after the LVGL port is up.
+ */
+void perf_hud_init(void);
+
+/**
+ * Select what the HUD does; the timer only runs while the mode is not OFF
+ * @param mode New mode
+ */
+void perf_hud_set_mode(PerfHudMode mode);
+
+/**
+ * @return Current mode
+ */
+PerfHudMode perf_hud_get_mode(void);
+
+/**
+ * Step OFF -> SHOW -> SHOW_LOG -> OFF
+ * @return The new mode
+ */
+PerfHudMode perf_hud_cycle(void);
+
+/**
+ * @return Short mode name for settings labels ("OFF", "ON", "LOG")
+ */
+const char *perf_hud_mode_name(PerfHudMode mode);
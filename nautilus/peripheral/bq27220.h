@@ -186,9 +186,14 @@ public:
     bool i2cReadBytes(uint8_t reg, uint8_t * dest, uint8_t count) {
         wire->beginTransmission(addr);
         wire->write(reg);
-        wire->endTransmission(true);
+        if(wire->endTransmission(true) != 0) {
+            return false;
+        }
 
-        wire->requestFrom(addr, count);
+        // A NACK leaves read() returning -1, stored as 0xFF
+        if(wire->requestFrom(addr, count) != count) {
+            return false;
+        }
         for(int i = 0; i < count; i++) {
             dest[i] = wire->read();
         }
@@ -0,0 +1,502 @@
+
+#include "peripheral.h"
+#include "Audio.h"
+#include "FSImpl.h"
+#include <dirent.h>
+
+extern Audio audio;
+
+/*********************************************************************************
+ *                          SD read-ahead filesystem
+ *********************************************************************************/
+// Audio::processLocalFile() asks for as much as its input buffer can take,
+// which would keep the SD card selected for a long time. This wrapper serves
+// those reads from a PSRAM cache and refills it one chunk at a time under
+// radioLock, so display flushes get the bus between chunks. Reads may come
+// back short, which the decoder already handles.
+
+static uint8_t *audio_cache = NULL;
+static size_t audio_cache_size = 0;
+
+class ReadAheadFileImpl : public fs::FileImpl {
+public:
+    ReadAheadFileImpl(File file) : _file(file), _pos(0), _cache_pos(0), _cache_len(0)
+    {
+        _size = _file.size();
+    }
+
+    ~ReadAheadFileImpl() { close(); }
+
+    size_t write(const uint8_t *buf, size_t size) { return 0; }
+
+    size_t read(uint8_t *buf, size_t size)
+    {
+        if (_pos < _cache_pos || _pos >= _cache_pos + _cache_len) {
+            if (!refill()) {
+                return 0;
+            }
+        }
+        size_t offset = _pos - _cache_pos;
+        size_t n = min(size, _cache_len - offset);
+        memcpy(buf, audio_cache + offset, n);
+        _pos += n;
+        return n;
+    }
+
+    void flush() {}
+
+    bool seek(uint32_t pos, SeekMode mode)
+    {
+        size_t target;
+        if (mode == SeekSet) {
+            target = pos;
+        } else if (mode == SeekCur) {
+            target = _pos + pos;
+        } else {
+            target = _size - pos;
+        }
+        if (target > _size) {
+            return false;
+        }
+        _pos = target;
+        return true;
+    }
+
+    size_t position() const { return _pos; }
+    size_t size() const { return _size; }
+    bool setBufferSize(size_t size) { return false; }
+
+    void close()
+    {
+        if (!_file) {
+            return;
+        }
+        xSemaphoreTake(radioLock, portMAX_DELAY);
+        _file.close();
+        xSemaphoreGive(radioLock);
+        _cache_len = 0;
+    }
+
+    time_t getLastWrite() { return _file.getLastWrite(); }
+    const char *path() const { return const_cast<File &>(_file).path(); }
+    const char *name() const { return const_cast<File &>(_file).name(); }
+    boolean isDirectory(void) { return false; }
+    fs::FileImplPtr openNextFile(const char *mode) { return fs::FileImplPtr(); }
+    boolean seekDir(long position) { return false; }
+    String getNextFileName(void) { return String(); }
+    void rewindDirectory(void) {}
+    operator bool() { return (bool)_file; }
+
+private:
+    bool refill()
+    {
+        if (!_file || _pos >= _size) {
+            return false;
+        }
+
+        xSemaphoreTake(radioLock, portMAX_DELAY);
+        if (_file.position() != _pos) {
+            _file.seek(_pos);
+        }
+        int n = _file.read(audio_cache, audio_cache_size);
+        xSemaphoreGive(radioLock);
+
+        _cache_pos = _pos;
+        _cache_len = (n > 0) ? n : 0;
+        return _cache_len > 0;
+    }
+
+    File _file;
+    size_t _size;
+    size_t _pos;
+    size_t _cache_pos;
+    size_t _cache_len;
+};
+
+class ReadAheadFSImpl : public fs::FSImpl {
+public:
+    ReadAheadFSImpl(fs::FS &base) : _base(base) {}
+
+    fs::FileImplPtr open(const char *path, const char *mode, const bool create)
+    {
+        xSemaphoreTake(radioLock, portMAX_DELAY);
+        File file = _base.open(path, FILE_READ);
+        xSemaphoreGive(radioLock);
+
+        if (!file) {
+            return fs::FileImplPtr();
+        }
+        return std::make_shared<ReadAheadFileImpl>(file);
+    }
+
+    bool exists(const char *path)
+    {
+        xSemaphoreTake(radioLock, portMAX_DELAY);
+        bool ret = _base.exists(path);
+        xSemaphoreGive(radioLock);
+        return ret;
+    }
+
+    // Read-only view
+    bool rename(const char *pathFrom, const char *pathTo) { return false; }
+    bool remove(const char *path) { return false; }
+    bool mkdir(const char *path) { return false; }
+    bool rmdir(const char *path) { return false; }
+
+private:
+    fs::FS &_base;
+};
+
+static fs::FS audio_sd_fs(fs::FSImplPtr(new ReadAheadFSImpl(SD)));
+
+/*********************************************************************************
+ *                                Audio task
+ *********************************************************************************/
+static SemaphoreHandle_t audio_mutex = NULL;
+static TaskHandle_t audio_handle = NULL;
+
+static void audio_task(void *param)
+{
+    while (1) {
+        xSemaphoreTakeRecursive(audio_mutex, portMAX_DELAY);
+        audio.loop();
+        bool running = audio.isRunning();
+        xSemaphoreGiveRecursive(audio_mutex);
+
+        if (running) {
+            vTaskDelay(1);
+        } else {
+            // Idle until audio_play() wakes us
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+    }
+}
+
+void audio_service_init(void)
+{
+    audio_cache_size = AUDIO_READAHEAD_SIZE;
+    audio_cache = (uint8_t *)ps_malloc(audio_cache_size);
+    if (!audio_cache) {
+        audio_cache_size = AUDIO_READAHEAD_SIZE_RAM;
+        audio_cache = (uint8_t *)malloc(audio_cache_size);
+    }
+    assert(audio_cache);
+
+    audio_mutex = xSemaphoreCreateRecursiveMutex();
+    assert(audio_mutex);
+
+    audio.setPinout(BOARD_VOICE_BCLK, BOARD_VOICE_LRCLK, BOARD_VOICE_DIN);
+    audio.setVolume(21); // 0...21
+
+    xTaskCreatePinnedToCore(audio_task, "audio_task", AUDIO_TASK_STACK, NULL,
+                            AUDIO_TASK_PRIORITY, &audio_handle, AUDIO_TASK_CORE);
+}
+
+bool audio_play(fs::FS &fs, const char *path)
+{
+    // SD goes through the read-ahead wrapper; SPIFFS is on flash and needs no lock
+    fs::FS &src = (&fs == &SD) ? audio_sd_fs : fs;
+
+    xSemaphoreTakeRecursive(audio_mutex, portMAX_DELAY);
+    bool ret = audio.connecttoFS(src, path);
+    xSemaphoreGiveRecursive(audio_mutex);
+
+    if (ret) {
+        xTaskNotifyGive(audio_handle);
+    }
+    return ret;
+}
+
+void audio_stop(void)
+{
+    xSemaphoreTakeRecursive(audio_mutex, portMAX_DELAY);
+    audio.stopSong();
+    xSemaphoreGiveRecursive(audio_mutex);
+}
+
+void audio_set_volume(uint8_t volume)
+{
+    xSemaphoreTakeRecursive(audio_mutex, portMAX_DELAY);
+    audio.setVolume(volume);
+    xSemaphoreGiveRecursive(audio_mutex);
+}
+
+bool audio_is_playing(void)
+{
+    return audio.isRunning();
+}
+
+/*********************************************************************************
+ *                              Playlist index
+ *********************************************************************************/
+// File layout: MusicIndexHeader followed by `count` records of
+// MUSIC_INDEX_NAME_LEN bytes, so entry i lives at a fixed offset.
+#define MUSIC_INDEX_MAGIC    0x4C504D4E  // "NMPL"
+#define MUSIC_INDEX_VERSION  1
+#define MUSIC_INDEX_TMP_PATH MUSIC_INDEX_PATH ".tmp"
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t name_len;
+    uint32_t count;
+    char dir[32];
+} MusicIndexHeader;
+
+static SemaphoreHandle_t music_index_mutex = NULL;
+static int music_count = -1;
+static char music_dir[32] = MUSIC_DIR;
+static int music_page_start = -1;
+static char (*music_page)[MUSIC_INDEX_NAME_LEN] = NULL;
+static volatile bool music_indexing = false;
+static volatile int music_indexed = 0;
+
+static void music_index_lock_init(void)
+{
+    if (!music_index_mutex) {
+        music_index_mutex = xSemaphoreCreateMutex();
+        assert(music_index_mutex);
+    }
+    if (!music_page) {
+        music_page = (char (*)[MUSIC_INDEX_NAME_LEN])ps_malloc(MUSIC_INDEX_PAGE * MUSIC_INDEX_NAME_LEN);
+        assert(music_page);
+    }
+}
+
+bool music_index_open(void)
+{
+    MusicIndexHeader hdr;
+    bool ok = false;
+
+    music_index_lock_init();
+
+    xSemaphoreTake(radioLock, portMAX_DELAY);
+    File file = SD.open(MUSIC_INDEX_PATH, FILE_READ);
+    if (file) {
+        ok = file.read((uint8_t *)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+             hdr.magic == MUSIC_INDEX_MAGIC &&
+             hdr.version == MUSIC_INDEX_VERSION &&
+             hdr.name_len == MUSIC_INDEX_NAME_LEN &&
+             file.size() >= sizeof(hdr) + (size_t)hdr.count * MUSIC_INDEX_NAME_LEN;
+        file.close();
+    }
+    xSemaphoreGive(radioLock);
+
+    if (!ok) {
+        return false;
+    }
+
+    xSemaphoreTake(music_index_mutex, portMAX_DELAY);
+    music_count = hdr.count;
+    hdr.dir[sizeof(hdr.dir) - 1] = '\0';
+    strncpy(music_dir, hdr.dir, sizeof(music_dir));
+    music_page_start = -1;
+    xSemaphoreGive(music_index_mutex);
+
+    Serial.printf("[MUSIC] Cached index: %d files in %s\n", (int)hdr.count, hdr.dir);
+    return true;
+}
+
+static bool music_index_is_mp3(const char *name)
+{
+    size_t len = strlen(name);
+    return len > 4 && strcasecmp(name + len - 4, ".mp3") == 0;
+}
+
+static bool music_index_write(File &file, const void *buf, size_t len)
+{
+    xSemaphoreTake(radioLock, portMAX_DELAY);
+    size_t n = file.write((const uint8_t *)buf, len);
+    xSemaphoreGive(radioLock);
+    return n == len;
+}
+
+static void music_index_task(void *param)
+{
+    static char batch[MUSIC_INDEX_PAGE][MUSIC_INDEX_NAME_LEN];
+    MusicIndexHeader hdr = {};
+    int batch_cnt = 0;
+    uint32_t count = 0;
+    uint32_t start = millis();
+    bool ok = true;
+
+    hdr.magic = MUSIC_INDEX_MAGIC;
+    hdr.version = MUSIC_INDEX_VERSION;
+    hdr.name_len = MUSIC_INDEX_NAME_LEN;
+
+    // Try /music first, fall back to root if it doesn't exist
+    xSemaphoreTake(radioLock, portMAX_DELAY);
+    strncpy(hdr.dir, MUSIC_DIR, sizeof(hdr.dir));
+    DIR *dir = opendir("/sd" MUSIC_DIR);
+    if (!dir) {
+        strncpy(hdr.dir, "/", sizeof(hdr.dir));
+        dir = opendir("/sd");
+    }
+    File file = dir ? SD.open(MUSIC_INDEX_TMP_PATH, FILE_WRITE) : File();
+    xSemaphoreGive(radioLock);
+
+    if (!dir || !file) {
+        Serial.println("[MUSIC] Failed to start index");
+        if (dir) {
+            closedir(dir);
+        }
+        music_indexing = false;
+        vTaskDelete(NULL);
+        return;
+    }
+
+    // Header is rewritten with the final count once the scan is done
+    ok = music_index_write(file, &hdr, sizeof(hdr));
+
+    while (ok) {
+        xSemaphoreTake(radioLock, portMAX_DELAY);
+        struct dirent *entry = readdir(dir);
+        xSemaphoreGive(radioLock);
+        if (!entry) {
+            break;
+        }
+
+        if (entry->d_type == DT_DIR || !music_index_is_mp3(entry->d_name)) {
+            continue;
+        }
+        if (strlen(entry->d_name) >= MUSIC_INDEX_NAME_LEN) {
+            Serial.printf("[MUSIC] Name too long, skipped: %s\n", entry->d_name);
+            continue;
+        }
+
+        memset(batch[batch_cnt], 0, MUSIC_INDEX_NAME_LEN);
+        strcpy(batch[batch_cnt], entry->d_name);
+        batch_cnt++;
+        count++;
+
+        if (batch_cnt == MUSIC_INDEX_PAGE) {
+            ok = music_index_write(file, batch, sizeof(batch));
+            batch_cnt = 0;
+            music_indexed = count;
+        }
+    }
+
+    if (ok && batch_cnt > 0) {
+        ok = music_index_write(file, batch, batch_cnt * MUSIC_INDEX_NAME_LEN);
+    }
+
+    hdr.count = count;
+    xSemaphoreTake(radioLock, portMAX_DELAY);
+    closedir(dir);
+    if (ok) {
+        ok = file.seek(0) && file.write((const uint8_t *)&hdr, sizeof(hdr)) == sizeof(hdr);
+    }
+    file.close();
+    xSemaphoreGive(radioLock);
+
+    // Swap in under the index mutex so a page load never sees a half-replaced file
+    xSemaphoreTake(music_index_mutex, portMAX_DELAY);
+    if (ok) {
+        xSemaphoreTake(radioLock, portMAX_DELAY);
+        SD.remove(MUSIC_INDEX_PATH);
+        ok = SD.rename(MUSIC_INDEX_TMP_PATH, MUSIC_INDEX_PATH);
+        xSemaphoreGive(radioLock);
+    }
+    if (ok) {
+        music_count = count;
+        strncpy(music_dir, hdr.dir, sizeof(music_dir));
+        music_page_start = -1;
+    }
+    xSemaphoreGive(music_index_mutex);
+
+    music_indexed = count;
+    Serial.printf("[MUSIC] Indexed %lu files in %lu ms%s\n", (unsigned long)count,
+                  (unsigned long)(millis() - start), ok ? "" : " (write failed)");
+
+    music_indexing = false;
+    vTaskDelete(NULL);
+}
+
+void music_index_rebuild(void)
+{
+    if (music_indexing || !sd_is_valid()) {
+        return;
+    }
+    music_index_lock_init();
+
+    music_indexing = true;
+    music_indexed = 0;
+    if (xTaskCreatePinnedToCore(music_index_task, "music_index", 1024 * 4, NULL,
+                                tskIDLE_PRIORITY + 1, NULL, AUDIO_TASK_CORE) != pdPASS) {
+        music_indexing = false;
+    }
+}
+
+bool music_index_is_busy(void)
+{
+    return music_indexing;
+}
+
+int music_index_count(void)
+{
+    return music_count;
+}
+
+int music_index_progress(void)
+{
+    return music_indexed;
+}
+
+bool music_index_get_name(int idx, char *name, size_t len)
+{
+    if (!music_index_mutex || idx < 0) {
+        return false;
+    }
+
+    xSemaphoreTake(music_index_mutex, portMAX_DELAY);
+    if (idx >= music_count) {
+        xSemaphoreGive(music_index_mutex);
+        return false;
+    }
+
+    // Page in the block of records around idx
+    if (music_page_start < 0 || idx < music_page_start || idx >= music_page_start + MUSIC_INDEX_PAGE) {
+        int page_start = idx - (idx % MUSIC_INDEX_PAGE);
+        int page_cnt = min(MUSIC_INDEX_PAGE, music_count - page_start);
+        bool ok = false;
+
+        xSemaphoreTake(radioLock, portMAX_DELAY);
+        File file = SD.open(MUSIC_INDEX_PATH, FILE_READ);
+        if (file) {
+            size_t bytes = page_cnt * MUSIC_INDEX_NAME_LEN;
+            ok = file.seek(sizeof(MusicIndexHeader) + page_start * MUSIC_INDEX_NAME_LEN) &&
+                 file.read((uint8_t *)music_page, bytes) == bytes;
+            file.close();
+        }
+        xSemaphoreGive(radioLock);
+
+        if (!ok) {
+            music_page_start = -1;
+            xSemaphoreGive(music_index_mutex);
+            return false;
+        }
+        music_page_start = page_start;
+    }
+
+    strncpy(name, music_page[idx - music_page_start], len);
+    name[len - 1] = '\0';
+    xSemaphoreGive(music_index_mutex);
+    return true;
+}
+
+bool music_index_get_path(int idx, char *path, size_t len)
+{
+    char name[MUSIC_INDEX_NAME_LEN];
+    if (!music_index_get_name(idx, name, sizeof(name))) {
+        return false;
+    }
+
+    xSemaphoreTake(music_index_mutex, portMAX_DELAY);
+    if (strcmp(music_dir, "/") == 0) {
+        snprintf(path, len, "/%s", name);
+    } else {
+        snprintf(path, len, "%s/%s", music_dir, name);
+    }
+    xSemaphoreGive(music_index_mutex);
+    return true;
+}
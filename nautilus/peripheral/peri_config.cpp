@@ -1,13 +1,63 @@
 #include "peri_config.h"
 #include "rf_utils.h"
+#include "rf_hopper.h"  // RF_HOP_MAX_FREQS
 #include <cmath>
 
 NautilusConfig g_config;
 
+extern SemaphoreHandle_t radioLock;  // Also guards the SPI bus shared by LCD, SD and CC1101
+
+static TaskHandle_t config_task_handle = NULL;
+static SemaphoreHandle_t config_mutex = NULL;   // g_config snapshot vs. structural edits
+static SemaphoreHandle_t config_write_mutex = NULL;
+static portMUX_TYPE config_dirty_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t config_dirty = 0;
+
+static void config_create_mutexes() {
+    if (!config_mutex) {
+        config_mutex = xSemaphoreCreateRecursiveMutex();
+    }
+    if (!config_write_mutex) {
+        config_write_mutex = xSemaphoreCreateMutex();
+    }
+}
+
 bool config_sd_available() {
     return SD.begin(BOARD_SD_CS);
 }
 
+void config_lock() {
+    config_create_mutexes();
+    xSemaphoreTakeRecursive(config_mutex, portMAX_DELAY);
+}
+
+void config_unlock() {
+    xSemaphoreGiveRecursive(config_mutex);
+}
+
+/**
+ * Restore a consistent nautilus.json after an interrupted atomic save
+ * A save writes .tmp, moves the old file to .bak, then renames .tmp into place,
+ * so a missing main file means the crash happened between the two renames.
+ */
+static void config_recover() {
+    if (SD.exists(CONFIG_FILE_PATH)) {
+        if (SD.exists(CONFIG_TMP_PATH)) {
+            SD.remove(CONFIG_TMP_PATH);   // Partial write, the main file is intact
+        }
+        return;
+    }
+
+    if (SD.exists(CONFIG_BAK_PATH)) {
+        if (SD.exists(CONFIG_TMP_PATH) && SD.rename(CONFIG_TMP_PATH, CONFIG_FILE_PATH)) {
+            Serial.println("[Config] Recovered nautilus.json from interrupted save");
+            SD.remove(CONFIG_BAK_PATH);
+        } else if (SD.rename(CONFIG_BAK_PATH, CONFIG_FILE_PATH)) {
+            Serial.println("[Config] Restored nautilus.json from backup");
+        }
+    }
+}
+
 bool config_load() {
     if (!config_sd_available()) {
         // Silently return if SD card is not available
@@ -15,6 +65,8 @@ bool config_load() {
         return false;
     }
 
+    config_recover();
+
     File file = SD.open(CONFIG_FILE_PATH, FILE_READ);
     if (!file) {
         // Config file doesn't exist - create example config on first boot
@@ -74,6 +126,7 @@ bool config_load() {
     // Load SubGHz settings
     g_config.subghz.last_frequency = doc["subghz"]["last_frequency"] | 433.92f;
     JsonArray custom_freqs = doc["subghz"]["custom_frequencies"];
+    config_lock();
     g_config.subghz.custom_frequencies.clear();
 
     // Load custom frequencies with deduplication
@@ -107,6 +160,7 @@ bool config_load() {
             g_config.subghz.custom_frequencies.push_back(freq);
         }
     }
+    config_unlock();
     bool needs_cleanup = (g_config.subghz.custom_frequencies.size() != original_count);
     if (needs_cleanup) {
         Serial.printf("[Config] Loaded %d custom frequencies (%d duplicates removed)\n",
@@ -129,6 +183,26 @@ bool config_load() {
     g_config.subghz.scan.threshold = doc["subghz"]["scan"]["thresh"] | -65;
     strlcpy(g_config.subghz.scan.type, doc["subghz"]["scan"]["type"] | "band", sizeof(g_config.subghz.scan.type));
     strlcpy(g_config.subghz.scan.range, doc["subghz"]["scan"]["range"] | "full", sizeof(g_config.subghz.scan.range));
+    g_config.subghz.dedup = doc["subghz"]["dedup"] | 2;
+    g_config.subghz.binraw = doc["subghz"]["binraw"] | true;
+
+    // Load capture filter settings
+    g_config.subghz.filter.glitch_us = doc["subghz"]["filter"]["glitch_us"] | 60;
+
+    // Load multi-frequency listen settings
+    JsonArray hop_freqs = doc["subghz"]["hop"]["freqs"];
+    if (!hop_freqs.isNull()) {
+        config_lock();
+        g_config.subghz.hop.freqs.clear();
+        for (JsonVariant v : hop_freqs) {
+            if (g_config.subghz.hop.freqs.size() < RF_HOP_MAX_FREQS) {
+                g_config.subghz.hop.freqs.push_back(v.as<float>());
+            }
+        }
+        config_unlock();
+    }
+    g_config.subghz.hop.dwell_min_ms = doc["subghz"]["hop"]["dwell_min_ms"] | 15;
+    g_config.subghz.hop.dwell_max_ms = doc["subghz"]["hop"]["dwell_max_ms"] | 150;
 
     // Load Display settings
     g_config.display.rotation = doc["display"]["rotation"] | 1;
@@ -148,12 +222,9 @@ bool config_load() {
     return true;
 }
 
-bool config_save() {
-    if (!config_sd_available()) {
-        return false;
-    }
-
-    JsonDocument doc;
+// Build the JSON document from a consistent view of g_config
+static void config_build_doc(JsonDocument& doc) {
+    config_lock();
 
     // Build hierarchical JSON structure
     doc["version"] = CONFIG_VERSION;
@@ -189,6 +260,19 @@ bool config_save() {
     doc["subghz"]["scan"]["thresh"] = g_config.subghz.scan.threshold;
     doc["subghz"]["scan"]["type"] = g_config.subghz.scan.type;
     doc["subghz"]["scan"]["range"] = g_config.subghz.scan.range;
+    doc["subghz"]["dedup"] = g_config.subghz.dedup;
+    doc["subghz"]["binraw"] = g_config.subghz.binraw;
+
+    // Capture filter settings
+    doc["subghz"]["filter"]["glitch_us"] = g_config.subghz.filter.glitch_us;
+
+    // Multi-frequency listen settings
+    JsonArray hop_freqs = doc["subghz"]["hop"]["freqs"].to<JsonArray>();
+    for (float freq : g_config.subghz.hop.freqs) {
+        hop_freqs.add(freq);
+    }
+    doc["subghz"]["hop"]["dwell_min_ms"] = g_config.subghz.hop.dwell_min_ms;
+    doc["subghz"]["hop"]["dwell_max_ms"] = g_config.subghz.hop.dwell_max_ms;
 
     // Display settings
     doc["display"]["rotation"] = g_config.display.rotation;
@@ -197,21 +281,117 @@ bool config_save() {
     // Audio settings
     doc["audio"]["volume"] = g_config.audio.volume;
 
-    // Write to file
-    File file = SD.open(CONFIG_FILE_PATH, FILE_WRITE);
+    config_unlock();
+}
+
+// Write to a temp file, then swap it in so a power cut never truncates nautilus.json
+static bool config_write_atomic(const JsonDocument& doc) {
+    SD.remove(CONFIG_TMP_PATH);
+
+    File file = SD.open(CONFIG_TMP_PATH, FILE_WRITE);
     if (!file) {
         return false;
     }
 
     if (serializeJsonPretty(doc, file) == 0) {
         file.close();
+        SD.remove(CONFIG_TMP_PATH);
         return false;
     }
 
+    file.flush();
     file.close();
+
+    SD.remove(CONFIG_BAK_PATH);
+    if (SD.exists(CONFIG_FILE_PATH) && !SD.rename(CONFIG_FILE_PATH, CONFIG_BAK_PATH)) {
+        return false;
+    }
+    if (!SD.rename(CONFIG_TMP_PATH, CONFIG_FILE_PATH)) {
+        SD.rename(CONFIG_BAK_PATH, CONFIG_FILE_PATH);
+        return false;
+    }
+    SD.remove(CONFIG_BAK_PATH);
+
     return true;
 }
 
+bool config_flush() {
+    config_create_mutexes();
+    xSemaphoreTake(config_write_mutex, portMAX_DELAY);
+
+    portENTER_CRITICAL(&config_dirty_mux);
+    uint32_t dirty = config_dirty;
+    config_dirty = 0;
+    portEXIT_CRITICAL(&config_dirty_mux);
+
+    if (dirty == 0) {
+        xSemaphoreGive(config_write_mutex);
+        return true;
+    }
+
+    JsonDocument doc;
+    config_build_doc(doc);
+
+    bool ok = false;
+    if (xSemaphoreTake(radioLock, portMAX_DELAY) == pdTRUE) {
+        ok = config_sd_available() && config_write_atomic(doc);
+        xSemaphoreGive(radioLock);
+    }
+
+    if (!ok) {
+        // Keep the changes pending so the next save retries them
+        portENTER_CRITICAL(&config_dirty_mux);
+        config_dirty |= dirty;
+        portEXIT_CRITICAL(&config_dirty_mux);
+    }
+
+    xSemaphoreGive(config_write_mutex);
+    return ok;
+}
+
+bool config_save() {
+    portENTER_CRITICAL(&config_dirty_mux);
+    config_dirty |= CONFIG_DIRTY_ALL;
+    portEXIT_CRITICAL(&config_dirty_mux);
+
+    return config_flush();
+}
+
+void config_mark_dirty(uint32_t sections) {
+    portENTER_CRITICAL(&config_dirty_mux);
+    config_dirty |= sections;
+    portEXIT_CRITICAL(&config_dirty_mux);
+
+    if (config_task_handle) {
+        xTaskNotifyGive(config_task_handle);
+    }
+}
+
+bool config_is_dirty() {
+    return config_dirty != 0;
+}
+
+static void config_task(void *param) {
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Restart the window on every new change so a spinning encoder saves once
+        while (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONFIG_SAVE_DEBOUNCE_MS)) > 0) {
+        }
+
+        if (!config_flush()) {
+            Serial.println("[Config] Background save failed, will retry on next change");
+        }
+    }
+}
+
+void config_service_init() {
+    config_create_mutexes();
+    if (!config_task_handle) {
+        xTaskCreate(config_task, "config_task", CONFIG_TASK_STACK, NULL, CONFIG_TASK_PRIORITY, &config_task_handle);
+    }
+}
+
 bool config_create_example() {
     if (!config_sd_available()) {
         return false;
@@ -287,16 +467,16 @@ void config_print() {
 
 /**
  * Save raw record frequency to config
- * Auto-saves to nautilus.json
+ * Schedules a debounced background save of nautilus.json
  */
 void config_save_raw_frequency(float freq_mhz) {
     g_config.subghz.raw.last_frequency = freq_mhz;
-    config_save();
+    config_mark_dirty(CONFIG_DIRTY_SUBGHZ);
 }
 
 /**
  * Save scan/record settings to config
- * Auto-saves to nautilus.json
+ * Schedules a debounced background save of nautilus.json
  *
  * @param type "single", "band", or "custom"
  * @param range Depends on type:
@@ -309,16 +489,16 @@ void config_save_scan_settings(const char* type, const char* range, int threshol
     strlcpy(g_config.subghz.scan.type, type, sizeof(g_config.subghz.scan.type));
     strlcpy(g_config.subghz.scan.range, range, sizeof(g_config.subghz.scan.range));
     g_config.subghz.scan.threshold = threshold;
-    config_save();
+    config_mark_dirty(CONFIG_DIRTY_SUBGHZ);
 }
 
 /**
  * Save modulation preset to config
- * Auto-saves to nautilus.json
+ * Schedules a debounced background save of nautilus.json
  *
  * @param mod "am270", "am650", "fm238", or "fm476"
  */
 void config_save_modulation(const char* mod) {
     strlcpy(g_config.subghz.modulation, mod, sizeof(g_config.subghz.modulation));
-    config_save();
+    config_mark_dirty(CONFIG_DIRTY_SUBGHZ);
 }
@@ -6,8 +6,23 @@
 #include "utilities.h"
 
 #define CONFIG_FILE_PATH "/nautilus.json"
+#define CONFIG_TMP_PATH  "/nautilus.json.tmp"
+#define CONFIG_BAK_PATH  "/nautilus.json.bak"
 #define CONFIG_VERSION "1.0"
 
+// Changes are coalesced for this long before the background writer saves them
+#define CONFIG_SAVE_DEBOUNCE_MS 1500
+#define CONFIG_TASK_PRIORITY    (tskIDLE_PRIORITY + 1)
+#define CONFIG_TASK_STACK       (1024 * 6)
+
+// Dirty section flags for config_mark_dirty()
+#define CONFIG_DIRTY_WS2812   (1 << 0)
+#define CONFIG_DIRTY_WIFI     (1 << 1)
+#define CONFIG_DIRTY_SUBGHZ   (1 << 2)
+#define CONFIG_DIRTY_DISPLAY  (1 << 3)
+#define CONFIG_DIRTY_AUDIO    (1 << 4)
+#define CONFIG_DIRTY_ALL      (0x1F)
+
 // Configuration structure with hierarchical organization
 struct NautilusConfig {
     // WS2812 LED Settings
@@ -58,6 +73,21 @@ struct NautilusConfig {
             char type[8];           // "single", "band", "custom"
             char range[16];         // Frequency or range (e.g., "315.000", "full", "433-435")
         } scan;
+
+        int dedup;                   // Duplicate captures on save: 0 = save, 1 = warn, 2 = skip
+        bool binraw;                 // Save RAW captures as BinRAW when TE quantization round-trips
+
+        // Capture edge filter
+        struct {
+            int glitch_us;           // Merge edges shorter than this (0 = off); decoder TEs start ~250us
+        } filter;
+
+        // Multi-frequency listen (uses scan.threshold as the trigger level)
+        struct {
+            std::vector<float> freqs;  // 3..8 channels in MHz, visited round-robin
+            int dwell_min_ms;        // Dwell on a quiet channel
+            int dwell_max_ms;        // Dwell on a channel with recent activity
+        } hop;
     } subghz;
 
     // Display Settings
@@ -94,6 +124,12 @@ struct NautilusConfig {
         subghz.scan.threshold = -65;
         strcpy(subghz.scan.type, "band");
         strcpy(subghz.scan.range, "full");
+        subghz.dedup = 2;
+        subghz.binraw = true;
+        subghz.filter.glitch_us = 60;
+        subghz.hop.freqs = {315.00f, 433.92f, 868.35f};
+        subghz.hop.dwell_min_ms = 15;
+        subghz.hop.dwell_max_ms = 150;
 
         // Display defaults
         display.rotation = 1;         // Landscape
@@ -109,7 +145,13 @@ extern NautilusConfig g_config;
 
 // Functions
 bool config_load();                    // Load from SD card
-bool config_save();                    // Save to SD card
+bool config_save();                    // Save everything to SD card now (blocking, atomic)
+void config_service_init();            // Start the background write-behind task
+void config_mark_dirty(uint32_t sections);  // Schedule a debounced background save
+bool config_flush();                   // Write pending changes now (blocking, atomic)
+bool config_is_dirty();                // True while changes are waiting to be written
+void config_lock();                    // Guard structural g_config changes (e.g. vectors)
+void config_unlock();                  //   against the background writer's snapshot
 bool config_create_example();          // Create fully-populated example nautilus.json
 void config_set_defaults();            // Set default values
 void config_print();                   // Debug print
@@ -7,6 +7,91 @@
 #define EXAMPLE_SAMPLE_RATE 44100    // Audio Sample Rate  44.1KHz
 #define EXAMPLE_BIT_SAMPLE  16       // Audio Bit Sample
 
+#define MIC_DMA_BUF_COUNT   8
+#define MIC_DMA_BUF_LEN     200      // Samples per DMA buffer (~4.5 ms)
+#define MIC_EVT_QUEUE_LEN   8
+
+static QueueHandle_t mic_evt_queue = NULL;
+static TaskHandle_t mic_handle = NULL;
+
+// Level snapshot: single writer (mic_task), readers retry on an odd or changed sequence
+static MicLevel mic_level;
+static volatile uint32_t mic_level_seq = 0;
+
+// Recent PCM; mic_ring_wr counts samples written since init and never wraps back
+static int16_t mic_ring[MIC_RING_SAMPLES];
+static volatile uint32_t mic_ring_wr = 0;
+
+static void mic_publish(const int16_t *samples, size_t count)
+{
+    int64_t sum = 0;
+    uint64_t sum_sq = 0;
+    int32_t peak = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        int32_t s = samples[i];
+        sum += s;
+        sum_sq += (uint64_t)(s * s);
+        int32_t a = s < 0 ? -s : s;
+        if (a > peak) {
+            peak = a;
+        }
+    }
+
+    // RMS about the mean, so the PDM DC offset doesn't read as sound
+    float mean = (float)sum / count;
+    float var = (float)sum_sq / count - mean * mean;
+    uint16_t rms = var > 0 ? (uint16_t)sqrtf(var) : 0;
+
+    // Copy into the ring before publishing the new write count
+    uint32_t wr = mic_ring_wr;
+    for (size_t i = 0; i < count; i++) {
+        mic_ring[(wr + i) % MIC_RING_SAMPLES] = samples[i];
+    }
+    __sync_synchronize();
+    mic_ring_wr = wr + count;
+
+    mic_level_seq++;
+    __sync_synchronize();
+    mic_level.rms = rms;
+    mic_level.peak = (uint16_t)min(peak, (int32_t)UINT16_MAX);
+    mic_level.peak_hold = max(mic_level.peak, (uint16_t)(mic_level.peak_hold - mic_level.peak_hold / 16));
+    mic_level.buffers++;
+    mic_level.updated_ms = millis();
+    __sync_synchronize();
+    mic_level_seq++;
+}
+
+static void mic_task(void *param)
+{
+    static int16_t buf[MIC_DMA_BUF_LEN];
+    i2s_event_t evt;
+
+    while (1) {
+        if (xQueueReceive(mic_evt_queue, &evt, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        if (evt.type == I2S_EVENT_RX_Q_OVF) {
+            mic_level_seq++;
+            __sync_synchronize();
+            mic_level.overruns++;
+            __sync_synchronize();
+            mic_level_seq++;
+            continue;
+        }
+        if (evt.type != I2S_EVENT_RX_DONE) {
+            continue;
+        }
+
+        // A DMA buffer is complete, so a zero-timeout read returns immediately
+        size_t bytes = 0;
+        while (i2s_read((i2s_port_t)EXAMPLE_I2S_CH, buf, sizeof(buf), &bytes, 0) == ESP_OK && bytes > 0) {
+            mic_publish(buf, bytes / sizeof(int16_t));
+        }
+    }
+}
+
 void init_microphone(void)
 {
     i2s_config_t i2s_config = {
@@ -16,8 +101,8 @@ void init_microphone(void)
         .channel_format = I2S_CHANNEL_FMT_ONLY_LEFT,
         .communication_format = I2S_COMM_FORMAT_STAND_I2S,
         .intr_alloc_flags = ESP_INTR_FLAG_LEVEL2,
-        .dma_buf_count = 8,
-        .dma_buf_len = 200,
+        .dma_buf_count = MIC_DMA_BUF_COUNT,
+        .dma_buf_len = MIC_DMA_BUF_LEN,
         .use_apll = 0,
     };
 
@@ -31,7 +116,62 @@ void init_microphone(void)
     };
 
     // Call driver installation function before any I2S R/W operation.
-    ESP_ERROR_CHECK( i2s_driver_install((i2s_port_t )EXAMPLE_I2S_CH, &i2s_config, 0, NULL) );
+    // The event queue posts I2S_EVENT_RX_DONE per filled DMA buffer for mic_task.
+    ESP_ERROR_CHECK( i2s_driver_install((i2s_port_t )EXAMPLE_I2S_CH, &i2s_config, MIC_EVT_QUEUE_LEN, &mic_evt_queue) );
     ESP_ERROR_CHECK( i2s_set_pin((i2s_port_t)EXAMPLE_I2S_CH, &pin_config) );
     ESP_ERROR_CHECK( i2s_set_clk((i2s_port_t )EXAMPLE_I2S_CH, EXAMPLE_SAMPLE_RATE, I2S_BITS_PER_SAMPLE_16BIT, I2S_CHANNEL_MONO) );
-}
\ No newline at end of file
+
+    xTaskCreatePinnedToCore(mic_task, "mic_task", MIC_TASK_STACK, NULL,
+                            MIC_TASK_PRIORITY, &mic_handle, MIC_TASK_CORE);
+}
+
+bool mic_get_level(MicLevel *out)
+{
+    // The writer holds the sequence odd for a few instructions; a handful of retries is plenty
+    for (int tries = 0; tries < 8; tries++) {
+        uint32_t seq = mic_level_seq;
+        if (seq & 1) {
+            continue;
+        }
+        __sync_synchronize();
+        *out = mic_level;
+        __sync_synchronize();
+        if (seq == mic_level_seq) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool mic_is_active(void)
+{
+    MicLevel lvl;
+    return mic_get_level(&lvl) && lvl.rms > MIC_ACTIVE_RMS;
+}
+
+size_t mic_get_samples(float *out, size_t num_samples)
+{
+    if (num_samples > MIC_RING_SAMPLES / 2) {
+        num_samples = MIC_RING_SAMPLES / 2;
+    }
+
+    for (int tries = 0; tries < 4; tries++) {
+        uint32_t wr = mic_ring_wr;
+        if (wr < num_samples) {
+            return 0;
+        }
+        __sync_synchronize();
+
+        uint32_t start = wr - num_samples;
+        for (size_t i = 0; i < num_samples; i++) {
+            out[i] = (float)mic_ring[(start + i) % MIC_RING_SAMPLES] / 32768.0f;
+        }
+
+        // Valid unless the writer lapped the start of our window while copying
+        __sync_synchronize();
+        if (mic_ring_wr - start <= MIC_RING_SAMPLES) {
+            return num_samples;
+        }
+    }
+    return 0;
+}
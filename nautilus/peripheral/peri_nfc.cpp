@@ -1,5 +1,6 @@
 
 #include "peripheral.h"
+#include "../boot_trace.h"
 
 Adafruit_PN532 nfc(BOARD_PN532_IRQ, BOARD_PN532_RF_REST);
 uint32_t versiondata = 0;
@@ -10,6 +11,7 @@ uint8_t uid[] = { 0, 0, 0, 0, 0, 0, 0 };  // Buffer to store the returned UID
 uint8_t uidLength;                        // Length of the UID (4 or 7 bytes depending on ISO14443A card type)
 uint32_t cardid = 0;
 bool nfc_init_st = false;
+static bool nfc_init_tried = false;
 
 void nfc_init(void)
 {
@@ -29,6 +31,25 @@ void nfc_init(void)
     }
 }
 
+// The PN532 is brought up on first use instead of at boot; the I2C probe
+// keeps a missing module from costing the getFirmwareVersion() timeout.
+bool nfc_ensure_init(void)
+{
+    if (nfc_init_tried) {
+        return nfc_init_st;
+    }
+    nfc_init_tried = true;
+
+    uint32_t start = micros();
+    Wire.beginTransmission(BOARD_I2C_ADDR_1);
+    if (Wire.endTransmission() == 0) {
+        nfc_init();
+    }
+    boot_trace_lazy("nfc_init", start);
+
+    return nfc_init_st;
+}
+
 bool nfc_is_init(void)
 {
     return nfc_init_st;
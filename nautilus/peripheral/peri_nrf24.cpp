@@ -10,6 +10,15 @@
 #define NRF24L01_MISO 10
 #define NRF24L01_SCK 11
 
+#define NRF24_RX_PIPE_EMPTY     7       // STATUS.RX_P_NO when the RX FIFO is empty
+#define NRF24_MAX_DRAIN         8       // Packets read per wake before yielding the bus
+#define NRF24_MAX_ERRORS        3       // Consecutive bad STATUS reads before re-init
+#define NRF24_RECOVER_BACKOFF_MS 500
+#define NRF24_DEFAULT_FREQ      2400
+
+#define NRF24_RPD_SETTLE_US     170     // Tstby2a (130us) + AGC delay (40us) before RPD is valid
+#define NRF24_SWEEP_BATCH       8       // Channels swept between 1-tick yields
+
 int nrf24_mode = NRF24_MODE_SEND;
 bool nrf24_init_flag = false;
 
@@ -21,11 +30,115 @@ int transmissionState = RADIOLIB_ERR_NONE;
 // Radio interrupt flag
 DECLARE_RADIO_FLAG(transmitted)
 
-bool containsSubstring(const std::string &mainStr, const std::string &subStr)
+// RX ring: nrf24_task produces, the UI consumes via nrf24_read_packet()
+static NRF24Packet *nrf24_ring = NULL;
+static volatile uint32_t nrf24_ring_head = 0;
+static volatile uint32_t nrf24_ring_tail = 0;
+static NRF24Stats nrf24_stats;
+static volatile bool nrf24_rx_active = false;
+static int nrf24_err_count = 0;
+
+// Sweep state: rows are written by nrf24_task, then nrf24_sweep_passes publishes them
+static uint8_t *nrf24_wf_rows = NULL;
+static uint32_t nrf24_sweep_hits[NRF24_CHANNELS];
+static uint32_t nrf24_sweep_samples = 0;
+static uint32_t nrf24_sweep_pass_us = 0;
+static volatile uint32_t nrf24_sweep_passes = 0;
+static volatile bool nrf24_sweep_clear = false;
+static portMUX_TYPE nrf24_sweep_mux = portMUX_INITIALIZER_UNLOCKED;
+
+#if NRF24L01_IQR >= 0
+static volatile uint32_t nrf24_irq_us = 0;
+
+static void IRAM_ATTR nrf24_rx_isr(void)
 {
-    if (subStr.empty())
-        return true;
-    return mainStr.find(subStr) != std::string::npos;
+    BaseType_t woken = pdFALSE;
+    nrf24_irq_us = micros();
+    vTaskNotifyGiveFromISR(nrf24_handle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+#endif
+
+static int nrf24_configure(void)
+{
+    int state = radio24.setFrequency(NRF24_DEFAULT_FREQ);
+    if (state == RADIOLIB_ERR_NONE) {
+        state = radio24.setBitRate(1000);
+    }
+    if (state == RADIOLIB_ERR_NONE) {
+        state = radio24.setOutputPower(0);
+    }
+    return state;
+}
+
+// Caller holds radioLock (or is in setup before other bus users start)
+static int nrf24_apply_mode(int mode)
+{
+    // NOTE: address width in bytes MUST be equal to the
+    //       width set in begin() or setAddressWidth()
+    //       methods (5 by default)
+    byte addr[] = {0x01, 0x23, 0x45, 0x67, 0x89};
+    int state;
+
+    if (mode == NRF24_MODE_SWEEP)
+    {
+        // PRX + PWR_UP, then CE low; nrf24_sweep_channel() pulses CE per sample
+        state = radio24.startReceive();
+        digitalWrite(NRF24L01_CE, LOW);
+        if (state != RADIOLIB_ERR_NONE)
+        {
+            Serial.printf("[NRF24] Sweep startReceive failed: %d\n", state);
+        }
+        return state;
+    }
+
+    // The sweep leaves RF_CH on its last channel
+    state = radio24.setFrequency(NRF24_DEFAULT_FREQ);
+    if (state != RADIOLIB_ERR_NONE)
+    {
+        Serial.printf("[NRF24] setFrequency failed: %d\n", state);
+        return state;
+    }
+
+    if (mode == NRF24_MODE_SEND)
+    {
+        // set transmit address
+        state = radio24.setTransmitPipe(addr);
+        if (state != RADIOLIB_ERR_NONE)
+        {
+            Serial.printf("[NRF24] setTransmitPipe failed: %d\n", state);
+            return state;
+        }
+
+        // set the function that will be called
+        // when packet transmission is finished
+        radio24.setPacketSentAction(transmittedSetFlag);
+
+        // start transmitting the first packet
+        transmissionState = radio24.startTransmit("Hello World!");
+        return RADIOLIB_ERR_NONE;
+    }
+
+    state = radio24.setReceivePipe(0, addr);
+    if (state != RADIOLIB_ERR_NONE)
+    {
+        Serial.printf("[NRF24] setReceivePipe failed: %d\n", state);
+        return state;
+    }
+
+#if NRF24L01_IQR >= 0
+    // set the function that will be called
+    // when new packet is received
+    radio24.setPacketReceivedAction(nrf24_rx_isr);
+#endif
+
+    // start listening
+    state = radio24.startReceive();
+    if (state != RADIOLIB_ERR_NONE)
+    {
+        Serial.printf("[NRF24] startReceive failed: %d\n", state);
+    }
+    return state;
 }
 
 void nrf24_init(void)
@@ -44,17 +157,18 @@ void nrf24_init(void)
         return;
     }
 
-    radio24.setFrequency(2400);
-
-    radio24.setBitRate(1000);
-
-    radio24.setOutputPower(0);
+    nrf24_configure();
 
     // while(1){
     //     radio24.transmitDirect();
     // }
 
-    nrf24_set_mode(nrf24_mode);
+    nrf24_ring = (NRF24Packet *)ps_malloc(NRF24_RX_RING_SIZE * sizeof(NRF24Packet));
+    assert(nrf24_ring);
+    nrf24_wf_rows = (uint8_t *)ps_malloc(NRF24_WATERFALL_ROWS * NRF24_CHANNELS);
+    assert(nrf24_wf_rows);
+
+    nrf24_apply_mode(nrf24_mode);
 }
 
 bool nrf24_is_init(void)
@@ -86,97 +200,205 @@ void nrf24_send(const char *str)
     // RF switch is powered down etc.
     radio24.finishTransmit();
 
-    // wait a second before transmitting again
-    // delay(1000);
-
-    // send another one
-
     // you can transmit C-string or Arduino string up to
     // 32 characters long
-    // String str = "Hello World! #" + String(count++);
     transmissionState = radio24.startTransmit(str);
 
     //
     xSemaphoreGive(radioLock);
 }
 
-void nrf24_recv(void)
+// Re-run begin/config/mode after the module stopped answering. Caller holds radioLock.
+static bool nrf24_recover(void)
 {
-    // check if the previous transmission finished
-    if (xSemaphoreTake(radioLock, portMAX_DELAY) != pdTRUE)
-    {
-        return;
+    nrf24_stats.recoveries++;
+    Serial.println("[NRF24] Module not responding, re-initializing");
+
+    int state = radio24.begin();
+    if (state == RADIOLIB_ERR_NONE) {
+        state = nrf24_configure();
+    }
+    if (state == RADIOLIB_ERR_NONE) {
+        state = nrf24_apply_mode(nrf24_mode);
     }
+    if (state != RADIOLIB_ERR_NONE) {
+        Serial.printf("[NRF24] Re-init failed: %d\n", state);
+        return false;
+    }
+    return true;
+}
 
-    String str;
-    int state = radio24.readData(str);
+// Empty the RX FIFO into the ring without leaving RX mode (CE stays high).
+// RadioLib's readData() drops to standby and startReceive() flushes the FIFO,
+// so the payload is pulled with the low-level accessors instead.
+static bool nrf24_drain_rx(void)
+{
+    Module *mod = radio24.getMod();
+    static uint8_t discard[NRF24_MAX_PAYLOAD];
+    bool ok = true;
 
-    // you can also read received data as byte array
-    /*
-      byte byteArr[8];
-      int numBytes = radio24.getPacketLength();
-      int state = radio24.readData(byteArr, numBytes);
-    */
+    if (xSemaphoreTake(radioLock, portMAX_DELAY) != pdTRUE) {
+        return false;
+    }
 
-    if (state == RADIOLIB_ERR_NONE)
-    {
-        if (containsSubstring(str.c_str(), "Hello World! #"))
-        {
-            // packet was successfully received
-            // print data of the packet
+    int16_t status = mod->SPIgetRegValue(RADIOLIB_NRF24_REG_STATUS);
+
+    // Bit 7 of STATUS always reads 0; anything else means MISO is floating
+    if (status < 0 || (status & 0x80)) {
+        nrf24_stats.errors++;
+        if (++nrf24_err_count >= NRF24_MAX_ERRORS) {
+            nrf24_err_count = 0;
+            ok = nrf24_recover();
         }
+        xSemaphoreGive(radioLock);
+        return ok;
     }
-    else
-    {
-        // some other error occurred
+    nrf24_err_count = 0;
+
+    uint8_t pipe = (status >> 1) & 0x07;
+    if (pipe != NRF24_RX_PIPE_EMPTY &&
+        (mod->SPIgetRegValue(RADIOLIB_NRF24_REG_FIFO_STATUS) & RADIOLIB_NRF24_RX_FIFO_FULL_FLAG)) {
+        // All three FIFO slots were taken; anything that arrived meanwhile was lost
+        nrf24_stats.fifo_full++;
     }
 
-    // put module back to listen mode
-    radio24.startReceive();
+#if NRF24L01_IQR >= 0
+    uint32_t t_us = nrf24_irq_us ? nrf24_irq_us : micros();
+    nrf24_irq_us = 0;
+#else
+    uint32_t t_us = micros();
+#endif
+
+    for (int n = 0; pipe != NRF24_RX_PIPE_EMPTY && n < NRF24_MAX_DRAIN; n++) {
+        uint8_t len = radio24.getPacketLength();
+
+        // Datasheet: a width above 32 means a corrupt payload; flush the FIFO
+        if (len == 0 || len > NRF24_MAX_PAYLOAD) {
+            radio24.SPItransfer(RADIOLIB_NRF24_CMD_FLUSH_RX);
+            nrf24_stats.bad_len++;
+        } else {
+            uint32_t head = nrf24_ring_head;
+            if (head - nrf24_ring_tail >= NRF24_RX_RING_SIZE) {
+                radio24.SPIreadRxPayload(discard, len);
+                nrf24_stats.ring_drops++;
+            } else {
+                NRF24Packet *pkt = &nrf24_ring[head % NRF24_RX_RING_SIZE];
+                radio24.SPIreadRxPayload(pkt->data, len);
+                pkt->t_us = t_us;
+                pkt->pipe = pipe;
+                pkt->len = len;
+                __sync_synchronize();
+                nrf24_ring_head = head + 1;
+                nrf24_stats.received++;
+            }
+        }
+
+        // Write-1-to-clear RX_DR; plain write since read-back verification would fail
+        mod->SPIwriteRegister(RADIOLIB_NRF24_REG_STATUS, RADIOLIB_NRF24_RX_DR);
+        pipe = (mod->SPIgetRegValue(RADIOLIB_NRF24_REG_STATUS) >> 1) & 0x07;
+    }
 
-    //
     xSemaphoreGive(radioLock);
+    return true;
+}
+
+// Sample RPD on one channel. The lock is held for a single channel
+// (~NRF24_SWEEP_SAMPLES * 180us) so the display flush can interleave.
+static uint8_t nrf24_sweep_channel(uint8_t ch)
+{
+    Module *mod = radio24.getMod();
+    uint8_t hits = 0;
+
+    if (xSemaphoreTake(radioLock, portMAX_DELAY) != pdTRUE) {
+        return 0;
+    }
+
+    mod->SPIwriteRegister(RADIOLIB_NRF24_REG_RF_CH, ch);
+    for (int s = 0; s < NRF24_SWEEP_SAMPLES; s++) {
+        // RPD latches the carrier level at the end of each CE-high window
+        digitalWrite(NRF24L01_CE, HIGH);
+        delayMicroseconds(NRF24_RPD_SETTLE_US);
+        digitalWrite(NRF24L01_CE, LOW);
+        if (mod->SPIreadRegister(RADIOLIB_NRF24_REG_RPD) & 0x01) {
+            hits++;
+        }
+    }
+
+    xSemaphoreGive(radioLock);
+    return hits;
+}
+
+static void nrf24_sweep_pass(void)
+{
+    uint32_t start = micros();
+    uint32_t pass = nrf24_sweep_passes;
+    uint8_t *row = &nrf24_wf_rows[(pass % NRF24_WATERFALL_ROWS) * NRF24_CHANNELS];
+
+    if (nrf24_sweep_clear) {
+        portENTER_CRITICAL(&nrf24_sweep_mux);
+        memset(nrf24_sweep_hits, 0, sizeof(nrf24_sweep_hits));
+        nrf24_sweep_samples = 0;
+        portEXIT_CRITICAL(&nrf24_sweep_mux);
+        nrf24_sweep_clear = false;
+    }
+
+    for (uint8_t ch = 0; ch < NRF24_CHANNELS; ch++) {
+        if (nrf24_mode != NRF24_MODE_SWEEP || !nrf24_rx_active) {
+            return;     // Abandon the partial pass; it is never published
+        }
+        row[ch] = nrf24_sweep_channel(ch);
+
+        // delayMicroseconds() spins, so give lower-priority tasks the core now and then
+        if ((ch % NRF24_SWEEP_BATCH) == NRF24_SWEEP_BATCH - 1) {
+            vTaskDelay(1);
+        }
+    }
+
+    portENTER_CRITICAL(&nrf24_sweep_mux);
+    for (int ch = 0; ch < NRF24_CHANNELS; ch++) {
+        nrf24_sweep_hits[ch] += row[ch];
+    }
+    nrf24_sweep_samples += NRF24_SWEEP_SAMPLES;
+    nrf24_sweep_pass_us = micros() - start;
+    nrf24_sweep_passes = pass + 1;
+    portEXIT_CRITICAL(&nrf24_sweep_mux);
 }
 
 void nrf24_task(void *param)
 {
-    vTaskSuspend(nrf24_handle);
     while (1)
     {
-        if(nrf24_is_init()) {
-            if (nrf24_mode == NRF24_MODE_RECV)
-            {
-                // you can read received data as an Arduino String
-                String str;
-                int state = radio24.readData(str);
-
-                // you can also read received data as byte array
-                /*
-                byte byteArr[8];
-                int numBytes = radio24.getPacketLength();
-                int state = radio24.readData(byteArr, numBytes);
-                */
-
-                if (state == RADIOLIB_ERR_NONE)
-                {
-                    if (containsSubstring(str.c_str(), "Hello World! #"))
-                    {
-                        // packet was successfully received
-                        // print data of the packet
-
-                        ws2812_pos_demo1();
-                    }
-                }
-                else
-                {
-                    // some other error occurred
-                }
-
-                // put module back to listen mode
-                radio24.startReceive();
-            }
+        if (!nrf24_rx_active || !nrf24_is_init() ||
+            (nrf24_mode != NRF24_MODE_RECV && nrf24_mode != NRF24_MODE_SWEEP))
+        {
+            // Parked until nrf24_rx_enable() / nrf24_set_mode() wakes us
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        if (nrf24_mode == NRF24_MODE_SWEEP)
+        {
+            TickType_t start = xTaskGetTickCount();
+            nrf24_sweep_pass();
+            // Pace to NRF24_SWEEP_PERIOD_MS; a mode change or exit9 wakes us early
+            TickType_t spent = xTaskGetTickCount() - start;
+            TickType_t period = pdMS_TO_TICKS(NRF24_SWEEP_PERIOD_MS);
+            ulTaskNotifyTake(pdTRUE, spent < period ? period - spent : 1);
+            continue;
+        }
+
+#if NRF24L01_IQR >= 0
+        // IRQ notification; the timeout only guards against a missed edge
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+#else
+        // IRQ line is not wired on this board: poll STATUS once per tick
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(NRF24_POLL_MS));
+#endif
+
+        if (!nrf24_drain_rx())
+        {
+            vTaskDelay(pdMS_TO_TICKS(NRF24_RECOVER_BACKOFF_MS));
         }
-        vTaskDelay(pdMS_TO_TICKS(500));
     }
 }
 
@@ -185,64 +407,72 @@ int nrf24_get_mode(void)
     return nrf24_mode;
 }
 
-void nrf24_set_mode(int mode)
+int nrf24_set_mode(int mode)
 {
-    nrf24_mode = mode;
-    if (nrf24_mode == NRF24_MODE_SEND)
+    if (xSemaphoreTake(radioLock, portMAX_DELAY) != pdTRUE)
     {
-        // set transmit address
-        // NOTE: address width in bytes MUST be equal to the
-        //       width set in begin() or setAddressWidth()
-        //       methods (5 by default)
-        byte addr[] = {0x01, 0x23, 0x45, 0x67, 0x89};
-        int state = radio24.setTransmitPipe(addr);
-        if (state == RADIOLIB_ERR_NONE)
-        {
-        }
-        else
-        {
-            while (true)
-            {
-                delay(10);
-            }
-        }
+        return RADIOLIB_ERR_UNKNOWN;
+    }
+    nrf24_mode = mode;
+    int state = nrf24_apply_mode(mode);
+    xSemaphoreGive(radioLock);
 
-        // set the function that will be called
-        // when packet transmission is finished
-        radio24.setPacketSentAction(transmittedSetFlag);
+    if (nrf24_handle) {
+        xTaskNotifyGive(nrf24_handle);
+    }
+    return state;
+}
 
-        // start transmitting the first packet
+void nrf24_rx_enable(bool en)
+{
+    nrf24_rx_active = en;
+    if (nrf24_handle) {
+        xTaskNotifyGive(nrf24_handle);
+    }
+}
 
-        // you can transmit C-string or Arduino string up to
-        // 256 characters long
-        transmissionState = radio24.startTransmit("Hello World!");
+bool nrf24_read_packet(NRF24Packet *pkt)
+{
+    uint32_t tail = nrf24_ring_tail;
+    if (tail == nrf24_ring_head) {
+        return false;
     }
-    else
-    {
-        byte addr[] = {0x01, 0x23, 0x45, 0x67, 0x89};
-        int state = radio24.setReceivePipe(0, addr);
-        if (state == RADIOLIB_ERR_NONE)
-        {
-        }
-        else
-        {
-            while (true)
-                ;
-        }
+    __sync_synchronize();
+    *pkt = nrf24_ring[tail % NRF24_RX_RING_SIZE];
+    nrf24_ring_tail = tail + 1;
+    return true;
+}
 
-        // set the function that will be called
-        // when new packet is received
-        radio24.setPacketReceivedAction(transmittedSetFlag);
+void nrf24_get_stats(NRF24Stats *st)
+{
+    *st = nrf24_stats;
+}
 
-        // start listening
-        state = radio24.startReceive();
-        if (state == RADIOLIB_ERR_NONE)
-        {
-        }
-        else
-        {
-            while (true)
-                ;
-        }
+void nrf24_sweep_reset(void)
+{
+    nrf24_sweep_clear = true;
+}
+
+uint32_t nrf24_sweep_get_hist(uint32_t *hits, uint32_t *samples, uint32_t *pass_us)
+{
+    // Any output may be NULL when the caller only wants the pass count
+    portENTER_CRITICAL(&nrf24_sweep_mux);
+    if (hits) memcpy(hits, nrf24_sweep_hits, sizeof(nrf24_sweep_hits));
+    if (samples) *samples = nrf24_sweep_samples;
+    if (pass_us) *pass_us = nrf24_sweep_pass_us;
+    uint32_t passes = nrf24_sweep_passes;
+    portEXIT_CRITICAL(&nrf24_sweep_mux);
+    return passes;
+}
+
+bool nrf24_sweep_get_row(uint32_t pass, uint8_t *row)
+{
+    uint32_t done = nrf24_sweep_passes;
+
+    // Keep one slot of margin: the row after `done` is being overwritten right now
+    if (pass == 0 || pass > done || done - pass >= NRF24_WATERFALL_ROWS - 1) {
+        return false;
     }
+    memcpy(row, &nrf24_wf_rows[((pass - 1) % NRF24_WATERFALL_ROWS) * NRF24_CHANNELS], NRF24_CHANNELS);
+    return true;
 }
@@ -0,0 +1,215 @@
+
+#include "peripheral.h"
+
+// BQ25896: REG00..REG14 in one auto-incrementing read
+#define PPM_REG_FIRST       0x00
+#define PPM_REG_COUNT       0x15
+
+// BQ27220: standard commands Temperature (0x06) .. StateOfHealth (0x2E) in one read
+#define GAUGE_REG_FIRST     CommandTemperature
+#define GAUGE_REG_COUNT     (CommandStateOfHealth + 2 - CommandTemperature)
+
+static TaskHandle_t power_handle = NULL;
+static volatile uint32_t power_period_ms = POWER_POLL_MS;
+
+// Snapshot: single writer (power_task), readers retry on an odd or changed sequence
+static PowerSnapshot power_snap;
+static volatile uint32_t power_snap_seq = 0;
+
+static PowerSample *power_hist = NULL;
+static uint32_t power_hist_count = 0;       // Samples pushed since boot
+static uint32_t power_hist_last_ms = 0;
+static portMUX_TYPE power_hist_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static inline uint16_t gauge_u16(const uint8_t *buf, uint8_t reg)
+{
+    return ((uint16_t)buf[reg - GAUGE_REG_FIRST + 1] << 8) | buf[reg - GAUGE_REG_FIRST];
+}
+
+static void power_read_ppm(PowerSnapshot *s)
+{
+    uint8_t r[PPM_REG_COUNT];
+
+    s->ppm_ok = (PPM.readRegister(PPM_REG_FIRST, r, PPM_REG_COUNT) != -1);
+    if (!s->ppm_ok) {
+        return;
+    }
+
+    // Same decoding as the XPowersLib getters, from one transaction instead of ~10
+    uint8_t vreg = (r[0x06] & 0xFC) >> 2;
+    s->chg_target_mv = vreg > 0x30 ? POWERS_BQ25896_FAST_CHG_VOL_MAX
+                                   : vreg * POWERS_BQ25896_CHG_VOL_STEP + POWERS_BQ25896_CHG_VOL_BASE;
+    s->precharge_ma = POWERS_BQ25896_PRE_CHG_CUR_STEP + ((r[0x05] >> 4) * POWERS_BQ25896_PRE_CHG_CUR_STEP);
+    s->bus_status = (r[0x0B] >> 5) & 0x07;
+    s->chg_status = (r[0x0B] >> 3) & 0x03;
+
+    uint8_t vbat = POWERS_BQ25896_VBAT_MASK_VAL(r[0x0E]);
+    s->vbat_mv = vbat ? vbat * POWERS_BQ25896_VBAT_VOL_STEP + POWERS_BQ25896_VBAT_BASE_VAL : 0;
+    uint8_t vsys = POWERS_BQ25896_VSYS_MASK_VAL(r[0x0F]);
+    s->vsys_mv = vsys ? vsys * POWERS_BQ25896_VSYS_VOL_STEP + POWERS_BQ25896_VSYS_BASE_VAL : 0;
+
+    s->vbus_in = (r[0x11] & 0x80) != 0;
+    s->vbus_mv = s->vbus_in ? POWERS_BQ25896_VBUS_MASK_VAL(r[0x11]) * POWERS_BQ25896_VBUS_VOL_STEP +
+                              POWERS_BQ25896_VBUS_BASE_VAL : 0;
+
+    // ICHGR keeps its last value after unplug, so only trust it while charging
+    s->ichg_ma = (s->chg_status != PowersBQ25896::CHARGE_STATE_NO_CHARGE) ?
+                 (r[0x12] & 0x7F) * POWERS_BQ25896_CHG_STEP_VAL : 0;
+}
+
+static void power_read_gauge(PowerSnapshot *s)
+{
+    uint8_t r[GAUGE_REG_COUNT];
+
+    s->gauge_ok = bq27220.i2cReadBytes(GAUGE_REG_FIRST, r, GAUGE_REG_COUNT);
+    if (!s->gauge_ok) {
+        return;
+    }
+
+    s->temperature_dk = gauge_u16(r, CommandTemperature);
+    s->voltage_mv = gauge_u16(r, CommandVoltage);
+    s->batt_status = gauge_u16(r, CommandBatteryStatus);
+    s->current_ma = (int16_t)gauge_u16(r, CommandCurrent);
+    s->remaining_mah = gauge_u16(r, CommandRemainingCapacity);
+    s->full_mah = gauge_u16(r, CommandFullChargeCapacity);
+    s->avg_current_ma = (int16_t)gauge_u16(r, CommandAverageCurrent);
+    s->tte_min = gauge_u16(r, CommandTimeToEmpty);
+    s->ttf_min = gauge_u16(r, CommandTimeToFull);
+    s->soc = gauge_u16(r, CommandStateOfCharge);
+    s->soh = gauge_u16(r, CommandStateOfHealth);
+
+    // Same rules as BQ27220::getIsCharging() / getCharingFinish()
+    BQ27220BatteryStatus st;
+    st.full = s->batt_status;
+    s->charging = !st.reg.DSG;
+    s->charge_done = !(st.reg.DSG || s->current_ma);
+}
+
+static void power_history_push(const PowerSnapshot *s)
+{
+    if (!power_hist || !s->gauge_ok) {
+        return;
+    }
+
+    PowerSample smp;
+    smp.t_s = s->updated_ms / 1000;
+    smp.voltage_mv = s->voltage_mv;
+    smp.current_ma = s->current_ma;
+    smp.soc = (uint8_t)min(s->soc, (uint16_t)100);
+    smp.flags = (s->vbus_in ? POWER_SAMPLE_VBUS : 0) | (s->charging ? POWER_SAMPLE_CHARGING : 0);
+
+    portENTER_CRITICAL(&power_hist_mux);
+    power_hist[power_hist_count % POWER_HISTORY_LEN] = smp;
+    power_hist_count++;
+    portEXIT_CRITICAL(&power_hist_mux);
+}
+
+static void power_poll(void)
+{
+    PowerSnapshot s;
+
+    // Read into a local first so the I2C time is outside the publish window
+    memset(&s, 0, sizeof(s));
+    power_read_ppm(&s);
+    power_read_gauge(&s);
+    s.updated_ms = millis();
+
+    power_snap_seq++;
+    __sync_synchronize();
+    s.version = power_snap.version + 1;
+    power_snap = s;
+    __sync_synchronize();
+    power_snap_seq++;
+
+    if (power_hist_count == 0 || s.updated_ms - power_hist_last_ms >= POWER_HISTORY_MS) {
+        power_hist_last_ms = s.updated_ms;
+        power_history_push(&s);
+    }
+}
+
+static void power_task(void *param)
+{
+    while (1) {
+        // power_set_rate() notifies so a faster rate takes effect immediately
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(power_period_ms));
+        power_poll();
+    }
+}
+
+void power_service_init(void)
+{
+    power_hist = (PowerSample *)ps_malloc(POWER_HISTORY_LEN * sizeof(PowerSample));
+    if (!power_hist) {
+        Serial.println("[POWER] No PSRAM for history ring");
+    }
+
+    // First snapshot synchronously so the status bar has data before the task runs
+    power_poll();
+
+    xTaskCreatePinnedToCore(power_task, "power_task", POWER_TASK_STACK, NULL,
+                            POWER_TASK_PRIORITY, &power_handle, POWER_TASK_CORE);
+}
+
+void power_set_rate(uint32_t period_ms)
+{
+    power_period_ms = period_ms ? period_ms : POWER_POLL_MS;
+    if (power_handle) {
+        xTaskNotifyGive(power_handle);
+    }
+}
+
+bool power_get(PowerSnapshot *out)
+{
+    for (int tries = 0; tries < 8; tries++) {
+        uint32_t seq = power_snap_seq;
+        if (seq & 1) {
+            continue;
+        }
+        __sync_synchronize();
+        *out = power_snap;
+        __sync_synchronize();
+        if (seq == power_snap_seq) {
+            return out->version != 0;
+        }
+    }
+    return false;
+}
+
+int power_history_get(PowerSample *out, int max)
+{
+    if (!power_hist || max <= 0) {
+        return 0;
+    }
+
+    portENTER_CRITICAL(&power_hist_mux);
+    uint32_t count = power_hist_count;
+    uint32_t n = min(count, (uint32_t)min(max, POWER_HISTORY_LEN));
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = power_hist[(count - n + i) % POWER_HISTORY_LEN];
+    }
+    portEXIT_CRITICAL(&power_hist_mux);
+
+    return (int)n;
+}
+
+const char *power_chg_status_str(uint8_t chg_status)
+{
+    switch (chg_status) {
+        case PowersBQ25896::CHARGE_STATE_NO_CHARGE:   return "Not Charging";
+        case PowersBQ25896::CHARGE_STATE_PRE_CHARGE:  return "Pre-charge";
+        case PowersBQ25896::CHARGE_STATE_FAST_CHARGE: return "Fast Charging";
+        case PowersBQ25896::CHARGE_STATE_DONE:        return "Charge Termination Done";
+        default:                                      return "Unknown";
+    }
+}
+
+const char *power_bus_status_str(uint8_t bus_status)
+{
+    switch (bus_status) {
+        case PowersBQ25896::BUS_STATE_NOINPUT: return "No input";
+        case PowersBQ25896::BUS_STATE_USB_SDP: return "USB Host SDP";
+        case PowersBQ25896::BUS_STATE_ADAPTER: return "Adapter";
+        case PowersBQ25896::BUS_STATE_OTG:     return "OTG";
+        default:                               return "Unknown";
+    }
+}
@@ -1,4 +1,5 @@
 #include "peripheral.h"
+#include "rf_library.h"
 
 bool sd_init_flag = false;
 uint32_t sd_sum_Mbyte = 0;
@@ -33,6 +34,7 @@ void sd_init(void)
 
 
     sd_init_flag = true;
+    rf_library_refresh();
 }
 
 bool sd_is_valid(void)
@@ -86,11 +88,13 @@ bool sd_mount(void)
 
 
     sd_init_flag = true;
+    rf_library_refresh();
     return true;
 }
 
 void sd_unmount(void)
 {
+    rf_library_invalidate();  // Index belongs to the card that was mounted
     if(sd_init_flag) {
         SD.end();
     }
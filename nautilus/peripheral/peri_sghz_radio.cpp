@@ -2,6 +2,7 @@
 #include "peripheral.h"
 #include "../lvgl_port/port_disp.h"
 #include "radio_flags.h"
+#include "../boot_trace.h"
 
 float sghz_freq = 315.0;
 
@@ -10,6 +11,7 @@ int sghz_mode = SGHZ_MODE_SEND;
 int sghz_recv_success = 0;
 int sghz_recv_rssi = 0;
 int sghz_init_st = false;
+static bool sghz_init_tried = false;
 String sghz_recv_str;
 
 // Radio interrupt flags
@@ -18,7 +20,14 @@ DECLARE_RADIO_FLAG(transmitted)
 static int transmissionState = RADIOLIB_ERR_NONE;
 
 
-void sghz_init(void)
+static bool sghz_init_fail(const char *step, int state)
+{
+    Serial.printf("[RF] CC1101 %s failed (%d)\n", step, state);
+    return false;
+}
+
+// Caller holds radioLock
+static bool sghz_init_radio(void)
 {
     pinMode(BOARD_SGHZ_SW1, OUTPUT);
     pinMode(BOARD_SGHZ_SW0, OUTPUT);
@@ -30,42 +39,44 @@ void sghz_init(void)
     SPI.begin(BOARD_SPI_SCK, BOARD_SPI_MISO, BOARD_SPI_MOSI);
 
     int state = radio.begin(sghz_freq);
-    if (state == RADIOLIB_ERR_NONE) {
-        sghz_init_st = true;
-    } else {
-        sghz_init_st = false;
-        return;
+    if (state != RADIOLIB_ERR_NONE) {
+        return sghz_init_fail("begin", state);
     }
 
-    if (radio.setFrequency(sghz_freq) == RADIOLIB_ERR_INVALID_FREQUENCY) {
-        while (true);
+    state = radio.setFrequency(sghz_freq);
+    if (state == RADIOLIB_ERR_INVALID_FREQUENCY) {
+        return sghz_init_fail("setFrequency", state);
     }
 
-    radio.setOOK(true);
-    if (state == RADIOLIB_ERR_INVALID_BIT_RATE) {
-        while (true);
+    state = radio.setOOK(true);
+    if (state != RADIOLIB_ERR_NONE) {
+        return sghz_init_fail("setOOK", state);
     }
 
     state = radio.setBitRate(1.2);
     if (state == RADIOLIB_ERR_INVALID_BIT_RATE) {
-        while (true);
+        return sghz_init_fail("setBitRate", state);
     }
 
-    if (radio.setRxBandwidth(58.0) == RADIOLIB_ERR_INVALID_RX_BANDWIDTH) {
-        while (true);
+    state = radio.setRxBandwidth(58.0);
+    if (state == RADIOLIB_ERR_INVALID_RX_BANDWIDTH) {
+        return sghz_init_fail("setRxBandwidth", state);
     }
-    if (radio.setFrequencyDeviation(5.2) == RADIOLIB_ERR_INVALID_FREQUENCY_DEVIATION) {
-        while (true);
+    state = radio.setFrequencyDeviation(5.2);
+    if (state == RADIOLIB_ERR_INVALID_FREQUENCY_DEVIATION) {
+        return sghz_init_fail("setFrequencyDeviation", state);
     }
 
     // set output power to 5 dBm
-    if (radio.setOutputPower(10) == RADIOLIB_ERR_INVALID_OUTPUT_POWER) {
-        while (true);
+    state = radio.setOutputPower(10);
+    if (state == RADIOLIB_ERR_INVALID_OUTPUT_POWER) {
+        return sghz_init_fail("setOutputPower", state);
     }
 
     // 2 bytes can be set as sync word
-    if (radio.setSyncWord(0x01, 0x23) == RADIOLIB_ERR_INVALID_SYNC_WORD) {
-        while (true);
+    state = radio.setSyncWord(0x01, 0x23);
+    if (state == RADIOLIB_ERR_INVALID_SYNC_WORD) {
+        return sghz_init_fail("setSyncWord", state);
     }
 
     if(sghz_mode == SGHZ_MODE_SEND){     // send
@@ -79,11 +90,23 @@ void sghz_init(void)
         radio.setPacketReceivedAction(receivedSetFlag);
         // start listening for packets
         state = radio.startReceive();
-        if (state == RADIOLIB_ERR_NONE) {
-        } else {
-            while (true);
+        if (state != RADIOLIB_ERR_NONE) {
+            return sghz_init_fail("startReceive", state);
         }
     }
+    return true;
+}
+
+// SPI is re-begun here on the bus shared with the display and SD card, so the
+// whole bring-up runs under radioLock
+bool sghz_init(void)
+{
+    if (xSemaphoreTake(radioLock, portMAX_DELAY) != pdTRUE) {
+        return false;
+    }
+    sghz_init_st = sghz_init_radio();
+    xSemaphoreGive(radioLock);
+    return sghz_init_st;
 }
 
 void sghz_mode_sw(int m)
@@ -92,9 +115,9 @@ void sghz_mode_sw(int m)
         radio.setPacketReceivedAction(receivedSetFlag);
         // start listening for packets
         int state = radio.startReceive();
-        if (state == RADIOLIB_ERR_NONE) {
-        } else {
-            while (true);
+        if (state != RADIOLIB_ERR_NONE) {
+            Serial.printf("[RF] CC1101 startReceive failed (%d)\n", state);
+            return;
         }
     } else if(m == SGHZ_MODE_SEND) {
         radio.setPacketSentAction(transmittedSetFlag);
@@ -107,6 +130,21 @@ int sghz_get_mode(void)
     return sghz_mode;
 }
 
+// The CC1101 is brought up on first use instead of at boot
+bool sghz_ensure_init(void)
+{
+    if (sghz_init_tried) {
+        return sghz_init_st;
+    }
+    sghz_init_tried = true;
+
+    uint32_t start = micros();
+    sghz_init();
+    boot_trace_lazy("sghz_init", start);
+
+    return sghz_init_st;
+}
+
 bool sghz_is_init(void)
 {
     return sghz_init_st;
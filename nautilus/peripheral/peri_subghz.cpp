@@ -9,6 +9,12 @@
 #include <RCSwitch.h>  // For protocol decoding
 #include "lvgl.h"  // For lv_timer_handler() to keep UI responsive during scanning
 #include "subghz/subghz_protocols.h"  // Protocol framework
+#include "subghz/subghz_edges.h"  // Packed, glitch-filtered decoder input
+#include "subghz/subghz_binraw.h"  // RAW -> BinRAW on save
+#include "peri_config.h"
+#include "rf_library.h"  // Fingerprint index of /rf
+#include "rf_packet.h"  // Packet-engine capture shares GDO2
+#include "rf_hopper.h"  // Multi-frequency listen owns the radio while active
 
 // Global state
 bool subghz_initialized = false;
@@ -17,18 +23,38 @@ RawRecordingStatus subghz_status;
 // Internal state
 static RawRecording *current_recording = nullptr;
 static RingbufHandle_t rmt_ringbuf = nullptr;
+
+// RMT frame copied off the ring buffer by the drain task
+typedef struct {
+    rmt_item32_t *items;    // malloc'd; ownership passes to whoever dequeues it
+    size_t size;            // Bytes
+    int64_t rx_us;          // esp_timer time the drain task picked the frame up
+    bool timed;             // Picked up as RMT completed it, not from a backlog
+} SubGhzRxFrame;
+
+static QueueHandle_t subghz_rx_queue = nullptr;
+static TaskHandle_t subghz_rx_task = nullptr;
+static volatile bool subghz_rx_task_stop = false;
 static bool rmt_rx_initialized = false;
 static bool rmt_tx_initialized = false;
 static volatile bool capturing = false;
 
 // Forward declaration for scan/record RMT capture (defined later with scan/record state)
 static RawRecording *scan_rmt_recording = nullptr;
+static uint16_t *subghz_edge_arena = nullptr;   // SUBGHZ_EDGE_ARENA_WORDS, see subghz_try_decode_recording()
 
 // Track recently saved RAW files for cleanup when protocol is detected
 static std::vector<String> recent_raw_files;
 static unsigned long last_raw_save_time = 0;
 static const unsigned long RAW_CLEANUP_TIMEOUT_MS = 5000;  // 5 seconds
 
+// Library file the last save matched, empty if the capture was new
+static String subghz_last_duplicate;
+
+// Peak RSSI/LQI since the last burst was stored, attached to the next burst
+static int burst_peak_rssi = -128;
+static uint8_t burst_peak_lqi = 0;
+
 /**
  * Convert preset number to Flipper Zero preset name
  */
@@ -57,6 +83,10 @@ void subghz_init(void) {
         return;
     }
 
+    // CC1101 is no longer probed at boot; RadioLib's module must be up
+    // before the raw TX path touches its registers
+    sghz_ensure_init();
+
 
     // Initialize protocol system
     subghz_protocols_init();
@@ -98,6 +128,9 @@ void subghz_deinit(void) {
         scan_rmt_recording = nullptr;
     }
 
+    free(subghz_edge_arena);
+    subghz_edge_arena = nullptr;
+
     // Deinitialize protocol system
     subghz_protocols_deinit();
 
@@ -111,6 +144,56 @@ bool subghz_is_init(void) {
     return subghz_initialized;
 }
 
+/**
+ * Move RMT frames from the ring buffer to subghz_rx_queue, stamping each one.
+ * The ring receive wakes this task as soon as the driver hands a frame over
+ * (RMT_RX_IDLE_US after its last edge). A frame already waiting when the
+ * previous one was done queued up while this task was busy, so its stamp is
+ * only an upper bound and it is marked untimed.
+ */
+static void subghz_rx_drain_task(void *param) {
+    (void)param;
+
+    while (!subghz_rx_task_stop) {
+        size_t rx_size = 0;
+        rmt_item32_t *items = (rmt_item32_t*)xRingbufferReceive(rmt_ringbuf, &rx_size, 0);
+        bool timed = (items == nullptr);
+        if (items == nullptr) {
+            items = (rmt_item32_t*)xRingbufferReceive(rmt_ringbuf, &rx_size, pdMS_TO_TICKS(50));
+            if (items == nullptr) {
+                continue;
+            }
+        }
+
+        SubGhzRxFrame frame;
+        frame.rx_us = esp_timer_get_time();
+        frame.timed = timed;
+        frame.size = rx_size;
+        frame.items = (rmt_item32_t*)malloc(rx_size);
+        if (frame.items != nullptr) {
+            memcpy(frame.items, items, rx_size);
+            // Nobody consuming: drop rather than stall the ring buffer
+            if (xQueueSend(subghz_rx_queue, &frame, 0) != pdTRUE) {
+                free(frame.items);
+            }
+        }
+        vRingbufferReturnItem(rmt_ringbuf, (void*)items);
+    }
+
+    subghz_rx_task = nullptr;
+    vTaskDelete(NULL);
+}
+
+/**
+ * Drop frames left over from a previous capture
+ */
+static void subghz_rx_flush(void) {
+    SubGhzRxFrame frame;
+    while (subghz_rx_queue != nullptr && xQueueReceive(subghz_rx_queue, &frame, 0) == pdTRUE) {
+        free(frame.items);
+    }
+}
+
 /**
  * Initialize RMT for receive (capture)
  */
@@ -132,7 +215,7 @@ bool subghz_rmt_rx_init(void) {
     rmt_rx_config.clk_div = RMT_CLK_DIV;
     rmt_rx_config.mem_block_num = 4;
     rmt_rx_config.flags = 0;
-    rmt_rx_config.rx_config.idle_threshold = 12 * RMT_1MS_TICKS;
+    rmt_rx_config.rx_config.idle_threshold = RMT_RX_IDLE_US * RMT_1US_TICKS;
     rmt_rx_config.rx_config.filter_ticks_thresh = 100 * RMT_1US_TICKS;
     rmt_rx_config.rx_config.filter_en = true;
 
@@ -152,6 +235,19 @@ bool subghz_rmt_rx_init(void) {
         return false;
     }
 
+    if (subghz_rx_queue == nullptr) {
+        subghz_rx_queue = xQueueCreate(SUBGHZ_RX_QUEUE_LEN, sizeof(SubGhzRxFrame));
+    }
+    subghz_rx_task_stop = false;
+    if (subghz_rx_queue == nullptr ||
+        xTaskCreatePinnedToCore(subghz_rx_drain_task, "subghz_rx", SUBGHZ_RX_TASK_STACK, NULL,
+                                SUBGHZ_RX_TASK_PRIORITY, &subghz_rx_task, SUBGHZ_RX_TASK_CORE) != pdPASS) {
+        subghz_rx_task = nullptr;
+        rmt_driver_uninstall(RMT_RX_CHANNEL);
+        rmt_ringbuf = nullptr;
+        return false;
+    }
+
     rmt_rx_initialized = true;
     return true;
 }
@@ -194,6 +290,12 @@ bool subghz_rmt_tx_init(void) {
 void subghz_rmt_deinit(void) {
     if (rmt_rx_initialized) {
         rmt_rx_stop(RMT_RX_CHANNEL);
+        // The drain task reads the ring buffer the uninstall frees
+        subghz_rx_task_stop = true;
+        while (subghz_rx_task != nullptr) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+        subghz_rx_flush();
         rmt_driver_uninstall(RMT_RX_CHANNEL);
         rmt_rx_initialized = false;
         rmt_ringbuf = nullptr;
@@ -273,26 +375,70 @@ int subghz_get_rssi(void) {
 }
 
 /**
- * Start RF signal capture
+ * Sample the CC1101 while a burst may be arriving.
+ * The RMT frame is only handed over after RMT_RX_IDLE_US of silence, when the
+ * RSSI register has already fallen back to the noise floor, so the burst's
+ * level has to be caught by sampling during reception and keeping the peak.
  */
-bool subghz_start_capture(float frequency, uint32_t timeout_ms) {
-    if (!subghz_initialized || !rmt_rx_initialized) {
-        return false;
+static void subghz_burst_meter_sample(void) {
+    // SPI is shared with the display and SD card, and captures may be
+    // polled from the hopper task; skip the sample rather than wait
+    if (xSemaphoreTake(radioLock, 0) != pdTRUE) {
+        return;
     }
-
-    if (capturing) {
-        return false;
+    int rssi = ELECHOUSE_cc1101.getRssi();
+    if (rssi > burst_peak_rssi) {
+        burst_peak_rssi = rssi;
+        burst_peak_lqi = ELECHOUSE_cc1101.getLqi();
     }
+    xSemaphoreGive(radioLock);
+}
 
-    if (xSemaphoreTake(radioLock, pdMS_TO_TICKS(1000)) != pdTRUE) {
-        return false;
-    }
+static void subghz_burst_meter_reset(void) {
+    burst_peak_rssi = -128;
+    burst_peak_lqi = 0;
+}
 
-    if (!rf_initModule("rx", frequency)) {
-        xSemaphoreGive(radioLock);
-        return false;
+/**
+ * Add one stamped RMT frame to a recording with its burst metadata; the
+ * recording takes over the frame's buffer
+ */
+static void subghz_append_burst(RawRecording *rec, const SubGhzRxFrame &frame) {
+    const rmt_item32_t *items = frame.items;
+    size_t num_items = frame.size / sizeof(rmt_item32_t);
+
+    RawBurst burst;
+    for (size_t i = 0; i < num_items; i++) {
+        burst.duration_us += RMT_TICKS_TO_US(items[i].duration0) + RMT_TICKS_TO_US(items[i].duration1);
+    }
+    burst.rssi = (int8_t)constrain(burst_peak_rssi, -128, 0);
+    burst.lqi = burst_peak_lqi;
+    burst.timed = frame.timed;
+
+    if (frame.timed) {
+        // The frame ends RMT_RX_IDLE_US after its last edge
+        burst.start_us = frame.rx_us - RMT_RX_IDLE_US - burst.duration_us;
+
+        if (!rec->bursts.empty() && rec->bursts.back().timed) {
+            const RawBurst &prev = rec->bursts.back();
+            int64_t gap = burst.start_us - (prev.start_us + prev.duration_us);
+            // RMT only splits frames on a silence of at least RMT_RX_IDLE_US, so a
+            // shorter figure is drain-task latency, not a short gap
+            burst.gap_us = (uint32_t)constrain(gap, (int64_t)RMT_RX_IDLE_US, (int64_t)UINT32_MAX);
+        }
     }
 
+    rec->codes.push_back(frame.items);
+    rec->codeLengths.push_back(num_items);
+    rec->bursts.push_back(burst);
+    subghz_burst_meter_reset();
+}
+
+/**
+ * Reset status, open a fresh recording and start the RMT receiver.
+ * Caller holds radioLock with the radio already receiving on frequency.
+ */
+static void subghz_capture_begin(float frequency) {
     subghz_status = RawRecordingStatus();
     subghz_status.frequency = frequency;
     subghz_status.recordingStarted = true;
@@ -305,14 +451,56 @@ bool subghz_start_capture(float frequency, uint32_t timeout_ms) {
     current_recording = new RawRecording();
     current_recording->frequency = frequency;
 
+    subghz_burst_meter_reset();
+    subghz_rx_flush();
     rmt_rx_start(RMT_RX_CHANNEL, true);
 
     capturing = true;
+}
+
+/**
+ * Start RF signal capture
+ */
+bool subghz_start_capture(float frequency, uint32_t timeout_ms) {
+    if (!subghz_initialized || !rmt_rx_initialized) {
+        return false;
+    }
+
+    if (capturing || rf_packet_is_active() || rf_hop_is_active()) {
+        return false;
+    }
+
+    if (xSemaphoreTake(radioLock, pdMS_TO_TICKS(1000)) != pdTRUE) {
+        return false;
+    }
+
+    if (!rf_initModule("rx", frequency)) {
+        xSemaphoreGive(radioLock);
+        return false;
+    }
+
+    subghz_capture_begin(frequency);
 
     xSemaphoreGive(radioLock);
     return true;
 }
 
+/**
+ * Start capture on the channel the receiver is already tuned to
+ */
+bool subghz_start_capture_tuned(float frequency) {
+    if (!subghz_initialized || !rmt_rx_initialized) {
+        return false;
+    }
+
+    if (capturing || rf_packet_is_active()) {
+        return false;
+    }
+
+    subghz_capture_begin(frequency);
+    return true;
+}
+
 /**
  * Stop RF signal capture
  */
@@ -338,34 +526,26 @@ bool subghz_is_capturing(void) {
 }
 
 RawRecording* subghz_get_capture(void) {
-    if (!capturing || rmt_ringbuf == nullptr || current_recording == nullptr) {
+    if (!capturing || subghz_rx_queue == nullptr || current_recording == nullptr) {
         return current_recording;
     }
 
-    size_t rx_size = 0;
-    rmt_item32_t *items = (rmt_item32_t*)xRingbufferReceive(
-        rmt_ringbuf,
-        &rx_size,
-        pdMS_TO_TICKS(100)
-    );
-
-    if (items != nullptr && rx_size > 0) {
-        size_t num_items = rx_size / sizeof(rmt_item32_t);
-
-        rmt_item32_t *code = (rmt_item32_t*)malloc(rx_size);
-        if (code != nullptr) {
-            memcpy(code, items, rx_size);
-            current_recording->codes.push_back(code);
-            current_recording->codeLengths.push_back(num_items);
-            current_recording->gaps.push_back(0);
+    // Wait up to 100ms in short slices, sampling RSSI while the burst comes in
+    SubGhzRxFrame frame;
+    bool received = false;
+    for (int slice = 0; slice < 20 && !received; slice++) {
+        subghz_burst_meter_sample();
+        received = xQueueReceive(subghz_rx_queue, &frame, pdMS_TO_TICKS(5)) == pdTRUE;
+    }
 
-            subghz_status.pulseCount += num_items;
-        }
+    if (received) {
+        subghz_status.pulseCount += frame.size / sizeof(rmt_item32_t);
+        subghz_append_burst(current_recording, frame);
 
-        vRingbufferReturnItem(rmt_ringbuf, (void*)items);
-
-        if (millis() - subghz_status.lastRssiUpdate > 100) {
+        if (millis() - subghz_status.lastRssiUpdate > 100 &&
+            xSemaphoreTake(radioLock, 0) == pdTRUE) {
             subghz_status.latestRssi = subghz_get_rssi();
+            xSemaphoreGive(radioLock);
             if (subghz_status.latestRssi > subghz_status.peakRssi) {
                 subghz_status.peakRssi = subghz_status.latestRssi;
             }
@@ -377,6 +557,19 @@ RawRecording* subghz_get_capture(void) {
     return current_recording;
 }
 
+/**
+ * Hand the finished recording to the caller
+ */
+RawRecording* subghz_take_capture(void) {
+    if (capturing) {
+        return nullptr;
+    }
+
+    RawRecording *rec = current_recording;
+    current_recording = nullptr;
+    return rec;
+}
+
 /**
  * Get capture status
  */
@@ -384,11 +577,41 @@ RawRecordingStatus* subghz_get_status(void) {
     return &subghz_status;
 }
 
+/**
+ * Decoder edge arena, allocated on first decode and kept until deinit.
+ * Internal RAM when available, since every decoder walks it once.
+ */
+static uint16_t *subghz_edge_arena_get(void) {
+    if (subghz_edge_arena == nullptr) {
+        size_t bytes = SUBGHZ_EDGE_ARENA_WORDS * sizeof(uint16_t);
+        subghz_edge_arena = (uint16_t*)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (subghz_edge_arena == nullptr) {
+            subghz_edge_arena = (uint16_t*)ps_malloc(bytes);
+        }
+    }
+    return subghz_edge_arena;
+}
+
+static void subghz_push_items(SubGhzEdgeWriter &writer, const rmt_item32_t *items, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        writer.push(items[i].level0 != 0, RMT_TICKS_TO_US(items[i].duration0));
+        writer.push(items[i].level1 != 0, RMT_TICKS_TO_US(items[i].duration1));
+    }
+}
+
 String subghz_try_decode_recording(RawRecording &recording, ProtocolDecodeResult &result) {
     if (recording.codes.empty()) {
         return "";
     }
 
+    uint16_t *arena = subghz_edge_arena_get();
+    if (arena == nullptr) {
+        return "";
+    }
+
+    SubGhzFilterConfig filter_cfg;
+    filter_cfg.glitch_us = g_config.subghz.filter.glitch_us > 0 ? g_config.subghz.filter.glitch_us : 0;
+
     for (size_t seq_idx = 0; seq_idx < recording.codes.size(); seq_idx++) {
         rmt_item32_t *sequence = recording.codes[seq_idx];
         size_t length = recording.codeLengths[seq_idx];
@@ -397,45 +620,20 @@ String subghz_try_decode_recording(RawRecording &recording, ProtocolDecodeResult
             continue;
         }
 
-        std::vector<std::pair<bool, uint32_t>> edges;
-        for (size_t i = 0; i < length; i++) {
-            if (sequence[i].duration0 > 0) {
-                bool level = (sequence[i].level0 != 0);
-                uint32_t duration = RMT_TICKS_TO_US(sequence[i].duration0);
-
-                if (!edges.empty() && edges.back().first == level) {
-                    edges.back().second += duration;
-                } else {
-                    edges.push_back(std::make_pair(level, duration));
-                }
-            }
-
-            if (sequence[i].duration1 > 0) {
-                bool level = (sequence[i].level1 != 0);
-                uint32_t duration = RMT_TICKS_TO_US(sequence[i].duration1);
-
-                if (!edges.empty() && edges.back().first == level) {
-                    edges.back().second += duration;
-                } else {
-                    edges.push_back(std::make_pair(level, duration));
-                }
-            }
-        }
+        SubGhzEdgeWriter edges(arena, SUBGHZ_EDGE_ARENA_WORDS, filter_cfg);
+        subghz_push_items(edges, sequence, length);
 
-        SubGhzProtocol* detected = autoDetectProtocolEdges(edges.data(), edges.size(), result);
+        SubGhzProtocol* detected = autoDetectProtocolEdges(edges.finish(), result);
 
         if (detected != nullptr) {
-            if (!result.extra_data.isEmpty()) {
-            }
             return String(detected->getName());
         }
     }
 
     if (recording.codes.size() >= 2) {
-        std::vector<std::pair<bool, uint32_t>> combined_edges;
+        SubGhzEdgeWriter combined_edges(arena, SUBGHZ_EDGE_ARENA_WORDS, filter_cfg);
         size_t valid_bursts = 0;
         size_t last_valid_burst = 0;
-        int last_level = -1;
 
         for (size_t seq_idx = 0; seq_idx < recording.codes.size(); seq_idx++) {
             rmt_item32_t *sequence = recording.codes[seq_idx];
@@ -453,50 +651,33 @@ String subghz_try_decode_recording(RawRecording &recording, ProtocolDecodeResult
 
             if (valid_bursts > 0) {
                 uint32_t gap_duration = 10000;
-
-                if (!combined_edges.empty() && !combined_edges.back().first) {
-                    combined_edges.back().second += gap_duration;
-                } else {
-                    combined_edges.push_back(std::make_pair(false, gap_duration));
-                }
-            }
-
-            for (size_t i = 0; i < length; i++) {
-                if (sequence[i].duration0 > 0) {
-                    bool level = (sequence[i].level0 != 0);
-                    uint32_t duration = RMT_TICKS_TO_US(sequence[i].duration0);
-
-                    if (!combined_edges.empty() && combined_edges.back().first == level) {
-                        combined_edges.back().second += duration;
-                    } else {
-                        combined_edges.push_back(std::make_pair(level, duration));
+                if (seq_idx < recording.bursts.size() &&
+                    recording.bursts[last_valid_burst].timed && recording.bursts[seq_idx].timed) {
+                    // Measured from the last burst kept, skipping any short ones in between
+                    const RawBurst &prev = recording.bursts[last_valid_burst];
+                    const RawBurst &cur = recording.bursts[seq_idx];
+                    int64_t measured = cur.start_us - (prev.start_us + prev.duration_us);
+                    if (measured > 0) {
+                        gap_duration = (uint32_t)min(measured, (int64_t)SUBGHZ_BURST_GAP_MAX_US);
                     }
-                    last_level = level ? 1 : 0;
                 }
 
-                if (sequence[i].duration1 > 0) {
-                    bool level = (sequence[i].level1 != 0);
-                    uint32_t duration = RMT_TICKS_TO_US(sequence[i].duration1);
-
-                    if (!combined_edges.empty() && combined_edges.back().first == level) {
-                        combined_edges.back().second += duration;
-                    } else {
-                        combined_edges.push_back(std::make_pair(level, duration));
-                    }
-                    last_level = level ? 1 : 0;
-                }
+                // Joins the previous burst's trailing low, if it ended low
+                combined_edges.push(false, gap_duration);
             }
 
+            subghz_push_items(combined_edges, sequence, length);
+
             valid_bursts++;
             last_valid_burst = seq_idx;
         }
 
-        if (valid_bursts >= 1 && combined_edges.size() >= 10) {
-            SubGhzProtocol* detected = autoDetectProtocolEdges(combined_edges.data(), combined_edges.size(), result);
+        SubGhzEdgeSpan combined = combined_edges.finish();
+
+        if (valid_bursts >= 1 && combined.edges >= 10) {
+            SubGhzProtocol* detected = autoDetectProtocolEdges(combined, result);
 
             if (detected != nullptr) {
-                if (!result.extra_data.isEmpty()) {
-                }
                 return String(detected->getName());
             }
         }
@@ -505,11 +686,169 @@ String subghz_try_decode_recording(RawRecording &recording, ProtocolDecodeResult
     return "";
 }
 
+/**
+ * Walk a recording's values in RAW_Data order (positive = high, negative =
+ * low, inter-burst gaps included); stops early when fn returns false
+ */
+template <typename Fn>
+static void subghz_raw_values(const RawRecording &recording, Fn fn) {
+    bool is_first_value = true;
+
+    for (size_t i = 0; i < recording.codes.size(); i++) {
+        size_t count = recording.codeLengths[i];
+
+        for (size_t j = 0; j < count; j++) {
+            const rmt_item32_t &item = recording.codes[i][j];
+
+            if (item.duration0 > 0) {
+                // A leading low is idle time before the first edge
+                if (!(is_first_value && item.level0 == 0)) {
+                    if (!fn(item.level0 ? (int)item.duration0 : -(int)item.duration0)) return;
+                }
+                is_first_value = false;
+            }
+
+            if (item.duration1 > 0) {
+                if (!fn(item.level1 ? (int)item.duration1 : -(int)item.duration1)) return;
+                is_first_value = false;
+            }
+        }
+
+        if (i + 1 < recording.codes.size() && i + 1 < recording.bursts.size() &&
+            recording.bursts[i + 1].gap_us > 0) {
+            if (!fn(-(int)min(recording.bursts[i + 1].gap_us, (uint32_t)SUBGHZ_BURST_GAP_MAX_US))) return;
+        }
+    }
+}
+
+/**
+ * Per-burst metadata as comments, which Flipper-format readers skip.
+ * start_us is relative to the first timed burst; gap_us is the uncapped
+ * measurement. Bursts without a completion time carry neither.
+ */
+static void subghz_write_burst_meta(File &file, const RawRecording &recording) {
+    int64_t t0 = 0;
+    bool have_t0 = false;
+    for (size_t i = 0; i < recording.bursts.size(); i++) {
+        const RawBurst &b = recording.bursts[i];
+        file.printf("# Burst: %u", (unsigned)i);
+        if (b.timed) {
+            if (!have_t0) {
+                t0 = b.start_us;
+                have_t0 = true;
+            }
+            file.printf(" start_us=%lld", (long long)(b.start_us - t0));
+        }
+        if (b.gap_us > 0) {
+            file.printf(" gap_us=%lu", (unsigned long)b.gap_us);
+        }
+        file.printf(" rssi=%d lqi=%u\n", (int)b.rssi, (unsigned)b.lqi);
+    }
+}
+
+/**
+ * Write the recording as a BinRAW key file if it quantizes to a TE grid and
+ * survives re-synthesis; nothing is written otherwise
+ * @return true if the file was written
+ */
+static bool subghz_write_binraw(File &file, const RawRecording &recording, uint8_t preset) {
+#if SUBGHZ_PROTOCOL_BINRAW
+    std::vector<int> values;
+    subghz_raw_values(recording, [&](int v) {
+        values.push_back(v);
+        return true;
+    });
+
+    std::vector<BinRAW_Block> blocks;
+    SubGhzBinRawStats stats = {};
+    bool converted = subghz_binraw_convert(values, blocks, &stats);
+    if (stats.te_us > 0) {
+        Serial.printf("[RF] BinRAW: TE=%luus bias=%ldus %lu values -> %lu bits, err max %luus mean %luus%s\n",
+                      (unsigned long)stats.te_us, (long)stats.bias_us, (unsigned long)values.size(),
+                      (unsigned long)stats.total_bits, (unsigned long)stats.max_err_us,
+                      (unsigned long)stats.mean_err_us, converted ? "" : " (rejected)");
+    }
+    std::vector<int>().swap(values);
+    if (!converted) {
+        return false;
+    }
+
+    BinRAWProtocol binraw;
+    binraw.setBlocks(stats.te_us, blocks);
+
+    file.println("Filetype: Flipper SubGhz Key File");
+    file.println("Version: 1");
+    file.printf("Frequency: %d\n", (int)(recording.frequency * 1000000));
+    file.printf("Preset: %s\n", subghz_preset_to_string(preset));
+    file.println("Lat: nan");
+    file.println("Lon: nan");
+    // Ahead of Protocol:, where the BinRAW field parser starts reading
+    subghz_write_burst_meta(file, recording);
+    return binraw.serializeToFile(file, ProtocolDecodeResult());
+#else
+    (void)file;
+    (void)recording;
+    (void)preset;
+    return false;
+#endif
+}
+
+static String subghz_path_name(const String &filepath) {
+    int slash = filepath.lastIndexOf('/');
+    return (slash >= 0) ? filepath.substring(slash + 1) : filepath;
+}
+
+/**
+ * Look a capture up in the /rf library before keeping it
+ * @return Path of the existing file to report instead of saving, or empty to save
+ */
+static String subghz_library_check(const RfFingerprint &fp, const String &filepath) {
+    if (g_config.subghz.dedup == SUBGHZ_DEDUP_OFF) {
+        return "";
+    }
+
+    const RfLibEntry *dup = rf_library_find_duplicate(&fp);
+    if (dup == nullptr || subghz_path_name(filepath) == dup->name) {
+        return "";
+    }
+
+    subghz_last_duplicate = dup->name;
+    Serial.printf("[RF] capture duplicates %s\n", dup->name);
+    return (g_config.subghz.dedup == SUBGHZ_DEDUP_SKIP) ? String(SUBGHZ_FILE_DIR) + "/" + dup->name : String();
+}
+
+/**
+ * Fingerprint a just-written key file, then index it or (in skip mode) drop
+ * it in favour of an existing duplicate
+ * @return Path the caller should report
+ */
+static String subghz_library_commit_key(const String &filepath) {
+    String name = subghz_path_name(filepath);
+    RfFingerprint fp;
+    if (!rf_library_fingerprint_file(name.c_str(), &fp)) {
+        return filepath;
+    }
+
+    String existing = subghz_library_check(fp, filepath);
+    if (!existing.isEmpty()) {
+        SD.remove(filepath);
+        return existing;
+    }
+    rf_library_add(name.c_str(), &fp);
+    return filepath;
+}
+
+const String &subghz_last_save_duplicate(void) {
+    return subghz_last_duplicate;
+}
+
 String subghz_save_capture(RawRecording &recording, const char *filename, String* out_protocol) {
     if (!sd_is_valid()) {
         return "";
     }
 
+    subghz_last_duplicate = "";
+
     ProtocolDecodeResult decode_result;
     String detected_protocol = subghz_try_decode_recording(recording, decode_result);
     SubGhzProtocol* proto = nullptr;
@@ -577,79 +916,73 @@ String subghz_save_capture(RawRecording &recording, const char *filename, String
                     if (SD.exists(raw_file)) {
                         SD.remove(raw_file);
                     }
+                    rf_library_remove(subghz_path_name(raw_file).c_str());
                 }
                 recent_raw_files.clear();
             }
 
-            return filepath;
+            return subghz_library_commit_key(filepath);
         }
     }
 
     if (proto == nullptr) {
-        file.println("Filetype: Flipper SubGhz RAW File");
-        file.println("Version: 1");
-        file.printf("Frequency: %d\n", (int)(recording.frequency * 1000000));
-        file.printf("Preset: %s\n", subghz_preset_to_string(subghz_current_preset));
-        file.println("Protocol: RAW");
-
-        uint16_t values_written = 0;
-        bool is_first_value = true;
-        file.print("RAW_Data:");
-
-    for (size_t i = 0; i < recording.codes.size(); i++) {
-        size_t count = recording.codeLengths[i];
-
-        for (size_t j = 0; j < count; j++) {
-            rmt_item32_t &item = recording.codes[i][j];
-
-            if (item.duration0 > 0) {
-                if (values_written > 0 && values_written % 512 == 0) {
-                    file.print("\nRAW_Data:");
-                }
-                file.print(" ");
-
-                if (is_first_value && item.level0 == 0) {
-                    is_first_value = false;
-                    continue;
+        RfFingerprint fp;
+        std::vector<int> fp_values;
+        fp_values.reserve(RF_LIB_FP_MAX_VALUES);
+        subghz_raw_values(recording, [&](int v) {
+            fp_values.push_back(v);
+            return fp_values.size() < (size_t)RF_LIB_FP_MAX_VALUES;
+        });
+        bool have_fp = rf_fingerprint_raw(fp_values, (uint32_t)(recording.frequency * 1000000), &fp);
+        std::vector<int>().swap(fp_values);
+
+        if (have_fp) {
+            String existing = subghz_library_check(fp, filepath);
+            if (!existing.isEmpty()) {
+                file.close();
+                SD.remove(filepath);
+                if (out_protocol != nullptr) {
+                    *out_protocol = "RAW";
                 }
-
-                if (item.level0 == 0) file.print("-");
-                file.print(item.duration0);
-                values_written++;
-                is_first_value = false;
+                return existing;
             }
+        }
 
-            if (item.duration1 > 0) {
+        // Fixed-rate captures are kept as BinRAW; anything that does not
+        // survive the round trip keeps its full RAW timings
+        bool binraw = g_config.subghz.binraw && subghz_write_binraw(file, recording, subghz_current_preset);
+        if (!binraw) {
+            file.println("Filetype: Flipper SubGhz RAW File");
+            file.println("Version: 1");
+            file.printf("Frequency: %d\n", (int)(recording.frequency * 1000000));
+            file.printf("Preset: %s\n", subghz_preset_to_string(subghz_current_preset));
+            file.println("Protocol: RAW");
+
+            subghz_write_burst_meta(file, recording);
+
+            uint32_t values_written = 0;
+            file.print("RAW_Data:");
+            subghz_raw_values(recording, [&](int v) {
                 if (values_written > 0 && values_written % 512 == 0) {
                     file.print("\nRAW_Data:");
+                    delay(1);
                 }
                 file.print(" ");
-                if (item.level1 == 0) file.print("-");
-                file.print(item.duration1);
+                file.print(v);
                 values_written++;
-                is_first_value = false;
-            }
-        }
+                return true;
+            });
 
-        if (i < recording.codes.size() - 1 && recording.gaps[i] > 0) {
-            if (values_written > 0 && values_written % 512 == 0) {
-                file.print("\nRAW_Data:");
-            }
-            file.print(" -");
-            file.print((int)(recording.gaps[i] * 1000));
-            values_written++;
+            file.println();
         }
+        file.close();
 
-        if (i > 0 && i % 50 == 0) {
-            delay(1);
+        if (have_fp) {
+            rf_library_add(subghz_path_name(filepath).c_str(), &fp);
         }
-    }
-
-        file.println();
-        file.close();
 
         if (out_protocol != nullptr) {
-            *out_protocol = "RAW";
+            *out_protocol = binraw ? "BinRAW" : "RAW";
         }
 
         recent_raw_files.push_back(filepath);
@@ -707,6 +1040,9 @@ String subghz_generate_filename(const char* protocol_name) {
         prefix = "capture";
     }
 
+    // The index knows every name in /rf; the probe only guards against files
+    // written behind its back and covers the time before it is built
+    index = rf_library_next_index(prefix.c_str());
     do {
         filepath = String(SUBGHZ_FILE_DIR) + "/" + prefix + "_" + String(index) + ".sub";
         index++;
@@ -820,6 +1156,7 @@ bool subghz_load_file(const char *filepath, RfCodes &codes) {
         SubGhzProtocol* proto = registry->getProtocol("Security+ 2.0");
 
         if (proto != nullptr) {
+#if SUBGHZ_PROTOCOL_SECPLUS_V2
             SecPlusV2Protocol* secplus = static_cast<SecPlusV2Protocol*>(proto);
 
             // Decode the packets to extract serial, button, and counter
@@ -840,6 +1177,7 @@ bool subghz_load_file(const char *filepath, RfCodes &codes) {
                 codes.secplus_rolling = 0;
                 codes.secplus_button = 0;
             }
+#endif
         } else {
             // Fallback if protocol not found
             codes.secplus_fixed = 0;
@@ -921,8 +1259,12 @@ bool subghz_transmit_raw(RawRecording &recording) {
             accumulatedDelay += recording.codes[i][j].duration1;
         }
 
-        if (!interrupted && i < recording.codes.size() - 1 && recording.gaps[i] > 0) {
-            delay(recording.gaps[i]);
+        if (!interrupted && i + 1 < recording.codes.size() && i + 1 < recording.bursts.size()) {
+            // Replay the measured spacing, not a fixed one; long pauses are capped
+            uint32_t gap_us = min(recording.bursts[i + 1].gap_us, (uint32_t)SUBGHZ_BURST_GAP_MAX_US);
+            digitalWrite(BOARD_SGHZ_IO0, LOW);
+            delay(gap_us / 1000);
+            delayMicroseconds(gap_us % 1000);
         }
     }
 
@@ -980,7 +1322,7 @@ float subghz_scan_frequency(int range_index, int threshold) {
     }
 
     // Get combined frequency list (hardcoded + custom from config)
-    std::vector<float> freq_list = rf_get_combined_frequency_list();
+    const std::vector<float> &freq_list = rf_get_combined_frequency_list();
     int total_freqs = freq_list.size();
 
     // Adjust range limits for combined list if scanning "Full" range
@@ -1062,7 +1404,8 @@ bool subghz_start_scan_record(int range_index) {
         return false;
     }
 
-    if (scan_record_active) {
+    // GDO2 is the packet engine's FIFO interrupt while packet capture runs
+    if (scan_record_active || rf_packet_is_active() || rf_hop_is_active()) {
         return false;
     }
 
@@ -1101,6 +1444,8 @@ bool subghz_start_scan_record(int range_index) {
     }
     scan_rmt_recording = new RawRecording();
     scan_rmt_recording->frequency = scan_status.frequency;
+    subghz_burst_meter_reset();
+    subghz_rx_flush();
 
     // Start RMT receive (uses same GDO2 pin - will capture same signal)
     rmt_rx_start(RMT_RX_CHANNEL, true);
@@ -1148,63 +1493,25 @@ ScanRecordStatus* subghz_get_scan_status(void) {
 
     // Poll RMT data and store in recording (for protocol detection later)
     // IMPORTANT: Drain ALL available items to prevent buffer overflow
-    if (scan_rmt_recording != nullptr && rmt_ringbuf != nullptr) {
-        int items_received = 0;
-        int items_dropped = 0;
-
-        // Keep polling until buffer is completely empty (prevent RMT RX BUFFER FULL errors)
-        // No safety limit - we MUST drain everything to prevent overflow
-        while (true) {
-            size_t rx_size = 0;
-            rmt_item32_t *items = (rmt_item32_t*)xRingbufferReceive(
-                rmt_ringbuf,
-                &rx_size,
-                0  // Non-blocking
-            );
-
-            if (items == nullptr || rx_size == 0) {
-                break;  // Buffer empty - this is our exit condition
-            }
-
-            size_t num_items = rx_size / sizeof(rmt_item32_t);
+    if (scan_rmt_recording != nullptr && subghz_rx_queue != nullptr) {
+        subghz_burst_meter_sample();
 
+        // Take every frame the drain task has stamped since the last poll
+        SubGhzRxFrame frame;
+        while (xQueueReceive(subghz_rx_queue, &frame, 0) == pdTRUE) {
             // Limit accumulated captures to prevent memory bloat
             // Keep only recent captures for protocol detection
-            if (scan_rmt_recording->codes.size() < 10) {
-                // Allocate and store RMT data
-                rmt_item32_t *code = (rmt_item32_t*)malloc(rx_size);
-                if (code != nullptr) {
-                    memcpy(code, items, rx_size);
-                    scan_rmt_recording->codes.push_back(code);
-                    scan_rmt_recording->codeLengths.push_back(num_items);
-                    scan_rmt_recording->gaps.push_back(0);
-                    items_received++;
-                } else {
-                    items_dropped++;
-                }
-            } else {
-                // Drop oldest capture and add new one (circular buffer behavior)
+            if (scan_rmt_recording->codes.size() >= 10) {
+                // Drop oldest capture (circular buffer behavior)
                 if (scan_rmt_recording->codes[0] != nullptr) {
                     free(scan_rmt_recording->codes[0]);
                 }
                 scan_rmt_recording->codes.erase(scan_rmt_recording->codes.begin());
                 scan_rmt_recording->codeLengths.erase(scan_rmt_recording->codeLengths.begin());
-                scan_rmt_recording->gaps.erase(scan_rmt_recording->gaps.begin());
-
-                // Add new capture
-                rmt_item32_t *code = (rmt_item32_t*)malloc(rx_size);
-                if (code != nullptr) {
-                    memcpy(code, items, rx_size);
-                    scan_rmt_recording->codes.push_back(code);
-                    scan_rmt_recording->codeLengths.push_back(num_items);
-                    scan_rmt_recording->gaps.push_back(0);
-                    items_received++;
-                } else {
-                    items_dropped++;
-                }
+                scan_rmt_recording->bursts.erase(scan_rmt_recording->bursts.begin());
             }
 
-            vRingbufferReturnItem(rmt_ringbuf, (void*)items);
+            subghz_append_burst(scan_rmt_recording, frame);
         }
 
         // Stop RMT RX after collecting enough data to prevent buffer overflow from continuous signals
@@ -1388,6 +1695,7 @@ String subghz_save_last_signal(const char *filename, String* out_protocol) {
     }
 
     // Fall back to RcSwitch-based save (heuristic detection only)
+    subghz_last_duplicate = "";
 
     // Create directory if needed
     if (!SD.exists(SUBGHZ_FILE_DIR)) {
@@ -1493,7 +1801,7 @@ String subghz_save_last_signal(const char *filename, String* out_protocol) {
 
     file.close();
 
-    return filepath;
+    return subghz_library_commit_key(filepath);
 }
 
 /**
@@ -1501,74 +1809,8 @@ String subghz_save_last_signal(const char *filename, String* out_protocol) {
  * CUSTOM RANGE SCANNING FUNCTIONALITY
  * ========================================================================
  * Enables scanning across arbitrary frequency ranges with configurable step sizes
- * Automatically skips invalid CC1101 frequency gaps
- */
-
-/**
- * Check if a frequency is in a valid CC1101 band
- * Valid bands: 300-348 MHz, 387-464 MHz, 779-928 MHz
- */
-bool subghz_is_freq_valid(float freq_mhz) {
-    return (freq_mhz >= 300.0f && freq_mhz <= 348.0f) ||
-           (freq_mhz >= 387.0f && freq_mhz <= 464.0f) ||
-           (freq_mhz >= 779.0f && freq_mhz <= 928.0f);
-}
-
-/**
- * Align frequency to step boundary to avoid floating-point drift
- * @param freq_mhz Frequency in MHz
- * @param step_khz Step size in kHz (supports fractional kHz like 6.25, 12.5)
- * @return Frequency aligned to nearest step boundary
+ * Channels come from an RfFreqPlan, which already excludes the CC1101 band gaps
  */
-float subghz_align_freq_to_step(float freq_mhz, float step_khz) {
-    // Work in 100 Hz increments to balance precision and avoid float overflow
-    // 312.0 MHz = 3,120,000 units (100 Hz each)
-    // 10 kHz = 100 units, 6.25 kHz = 62.5 units
-    long freq_units = lroundf(freq_mhz * 10000.0f);
-    float step_units = step_khz * 10.0f;
-
-    // Calculate number of steps from zero and round
-    long num_steps = lroundf((float)freq_units / step_units);
-
-    // Calculate aligned frequency in 100 Hz units
-    long aligned_units = lroundf(num_steps * step_units);
-
-    // Convert back to MHz
-    return aligned_units / 10000.0f;
-}
-
-/**
- * Get next valid frequency, skipping invalid gaps
- * @param current_freq_mhz Current frequency in MHz
- * @param step_khz Step size in kHz (supports fractional kHz like 6.25, 12.5)
- * @return Next valid frequency, or 0 if end of range
- */
-float subghz_next_valid_freq(float current_freq_mhz, float step_khz) {
-    // Use integer arithmetic in 100 Hz units to avoid floating-point accumulation errors
-    // Example: 312.000 MHz + 10 kHz = 3,120,000 units + 100 units = 3,120,100 units = 312.010 MHz
-    long current_units = lroundf(current_freq_mhz * 10000.0f);
-    long step_units = lroundf(step_khz * 10.0f);
-
-    long next_units = current_units + step_units;
-    float next_freq = next_units / 10000.0f;
-
-    // Skip gap between 348-387 MHz
-    if (current_freq_mhz <= 348.0f && next_freq > 348.0f && next_freq < 387.0f) {
-        next_freq = 387.0f;
-    }
-
-    // Skip gap between 464-779 MHz
-    if (current_freq_mhz <= 464.0f && next_freq > 464.0f && next_freq < 779.0f) {
-        next_freq = 779.0f;
-    }
-
-    // Check if we've exceeded the maximum frequency
-    if (next_freq > 928.0f) {
-        return 0.0f;  // End of range
-    }
-
-    return next_freq;
-}
 
 /**
  * Scan custom frequency range with specified step size
@@ -1596,48 +1838,43 @@ float subghz_scan_custom_range(float start_mhz, float end_mhz, float step_khz, i
     }
 
     uint8_t attempt = 0;
-    float current_freq = start_mhz;
-
-    // Ensure start frequency is valid
-    if (!subghz_is_freq_valid(current_freq)) {
-        current_freq = subghz_next_valid_freq(current_freq - (step_khz / 1000.0f), step_khz);
-        if (current_freq == 0.0f) {
-            scan_status.scanning = false;
-            return 0.0f;
-        }
+
+    static RfFreqPlan plan;
+    if (!rf_freq_plan_build(&plan, rf_freq_mhz_to_hz(start_mhz), rf_freq_mhz_to_hz(end_mhz),
+                            (uint32_t)lroundf(step_khz * 1000.0f))) {
+        scan_status.scanning = false;
+        return 0.0f;
     }
 
     // Scan through frequency range
-    while (attempt < FREQ_SCAN_MAX_TRIES && scan_status.scanning && current_freq <= end_mhz && current_freq > 0.0f) {
+    for (uint32_t idx = 0; idx < plan.count && attempt < FREQ_SCAN_MAX_TRIES; idx++) {
         // Check if user requested stop
         if (!scan_status.scanning) {
             break;
         }
 
-        // Only scan valid frequencies
-        if (subghz_is_freq_valid(current_freq)) {
-            // Update current frequency being scanned for UI display
-            scan_status.frequency = current_freq;
+        RfChannel ch;
+        rf_freq_plan_get(&plan, idx, &ch);
+        float current_freq = rf_freq_hz_to_mhz(ch.hz);
 
-            // Configure radio for this frequency
-            if (rf_initModule("rx", current_freq)) {
-                delay(5);  // Let radio settle
+        // Update current frequency being scanned for UI display
+        scan_status.frequency = current_freq;
 
-                int rssi = ELECHOUSE_cc1101.getRssi();
-                scan_status.rssi = rssi;
+        // First channel sets the radio up; later ones in the same band only rewrite FREQ
+        if (rf_retune_rx(&ch)) {
+            delay(5);  // Let radio settle
 
-                if (rssi > threshold) {
-                    best_freqs[attempt].freq = current_freq;
-                    best_freqs[attempt].rssi = rssi;
-                    attempt++;
+            int rssi = ELECHOUSE_cc1101.getRssi();
+            scan_status.rssi = rssi;
+
+            if (rssi > threshold) {
+                best_freqs[attempt].freq = current_freq;
+                best_freqs[attempt].rssi = rssi;
+                attempt++;
 
-                }
             }
         }
 
-        // Move to next frequency
-        current_freq = subghz_next_valid_freq(current_freq, step_khz);
-
         // Yield to UI task - allow button presses and display updates
         for (int i = 0; i < 3; i++) {
             lv_timer_handler();
@@ -1646,6 +1883,7 @@ float subghz_scan_custom_range(float start_mhz, float end_mhz, float step_khz, i
     }
 
     rf_deinitModule();
+    rf_freq_plan_free(&plan);
 
     // Find the best frequency from our samples
     if (attempt > 0) {
@@ -1677,7 +1915,8 @@ bool subghz_start_scan_record_custom(float start_mhz, float end_mhz, float step_
         return false;
     }
 
-    if (scan_record_active) {
+    // GDO2 is the packet engine's FIFO interrupt while packet capture runs
+    if (scan_record_active || rf_packet_is_active() || rf_hop_is_active()) {
         return false;
     }
 
@@ -1708,6 +1947,8 @@ bool subghz_start_scan_record_custom(float start_mhz, float end_mhz, float step_
     }
     scan_rmt_recording = new RawRecording();
     scan_rmt_recording->frequency = scan_status.frequency;
+    subghz_burst_meter_reset();
+    subghz_rx_flush();
 
     // Start RMT receive
     rmt_rx_start(RMT_RX_CHANNEL, true);
@@ -28,6 +28,14 @@
 // RMT Timing Constants
 #define RMT_1US_TICKS      (80000000 / RMT_CLK_DIV / 1000000)
 #define RMT_1MS_TICKS      (RMT_1US_TICKS * 1000)
+#define RMT_RX_IDLE_US     12000       // Silence that ends an RMT receive frame (one burst)
+
+// RMT drain task: pulls frames off the ring buffer as they complete and
+// timestamps them, so consumers polling from the UI still see receive times
+#define SUBGHZ_RX_TASK_PRIORITY (configMAX_PRIORITIES - 2)
+#define SUBGHZ_RX_TASK_CORE     1          // Off the LVGL core
+#define SUBGHZ_RX_TASK_STACK    3072
+#define SUBGHZ_RX_QUEUE_LEN     32         // Stamped frames awaiting a consumer
 
 // SubGHz Configuration
 #define SUBGHZ_DEFAULT_FREQ     433.92f    // Default frequency (MHz)
@@ -35,6 +43,13 @@
 #define SUBGHZ_MAX_RAW_PULSES   10000      // Maximum pulses per RAW recording
 #define SUBGHZ_CAPTURE_TIMEOUT  30000      // Capture timeout (milliseconds)
 #define SUBGHZ_FILE_DIR         "/rf"      // SD card directory for captures
+#define SUBGHZ_BURST_GAP_MAX_US 1000000    // Replayed/saved inter-burst gaps are capped here
+#define SUBGHZ_EDGE_ARENA_WORDS 8192       // Packed decoder edges per recording (16 KB); later edges are dropped
+
+// Duplicate handling on save (subghz.dedup in nautilus.json)
+#define SUBGHZ_DEDUP_OFF        0  // Always save
+#define SUBGHZ_DEDUP_WARN       1  // Save, but report the matching file
+#define SUBGHZ_DEDUP_SKIP       2  // Keep the existing file instead of saving
 
 // SubGHz File Presets
 // Legacy (kept for compatibility)
@@ -51,6 +66,24 @@
 // Preset name conversion for Flipper Zero compatibility
 const char* subghz_preset_to_string(uint8_t preset);
 
+/**
+ * RAW Burst Metadata
+ * One entry per RMT frame; timestamps are esp_timer microseconds, taken by the
+ * RMT drain task as each frame completes. A frame that found the drain task
+ * still busy with the previous one has no usable start time, and neither it
+ * nor the next frame gets a gap.
+ */
+struct RawBurst {
+    int64_t start_us;                   // First edge of the burst (valid when timed)
+    uint32_t duration_us;               // Sum of the burst's edge durations
+    uint32_t gap_us;                    // Silence since the previous burst ended (0 if first or unknown)
+    int8_t rssi;                        // Peak RSSI over the burst window (dBm)
+    uint8_t lqi;                        // CC1101 LQI read alongside the peak RSSI
+    bool timed;                         // start_us was stamped as the frame completed
+
+    RawBurst() : start_us(0), duration_us(0), gap_us(0), rssi(-128), lqi(0), timed(false) {}
+};
+
 /**
  * RAW Recording Structure
  * Stores captured RF signal timing data from RMT peripheral
@@ -59,7 +92,7 @@ struct RawRecording {
     float frequency;                           // Frequency in MHz
     std::vector<rmt_item32_t*> codes;         // Captured pulse/gap sequences
     std::vector<uint16_t> codeLengths;        // Number of items per sequence
-    std::vector<uint16_t> gaps;               // Gap durations between sequences (ms)
+    std::vector<RawBurst> bursts;             // Timing and signal metadata per sequence
 
     RawRecording() : frequency(SUBGHZ_DEFAULT_FREQ) {}
 
@@ -72,10 +105,10 @@ struct RawRecording {
         }
         codes.clear();
         codeLengths.clear();
-        gaps.clear();
+        bursts.clear();
         codes.shrink_to_fit();
         codeLengths.shrink_to_fit();
-        gaps.shrink_to_fit();
+        bursts.shrink_to_fit();
     }
 
     ~RawRecording() {
@@ -174,6 +207,18 @@ bool subghz_start_capture(float frequency, uint32_t timeout_ms = SUBGHZ_CAPTURE_
 void subghz_stop_capture(void);
 bool subghz_is_capturing(void);
 RawRecording* subghz_get_capture(void);
+
+/**
+ * Start capture without re-initialising the radio, for callers that tuned it
+ * with rf_retune_rx(). Caller holds radioLock.
+ */
+bool subghz_start_capture_tuned(float frequency);
+
+/**
+ * Detach the finished recording; the caller deletes it
+ * @return nullptr while still capturing or if nothing was recorded
+ */
+RawRecording* subghz_take_capture(void);
 RawRecordingStatus* subghz_get_status(void);
 
 /**
@@ -188,6 +233,7 @@ bool subghz_transmit_file(const char *filepath);
  */
 String subghz_try_decode_recording(RawRecording &recording, ProtocolDecodeResult &result);
 String subghz_save_capture(RawRecording &recording, const char *filename = nullptr, String* out_protocol = nullptr);
+const String &subghz_last_save_duplicate(void);  // /rf name the last save matched, or empty
 bool subghz_load_file(const char *filepath, RfCodes &codes);
 bool subghz_parse_raw_line(const String &line, std::vector<int32_t> &timings);
 
@@ -254,8 +300,5 @@ String subghz_save_last_signal(const char *filename = nullptr, String* out_proto
 /**
  * Custom Range Scanning Functions
  */
-bool subghz_is_freq_valid(float freq_mhz);
-float subghz_align_freq_to_step(float freq_mhz, float step_khz);
-float subghz_next_valid_freq(float current_freq_mhz, float step_khz);
 float subghz_scan_custom_range(float start_mhz, float end_mhz, float step_khz, int threshold = -65);
 bool subghz_start_scan_record_custom(float start_mhz, float end_mhz, float step_khz);
@@ -0,0 +1,179 @@
+
+#include "peripheral.h"
+
+// Merged AP table, only touched from the LVGL thread (wifi_scan_poll and the getters).
+// Slots are stable for the lifetime of an AP so the UI can bind one row to one slot.
+static WiFiScanEntry wifi_scan_table[WIFI_SCAN_MAX_APS];
+static uint32_t wifi_scan_generation = 0;
+
+static bool wifi_scan_event_registered = false;
+static bool wifi_scan_running = false;
+static bool wifi_scan_continuous = false;
+static volatile bool wifi_scan_done = false;       // Set from the WiFi event task
+
+static wifi_scan_sink_t wifi_scan_sink = NULL;
+
+static void wifi_scan_done_event(arduino_event_id_t event, arduino_event_info_t info)
+{
+    // Arduino has already fetched the records by the time user handlers run;
+    // the merge itself happens on the next wifi_scan_poll()
+    wifi_scan_done = true;
+}
+
+static bool wifi_scan_kick(void)
+{
+    if (!wifi_scan_event_registered) {
+        WiFi.onEvent(wifi_scan_done_event, ARDUINO_EVENT_WIFI_SCAN_DONE);
+        wifi_scan_event_registered = true;
+    }
+
+    wifi_scan_done = false;
+    int16_t ret = WiFi.scanNetworks(true, false);
+    if (ret == WIFI_SCAN_FAILED) {
+        Serial.println("[WIFI] Async scan start failed");
+        wifi_scan_running = false;
+        return false;
+    }
+    wifi_scan_running = true;
+    return true;
+}
+
+static int wifi_scan_find_slot(const uint8_t *bssid)
+{
+    for (int i = 0; i < WIFI_SCAN_MAX_APS; i++) {
+        if (wifi_scan_table[i].used && memcmp(wifi_scan_table[i].bssid, bssid, 6) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Free slot, or the AP that has been quiet the longest when the table is full
+static int wifi_scan_alloc_slot(void)
+{
+    int oldest = 0;
+
+    for (int i = 0; i < WIFI_SCAN_MAX_APS; i++) {
+        if (!wifi_scan_table[i].used) {
+            return i;
+        }
+        if (wifi_scan_table[i].last_seen_ms < wifi_scan_table[oldest].last_seen_ms) {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
+
+static void wifi_scan_merge(const wifi_ap_record_t *ap, uint32_t now)
+{
+    int slot = wifi_scan_find_slot(ap->bssid);
+    WiFiScanEntry *e;
+
+    if (slot < 0) {
+        e = &wifi_scan_table[wifi_scan_alloc_slot()];
+        memset(e, 0, sizeof(*e));
+        e->used = true;
+        memcpy(e->bssid, ap->bssid, 6);
+        e->first_seen_ms = now;
+        e->rssi_x16 = (int16_t)ap->rssi * 16;
+    } else {
+        e = &wifi_scan_table[slot];
+        // EMA in 1/16 dB so small steps are not lost to integer truncation
+        e->rssi_x16 += ((int16_t)ap->rssi * 16 - e->rssi_x16) >> WIFI_SCAN_RSSI_SHIFT;
+    }
+
+    strlcpy(e->ssid, (const char *)ap->ssid, sizeof(e->ssid));
+    e->rssi = ap->rssi;
+    e->channel = ap->primary;
+    e->encryption = ap->authmode;
+    e->last_seen_ms = now;
+    if (e->seen < UINT16_MAX) {
+        e->seen++;
+    }
+}
+
+static void wifi_scan_expire(uint32_t now)
+{
+    for (int i = 0; i < WIFI_SCAN_MAX_APS; i++) {
+        if (wifi_scan_table[i].used && now - wifi_scan_table[i].last_seen_ms > WIFI_SCAN_EXPIRE_MS) {
+            wifi_scan_table[i].used = false;
+        }
+    }
+}
+
+bool wifi_scan_start(bool continuous)
+{
+    wifi_scan_continuous = continuous;
+    if (wifi_scan_running) {
+        return true;
+    }
+    return wifi_scan_kick();
+}
+
+void wifi_scan_stop(void)
+{
+    // A pass already in flight runs to completion and is merged by the next poll
+    wifi_scan_continuous = false;
+}
+
+bool wifi_scan_is_running(void)
+{
+    return wifi_scan_running;
+}
+
+bool wifi_scan_is_continuous(void)
+{
+    return wifi_scan_continuous;
+}
+
+bool wifi_scan_poll(void)
+{
+    if (!wifi_scan_running || !wifi_scan_done) {
+        return false;
+    }
+
+    int16_t n = WiFi.scanComplete();
+    if (n == WIFI_SCAN_RUNNING) {
+        return false;
+    }
+
+    uint32_t now = millis();
+    for (int i = 0; i < n; i++) {
+        const wifi_ap_record_t *ap = (const wifi_ap_record_t *)WiFi.getScanInfoByIndex(i);
+        if (!ap) {
+            continue;
+        }
+        wifi_scan_merge(ap, now);
+        if (wifi_scan_sink) {
+            wifi_scan_sink(ap->bssid, (const char *)ap->ssid, ap->rssi);
+        }
+    }
+    wifi_scan_expire(now);
+    WiFi.scanDelete();
+
+    wifi_scan_generation++;
+    wifi_scan_running = false;
+
+    if (wifi_scan_continuous) {
+        wifi_scan_kick();
+    }
+    return true;
+}
+
+void wifi_scan_set_sink(wifi_scan_sink_t sink)
+{
+    wifi_scan_sink = sink;
+}
+
+const WiFiScanEntry *wifi_scan_get(int slot)
+{
+    if (slot < 0 || slot >= WIFI_SCAN_MAX_APS || !wifi_scan_table[slot].used) {
+        return NULL;
+    }
+    return &wifi_scan_table[slot];
+}
+
+uint32_t wifi_scan_get_generation(void)
+{
+    return wifi_scan_generation;
+}
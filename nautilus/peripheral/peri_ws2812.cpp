@@ -1,44 +1,78 @@
 
 #include "peripheral.h"
+#include "driver/rmt.h"
 
 extern int lv_port_indev_get_pos(void);
 
+// RMT timing at 40 MHz (clk_div 2, 25 ns per tick)
+#define WS2812_RMT_CLK_DIV  2
+#define WS2812_T0H          16      // 0.40 us
+#define WS2812_T0L          34      // 0.85 us
+#define WS2812_T1H          32      // 0.80 us
+#define WS2812_T1L          18      // 0.45 us
+#define WS2812_WIRE_BYTES   (WS2812_NUM_LEDS * 3)
+
 // Default mode 0 (static) - actual mode will be set by config_load() -> ui_scr1_set_mode()
 int ws2812_effs_mode = 0;
-CRGB leds[WS2812_NUM_LEDS];
+CRGB leds[WS2812_NUM_LEDS];     // Static colour / demo pixels, written by other tasks
 
-void ws2812_init(void)
-{
-    FastLED.addLeds<WS2812, WS2812_DATA_PIN, GRB>(leds, WS2812_NUM_LEDS);
-    FastLED.setBrightness(0);  // Start completely dark
-    ws2812_set_color(CRGB::Black);  // LEDs off by default
-    FastLED.show();
-}
+static CRGB ws2812_palette[256];        // Rainbow, indexed by 8-bit hue
+static uint8_t ws2812_level[256];       // Brightness scale, rebuilt on ws2812_set_light()
+static uint8_t ws2812_light = 0;        // Start completely dark
 
-void ws2812_set_color(CRGB c)
+// Wire-format (GRB, brightness applied) double buffer. RMT reads one while
+// the task encodes into the other; ws2812_wire_cur is the last one sent.
+static uint8_t ws2812_wire[2][WS2812_WIRE_BYTES];
+static int ws2812_wire_cur = 0;
+static bool ws2812_wire_valid = false;
+static bool ws2812_rmt_ready = false;
+
+static portMUX_TYPE ws2812_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Expand bytes to RMT items from the driver ISR, MSB first
+static void IRAM_ATTR ws2812_rmt_translate(const void *src, rmt_item32_t *dest, size_t src_size,
+                                          size_t wanted_num, size_t *translated_size, size_t *item_num)
 {
-    for(int i = 0; i < WS2812_NUM_LEDS; i++){
-        leds[i] = c;
+    const rmt_item32_t bit0 = {{{WS2812_T0H, 1, WS2812_T0L, 0}}};
+    const rmt_item32_t bit1 = {{{WS2812_T1H, 1, WS2812_T1L, 0}}};
+    const uint8_t *psrc = (const uint8_t *)src;
+    size_t size = 0;
+    size_t num = 0;
+
+    while (size < src_size && num + 8 <= wanted_num) {
+        for (int i = 7; i >= 0; i--) {
+            dest[num++] = (psrc[size] & (1 << i)) ? bit1 : bit0;
+        }
+        size++;
     }
-    // if(ws2812_effs_mode == 0)
-        FastLED.show();
+    *translated_size = size;
+    *item_num = num;
 }
 
-void ws2812_set_light(uint8_t light)
+static void ws2812_rmt_init(void)
 {
-    FastLED.setBrightness(light);
-    FastLED.show();
-}
+    rmt_config_t cfg = RMT_DEFAULT_CONFIG_TX((gpio_num_t)WS2812_DATA_PIN, WS2812_RMT_CHANNEL);
+    cfg.clk_div = WS2812_RMT_CLK_DIV;
 
-void ws2812_set_mode(int m)
-{
-    m &= 0x3;
-    ws2812_effs_mode = m;
+    esp_err_t err = rmt_config(&cfg);
+    if (err == ESP_OK) {
+        err = rmt_driver_install(WS2812_RMT_CHANNEL, 0, 0);
+    }
+    if (err == ESP_OK) {
+        err = rmt_translator_init(WS2812_RMT_CHANNEL, ws2812_rmt_translate);
+    }
+    if (err != ESP_OK) {
+        Serial.printf("[WS2812] RMT init failed: %d\n", err);
+        return;
+    }
+    ws2812_rmt_ready = true;
 }
 
-int ws2812_get_mode(void)
+static void ws2812_build_level(uint8_t *level, uint8_t light)
 {
-    return ws2812_effs_mode;
+    for (int i = 0; i < 256; i++) {
+        level[i] = scale8_video(i, light);
+    }
 }
 
 CRGB hsvToRgb(uint16_t h, uint8_t s, uint8_t v)
@@ -64,67 +98,169 @@ CRGB hsvToRgb(uint16_t h, uint8_t s, uint8_t v)
     return c;
 }
 
+static void ws2812_wake(void)
+{
+    if (ws2812_handle) {
+        xTaskNotifyGive(ws2812_handle);
+    }
+}
+
+void ws2812_init(void)
+{
+    // Same hue mapping the effects used to compute per LED per frame
+    for (int i = 0; i < 256; i++) {
+        ws2812_palette[i] = hsvToRgb((uint32_t)i * 359 / 256, 255, 255);
+    }
+    ws2812_build_level(ws2812_level, ws2812_light);
+    ws2812_set_color(CRGB::Black);  // LEDs off by default
+}
+
+void ws2812_set_color(CRGB c)
+{
+    portENTER_CRITICAL(&ws2812_mux);
+    for(int i = 0; i < WS2812_NUM_LEDS; i++){
+        leds[i] = c;
+    }
+    portEXIT_CRITICAL(&ws2812_mux);
+    ws2812_wake();
+}
+
+void ws2812_set_light(uint8_t light)
+{
+    uint8_t level[256];
+
+    ws2812_build_level(level, light);
+    portENTER_CRITICAL(&ws2812_mux);
+    ws2812_light = light;
+    memcpy(ws2812_level, level, sizeof(level));
+    portEXIT_CRITICAL(&ws2812_mux);
+    ws2812_wake();
+}
+
+void ws2812_set_mode(int m)
+{
+    m &= 0x3;
+    ws2812_effs_mode = m;
+    ws2812_wake();
+}
+
+int ws2812_get_mode(void)
+{
+    return ws2812_effs_mode;
+}
+
+static void ws2812_render(int mode, CRGB *frame)
+{
+    uint8_t time = millis() >> 4;
+
+    switch (mode) {
+        case 1:
+            for (uint16_t i = 0; i < WS2812_NUM_LEDS; i++) {
+                frame[i] = ws2812_palette[time];
+            }
+            break;
+        case 2:
+            for (uint16_t i = 0; i < WS2812_NUM_LEDS; i++) {
+                frame[i] = ws2812_palette[(uint8_t)(time - i * 8)];
+            }
+            break;
+        case 3: {
+            int led_pos = abs(lv_port_indev_get_pos()) % WS2812_NUM_LEDS;
+            for (uint16_t i = 0; i < WS2812_NUM_LEDS; i++) {
+                frame[i] = CRGB::Black;
+            }
+            frame[led_pos] = ws2812_palette[time];
+            break;
+        }
+        default:
+            portENTER_CRITICAL(&ws2812_mux);
+            memcpy(frame, leds, sizeof(leds));
+            portEXIT_CRITICAL(&ws2812_mux);
+            break;
+    }
+}
+
+// Encode into the idle wire buffer and start a non-blocking transfer if any
+// byte differs from the last frame sent. Returns false if the frame is still pending.
+static bool ws2812_commit(const CRGB *frame)
+{
+    uint8_t *wire = ws2812_wire[ws2812_wire_cur ^ 1];
+
+    portENTER_CRITICAL(&ws2812_mux);
+    for (int i = 0; i < WS2812_NUM_LEDS; i++) {
+        wire[i * 3 + 0] = ws2812_level[frame[i].green];
+        wire[i * 3 + 1] = ws2812_level[frame[i].red];
+        wire[i * 3 + 2] = ws2812_level[frame[i].blue];
+    }
+    portEXIT_CRITICAL(&ws2812_mux);
+
+    if (ws2812_wire_valid && memcmp(wire, ws2812_wire[ws2812_wire_cur], WS2812_WIRE_BYTES) == 0) {
+        return true;
+    }
+    if (!ws2812_rmt_ready) {
+        return true;
+    }
+    // Previous frame still on the wire: keep it dirty and retry next frame
+    if (rmt_wait_tx_done(WS2812_RMT_CHANNEL, 0) != ESP_OK) {
+        return false;
+    }
+
+    rmt_write_sample(WS2812_RMT_CHANNEL, wire, WS2812_WIRE_BYTES, false);
+    ws2812_wire_cur ^= 1;
+    ws2812_wire_valid = true;
+    return true;
+}
+
 void ws2812_task(void *param)
 {
-    EventBits_t bit;
+    CRGB frame[WS2812_NUM_LEDS];
+    bool pending = true;    // Push the initial (black) frame set by ws2812_init()
+
+    // Installed from here so the RMT TX interrupt lands on this task's core
+    ws2812_rmt_init();
+    TickType_t last_wake = xTaskGetTickCount();
 
-    vTaskSuspend(ws2812_handle);
-    
     while(1){
-        uint8_t time = millis() >> 4;
-        switch (ws2812_effs_mode) {
-            case 0:
-                // for (uint16_t i = 0; i < WS2812_NUM_LEDS; i++) {
-                //     leds[i] = CRGB::Black;
-                // }
-                FastLED.show();
-                break;
-            case 1:
-                for (uint16_t i = 0; i < WS2812_NUM_LEDS; i++) {
-                    leds[i] = hsvToRgb((uint32_t)time * 359 / 256, 255, 255);
-                }
-                FastLED.show();
-                break;
-            case 2:
-                for (uint16_t i = 0; i < WS2812_NUM_LEDS; i++) {
-                    uint8_t p = time - i * 8;
-                    leds[i] = hsvToRgb((uint32_t)p * 359 / 256, 255, 255);
-                }
-                FastLED.show();
-                break;
-            case 3:{
-                int curr_pos = lv_port_indev_get_pos();
-                int led_pos;
-                ws2812_set_color(CRGB::Black);
-                led_pos = abs(curr_pos) % WS2812_NUM_LEDS;
-                leds[led_pos] = hsvToRgb((uint32_t)time * 359 / 256, 255, 255);
-                FastLED.show();
-            }
-            default:
-                break;
+        int mode = ws2812_effs_mode;
+
+        if (mode == 0 && !pending) {
+            // Static colour: nothing to animate, sleep until a setter wakes us
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            last_wake = xTaskGetTickCount();
+        } else {
+            // Fixed frame budget; a setter's notification just gets folded into the next frame
+            vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(WS2812_FRAME_MS));
+            ulTaskNotifyTake(pdTRUE, 0);
         }
-        vTaskDelay(pdMS_TO_TICKS(10));
+
+        ws2812_render(ws2812_effs_mode, frame);
+        pending = !ws2812_commit(frame);
     }
 }
 
 void ws2812_pos_demo(int pos)
 {
     uint8_t time = millis() >> 4;
-    int curr_pos = pos;
-    int led_pos;
-    ws2812_set_color(CRGB::Black);
-    led_pos = abs(curr_pos) % WS2812_NUM_LEDS;
-    leds[led_pos] = hsvToRgb((uint32_t)time * 359 / 256, 255, 255);
-    FastLED.show();
+    int led_pos = abs(pos) % WS2812_NUM_LEDS;
+
+    portENTER_CRITICAL(&ws2812_mux);
+    for (uint16_t i = 0; i < WS2812_NUM_LEDS; i++) {
+        leds[i] = CRGB::Black;
+    }
+    leds[led_pos] = ws2812_palette[time];
+    portEXIT_CRITICAL(&ws2812_mux);
+    ws2812_wake();
 }
 
 void ws2812_pos_demo1(void)
 {
     uint8_t time = millis() >> 4;
+
+    portENTER_CRITICAL(&ws2812_mux);
     for (uint16_t i = 0; i < WS2812_NUM_LEDS; i++)
     {
-        uint8_t p = time - i * 8;
-        leds[i] = hsvToRgb((uint32_t)p * 359 / 256, 255, 255);
+        leds[i] = ws2812_palette[(uint8_t)(time - i * 8)];
     }
-    FastLED.show();
+    portEXIT_CRITICAL(&ws2812_mux);
+    ws2812_wake();
 }
@@ -12,6 +12,13 @@
 #define FASTLED_ESP32_RMT_CHANNEL_0 0
 #include <FastLED.h>
 #define WS2812_DEFAULT_LIGHT 15
+
+// Frames are rendered from palette LUTs by ws2812_task and pushed with a
+// non-blocking RMT write on channel 0, only when the encoded pixels change.
+// FastLED is only used for CRGB/scale8; it never drives the strip.
+#define WS2812_RMT_CHANNEL  RMT_CHANNEL_0
+#define WS2812_FRAME_MS     16          // ~60 fps frame budget for animated modes
+#define WS2812_TASK_CORE    0           // Off core 1, where SubGHz capture and audio run
 extern TaskHandle_t ws2812_handle;
 
 void ws2812_init(void);
@@ -29,6 +36,7 @@ void ws2812_pos_demo1(void);
 #include <Adafruit_PN532.h>
 extern TaskHandle_t nfc_handle;
 void nfc_init(void);
+bool nfc_ensure_init(void);
 bool nfc_is_init(void);
 uint32_t nfc_get_ver_data(void);
 void nfc_task(void *param);
@@ -44,7 +52,8 @@ extern TaskHandle_t sghz_handle;
 extern SemaphoreHandle_t radioLock;
 extern CC1101 radio;
 
-void sghz_init(void);
+bool sghz_init(void);
+bool sghz_ensure_init(void);
 void sghz_mode_sw(int m);
 int sghz_get_mode(void);
 bool sghz_is_init(void);
@@ -59,15 +68,55 @@ void sghz_task(void *param);
 // NRF24
 #define NRF24_MODE_SEND 0
 #define NRF24_MODE_RECV 1
+#define NRF24_MODE_SWEEP 2
+
+// nrf24_task drains the RX FIFO into a PSRAM ring on each IRQ notification
+// (or every NRF24_POLL_MS when no IRQ line is wired) and re-inits on bus errors.
+#define NRF24_MAX_PAYLOAD   32
+#define NRF24_RX_RING_SIZE  256
+#define NRF24_POLL_MS       1
+
+typedef struct {
+    uint32_t t_us;                      // micros() when the packet was drained
+    uint8_t pipe;                       // RX pipe number (0-5)
+    uint8_t len;                        // Payload length in bytes
+    uint8_t data[NRF24_MAX_PAYLOAD];
+} NRF24Packet;
+
+typedef struct {
+    uint32_t received;      // Packets pushed into the ring
+    uint32_t ring_drops;    // Packets dropped because the ring was full
+    uint32_t fifo_full;     // Drains that found the 3-deep RX FIFO full
+    uint32_t bad_len;       // Corrupt payload widths (FIFO flushed)
+    uint32_t errors;        // Invalid STATUS reads
+    uint32_t recoveries;    // Module re-inits after repeated errors
+} NRF24Stats;
+
+// Sweep mode steps RF_CH 0..125 and samples the RPD (>-64 dBm) carrier
+// detect bit several times per channel; radioLock is held per channel only.
+#define NRF24_CHANNELS          126
+#define NRF24_SWEEP_SAMPLES     3       // RPD reads per channel per pass
+#define NRF24_SWEEP_PERIOD_MS   200     // Full-band pass interval (5 Hz)
+#define NRF24_WATERFALL_ROWS    64      // Passes kept for the waterfall
 
 extern TaskHandle_t nrf24_handle;
 
 void nrf24_init(void);
 bool nrf24_is_init();
 int nrf24_get_mode(void);
-void nrf24_set_mode(int mode);
+int nrf24_set_mode(int mode);
 void nrf24_task(void *param);
 void nrf24_send(const char *str);
+void nrf24_rx_enable(bool en);
+bool nrf24_read_packet(NRF24Packet *pkt);
+void nrf24_get_stats(NRF24Stats *st);
+void nrf24_sweep_reset(void);
+/** Copy cumulative per-channel RPD hits and samples-per-channel.
+ * @return number of completed passes */
+uint32_t nrf24_sweep_get_hist(uint32_t *hits, uint32_t *samples, uint32_t *pass_us);
+/** Copy the per-channel hit counts (0..NRF24_SWEEP_SAMPLES) of pass number `pass` (1-based).
+ * @return false if the pass has not completed yet or has left the waterfall ring */
+bool nrf24_sweep_get_row(uint32_t pass, uint8_t *row);
 
 /**---------------------------- BATTERY ----------------------------------**/
 #define XPOWERS_CHIP_BQ25896
@@ -78,11 +127,124 @@ extern XPowersPPM PPM;
 #include "bq27220.h"
 extern BQ27220 bq27220;
 
+/**----------------------------- POWER -----------------------------------**/
+// power_task burst-reads the BQ25896 and BQ27220 and publishes a versioned
+// snapshot; the UI reads it without touching I2C.
+#define POWER_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+#define POWER_TASK_CORE     0
+#define POWER_TASK_STACK    (1024 * 3)
+#define POWER_POLL_MS       5000        // Background rate (status bar)
+#define POWER_POLL_FAST_MS  500         // While the battery screen is open
+#define POWER_HISTORY_MS    15000       // History sample interval
+#define POWER_HISTORY_LEN   240         // 1 hour at POWER_HISTORY_MS, in PSRAM
+
+#define POWER_SAMPLE_VBUS       0x01
+#define POWER_SAMPLE_CHARGING   0x02
+
+typedef struct {
+    uint32_t version;       // Incremented on every publish; 0 = no data yet
+    uint32_t updated_ms;    // millis() of the read
+
+    // BQ25896 charger
+    bool ppm_ok;
+    bool vbus_in;
+    uint8_t chg_status;     // PowersBQ25896::ChargeStatus
+    uint8_t bus_status;     // PowersBQ25896::BusStatus
+    uint16_t vbus_mv;
+    uint16_t vsys_mv;
+    uint16_t vbat_mv;
+    uint16_t ichg_ma;
+    uint16_t chg_target_mv;
+    uint16_t precharge_ma;
+
+    // BQ27220 fuel gauge
+    bool gauge_ok;
+    bool charging;          // Not in DSG
+    bool charge_done;       // Not in DSG and no current flowing
+    uint16_t batt_status;   // BQ27220BatteryStatus.full
+    uint16_t voltage_mv;
+    int16_t current_ma;
+    int16_t avg_current_ma;
+    uint16_t temperature_dk; // 0.1 K
+    uint16_t remaining_mah;
+    uint16_t full_mah;
+    uint16_t tte_min;
+    uint16_t ttf_min;
+    uint16_t soc;
+    uint16_t soh;
+} PowerSnapshot;
+
+typedef struct {
+    uint32_t t_s;           // Seconds since boot
+    uint16_t voltage_mv;
+    int16_t current_ma;
+    uint8_t soc;
+    uint8_t flags;          // POWER_SAMPLE_*
+} PowerSample;
+
+void power_service_init(void);
+void power_set_rate(uint32_t period_ms);
+bool power_get(PowerSnapshot *out);
+/** Copy up to `max` history samples, oldest first.
+ * @return number of samples copied */
+int power_history_get(PowerSample *out, int max);
+const char *power_chg_status_str(uint8_t chg_status);
+const char *power_bus_status_str(uint8_t bus_status);
+
 /**------------------------------ MIC ------------------------------------**/
-#define SAMPLE_SIZE         (20)
 #define EXAMPLE_I2S_CH      0        // I2S Channel Number
 
+// The mic task drains each PDM DMA buffer on its I2S_EVENT_RX_DONE event and
+// publishes levels through a sequence-counted snapshot, so readers never block.
+#define MIC_TASK_PRIORITY   (tskIDLE_PRIORITY + 2)
+#define MIC_TASK_CORE       0
+#define MIC_TASK_STACK      (1024 * 3)
+#define MIC_RING_SAMPLES    2048     // Recent PCM kept for the spectrogram
+#define MIC_ACTIVE_RMS      300      // RMS above this counts as sound present
+
+typedef struct {
+    uint16_t rms;           // RMS of the last DMA buffer
+    uint16_t peak;          // Absolute peak of the last DMA buffer
+    uint16_t peak_hold;     // Decaying peak across buffers
+    uint32_t buffers;       // DMA buffers processed since init
+    uint32_t overruns;      // Buffers dropped because the driver queue overflowed
+    uint32_t updated_ms;    // millis() of the last update
+} MicLevel;
+
 void init_microphone(void);
+bool mic_get_level(MicLevel *out);
+bool mic_is_active(void);
+size_t mic_get_samples(float *out, size_t num_samples);
+
+/**----------------------------- AUDIO -----------------------------------**/
+// MP3 decode runs in its own task; SD reads go through a PSRAM read-ahead
+// cache so the shared SPI bus is only held for one chunk at a time.
+#define AUDIO_TASK_PRIORITY     (configMAX_PRIORITIES - 2)
+#define AUDIO_TASK_CORE         1
+#define AUDIO_TASK_STACK        (1024 * 8)
+#define AUDIO_READAHEAD_SIZE    (32 * 1024)   // PSRAM chunk per SD read
+#define AUDIO_READAHEAD_SIZE_RAM (4 * 1024)   // Fallback without PSRAM
+
+void audio_service_init(void);
+bool audio_play(fs::FS &fs, const char *path);
+void audio_stop(void);
+void audio_set_volume(uint8_t volume);
+bool audio_is_playing(void);
+
+// Playlist index: /music is enumerated in the background into a fixed-record
+// cache file, and the player reads names from it a page at a time.
+#define MUSIC_DIR               "/music"
+#define MUSIC_INDEX_PATH        "/.music_index"
+#define MUSIC_INDEX_NAME_LEN    128
+#define MUSIC_INDEX_PAGE        16
+
+bool music_index_open(void);
+void music_index_rebuild(void);
+bool music_index_is_busy(void);
+int music_index_count(void);
+int music_index_progress(void);
+bool music_index_get_name(int idx, char *name, size_t len);
+bool music_index_get_path(int idx, char *path, size_t len);
 
 /**------------------------------- IR ------------------------------------**/
 #define IR_MODE_SEND 1
@@ -112,6 +274,44 @@ extern char wifi_ssid[WIFI_SSID_MAX_LEN];
 extern char wifi_password[WIFI_PSWD_MAX_LEN];
 extern bool wifi_is_connect;
 
+// Async scanner: scanNetworks(true) + SCAN_DONE event, merged into a BSSID-keyed
+// table that the UI polls from an lv_timer. Not thread safe, LVGL thread only.
+#define WIFI_SCAN_MAX_APS       64
+#define WIFI_SCAN_RSSI_SHIFT    2           // RSSI EMA weight 1/4 per pass
+#define WIFI_SCAN_EXPIRE_MS     60000       // Drop APs not seen for this long
+
+typedef struct {
+    bool used;
+    uint8_t bssid[6];
+    char ssid[33];
+    uint8_t channel;
+    uint8_t encryption;     // wifi_auth_mode_t
+    int8_t rssi;            // Last raw sample
+    int16_t rssi_x16;       // Smoothed RSSI, dBm * 16
+    uint16_t seen;          // Number of passes the AP showed up in
+    uint32_t first_seen_ms;
+    uint32_t last_seen_ms;
+} WiFiScanEntry;
+
+// Called for every raw record of a finished pass, before it is deleted
+typedef void (*wifi_scan_sink_t)(const uint8_t *bssid, const char *ssid, int8_t rssi);
+
+static inline int wifi_scan_rssi(const WiFiScanEntry *e) { return (e->rssi_x16 - 8) / 16; }
+
+/** Start an async pass; with `continuous` a new pass starts as soon as one is merged.
+ * @return false if the driver refused to start scanning */
+bool wifi_scan_start(bool continuous);
+void wifi_scan_stop(void);
+bool wifi_scan_is_running(void);
+bool wifi_scan_is_continuous(void);
+/** Merge a finished pass into the table. Cheap when nothing is pending.
+ * @return true if the table changed */
+bool wifi_scan_poll(void);
+void wifi_scan_set_sink(wifi_scan_sink_t sink);
+/** @return the entry in `slot` (0..WIFI_SCAN_MAX_APS-1), or NULL if the slot is free */
+const WiFiScanEntry *wifi_scan_get(int slot);
+uint32_t wifi_scan_get_generation(void);
+
 /**---------------------------- EEPROM -----------------------------------**/
 #include <EEPROM.h>
 #define EEPROM_UPDATA_FLAG_NUM   0xAA
@@ -0,0 +1,226 @@
+/**
+ * RF Freq Plan - integer frequency plan for CC1101 scanning
+ */
+
+#include "rf_freq_plan.h"
+
+typedef struct {
+    uint32_t lo_hz;
+    uint32_t hi_hz;
+} RfFreqBand;
+
+// Valid CC1101 bands, ascending
+static const RfFreqBand rf_freq_bands[RF_FREQ_BAND_COUNT] = {
+    { 300000000UL, 348000000UL },
+    { 387000000UL, 464000000UL },
+    { 779000000UL, 928000000UL },
+};
+
+// Lowest frequency of every calibration segment after the first in each band
+static const uint32_t rf_freq_cal_splits[RF_FREQ_BAND_COUNT][2] = {
+    { 322880000UL, 0 },
+    { 430500000UL, 0 },
+    { 861000000UL, 900000000UL },
+};
+
+uint32_t rf_freq_mhz_to_hz(float mhz)
+{
+    if (mhz <= 0.0f) {
+        return 0;
+    }
+    // 100 Hz units keep float error (~30 Hz at 928 MHz) out of the result
+    return (uint32_t)lroundf(mhz * 10000.0f) * 100UL;
+}
+
+float rf_freq_hz_to_mhz(uint32_t hz)
+{
+    return hz / 1000000.0f;
+}
+
+int rf_freq_band(uint32_t hz)
+{
+    for (int i = 0; i < RF_FREQ_BAND_COUNT; i++) {
+        if (hz >= rf_freq_bands[i].lo_hz && hz <= rf_freq_bands[i].hi_hz) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int rf_freq_cal_segment(uint32_t hz)
+{
+    int band = rf_freq_band(hz);
+    if (band < 0) {
+        return -1;
+    }
+
+    int segment = 0;
+    for (int b = 0; b < band; b++) {
+        segment += 1 + (rf_freq_cal_splits[b][0] != 0) + (rf_freq_cal_splits[b][1] != 0);
+    }
+    for (int i = 0; i < 2; i++) {
+        if (rf_freq_cal_splits[band][i] != 0 && hz >= rf_freq_cal_splits[band][i]) {
+            segment++;
+        }
+    }
+    return segment;
+}
+
+bool rf_freq_is_valid(uint32_t hz)
+{
+    return rf_freq_band(hz) >= 0;
+}
+
+uint32_t rf_freq_word(uint32_t hz)
+{
+    return (uint32_t)((((uint64_t)hz << 16) + RF_FREQ_XOSC_HZ / 2) / RF_FREQ_XOSC_HZ);
+}
+
+static uint32_t rf_freq_run_hz(const RfFreqPlan *plan, const RfFreqRun *run, uint32_t idx)
+{
+    return run->first_hz + (idx - run->base) * plan->step_hz;
+}
+
+// Run holding plan index idx; runs are contiguous in index space
+static const RfFreqRun *rf_freq_run_of(const RfFreqPlan *plan, uint32_t idx)
+{
+    int lo = 0, hi = plan->run_count - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (plan->runs[mid].base <= idx) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return &plan->runs[lo];
+}
+
+void rf_freq_plan_free(RfFreqPlan *plan)
+{
+    if (plan->table) {
+        free(plan->table);
+    }
+    memset(plan, 0, sizeof(*plan));
+}
+
+bool rf_freq_plan_build(RfFreqPlan *plan, uint32_t start_hz, uint32_t stop_hz, uint32_t step_hz)
+{
+    rf_freq_plan_free(plan);
+
+    if (step_hz == 0 || start_hz > stop_hz) {
+        return false;
+    }
+    plan->start_hz = start_hz;
+    plan->stop_hz = stop_hz;
+    plan->step_hz = step_hz;
+
+    for (int i = 0; i < RF_FREQ_BAND_COUNT; i++) {
+        uint32_t lo = max(start_hz, rf_freq_bands[i].lo_hz);
+        uint32_t hi = min(stop_hz, rf_freq_bands[i].hi_hz);
+        if (lo > hi) {
+            continue;
+        }
+        // Snap to the step grid so every scan of the same range hits the same channels
+        uint32_t first = (lo + step_hz - 1) / step_hz * step_hz;
+        uint32_t last = hi / step_hz * step_hz;
+        if (first > last) {
+            continue;
+        }
+
+        RfFreqRun *run = &plan->runs[plan->run_count++];
+        run->first_hz = first;
+        run->count = (last - first) / step_hz + 1;
+        run->base = plan->count;
+        plan->count += run->count;
+    }
+
+    if (plan->count == 0) {
+        return false;
+    }
+
+    if (plan->count <= RF_FREQ_PLAN_TABLE_MAX) {
+        plan->table = (RfChannel *)ps_malloc(plan->count * sizeof(RfChannel));
+        if (plan->table) {
+            uint32_t n = 0;
+            for (uint8_t r = 0; r < plan->run_count; r++) {
+                const RfFreqRun *run = &plan->runs[r];
+                uint32_t hz = run->first_hz;
+                for (uint32_t i = 0; i < run->count; i++, hz += step_hz) {
+                    plan->table[n].hz = hz;
+                    plan->table[n].freq_word = rf_freq_word(hz);
+                    n++;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool rf_freq_plan_get(const RfFreqPlan *plan, uint32_t idx, RfChannel *out)
+{
+    if (idx >= plan->count) {
+        return false;
+    }
+    if (plan->table) {
+        *out = plan->table[idx];
+        return true;
+    }
+    out->hz = rf_freq_run_hz(plan, rf_freq_run_of(plan, idx), idx);
+    out->freq_word = rf_freq_word(out->hz);
+    return true;
+}
+
+uint32_t rf_freq_plan_lower_bound(const RfFreqPlan *plan, uint32_t hz)
+{
+    if (plan->run_count == 0) {
+        return 0;
+    }
+
+    // Last run starting at or below hz
+    int lo = 0, hi = plan->run_count - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (plan->runs[mid].first_hz <= hz) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    const RfFreqRun *run = &plan->runs[lo];
+    if (hz <= run->first_hz) {
+        return run->base;
+    }
+    uint32_t off = (hz - run->first_hz + plan->step_hz - 1) / plan->step_hz;
+    // Past this run: the answer is the start of the next one (or count)
+    return off < run->count ? run->base + off : run->base + run->count;
+}
+
+int32_t rf_freq_plan_nearest(const RfFreqPlan *plan, uint32_t hz)
+{
+    if (plan->count == 0) {
+        return -1;
+    }
+
+    uint32_t idx = rf_freq_plan_lower_bound(plan, hz);
+    if (idx == 0) {
+        return 0;
+    }
+    if (idx >= plan->count) {
+        return plan->count - 1;
+    }
+
+    RfChannel above, below;
+    rf_freq_plan_get(plan, idx, &above);
+    rf_freq_plan_get(plan, idx - 1, &below);
+    return (above.hz - hz < hz - below.hz) ? idx : idx - 1;
+}
+
+RfChannelSpan rf_freq_plan_span(const RfFreqPlan *plan)
+{
+    RfChannelSpan span;
+    span.data = plan->table;
+    span.count = plan->table ? plan->count : 0;
+    return span;
+}
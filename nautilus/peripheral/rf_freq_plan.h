@@ -0,0 +1,109 @@
+/**
+ * RF Freq Plan - integer frequency plan for CC1101 scanning
+ * Channels are integer Hz on a step grid, clipped to the CC1101 bands, with
+ * the FREQ2:FREQ1:FREQ0 register word precomputed per channel
+ */
+
+#ifndef __RF_FREQ_PLAN_H__
+#define __RF_FREQ_PLAN_H__
+
+#include <Arduino.h>
+
+#define RF_FREQ_XOSC_HZ           26000000UL   // CC1101 crystal
+#define RF_FREQ_BAND_COUNT        3
+#define RF_FREQ_CAL_SEGMENT_COUNT 7            // Bands split where setMHZ() changes TEST0/FSCAL2
+#define RF_FREQ_PLAN_TABLE_MAX    16384        // Plans up to this size get a PSRAM channel table
+
+typedef struct {
+    uint32_t hz;          // Channel centre
+    uint32_t freq_word;   // 24-bit FREQ register value
+} RfChannel;
+
+// No-copy view of a channel table
+typedef struct {
+    const RfChannel *data;
+    uint32_t count;
+} RfChannelSpan;
+
+// One contiguous run of channels inside a single band
+typedef struct {
+    uint32_t first_hz;
+    uint32_t count;
+    uint32_t base;        // Plan index of first_hz
+} RfFreqRun;
+
+typedef struct {
+    uint32_t start_hz;
+    uint32_t stop_hz;
+    uint32_t step_hz;
+    RfFreqRun runs[RF_FREQ_BAND_COUNT];
+    uint8_t run_count;
+    uint32_t count;       // Total channels
+    RfChannel *table;     // NULL when count > RF_FREQ_PLAN_TABLE_MAX or no PSRAM
+} RfFreqPlan;
+
+/**
+ * UI values are float MHz; convert once at the edge, rounded to 100 Hz
+ */
+uint32_t rf_freq_mhz_to_hz(float mhz);
+float rf_freq_hz_to_mhz(uint32_t hz);
+
+/**
+ * @return true if hz lies inside one of the CC1101 bands
+ */
+bool rf_freq_is_valid(uint32_t hz);
+
+/**
+ * @return Band index (0..RF_FREQ_BAND_COUNT-1), or -1 outside all bands
+ */
+int rf_freq_band(uint32_t hz);
+
+/**
+ * Calibration segment: a band split at the points where ELECHOUSE setMHZ()
+ * switches TEST0 and the FSCAL2 VCO bit (322.88, 430.5, 861 and 900 MHz).
+ * Channels in one segment share FSCTRL0/FSCAL2/TEST0 up to FSCTRL0 rounding.
+ * @return Segment index (0..RF_FREQ_CAL_SEGMENT_COUNT-1), or -1 outside all bands
+ */
+int rf_freq_cal_segment(uint32_t hz);
+
+/**
+ * FREQ register word: round(hz * 2^16 / f_xosc)
+ */
+uint32_t rf_freq_word(uint32_t hz);
+
+/**
+ * Build the valid channel set for [start_hz, stop_hz] on multiples of step_hz.
+ * Any previous contents of plan are released, so a plan must start zeroed.
+ * @return true if at least one channel is valid
+ */
+bool rf_freq_plan_build(RfFreqPlan *plan, uint32_t start_hz, uint32_t stop_hz, uint32_t step_hz);
+
+/**
+ * Release the channel table
+ */
+void rf_freq_plan_free(RfFreqPlan *plan);
+
+/**
+ * Channel at a plan index
+ * @return false if idx is out of range
+ */
+bool rf_freq_plan_get(const RfFreqPlan *plan, uint32_t idx, RfChannel *out);
+
+/**
+ * Binary search for the first channel at or above hz
+ * @return Plan index, or plan->count if hz is above the last channel
+ */
+uint32_t rf_freq_plan_lower_bound(const RfFreqPlan *plan, uint32_t hz);
+
+/**
+ * @return Plan index of the channel closest to hz, or -1 for an empty plan
+ */
+int32_t rf_freq_plan_nearest(const RfFreqPlan *plan, uint32_t hz);
+
+/**
+ * @return The precomputed channel table, or an empty span if the plan is
+ *         too large to materialise (use rf_freq_plan_get() then)
+ */
+RfChannelSpan rf_freq_plan_span(const RfFreqPlan *plan);
+
+#endif // __RF_FREQ_PLAN_H__
@@ -0,0 +1,298 @@
+/**
+ * RF Hopper - round-robin listen over a small set of frequencies
+ */
+
+#include "rf_hopper.h"
+#include "rf_utils.h"
+#include "rf_packet.h"
+#include "peri_subghz.h"
+#include "peri_config.h"
+#include "peripheral.h"
+
+#define RF_HOP_PKTSTATUS_CS      0x40    // PKTSTATUS: carrier sense
+#define RF_HOP_ACTIVITY_FULL     256
+#define RF_HOP_ACTIVITY_HIT      32      // Score added per active visit; decays by 1/8 per visit
+
+typedef struct {
+    RfChannel ch;
+    RfHopChannelStats stats;
+} RfHopSlot;
+
+static TaskHandle_t rf_hop_handle = NULL;
+static volatile bool rf_hop_active = false;
+static volatile bool rf_hop_running = false;   // Task is inside a visit or capture
+static volatile uint32_t rf_hop_freq = 0;
+static RfHopConfig rf_hop_cfg;
+static RfHopSlot rf_hop_slots[RF_HOP_MAX_FREQS];
+
+// Queue: rf_hop_task produces, the UI consumes via rf_hop_take_capture()
+static RawRecording *rf_hop_queue[RF_HOP_QUEUE_SIZE];
+static volatile uint32_t rf_hop_queue_head = 0;
+static volatile uint32_t rf_hop_queue_tail = 0;
+
+static void rf_hop_push(RfHopSlot *slot, RawRecording *rec)
+{
+    uint32_t head = rf_hop_queue_head;
+    if (head - rf_hop_queue_tail >= RF_HOP_QUEUE_SIZE) {
+        Serial.printf("[RF] hop: queue full, dropping %.2f MHz capture\n", rec->frequency);
+        delete rec;
+        return;
+    }
+
+    rf_hop_queue[head % RF_HOP_QUEUE_SIZE] = rec;
+    __sync_synchronize();
+    rf_hop_queue_head = head + 1;
+    slot->stats.captures++;
+}
+
+/**
+ * Record on the channel the receiver is sitting on until the bursts stop
+ */
+static void rf_hop_capture(RfHopSlot *slot)
+{
+    float mhz = rf_freq_hz_to_mhz(slot->ch.hz);
+
+    if (xSemaphoreTake(radioLock, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return;
+    }
+    bool started = subghz_start_capture_tuned(mhz);
+    xSemaphoreGive(radioLock);
+    if (!started) {
+        return;
+    }
+
+    // The frame that tripped the trigger is usually cut short; remotes repeat,
+    // so the following frames arrive whole
+    uint32_t start = millis();
+    uint32_t last = start;
+    size_t bursts = 0;
+    while (rf_hop_active && millis() - start < RF_HOP_CAPTURE_MAX_MS) {
+        RawRecording *rec = subghz_get_capture();     // Waits up to 100ms for a frame
+        if (rec != nullptr && rec->codes.size() != bursts) {
+            bursts = rec->codes.size();
+            last = millis();
+        } else if (millis() - last >= RF_HOP_CAPTURE_IDLE_MS) {
+            break;
+        }
+    }
+
+    if (xSemaphoreTake(radioLock, portMAX_DELAY) == pdTRUE) {
+        subghz_stop_capture();
+        xSemaphoreGive(radioLock);
+    }
+
+    RawRecording *rec = subghz_take_capture();
+    if (rec == nullptr) {
+        return;
+    }
+    if (rec->codes.empty()) {
+        delete rec;
+        return;
+    }
+    Serial.printf("[RF] hop: captured %u bursts on %.2f MHz\n", (unsigned)rec->codes.size(), mhz);
+    rf_hop_push(slot, rec);
+}
+
+/**
+ * Listen on one channel for its dwell window
+ * @return true if the trigger level was reached
+ */
+static bool rf_hop_visit(RfHopSlot *slot)
+{
+    if (xSemaphoreTake(radioLock, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return false;
+    }
+    bool tuned = rf_retune_rx(&slot->ch);
+    xSemaphoreGive(radioLock);
+    if (!tuned) {
+        return false;
+    }
+
+    rf_hop_freq = slot->ch.hz;
+    slot->stats.visits++;
+
+    int peak = -128;
+    bool triggered = false;
+    uint32_t start = millis();
+    do {
+        // Also gives RSSI time to settle after the IDLE->RX calibration
+        vTaskDelay(pdMS_TO_TICKS(RF_HOP_SAMPLE_MS));
+        if (xSemaphoreTake(radioLock, pdMS_TO_TICKS(5)) != pdTRUE) {
+            continue;
+        }
+        int rssi = ELECHOUSE_cc1101.getRssi();
+        bool cs = rf_hop_cfg.carrier_sense &&
+                  (ELECHOUSE_cc1101.SpiReadStatus(CC1101_PKTSTATUS) & RF_HOP_PKTSTATUS_CS);
+        xSemaphoreGive(radioLock);
+
+        if (rssi > peak) {
+            peak = rssi;
+        }
+        triggered = cs || rssi >= rf_hop_cfg.rssi_threshold;
+    } while (!triggered && rf_hop_active && millis() - start < slot->stats.dwell_ms);
+
+    if (peak > slot->stats.peak_rssi) {
+        slot->stats.peak_rssi = (int8_t)constrain(peak, -128, 0);
+    }
+
+    // Activity decays every visit; a near-threshold peak or a trigger lengthens
+    // the next dwell on this channel, up to dwell_max_ms
+    bool active = triggered || peak >= rf_hop_cfg.rssi_threshold - RF_HOP_ACTIVITY_DB;
+    uint16_t activity = slot->stats.activity - slot->stats.activity / 8;
+    if (active) {
+        activity = min(activity + RF_HOP_ACTIVITY_HIT, RF_HOP_ACTIVITY_FULL);
+    }
+    slot->stats.activity = activity;
+    slot->stats.dwell_ms = rf_hop_cfg.dwell_min_ms +
+        (uint32_t)(rf_hop_cfg.dwell_max_ms - rf_hop_cfg.dwell_min_ms) * activity / RF_HOP_ACTIVITY_FULL;
+
+    if (triggered) {
+        slot->stats.triggers++;
+    }
+    return triggered;
+}
+
+static void rf_hop_task(void *param)
+{
+    uint8_t idx = 0;
+
+    while (1) {
+        if (!rf_hop_active) {
+            rf_hop_running = false;
+            // Parked until rf_hop_start() wakes us
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            idx = 0;
+            continue;
+        }
+
+        rf_hop_running = true;
+        RfHopSlot *slot = &rf_hop_slots[idx];
+        if (rf_hop_visit(slot) && rf_hop_cfg.auto_capture && rf_hop_active) {
+            rf_hop_capture(slot);
+        }
+        idx = (idx + 1) % rf_hop_cfg.count;
+    }
+}
+
+void rf_hop_default_config(RfHopConfig *cfg)
+{
+    memset(cfg, 0, sizeof(*cfg));
+
+    config_lock();
+    for (float mhz : g_config.subghz.hop.freqs) {
+        if (cfg->count < RF_HOP_MAX_FREQS) {
+            cfg->freq_hz[cfg->count++] = rf_freq_mhz_to_hz(mhz);
+        }
+    }
+    config_unlock();
+
+    cfg->rssi_threshold = g_config.subghz.scan.threshold;
+    cfg->carrier_sense = false;
+    cfg->dwell_min_ms = constrain(g_config.subghz.hop.dwell_min_ms, 1, 1000);
+    cfg->dwell_max_ms = constrain(g_config.subghz.hop.dwell_max_ms, cfg->dwell_min_ms, 5000);
+    cfg->auto_capture = true;
+}
+
+bool rf_hop_start(const RfHopConfig *cfg)
+{
+    if (rf_hop_active) {
+        rf_hop_stop();
+    }
+    if (subghz_is_capturing() || subghz_is_scan_recording() || rf_packet_is_active()) {
+        return false;
+    }
+    if (cfg->count < RF_HOP_MIN_FREQS || cfg->count > RF_HOP_MAX_FREQS ||
+        cfg->dwell_min_ms == 0 || cfg->dwell_max_ms < cfg->dwell_min_ms) {
+        return false;
+    }
+    for (uint8_t i = 0; i < cfg->count; i++) {
+        if (!rf_freq_is_valid(cfg->freq_hz[i])) {
+            Serial.printf("[RF] hop: %lu Hz is outside the CC1101 bands\n", (unsigned long)cfg->freq_hz[i]);
+            return false;
+        }
+    }
+
+    if (cfg->auto_capture) {
+        subghz_init();
+        if (!subghz_is_init()) {
+            return false;
+        }
+    }
+
+    if (rf_hop_handle == NULL &&
+        xTaskCreatePinnedToCore(rf_hop_task, "rf_hopper", RF_HOP_TASK_STACK, NULL,
+                                RF_HOP_TASK_PRIORITY, &rf_hop_handle, RF_HOP_TASK_CORE) != pdPASS) {
+        return false;
+    }
+
+    rf_hop_cfg = *cfg;
+    for (uint8_t i = 0; i < cfg->count; i++) {
+        RfHopSlot *slot = &rf_hop_slots[i];
+        slot->ch.hz = cfg->freq_hz[i];
+        slot->ch.freq_word = rf_freq_word(cfg->freq_hz[i]);
+        slot->stats = RfHopChannelStats();
+        slot->stats.freq_hz = cfg->freq_hz[i];
+        slot->stats.peak_rssi = -128;
+        slot->stats.dwell_ms = cfg->dwell_min_ms;
+    }
+
+    rf_hop_active = true;
+    xTaskNotifyGive(rf_hop_handle);
+
+    Serial.printf("[RF] hop: %u channels, dwell %u-%u ms, trigger %d dBm%s\n",
+                  cfg->count, cfg->dwell_min_ms, cfg->dwell_max_ms, cfg->rssi_threshold,
+                  cfg->carrier_sense ? " or CS" : "");
+    return true;
+}
+
+void rf_hop_stop(void)
+{
+    if (!rf_hop_active) {
+        return;
+    }
+
+    rf_hop_active = false;
+    xTaskNotifyGive(rf_hop_handle);
+
+    // A capture notices within one 100ms ring-buffer wait
+    for (int i = 0; i < 50 && rf_hop_running; i++) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    rf_hop_freq = 0;
+
+    if (xSemaphoreTake(radioLock, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        rf_deinitModule();
+        xSemaphoreGive(radioLock);
+    }
+}
+
+bool rf_hop_is_active(void)
+{
+    return rf_hop_active;
+}
+
+uint32_t rf_hop_current_freq(void)
+{
+    return rf_hop_freq;
+}
+
+RawRecording *rf_hop_take_capture(void)
+{
+    uint32_t tail = rf_hop_queue_tail;
+    if (tail == rf_hop_queue_head) {
+        return nullptr;
+    }
+    __sync_synchronize();
+    RawRecording *rec = rf_hop_queue[tail % RF_HOP_QUEUE_SIZE];
+    rf_hop_queue_tail = tail + 1;
+    return rec;
+}
+
+uint8_t rf_hop_get_stats(RfHopChannelStats *out, uint8_t max_out)
+{
+    uint8_t n = min(rf_hop_cfg.count, max_out);
+    for (uint8_t i = 0; i < n; i++) {
+        out[i] = rf_hop_slots[i].stats;
+    }
+    return n;
+}
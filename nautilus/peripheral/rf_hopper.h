@@ -0,0 +1,88 @@
+/**
+ * RF Hopper - round-robin listen over a small set of frequencies
+ * Each channel is held for a dwell window while RSSI and carrier sense are
+ * polled; channels with recent activity earn longer dwells. When a channel
+ * crosses the trigger level the hopper stays on it and records a RAW capture
+ * tagged with that frequency, then resumes hopping.
+ *
+ * Retuning goes through rf_retune_rx(), so a hop is a FREQ write (plus the
+ * cached calibration registers on a segment change and the antenna switch on
+ * a band change), not a full init.
+ */
+
+#ifndef __RF_HOPPER_H__
+#define __RF_HOPPER_H__
+
+#include <Arduino.h>
+
+struct RawRecording;
+
+#define RF_HOP_MIN_FREQS         3
+#define RF_HOP_MAX_FREQS         8
+#define RF_HOP_SAMPLE_MS         1       // RSSI/carrier-sense poll interval inside a dwell
+#define RF_HOP_ACTIVITY_DB       10      // Peaks this close below the trigger still count as activity
+#define RF_HOP_CAPTURE_IDLE_MS   300     // Capture ends after this long without a new burst
+#define RF_HOP_CAPTURE_MAX_MS    3000    // Longest a triggered capture holds the hopper
+#define RF_HOP_QUEUE_SIZE        4       // Finished captures waiting for rf_hop_take_capture()
+#define RF_HOP_TASK_STACK        (1024 * 4)
+#define RF_HOP_TASK_PRIORITY     (tskIDLE_PRIORITY + 2)
+#define RF_HOP_TASK_CORE         0
+
+typedef struct {
+    uint32_t freq_hz[RF_HOP_MAX_FREQS];
+    uint8_t count;              // RF_HOP_MIN_FREQS..RF_HOP_MAX_FREQS
+    int rssi_threshold;         // Trigger level in dBm
+    bool carrier_sense;         // Also trigger on PKTSTATUS.CS
+    uint16_t dwell_min_ms;      // Dwell on a quiet channel
+    uint16_t dwell_max_ms;      // Dwell on a channel active on every recent visit
+    bool auto_capture;          // Record on trigger; otherwise only count triggers
+} RfHopConfig;
+
+typedef struct {
+    uint32_t freq_hz;
+    uint32_t visits;
+    uint32_t triggers;
+    uint32_t captures;          // Captures queued for the caller
+    int8_t peak_rssi;           // Highest RSSI seen on any visit (dBm)
+    uint16_t activity;          // Decayed activity score, 0..256
+    uint16_t dwell_ms;          // Current adaptive dwell
+} RfHopChannelStats;
+
+/**
+ * Fill from g_config.subghz.hop, with scan.threshold as the trigger level
+ */
+void rf_hop_default_config(RfHopConfig *cfg);
+
+/**
+ * Start hopping
+ * @return false for an invalid channel set, or if RAW capture, Scan/Record
+ *         or packet capture own the radio
+ */
+bool rf_hop_start(const RfHopConfig *cfg);
+
+/**
+ * Stop hopping (ending any capture in progress) and release the radio;
+ * queued captures stay available
+ */
+void rf_hop_stop(void);
+
+bool rf_hop_is_active(void);
+
+/**
+ * @return Frequency currently listened to, 0 when stopped
+ */
+uint32_t rf_hop_current_freq(void);
+
+/**
+ * Pop the oldest finished capture; the caller deletes it
+ * @return nullptr if none is waiting
+ */
+RawRecording *rf_hop_take_capture(void);
+
+/**
+ * Copy per-channel statistics
+ * @return Number of channels written to out
+ */
+uint8_t rf_hop_get_stats(RfHopChannelStats *out, uint8_t max_out);
+
+#endif // __RF_HOPPER_H__
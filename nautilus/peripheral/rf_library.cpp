@@ -0,0 +1,664 @@
+/**
+ * RF Library - fingerprint index for the /rf capture library
+ */
+
+#include "rf_library.h"
+#include "rf_utils.h"       // crc64_ecma
+#include "peri_subghz.h"    // subghz_load_file, SUBGHZ_FILE_DIR
+#include "peripheral.h"
+#include "subghz/subghz_binraw.h"  // TE clustering; BinRAW files are fingerprinted from their expansion
+#include <algorithm>
+#include <dirent.h>
+
+// On-card layout: header, then fixed-size RfLibEntry records
+typedef struct {
+    uint32_t magic;
+    uint16_t record_size;
+    uint16_t reserved;
+} RfLibHeader;
+
+#define RF_LIB_MIN_FRAME    8   // Symbols; shorter frames are noise between bursts
+
+typedef struct {
+    RfLibEntry *entries;    // PSRAM, grown on demand
+    size_t count;
+    size_t cap;
+} RfLibTable;
+
+static RfLibTable rf_lib = {};                  // Live index; only touched once rf_lib_loaded
+static SemaphoreHandle_t rf_lib_mutex = NULL;   // Guards the flags below and the swap into rf_lib
+static volatile bool rf_lib_loaded = false;
+static volatile bool rf_lib_building = false;
+static volatile bool rf_lib_rescan = false;     // /rf changed while a pass was running
+static volatile bool rf_lib_cancel = false;     // Card is going away: drop the running pass
+
+static void rf_lib_lock_init(void)
+{
+    if (!rf_lib_mutex) {
+        rf_lib_mutex = xSemaphoreCreateMutex();
+        assert(rf_lib_mutex);
+    }
+}
+
+static bool rf_lib_reserve(RfLibTable *t, size_t n)
+{
+    if (n <= t->cap) {
+        return true;
+    }
+    size_t cap = max(n, t->cap ? t->cap * 2 : (size_t)64);
+    RfLibEntry *p = (RfLibEntry *)ps_realloc(t->entries, cap * sizeof(RfLibEntry));
+    if (p == NULL) {
+        return false;
+    }
+    t->entries = p;
+    t->cap = cap;
+    return true;
+}
+
+static void rf_lib_push(RfLibTable *t, const char *name, uint32_t size, const RfFingerprint *fp)
+{
+    if (!rf_lib_reserve(t, t->count + 1)) {
+        return;
+    }
+    RfLibEntry *e = &t->entries[t->count++];
+    memset(e, 0, sizeof(*e));
+    e->fp = *fp;
+    e->size = size;
+    strlcpy(e->name, name, sizeof(e->name));
+}
+
+static int rf_lib_find_name(const RfLibTable *t, const char *name)
+{
+    for (size_t i = 0; i < t->count; i++) {
+        if (strcmp(t->entries[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void rf_lib_erase(RfLibTable *t, size_t idx)
+{
+    memmove(&t->entries[idx], &t->entries[idx + 1], (t->count - idx - 1) * sizeof(RfLibEntry));
+    t->count--;
+}
+
+static bool rf_lib_write_all(const RfLibTable *t)
+{
+    File f = SD.open(RF_LIB_INDEX_PATH, FILE_WRITE, true);
+    if (!f) {
+        return false;
+    }
+    RfLibHeader hdr = { RF_LIB_INDEX_MAGIC, sizeof(RfLibEntry), 0 };
+    f.write((const uint8_t *)&hdr, sizeof(hdr));
+    if (t->count > 0) {
+        f.write((const uint8_t *)t->entries, t->count * sizeof(RfLibEntry));
+    }
+    f.close();
+    return true;
+}
+
+static void rf_lib_read_index(RfLibTable *t)
+{
+    t->count = 0;
+
+    File f = SD.open(RF_LIB_INDEX_PATH);
+    if (!f) {
+        return;
+    }
+    RfLibHeader hdr;
+    if (f.read((uint8_t *)&hdr, sizeof(hdr)) != sizeof(hdr) ||
+        hdr.magic != RF_LIB_INDEX_MAGIC || hdr.record_size != sizeof(RfLibEntry)) {
+        // Unknown layout: rebuilt from the files by the reconcile pass
+        f.close();
+        return;
+    }
+    size_t n = (f.size() - sizeof(hdr)) / sizeof(RfLibEntry);
+    if (n > 0 && rf_lib_reserve(t, n)) {
+        t->count = f.read((uint8_t *)t->entries, n * sizeof(RfLibEntry)) / sizeof(RfLibEntry);
+    }
+    f.close();
+}
+
+static uint32_t rf_lib_file_size(const char *name)
+{
+    File f = SD.open(String(SUBGHZ_FILE_DIR) + "/" + name);
+    if (!f) {
+        return 0;
+    }
+    uint32_t size = f.size();
+    f.close();
+    return size;
+}
+
+bool rf_library_fingerprint_file(const char *name, RfFingerprint *fp)
+{
+    String path = String(SUBGHZ_FILE_DIR) + "/" + name;
+    RfCodes codes;
+    if (!subghz_load_file(path.c_str(), codes)) {
+        return false;
+    }
+
+#if SUBGHZ_PROTOCOL_BINRAW
+    if (codes.protocol == "BinRAW") {
+        // Expanded through the transmit encoder, so it indexes like the RAW it came from
+        std::vector<int> timings;
+        if (!subghz_binraw_file_timings(path.c_str(), timings)) {
+            return false;
+        }
+        if (timings.size() > RF_LIB_FP_MAX_VALUES) {
+            timings.resize(RF_LIB_FP_MAX_VALUES);
+        }
+        return rf_fingerprint_raw(timings, codes.frequency, fp);
+    }
+#endif
+    if (codes.protocol == "RAW") {
+        std::vector<int32_t> parsed;
+        subghz_parse_raw_line(codes.data, parsed);
+        if (parsed.size() > RF_LIB_FP_MAX_VALUES) {
+            parsed.resize(RF_LIB_FP_MAX_VALUES);
+        }
+        std::vector<int> timings(parsed.begin(), parsed.end());
+        return rf_fingerprint_raw(timings, codes.frequency, fp);
+    }
+    rf_fingerprint_key(codes.protocol.c_str(), codes.key, codes.Bit, codes.frequency, fp);
+    return true;
+}
+
+/**
+ * Symbol alphabet for one capture. With a TE grid every duration maps to its
+ * bias-corrected whole TE multiple; otherwise to the nearest histogram
+ * cluster of its level. Either way the alphabet comes from the bulk of the
+ * durations, so stray noise pulses cannot shift it.
+ */
+typedef struct {
+    SubGhzTeEstimate te;                   // te.te_us == 0 without a TE grid
+    std::vector<SubGhzTeCluster> clusters; // Highs first, then lows, each shortest first
+    size_t first_low;
+} RfLibAlphabet;
+
+static bool rf_lib_alphabet(const std::vector<int> &timings, RfLibAlphabet *a)
+{
+    if (subghz_estimate_te(timings, &a->te)) {
+        return true;
+    }
+    a->te.te_us = 0;
+    a->clusters.clear();
+    subghz_te_clusters(timings, true, a->clusters);
+    a->first_low = a->clusters.size();
+    subghz_te_clusters(timings, false, a->clusters);
+    return !a->clusters.empty();
+}
+
+/**
+ * @return Symbol for one duration below RF_LIB_GAP_US, or -1 if its level has no cluster
+ */
+static int rf_lib_symbol(const RfLibAlphabet *a, int t)
+{
+    bool level = t > 0;
+    int d = abs(t);
+
+    if (a->te.te_us > 0) {
+        int corrected = d + (level ? -a->te.bias_us : a->te.bias_us);
+        int k = max(1, (int)((corrected + (int)a->te.te_us / 2) / (int)a->te.te_us));
+        return k * 2 + (level ? 1 : 0);
+    }
+
+    size_t from = level ? 0 : a->first_low;
+    size_t to = level ? a->first_low : a->clusters.size();
+    int best = -1;
+    int best_diff = 0;
+    for (size_t i = from; i < to; i++) {
+        int diff = abs((int)a->clusters[i].mean_us - d);
+        if (best < 0 || diff < best_diff) {
+            best = i - from;
+            best_diff = diff;
+        }
+    }
+    return best < 0 ? -1 : best * 2 + (level ? 1 : 0);
+}
+
+bool rf_fingerprint_raw(const std::vector<int> &timings, uint32_t freq_hz, RfFingerprint *out)
+{
+    memset(out, 0, sizeof(*out));
+
+    size_t n = min(timings.size(), (size_t)RF_LIB_FP_MAX_VALUES);
+    std::vector<int> head;
+    if (n < timings.size()) {
+        head.assign(timings.begin(), timings.begin() + n);
+    }
+    RfLibAlphabet alphabet;
+    if (!rf_lib_alphabet(n < timings.size() ? head : timings, &alphabet)) {
+        return false;
+    }
+
+    int votes[64] = { 0 };
+    std::vector<int> gram(4);
+    std::vector<int> frame;
+    std::vector<std::pair<uint64_t, int>> frames;   // crc, repeat count
+
+    auto close_frame = [&]() {
+        if (frame.size() >= RF_LIB_MIN_FRAME) {
+            uint64_t crc = crc64_ecma(frame);
+            bool found = false;
+            for (auto &fc : frames) {
+                if (fc.first == crc) {
+                    fc.second++;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                frames.push_back(std::make_pair(crc, 1));
+            }
+
+            for (size_t i = 0; i + 4 <= frame.size(); i++) {
+                std::copy(frame.begin() + i, frame.begin() + i + 4, gram.begin());
+                uint64_t h = crc64_ecma(gram);
+                for (int b = 0; b < 64; b++) {
+                    votes[b] += ((h >> b) & 1) ? 1 : -1;
+                }
+            }
+        }
+        frame.clear();
+    };
+
+    for (size_t i = 0; i < n; i++) {
+        int t = timings[i];
+        int d = abs(t);
+        if (d == 0) {
+            continue;
+        }
+        if (d >= RF_LIB_GAP_US) {
+            close_frame();
+            continue;
+        }
+        int sym = rf_lib_symbol(&alphabet, t);
+        if (sym >= 0) {
+            frame.push_back(sym);
+        }
+    }
+    close_frame();
+
+    if (frames.empty()) {
+        return false;
+    }
+
+    // The most repeated frame is the transmitter's word; how often it was
+    // repeated depends only on how long the button was held
+    size_t best = 0;
+    for (size_t i = 1; i < frames.size(); i++) {
+        if (frames[i].second > frames[best].second) {
+            best = i;
+        }
+    }
+
+    for (int b = 0; b < 64; b++) {
+        if (votes[b] > 0) {
+            out->shape |= (1ULL << b);
+        }
+    }
+    out->exact = frames[best].first;
+    out->freq_hz = freq_hz;
+    uint32_t te_us = alphabet.te.te_us;
+    if (te_us == 0) {
+        te_us = alphabet.clusters[0].mean_us;
+        for (const SubGhzTeCluster &c : alphabet.clusters) {
+            te_us = min(te_us, c.mean_us);
+        }
+    }
+    out->te_us = (uint16_t)min(te_us, (uint32_t)0xFFFF);
+    out->kind = RF_LIB_KIND_RAW;
+    return true;
+}
+
+void rf_fingerprint_key(const char *protocol, uint64_t key, uint16_t bits, uint32_t freq_hz, RfFingerprint *out)
+{
+    memset(out, 0, sizeof(*out));
+
+    std::vector<int> name(protocol, protocol + strlen(protocol));
+    uint64_t proto_crc = crc64_ecma(name);
+
+    std::vector<int> data = name;
+    for (int i = 0; i < 8; i++) {
+        data.push_back((key >> (i * 8)) & 0xFF);
+    }
+    data.push_back(bits & 0xFF);
+
+    // XOR with a per-protocol constant keeps key-bit Hamming distance intact
+    out->shape = key ^ proto_crc;
+    out->exact = crc64_ecma(data);
+    out->freq_hz = freq_hz;
+    out->kind = RF_LIB_KIND_KEY;
+}
+
+uint8_t rf_fingerprint_distance(const RfFingerprint *a, const RfFingerprint *b)
+{
+    if (a->kind != b->kind || a->kind == RF_LIB_KIND_NONE) {
+        return RF_LIB_DIST_NONE;
+    }
+    uint32_t df = (a->freq_hz > b->freq_hz) ? a->freq_hz - b->freq_hz : b->freq_hz - a->freq_hz;
+    if (df > RF_LIB_SAME_FREQ_HZ) {
+        return RF_LIB_DIST_NONE;
+    }
+    return __builtin_popcountll(a->shape ^ b->shape);
+}
+
+/**
+ * One pass of the index in t over /rf. Each SD call takes radioLock on its
+ * own so the display keeps flushing while a large library is fingerprinted.
+ * @return false if /rf is unavailable or the pass was cancelled
+ */
+static bool rf_lib_reconcile(RfLibTable *t, size_t *fingerprinted, size_t *dropped)
+{
+    xSemaphoreTake(radioLock, portMAX_DELAY);
+    if (t->count == 0) {
+        rf_lib_read_index(t);
+    }
+
+    // Same mount point probing as the file browsers
+    const char *mount_points[] = {"/sd", "/sdcard", "/mnt/sd"};
+    DIR *dir = NULL;
+    for (int i = 0; i < 3 && dir == NULL; i++) {
+        char path[64];
+        snprintf(path, sizeof(path), "%s%s", mount_points[i], SUBGHZ_FILE_DIR);
+        dir = opendir(path);
+    }
+    if (dir == NULL) {
+        dir = opendir(SUBGHZ_FILE_DIR);
+    }
+    xSemaphoreGive(radioLock);
+    if (dir == NULL) {
+        return false;
+    }
+
+    size_t indexed = t->count;
+    std::vector<bool> seen(indexed, false);
+    bool changed = false;
+    bool ok = true;
+
+    while (true) {
+        if (rf_lib_cancel) {
+            ok = false;
+            break;
+        }
+        xSemaphoreTake(radioLock, portMAX_DELAY);
+        struct dirent *entry = readdir(dir);
+        xSemaphoreGive(radioLock);
+        if (entry == NULL) {
+            break;
+        }
+        if (entry->d_type != DT_REG) {
+            continue;
+        }
+        size_t len = strlen(entry->d_name);
+        if (len < 5 || len >= RF_LIB_NAME_MAX || strcasecmp(entry->d_name + len - 4, ".sub") != 0) {
+            continue;
+        }
+
+        xSemaphoreTake(radioLock, portMAX_DELAY);
+        uint32_t size = rf_lib_file_size(entry->d_name);
+        xSemaphoreGive(radioLock);
+
+        int idx = rf_lib_find_name(t, entry->d_name);
+        if (idx >= 0 && (size_t)idx < indexed) {
+            seen[idx] = true;
+            if (t->entries[idx].size == size) {
+                continue;
+            }
+        }
+
+        // New file, or rewritten since it was indexed
+        RfFingerprint fp;
+        xSemaphoreTake(radioLock, portMAX_DELAY);
+        if (!rf_library_fingerprint_file(entry->d_name, &fp)) {
+            memset(&fp, 0, sizeof(fp));
+        }
+        xSemaphoreGive(radioLock);
+        if (idx >= 0) {
+            t->entries[idx].fp = fp;
+            t->entries[idx].size = size;
+        } else {
+            rf_lib_push(t, entry->d_name, size, &fp);
+        }
+        (*fingerprinted)++;
+        changed = true;
+    }
+
+    xSemaphoreTake(radioLock, portMAX_DELAY);
+    closedir(dir);
+    xSemaphoreGive(radioLock);
+    if (!ok) {
+        return false;
+    }
+
+    // Drop entries whose file is gone, walking back so indices stay valid
+    for (size_t i = indexed; i-- > 0;) {
+        if (!seen[i]) {
+            rf_lib_erase(t, i);
+            (*dropped)++;
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        xSemaphoreTake(radioLock, portMAX_DELAY);
+        rf_lib_write_all(t);
+        xSemaphoreGive(radioLock);
+    }
+    return true;
+}
+
+static void rf_library_task(void *param)
+{
+    (void)param;
+    RfLibTable t = {};
+    size_t fingerprinted = 0;
+    size_t dropped = 0;
+    size_t count = 0;
+    uint32_t start = millis();
+    bool ok;
+
+    while (true) {
+        rf_lib_rescan = false;
+        ok = rf_lib_reconcile(&t, &fingerprinted, &dropped);
+
+        // Decided under the mutex so a save or delete reported after the
+        // last readdir is never lost
+        xSemaphoreTake(rf_lib_mutex, portMAX_DELAY);
+        if (ok && rf_lib_rescan && !rf_lib_cancel) {
+            xSemaphoreGive(rf_lib_mutex);
+            continue;
+        }
+        ok = ok && !rf_lib_cancel;
+        if (ok) {
+            free(rf_lib.entries);
+            rf_lib = t;
+            rf_lib_loaded = true;
+            count = t.count;
+        } else {
+            free(t.entries);
+        }
+        rf_lib_building = false;
+        xSemaphoreGive(rf_lib_mutex);
+        break;
+    }
+
+    if (ok) {
+        Serial.printf("[RF] library index: %u entries, %u fingerprinted, %u dropped in %lu ms\n",
+                      (unsigned)count, (unsigned)fingerprinted, (unsigned)dropped,
+                      (unsigned long)(millis() - start));
+    } else {
+        Serial.println("[RF] library index not built");
+    }
+    vTaskDelete(NULL);
+}
+
+void rf_library_refresh(void)
+{
+    if (!sd_is_valid()) {
+        return;
+    }
+    rf_lib_lock_init();
+
+    xSemaphoreTake(rf_lib_mutex, portMAX_DELAY);
+    if (rf_lib_building) {
+        rf_lib_rescan = true;
+        xSemaphoreGive(rf_lib_mutex);
+        return;
+    }
+    rf_lib_loaded = false;
+    rf_lib_cancel = false;
+    rf_lib_building = true;
+    xSemaphoreGive(rf_lib_mutex);
+
+    if (xTaskCreatePinnedToCore(rf_library_task, "rf_library", RF_LIB_TASK_STACK, NULL,
+                                RF_LIB_TASK_PRIORITY, NULL, RF_LIB_TASK_CORE) != pdPASS) {
+        rf_lib_building = false;
+    }
+}
+
+bool rf_library_ready(void)
+{
+    if (rf_lib_loaded) {
+        return true;
+    }
+    if (!rf_lib_building) {
+        rf_library_refresh();
+    }
+    return false;
+}
+
+void rf_library_invalidate(void)
+{
+    if (!rf_lib_mutex) {
+        return;
+    }
+    xSemaphoreTake(rf_lib_mutex, portMAX_DELAY);
+    rf_lib_cancel = rf_lib_building;
+    rf_lib_loaded = false;
+    rf_lib.count = 0;
+    xSemaphoreGive(rf_lib_mutex);
+
+    // The pass stops at its next file; the card must not go away under it
+    while (rf_lib_building) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+const RfLibEntry *rf_library_find_duplicate(const RfFingerprint *fp)
+{
+    if (!rf_library_ready()) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < rf_lib.count;) {
+        const RfLibEntry *e = &rf_lib.entries[i];
+        if (e->fp.exact != fp->exact || rf_fingerprint_distance(&e->fp, fp) == RF_LIB_DIST_NONE) {
+            i++;
+            continue;
+        }
+        // Files deleted from the browser since the index was loaded
+        if (!SD.exists(String(SUBGHZ_FILE_DIR) + "/" + e->name)) {
+            rf_lib_erase(&rf_lib, i);
+            rf_lib_write_all(&rf_lib);
+            continue;
+        }
+        return e;
+    }
+    return NULL;
+}
+
+size_t rf_library_find_similar(const RfFingerprint *fp, uint8_t max_dist, RfLibMatch *out, size_t max_out)
+{
+    if (max_out == 0 || !rf_library_ready()) {
+        return 0;
+    }
+
+    std::vector<RfLibMatch> matches;
+    for (size_t i = 0; i < rf_lib.count; i++) {
+        uint8_t d = rf_fingerprint_distance(&rf_lib.entries[i].fp, fp);
+        if (d != RF_LIB_DIST_NONE && d <= max_dist) {
+            matches.push_back({ &rf_lib.entries[i], d });
+        }
+    }
+
+    size_t n = min(max_out, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + n, matches.end(),
+                      [](const RfLibMatch &a, const RfLibMatch &b) { return a.distance < b.distance; });
+    std::copy(matches.begin(), matches.begin() + n, out);
+    return n;
+}
+
+bool rf_library_add(const char *name, const RfFingerprint *fp)
+{
+    if (!rf_lib_loaded) {
+        // Starts a pass, or has the running one (maybe already past this
+        // name) walk /rf again
+        rf_library_refresh();
+        return false;
+    }
+
+    uint32_t size = rf_lib_file_size(name);
+    int idx = rf_lib_find_name(&rf_lib, name);
+    if (idx >= 0) {
+        // Overwritten file: replace in place
+        rf_lib.entries[idx].fp = *fp;
+        rf_lib.entries[idx].size = size;
+        return rf_lib_write_all(&rf_lib);
+    }
+
+    size_t before = rf_lib.count;
+    rf_lib_push(&rf_lib, name, size, fp);
+    if (rf_lib.count == before) {
+        return false;
+    }
+
+    if (!SD.exists(RF_LIB_INDEX_PATH)) {
+        return rf_lib_write_all(&rf_lib);
+    }
+    File f = SD.open(RF_LIB_INDEX_PATH, FILE_APPEND);
+    if (!f) {
+        return false;
+    }
+    f.write((const uint8_t *)&rf_lib.entries[rf_lib.count - 1], sizeof(RfLibEntry));
+    f.close();
+    return true;
+}
+
+void rf_library_remove(const char *name)
+{
+    if (!rf_lib_loaded) {
+        if (rf_lib_building) {
+            rf_library_refresh();
+        }
+        return;
+    }
+    int idx = rf_lib_find_name(&rf_lib, name);
+    if (idx >= 0) {
+        rf_lib_erase(&rf_lib, idx);
+        rf_lib_write_all(&rf_lib);
+    }
+}
+
+int rf_library_next_index(const char *prefix)
+{
+    if (!rf_library_ready()) {
+        return 0;
+    }
+
+    size_t plen = strlen(prefix);
+    int next = 0;
+    for (size_t i = 0; i < rf_lib.count; i++) {
+        const char *name = rf_lib.entries[i].name;
+        if (strncmp(name, prefix, plen) != 0 || name[plen] != '_') {
+            continue;
+        }
+        char *end = NULL;
+        long n = strtol(name + plen + 1, &end, 10);
+        if (end != name + plen + 1 && strcasecmp(end, ".sub") == 0 && n >= next) {
+            next = n + 1;
+        }
+    }
+    return next;
+}
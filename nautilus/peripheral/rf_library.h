@@ -0,0 +1,130 @@
+/**
+ * RF Library - fingerprint index for the /rf capture library
+ * Each .sub file gets a compact fingerprint of its quantized pulse pattern,
+ * kept in one index file so duplicates and look-alikes are found without
+ * opening the captures themselves
+ */
+
+#ifndef __RF_LIBRARY_H__
+#define __RF_LIBRARY_H__
+
+#include <Arduino.h>
+#include <vector>
+
+#define RF_LIB_INDEX_PATH       "/rf/.fpindex"
+#define RF_LIB_INDEX_MAGIC      0x33585046UL   // "FPX3"
+#define RF_LIB_NAME_MAX         40
+#define RF_LIB_GAP_US           5000           // Longer lows split a RAW capture into frames
+#define RF_LIB_SAME_FREQ_HZ     100000         // Captures further apart than this never match
+#define RF_LIB_DIST_NONE        0xFF           // Distance between incomparable fingerprints
+#define RF_LIB_FP_MAX_VALUES    4096           // RAW timings past this are not fingerprinted
+#define RF_LIB_TASK_STACK       (1024 * 6)
+#define RF_LIB_TASK_PRIORITY    (tskIDLE_PRIORITY + 1)
+#define RF_LIB_TASK_CORE        0
+
+typedef enum {
+    RF_LIB_KIND_NONE = 0,    // Unreadable file, tracked for its name only
+    RF_LIB_KIND_RAW,         // RAW_Data pulse pattern
+    RF_LIB_KIND_KEY,         // Decoded protocol key
+} RfLibKind;
+
+typedef struct {
+    uint64_t shape;          // Similarity hash: Hamming distance tracks how different two captures are
+    uint64_t exact;          // crc64_ecma of the dominant frame (RAW) or protocol+key (KEY)
+    uint32_t freq_hz;
+    uint16_t te_us;          // Shortest quantized duration (RAW) or 0
+    uint8_t kind;            // RfLibKind
+    uint8_t reserved;
+} RfFingerprint;
+
+typedef struct {
+    RfFingerprint fp;
+    uint32_t size;                 // File size when fingerprinted; a different size re-fingerprints it
+    char name[RF_LIB_NAME_MAX];    // File name inside /rf
+} RfLibEntry;
+
+typedef struct {
+    const RfLibEntry *entry;
+    uint8_t distance;
+} RfLibMatch;
+
+/**
+ * Fingerprint signed RAW timings (positive = high, negative = low, in us).
+ * Durations are quantized to whole multiples of the capture's estimated TE,
+ * or to its duration histogram clusters when there is no TE grid, so captures
+ * of the same transmitter hash alike despite timing jitter, stray noise
+ * pulses and repeat count. Only the first RF_LIB_FP_MAX_VALUES timings are used.
+ * @return false if the timings hold no usable pulses
+ */
+bool rf_fingerprint_raw(const std::vector<int> &timings, uint32_t freq_hz, RfFingerprint *out);
+
+/**
+ * Fingerprint a file in /rf the same way it would have been at save time
+ * @param name File name inside /rf
+ */
+bool rf_library_fingerprint_file(const char *name, RfFingerprint *out);
+
+/**
+ * Fingerprint a decoded key; keys of one protocol differ in shape by the
+ * Hamming distance of their key bits
+ */
+void rf_fingerprint_key(const char *protocol, uint64_t key, uint16_t bits, uint32_t freq_hz, RfFingerprint *out);
+
+/**
+ * @return Hamming distance of the shapes, or RF_LIB_DIST_NONE for different
+ *         kinds or frequencies
+ */
+uint8_t rf_fingerprint_distance(const RfFingerprint *a, const RfFingerprint *b);
+
+/**
+ * Load the index and reconcile it with /rf in a background task: files
+ * without an entry or whose size changed are fingerprinted, entries without
+ * a file are dropped. Called at SD mount; while a pass runs, another request
+ * makes it walk /rf again before it finishes.
+ */
+void rf_library_refresh(void);
+
+/**
+ * @return true once the index is loaded; if it is not, starts
+ *         rf_library_refresh() instead of waiting for it
+ */
+bool rf_library_ready(void);
+
+/**
+ * Forget the in-memory index (e.g. after the SD card was swapped); cancels
+ * and waits out a running refresh so the card can be released
+ */
+void rf_library_invalidate(void);
+
+/**
+ * Library entry with the same frequency and dominant frame/key, if any.
+ * Entries whose file has since been deleted are dropped on the way.
+ * Always NULL until the index is ready.
+ */
+const RfLibEntry *rf_library_find_duplicate(const RfFingerprint *fp);
+
+/**
+ * Rank library entries by fingerprint distance, closest first
+ * @param max_dist Only entries at or below this distance are returned
+ * @return Number of matches written to out
+ */
+size_t rf_library_find_similar(const RfFingerprint *fp, uint8_t max_dist, RfLibMatch *out, size_t max_out);
+
+/**
+ * Record a newly saved file (name relative to /rf); appends one index record.
+ * While the index is still being built the file is left to the running pass.
+ */
+bool rf_library_add(const char *name, const RfFingerprint *fp);
+
+/**
+ * Drop a file's entry; rewrites the index file
+ */
+void rf_library_remove(const char *name);
+
+/**
+ * @return First unused N for "<prefix>_N.sub", from the index instead of
+ *         probing the card one name at a time; 0 until the index is ready
+ */
+int rf_library_next_index(const char *prefix);
+
+#endif // __RF_LIBRARY_H__
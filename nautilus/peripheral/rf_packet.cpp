@@ -0,0 +1,296 @@
+/**
+ * RF Packet - CC1101 packet-engine capture
+ */
+
+#include "rf_packet.h"
+#include "rf_utils.h"
+#include "rf_hopper.h"
+#include "peripheral.h"
+
+#define RF_PKT_STATUS_LEN       2       // Appended RSSI and LQI/CRC_OK bytes
+#define RF_PKT_OVERFLOW         0x80    // RXBYTES.RXFIFO_OVERFLOW
+#define RF_PKT_CRC_OK           0x80    // Second status byte
+#define RF_PKT_IOCFG2_RXTHR     0x01    // GDO2: RX FIFO at threshold or end of packet
+#define RF_PKT_MCSM1_STAY_RX    0x3C    // CCA default, RXOFF_MODE = RX, TXOFF_MODE = IDLE
+#define RF_PKT_MAX_DRAIN        8       // FIFO reads per wake before yielding the bus
+
+static TaskHandle_t rf_packet_handle = NULL;
+static volatile bool rf_packet_active = false;
+static RfPacketConfig rf_packet_cfg;
+static RfPacketStats rf_packet_stats;
+
+// Ring: rf_packet_task produces, the UI consumes via rf_packet_read()
+static RfPacket *rf_packet_ring = NULL;
+static volatile uint32_t rf_packet_ring_head = 0;
+static volatile uint32_t rf_packet_ring_tail = 0;
+
+// Packet being assembled; a packet longer than the FIFO spans several drains
+static uint8_t rf_packet_buf[1 + RF_PKT_MAX_LEN + RF_PKT_STATUS_LEN];
+static size_t rf_packet_have = 0;
+static size_t rf_packet_need = 0;      // 0 = length byte not read yet (variable mode)
+
+static void IRAM_ATTR rf_packet_isr(void)
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(rf_packet_handle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void rf_packet_reset_assembly(void)
+{
+    rf_packet_have = 0;
+    rf_packet_need = (rf_packet_cfg.length_mode == RF_PKT_LEN_FIXED)
+                     ? rf_packet_cfg.packet_len + RF_PKT_STATUS_LEN : 0;
+}
+
+// Caller holds radioLock
+static void rf_packet_flush_rx(void)
+{
+    ELECHOUSE_cc1101.SpiStrobe(CC1101_SIDLE);
+    ELECHOUSE_cc1101.SpiStrobe(CC1101_SFRX);
+    ELECHOUSE_cc1101.SpiStrobe(CC1101_SRX);
+    rf_packet_reset_assembly();
+}
+
+// Errata: RXBYTES may be read mid-update, so read until two reads agree
+static uint8_t rf_packet_rxbytes(void)
+{
+    uint8_t a = ELECHOUSE_cc1101.SpiReadStatus(CC1101_RXBYTES);
+    uint8_t b;
+    while ((b = ELECHOUSE_cc1101.SpiReadStatus(CC1101_RXBYTES)) != a) {
+        a = b;
+    }
+    return a;
+}
+
+static void rf_packet_push(void)
+{
+    size_t hdr = (rf_packet_cfg.length_mode == RF_PKT_LEN_FIXED) ? 0 : 1;
+    size_t len = rf_packet_need - hdr - RF_PKT_STATUS_LEN;
+    int8_t rssi_raw = (int8_t)rf_packet_buf[rf_packet_need - 2];
+    uint8_t lqi = rf_packet_buf[rf_packet_need - 1];
+    bool crc_ok = !rf_packet_cfg.crc || (lqi & RF_PKT_CRC_OK);
+
+    if (!crc_ok) {
+        rf_packet_stats.crc_errors++;
+    }
+
+    uint32_t head = rf_packet_ring_head;
+    if (head - rf_packet_ring_tail >= RF_PKT_RING_SIZE) {
+        rf_packet_stats.ring_drops++;
+        return;
+    }
+
+    RfPacket *pkt = &rf_packet_ring[head % RF_PKT_RING_SIZE];
+    pkt->t_us = esp_timer_get_time();
+    pkt->freq_mhz = rf_packet_cfg.freq_mhz;
+    pkt->len = len;
+    pkt->rssi = rssi_raw / 2 - 74;     // Datasheet offset for 433 MHz
+    pkt->lqi = lqi & 0x7F;
+    pkt->crc_ok = crc_ok;
+    memcpy(pkt->data, &rf_packet_buf[hdr], len);
+    __sync_synchronize();
+    rf_packet_ring_head = head + 1;
+    rf_packet_stats.received++;
+}
+
+// Move whatever the FIFO holds into the packet being assembled
+static void rf_packet_drain(void)
+{
+    if (xSemaphoreTake(radioLock, portMAX_DELAY) != pdTRUE) {
+        return;
+    }
+
+    for (int n = 0; n < RF_PKT_MAX_DRAIN && rf_packet_active; n++) {
+        uint8_t rxbytes = rf_packet_rxbytes();
+        if (rxbytes & RF_PKT_OVERFLOW) {
+            rf_packet_stats.overflows++;
+            rf_packet_flush_rx();
+            break;
+        }
+
+        size_t avail = rxbytes & 0x7F;
+
+        if (rf_packet_need == 0) {
+            // Errata: never empty the FIFO while a packet is still coming in
+            if (avail < 2) {
+                break;
+            }
+            uint8_t len = ELECHOUSE_cc1101.SpiReadReg(CC1101_RXFIFO);
+            if (len == 0 || len > rf_packet_cfg.packet_len) {
+                rf_packet_stats.bad_len++;
+                rf_packet_flush_rx();
+                break;
+            }
+            rf_packet_buf[0] = len;
+            rf_packet_have = 1;
+            rf_packet_need = 1 + len + RF_PKT_STATUS_LEN;
+            avail--;
+        }
+
+        // The status bytes end the packet, so the last one may be read safely
+        size_t remain = rf_packet_need - rf_packet_have;
+        size_t take = (avail >= remain) ? remain : (avail > 0 ? avail - 1 : 0);
+        if (take == 0) {
+            break;
+        }
+
+        ELECHOUSE_cc1101.SpiReadBurstReg(CC1101_RXFIFO, &rf_packet_buf[rf_packet_have], take);
+        rf_packet_have += take;
+
+        if (rf_packet_have == rf_packet_need) {
+            rf_packet_push();
+            rf_packet_reset_assembly();
+        }
+    }
+
+    xSemaphoreGive(radioLock);
+}
+
+static void rf_packet_task(void *param)
+{
+    while (1) {
+        if (!rf_packet_active) {
+            // Parked until rf_packet_start() wakes us
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        // GDO2 edge; the timeout covers a FIFO left non-empty, which keeps
+        // GDO2 asserted and so produces no further edge
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RF_PKT_POLL_MS));
+        if (rf_packet_active) {
+            rf_packet_drain();
+        }
+    }
+}
+
+void rf_packet_default_config(RfPacketConfig *cfg)
+{
+    cfg->freq_mhz = 433.92f;
+    cfg->modulation = 0;
+    cfg->data_rate_kbaud = 4.8f;
+    cfg->deviation_khz = 20.0f;
+    cfg->rx_bw_khz = 101.0f;
+    cfg->sync_word = 0xD391;
+    cfg->sync_mode = 2;
+    cfg->length_mode = RF_PKT_LEN_VARIABLE;
+    cfg->packet_len = 61;
+    cfg->crc = true;
+    cfg->manchester = false;
+}
+
+bool rf_packet_start(const RfPacketConfig *cfg)
+{
+    if (rf_packet_active) {
+        rf_packet_stop();
+    }
+    if (subghz_is_capturing() || subghz_is_scan_recording() || rf_hop_is_active()) {
+        return false;
+    }
+    if (cfg->packet_len == 0) {
+        return false;
+    }
+
+    if (rf_packet_ring == NULL) {
+        rf_packet_ring = (RfPacket *)ps_malloc(RF_PKT_RING_SIZE * sizeof(RfPacket));
+        if (rf_packet_ring == NULL) {
+            return false;
+        }
+    }
+    if (rf_packet_handle == NULL &&
+        xTaskCreatePinnedToCore(rf_packet_task, "rf_packet", RF_PKT_TASK_STACK, NULL,
+                                RF_PKT_TASK_PRIORITY, &rf_packet_handle, RF_PKT_TASK_CORE) != pdPASS) {
+        return false;
+    }
+
+    if (xSemaphoreTake(radioLock, pdMS_TO_TICKS(1000)) != pdTRUE) {
+        return false;
+    }
+
+    // Base init leaves the radio in async serial mode; the packet engine is set up on top
+    if (!rf_initModule("", cfg->freq_mhz)) {
+        xSemaphoreGive(radioLock);
+        return false;
+    }
+
+    ELECHOUSE_cc1101.setModulation(cfg->modulation);
+    ELECHOUSE_cc1101.setDRate(cfg->data_rate_kbaud);
+    if (cfg->modulation != 2) {
+        ELECHOUSE_cc1101.setDeviation(cfg->deviation_khz);
+    }
+    ELECHOUSE_cc1101.setRxBW(cfg->rx_bw_khz);
+
+    ELECHOUSE_cc1101.setPktFormat(0);           // Normal mode: FIFOs
+    ELECHOUSE_cc1101.setSyncMode(cfg->sync_mode);
+    ELECHOUSE_cc1101.setSyncWord(cfg->sync_word >> 8, cfg->sync_word & 0xFF);
+    ELECHOUSE_cc1101.setLengthConfig(cfg->length_mode == RF_PKT_LEN_FIXED ? 0 : 1);
+    ELECHOUSE_cc1101.setPacketLength(cfg->packet_len);
+    ELECHOUSE_cc1101.setCrc(cfg->crc);
+    ELECHOUSE_cc1101.setCRC_AF(false);          // Keep bad-CRC packets so they can be counted
+    ELECHOUSE_cc1101.setAppendStatus(true);
+    ELECHOUSE_cc1101.setAdrChk(0);
+    ELECHOUSE_cc1101.setWhiteData(false);
+    ELECHOUSE_cc1101.setManchester(cfg->manchester);
+
+    ELECHOUSE_cc1101.SpiWriteReg(CC1101_FIFOTHR, RF_PKT_FIFO_THR);
+    ELECHOUSE_cc1101.SpiWriteReg(CC1101_IOCFG2, RF_PKT_IOCFG2_RXTHR);
+    ELECHOUSE_cc1101.SpiWriteReg(CC1101_MCSM1, RF_PKT_MCSM1_STAY_RX);
+
+    rf_packet_cfg = *cfg;
+    rf_packet_stats = RfPacketStats();
+    rf_packet_flush_rx();
+
+    xSemaphoreGive(radioLock);
+
+    pinMode(BOARD_SGHZ_IO2, INPUT);
+    attachInterrupt(digitalPinToInterrupt(BOARD_SGHZ_IO2), rf_packet_isr, RISING);
+
+    rf_packet_active = true;
+    xTaskNotifyGive(rf_packet_handle);
+
+    Serial.printf("[RF] packet capture: %.2f MHz mod=%u %.2f kBaud sync=%04X len=%s/%u crc=%u\n",
+                  cfg->freq_mhz, cfg->modulation, cfg->data_rate_kbaud, cfg->sync_word,
+                  cfg->length_mode == RF_PKT_LEN_FIXED ? "fixed" : "var", cfg->packet_len, cfg->crc);
+    return true;
+}
+
+void rf_packet_stop(void)
+{
+    if (!rf_packet_active) {
+        return;
+    }
+
+    rf_packet_active = false;
+    detachInterrupt(digitalPinToInterrupt(BOARD_SGHZ_IO2));
+
+    if (xSemaphoreTake(radioLock, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        ELECHOUSE_cc1101.SpiStrobe(CC1101_SIDLE);
+        ELECHOUSE_cc1101.SpiStrobe(CC1101_SFRX);
+        // Next rf_initModule() restores async serial mode and GDO2 data output
+        rf_deinitModule();
+        xSemaphoreGive(radioLock);
+    }
+}
+
+bool rf_packet_is_active(void)
+{
+    return rf_packet_active;
+}
+
+bool rf_packet_read(RfPacket *pkt)
+{
+    uint32_t tail = rf_packet_ring_tail;
+    if (tail == rf_packet_ring_head) {
+        return false;
+    }
+    __sync_synchronize();
+    *pkt = rf_packet_ring[tail % RF_PKT_RING_SIZE];
+    rf_packet_ring_tail = tail + 1;
+    return true;
+}
+
+void rf_packet_get_stats(RfPacketStats *st)
+{
+    *st = rf_packet_stats;
+}
@@ -0,0 +1,88 @@
+/**
+ * RF Packet - CC1101 packet-engine capture
+ * The radio does bit sync, sync-word match, length handling and CRC itself;
+ * GDO2 interrupts on RX FIFO threshold / end of packet and rf_packet_task
+ * drains whole payloads into a PSRAM ring. For known-rate protocols this
+ * replaces RMT edge timing, which is still used for everything else.
+ *
+ * GDO2 is the async-mode data line too, so packet capture cannot run while
+ * RAW capture or Scan/Record own the radio.
+ */
+
+#ifndef __RF_PACKET_H__
+#define __RF_PACKET_H__
+
+#include <Arduino.h>
+
+#define RF_PKT_MAX_LEN          255     // Payload bytes (variable length byte excluded)
+#define RF_PKT_RING_SIZE        32
+#define RF_PKT_FIFO_THR         7       // FIFOTHR: RX threshold 32 bytes, half the FIFO
+#define RF_PKT_POLL_MS          10      // Wake-up when no GDO2 edge arrives (e.g. FIFO never emptied)
+#define RF_PKT_TASK_STACK       (1024 * 3)
+#define RF_PKT_TASK_PRIORITY    (tskIDLE_PRIORITY + 3)
+#define RF_PKT_TASK_CORE        0
+
+typedef enum {
+    RF_PKT_LEN_FIXED = 0,       // Every packet is packet_len bytes
+    RF_PKT_LEN_VARIABLE,        // First byte after the sync word is the length, up to packet_len
+} RfPacketLengthMode;
+
+typedef struct {
+    float freq_mhz;
+    uint8_t modulation;         // ELECHOUSE setModulation(): 0 2-FSK, 1 GFSK, 2 ASK/OOK, 3 4-FSK, 4 MSK
+    float data_rate_kbaud;
+    float deviation_khz;        // FSK/GFSK/MSK only
+    float rx_bw_khz;
+    uint16_t sync_word;
+    uint8_t sync_mode;          // MDMCFG2 SYNC_MODE: 1 = 15/16, 2 = 16/16, 3 = 30/32 sync bits
+    uint8_t length_mode;        // RfPacketLengthMode
+    uint8_t packet_len;         // Fixed length, or maximum accepted in variable mode
+    bool crc;                   // Check CRC16 in hardware
+    bool manchester;
+} RfPacketConfig;
+
+typedef struct {
+    int64_t t_us;               // esp_timer time the packet was completed
+    float freq_mhz;
+    uint8_t len;
+    int8_t rssi;                // dBm, from the appended status bytes
+    uint8_t lqi;
+    bool crc_ok;                // Always true with crc disabled
+    uint8_t data[RF_PKT_MAX_LEN];
+} RfPacket;
+
+typedef struct {
+    uint32_t received;          // Packets pushed into the ring
+    uint32_t crc_errors;        // Packets whose status byte had CRC_OK clear
+    uint32_t ring_drops;        // Packets dropped because the ring was full
+    uint32_t overflows;         // RX FIFO overflows (FIFO flushed, partial packet lost)
+    uint32_t bad_len;           // Variable-length bytes of 0 or above packet_len
+} RfPacketStats;
+
+/**
+ * Defaults: 433.92 MHz 2-FSK, 4.8 kBaud, sync 0xD391 (16/16), variable length
+ */
+void rf_packet_default_config(RfPacketConfig *cfg);
+
+/**
+ * Program the packet engine and start receiving
+ * @return false if the radio is busy with RAW capture or Scan/Record, or init failed
+ */
+bool rf_packet_start(const RfPacketConfig *cfg);
+
+/**
+ * Stop receiving and release the radio; packets left in the ring stay readable
+ */
+void rf_packet_stop(void);
+
+bool rf_packet_is_active(void);
+
+/**
+ * Pop the oldest packet
+ * @return false if the ring is empty
+ */
+bool rf_packet_read(RfPacket *pkt);
+
+void rf_packet_get_stats(RfPacketStats *st);
+
+#endif // __RF_PACKET_H__
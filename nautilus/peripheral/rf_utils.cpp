@@ -109,6 +109,19 @@ const float subghz_mhz_list[] = {
 };
 
 static bool cc1101_spi_ready = false;
+static int rf_rx_segment = -1;   // Calibration segment of the tuned channel, -1 if not receiving
+static uint8_t rf_antenna = 200;   // Antenna switch position (band index), 200 = not set yet
+
+#define RF_ANT_FAST_SETTLE_US 200  // Switch settling on the retune path; full inits keep 10 ms
+
+// Registers setMHZ() left behind on the last full RX init per calibration segment
+typedef struct {
+    bool valid;
+    uint8_t fsctrl0;
+    uint8_t fscal2;
+    uint8_t test0;
+} RfSegmentRegs;
+static RfSegmentRegs rf_segment_regs[RF_FREQ_CAL_SEGMENT_COUNT];
 
 // Cache for combined frequency list
 static std::vector<float> cached_combined_list;
@@ -126,9 +139,10 @@ void rf_invalidate_frequency_cache() {
 /**
  * Get combined frequency list (hardcoded + custom from config)
  * Returns a vector containing all 57 default frequencies plus any custom ones from nautilus.json
- * Result is cached for efficiency - call rf_invalidate_frequency_cache() when custom frequencies change
+ * Result is cached and returned by reference - call rf_invalidate_frequency_cache() when custom
+ * frequencies change; the reference is only valid until then
  */
-std::vector<float> rf_get_combined_frequency_list() {
+const std::vector<float> &rf_get_combined_frequency_list() {
     // Check if cache is still valid (same number of custom frequencies)
     if (cache_valid && cached_custom_count == g_config.subghz.custom_frequencies.size()) {
         return cached_combined_list;
@@ -145,11 +159,13 @@ std::vector<float> rf_get_combined_frequency_list() {
     // Add custom frequencies from config (avoiding duplicates)
     for (size_t i = 0; i < g_config.subghz.custom_frequencies.size(); i++) {
         float custom_freq = g_config.subghz.custom_frequencies[i];
+        uint32_t custom_hz = rf_freq_mhz_to_hz(custom_freq);
 
-        // Check if this frequency already exists in the list
+        // Check if this frequency already exists in the list (within 10 kHz)
         bool is_duplicate = false;
         for (size_t j = 0; j < cached_combined_list.size(); j++) {
-            if (fabs(cached_combined_list[j] - custom_freq) < 0.01f) {
+            uint32_t hz = rf_freq_mhz_to_hz(cached_combined_list[j]);
+            if ((hz > custom_hz ? hz - custom_hz : custom_hz - hz) < 10000) {
                 is_duplicate = true;
                 break;
             }
@@ -196,6 +212,28 @@ void rf_initCC1101(SPIClass *SSPI) {
     ELECHOUSE_cc1101.setGDO0(BOARD_SGHZ_IO0);
 }
 
+/**
+ * Point the antenna switch at a band
+ * SW1:1  SW0:0 --- 315MHz
+ * SW1:1  SW0:1 --- 433MHz
+ * SW1:0  SW0:1 --- 868/915MHz
+ */
+static void rf_set_antenna(uint8_t antenna, bool fast) {
+    if (antenna == rf_antenna) {
+        return;
+    }
+
+    digitalWrite(BOARD_SGHZ_SW1, antenna == 2 ? LOW : HIGH);
+    digitalWrite(BOARD_SGHZ_SW0, antenna == 0 ? LOW : HIGH);
+    rf_antenna = antenna;
+
+    if (fast) {
+        delayMicroseconds(RF_ANT_FAST_SETTLE_US);
+    } else {
+        vTaskDelay(10 / portTICK_PERIOD_MS);
+    }
+}
+
 /**
  * Set antenna switch based on frequency
  * Nautilus has SW1=GPIO47, SW0=GPIO48
@@ -206,31 +244,52 @@ void rf_setFrequency(float frequency) {
         Serial.println("[RF] Frequency out of band, using 433.92");
     }
 
-    static uint8_t antenna = 200; // First run flag
-
-    // SW1:1  SW0:0 --- 315MHz
-    // SW1:1  SW0:1 --- 433MHz
-    // SW1:0  SW0:1 --- 868/915MHz
-    if (frequency <= 350 && antenna != 0) {
-        digitalWrite(BOARD_SGHZ_SW1, HIGH);
-        digitalWrite(BOARD_SGHZ_SW0, LOW);
-        antenna = 0;
-        vTaskDelay(10 / portTICK_PERIOD_MS);
-    } else if (frequency > 350 && frequency < 468 && antenna != 1) {
-        digitalWrite(BOARD_SGHZ_SW1, HIGH);
-        digitalWrite(BOARD_SGHZ_SW0, HIGH);
-        antenna = 1;
-        vTaskDelay(10 / portTICK_PERIOD_MS);
-    } else if (frequency > 778 && antenna != 2) {
-        digitalWrite(BOARD_SGHZ_SW1, LOW);
-        digitalWrite(BOARD_SGHZ_SW0, HIGH);
-        antenna = 2;
-        vTaskDelay(10 / portTICK_PERIOD_MS);
+    if (frequency <= 350) {
+        rf_set_antenna(0, false);
+    } else if (frequency < 468) {
+        rf_set_antenna(1, false);
+    } else if (frequency > 778) {
+        rf_set_antenna(2, false);
     }
 
     ELECHOUSE_cc1101.setMHZ(frequency);
 }
 
+/**
+ * Move the receiver to another channel
+ * While receiving, a channel in the same calibration segment only needs the
+ * precomputed FREQ word; autocalibration runs on the IDLE->RX transition. A
+ * segment change additionally restores FSCTRL0/FSCAL2/TEST0 cached from that
+ * segment's last full init and flips the antenna switch on a band change. A
+ * segment with nothing cached, or a radio not receiving, falls back to a full
+ * rf_initModule().
+ *
+ * @param ch Channel from an RfFreqPlan
+ */
+bool rf_retune_rx(const RfChannel *ch) {
+    int band = rf_freq_band(ch->hz);
+    int segment = rf_freq_cal_segment(ch->hz);
+    if (!cc1101_spi_ready || segment < 0 || rf_rx_segment < 0 ||
+        (segment != rf_rx_segment && !rf_segment_regs[segment].valid)) {
+        return rf_initModule("rx", rf_freq_hz_to_mhz(ch->hz));
+    }
+
+    ELECHOUSE_cc1101.setSidle();
+    if (segment != rf_rx_segment) {
+        const RfSegmentRegs *regs = &rf_segment_regs[segment];
+        ELECHOUSE_cc1101.SpiWriteReg(CC1101_FSCTRL0, regs->fsctrl0);
+        ELECHOUSE_cc1101.SpiWriteReg(CC1101_FSCAL2, regs->fscal2);
+        ELECHOUSE_cc1101.SpiWriteReg(CC1101_TEST0, regs->test0);
+        rf_set_antenna(band, true);
+        rf_rx_segment = segment;
+    }
+    ELECHOUSE_cc1101.SpiWriteReg(CC1101_FREQ2, (ch->freq_word >> 16) & 0xFF);
+    ELECHOUSE_cc1101.SpiWriteReg(CC1101_FREQ1, (ch->freq_word >> 8) & 0xFF);
+    ELECHOUSE_cc1101.SpiWriteReg(CC1101_FREQ0, ch->freq_word & 0xFF);
+    ELECHOUSE_cc1101.SetRx();
+    return true;
+}
+
 /**
  * Initialize RF module
  *
@@ -277,6 +336,7 @@ bool rf_initModule(String mode, float frequency) {
     ELECHOUSE_cc1101.setPktFormat(3);   // Asynchronous serial mode (CRITICAL for RMT!)
 
     rf_setFrequency(frequency);
+    rf_rx_segment = -1;
 
     // Set mode
     if (mode == "tx") {
@@ -286,6 +346,14 @@ bool rf_initModule(String mode, float frequency) {
     } else if (mode == "rx") {
         pinMode(BOARD_SGHZ_IO2, INPUT);  // GDO2 for RX
         ELECHOUSE_cc1101.SetRx();
+        rf_rx_segment = rf_freq_cal_segment(rf_freq_mhz_to_hz(frequency));
+        if (rf_rx_segment >= 0) {
+            RfSegmentRegs *regs = &rf_segment_regs[rf_rx_segment];
+            regs->fsctrl0 = ELECHOUSE_cc1101.SpiReadReg(CC1101_FSCTRL0);
+            regs->fscal2 = ELECHOUSE_cc1101.SpiReadReg(CC1101_FSCAL2);
+            regs->test0 = ELECHOUSE_cc1101.SpiReadReg(CC1101_TEST0);
+            regs->valid = true;
+        }
     } 
 
     cc1101_spi_ready = true;
@@ -296,6 +364,7 @@ bool rf_initModule(String mode, float frequency) {
  * Deinitialize RF module
  */
 void rf_deinitModule() {
+    rf_rx_segment = -1;
     if (cc1101_spi_ready) {
         ELECHOUSE_cc1101.setSidle();
         cc1101_spi_ready = false;
@@ -441,6 +510,7 @@ bool rf_sendCommand(struct RfCodes rfcode) {
 
         // Special handling for Security+ 1.0 (two-packet alternating transmission)
         if (protocol == "Security+ 1.0") {
+#if SUBGHZ_PROTOCOL_SECPLUS_V1
             SecPlusV1Protocol* secplus = static_cast<SecPlusV1Protocol*>(proto);
 
             // Check if button held down for continuous transmission
@@ -513,9 +583,11 @@ bool rf_sendCommand(struct RfCodes rfcode) {
                 rf_last_error = RF_TX_ENCODING_ERROR;
                 success = false;
             }
+#endif
         }
         // Special handling for Security+ 2.0 (two-burst transmission)
         else if (protocol == "Security+ 2.0") {
+#if SUBGHZ_PROTOCOL_SECPLUS_V2
             SecPlusV2Protocol* secplus = static_cast<SecPlusV2Protocol*>(proto);
 
             // Construct 40-bit fixed code from button + serial (like Flipper does)
@@ -593,6 +665,7 @@ bool rf_sendCommand(struct RfCodes rfcode) {
                 rf_last_error = RF_TX_ENCODING_ERROR;
                 success = false;
             }
+#endif
         }
         // Special handling for BinRAW (requires deserializeFromFile)
         else if (protocol == "BinRAW") {
@@ -687,18 +760,22 @@ bool rf_sendCommand(struct RfCodes rfcode) {
             if (proto->encode(params)) {
                 // For CAME and Princeton protocols, use direct GPIO transmission
                 if (protocol == "CAME") {
+#if SUBGHZ_PROTOCOL_CAME
                     // Check if button held down for continuous transmission
                     bool continuous = (digitalRead(ENCODER_KEY) == LOW);
 
                     CAMEProtocol* came = static_cast<CAMEProtocol*>(proto);
                     success = came->transmitDirect(BOARD_SGHZ_IO0, continuous);
+#endif
 
                 } else if (protocol == "Princeton") {
+#if SUBGHZ_PROTOCOL_PRINCETON
                     // Check if button held down for continuous transmission
                     bool continuous = (digitalRead(ENCODER_KEY) == LOW);
 
                     PrincetonProtocol* princeton = static_cast<PrincetonProtocol*>(proto);
                     success = princeton->transmitDirect(BOARD_SGHZ_IO0, continuous);
+#endif
 
                 } else {
                     // Other protocols: try RMT items
@@ -828,6 +905,7 @@ bool rf_transmitFile(String filepath) {
     }
     databaseFile.close();
 
+#if SUBGHZ_PROTOCOL_SECPLUS_V2
     // Decode Security+ 2.0 packets if present
     if (selected_code.protocol == "Security+ 2.0" && secplus_packet1 != 0 && keyList.size() > 0) {
         uint64_t secplus_packet2 = keyList[0];  // Key field contains packet 2
@@ -847,6 +925,7 @@ bool rf_transmitFile(String filepath) {
             }
         }
     }
+#endif
 
     // Count actual signals (key/bit pairs count as 1, RAW data counts as 1)
     size_t signal_count = (keyList.size() > bitList.size()) ? keyList.size() : bitList.size();
@@ -10,6 +10,7 @@
 #include <ELECHOUSE_CC1101_SRC_DRV.h>
 #include <driver/rmt.h>
 #include <vector>
+#include "rf_freq_plan.h"
 
 // RMT Configuration
 #define SUBGHZ_RMT_RX_CHANNEL RMT_CHANNEL_6
@@ -26,7 +27,7 @@ extern const char *subghz_frequency_ranges[];
 extern const int range_limits[4][2];
 
 // Combined frequency list (hardcoded + custom from config)
-std::vector<float> rf_get_combined_frequency_list();
+const std::vector<float> &rf_get_combined_frequency_list();
 int rf_get_combined_frequency_count();
 void rf_invalidate_frequency_cache();  // Call when custom frequencies change
 
@@ -50,6 +51,7 @@ bool rf_initModule(String mode = "", float frequency = 0);
 void rf_deinitModule();
 void rf_initCC1101(SPIClass *SSPI);
 void rf_setFrequency(float frequency);
+bool rf_retune_rx(const RfChannel *ch);
 
 // Transmission functions
 bool rf_sendRaw(int *ptrtransmittimings);
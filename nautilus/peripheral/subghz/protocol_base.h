@@ -13,6 +13,8 @@
 #include <Arduino.h>
 #include <driver/rmt.h>
 #include <FS.h>
+#include "subghz_edges.h"
+#include "subghz_protocol_config.h"
 
 /**
  * Protocol decode result
@@ -47,13 +49,42 @@ struct ProtocolEncodeParams {
     int repeat_count;        // Number of transmissions (0 = use protocol default)
 };
 
+/**
+ * Protocol timing descriptor
+ * One constexpr instance per protocol. Decoders build their pulse windows
+ * from it at compile time; the registry reads it through timing() to skip
+ * decoders a capture cannot satisfy without a virtual call.
+ */
+struct SubGhzTiming {
+    uint32_t te_short;       // Short pulse/gap (us)
+    uint32_t te_long;        // Long pulse/gap (us)
+    uint32_t te_delta;       // Edge-decoder tolerance, +/- us
+    uint32_t preamble;       // Header/sync low (us), 0 = not fixed
+    uint8_t bit_count;       // Shortest valid frame, 0 = no RX decoder
+    uint16_t min_items;      // Fewer RMT items or edges cannot decode
+};
+
 /**
  * Abstract base class for SubGHz protocols
  */
 class SubGhzProtocol {
+private:
+    const SubGhzTiming* timing_desc;
+
+protected:
+    SubGhzProtocol() : timing_desc(nullptr) {}
+    explicit SubGhzProtocol(const SubGhzTiming& timing) : timing_desc(&timing) {}
+
 public:
     virtual ~SubGhzProtocol() {}
 
+    /**
+     * Timing descriptor, nullptr if the protocol has none
+     */
+    const SubGhzTiming* timing() const {
+        return timing_desc;
+    }
+
     /**
      * Get protocol name (e.g., "CAME", "Princeton", "RAW")
      */
@@ -136,6 +167,26 @@ public:
         return false;
     }
 
+    /**
+     * Run the state machine over packed edges, stopping at the first decode.
+     * Callers reset() first.
+     * @param edges Span built by SubGhzEdgeWriter
+     * @param result Output: decode result (only valid if returns true)
+     * @return true if decode_check() succeeded on some edge
+     */
+    virtual bool feed_span(const SubGhzEdgeSpan& edges, ProtocolDecodeResult& result) {
+        SubGhzEdgeReader reader(edges);
+        bool level;
+        uint32_t duration;
+        while (reader.next(level, duration)) {
+            feed(level, duration);
+            if (decode_check(result)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     /**
      * Get minimum number of RMT items this protocol needs for detection
      * Used to optimize decoder attempts
@@ -173,16 +224,49 @@ public:
  */
 
 /**
- * Check if pulse duration matches expected value within tolerance
- *
- * @param duration_us Measured pulse duration in microseconds
- * @param expected_us Expected duration
- * @param tolerance_percent Tolerance percentage (e.g., 20 for +/-20%)
- * @return true if duration is within tolerance
+ * Inclusive duration window, tested with one subtraction and one compare
+ */
+struct SubGhzPulseWindow {
+    uint32_t lo;
+    uint32_t width;
+
+    inline bool contains(uint32_t duration_us) const {
+        return duration_us - lo <= width;
+    }
+};
+
+/**
+ * Window of expected_us +/- delta_us, clamped at 0
+ */
+constexpr SubGhzPulseWindow pulse_window(uint32_t expected_us, uint32_t delta_us) {
+    return SubGhzPulseWindow{ expected_us > delta_us ? expected_us - delta_us : 0,
+                              expected_us > delta_us ? 2 * delta_us : expected_us + delta_us };
+}
+
+/**
+ * Window of expected_us +/- tolerance_percent
+ * For TEs only known at runtime; build it once per frame, not per edge
+ */
+constexpr SubGhzPulseWindow pulse_window_pct(uint32_t expected_us, uint8_t tolerance_percent) {
+    return pulse_window(expected_us, expected_us * tolerance_percent / 100);
+}
+
+/**
+ * Check if pulse duration is within Expected +/- Delta us
+ * The window is fixed at compile time
+ */
+template<uint32_t Expected, uint32_t Delta>
+inline bool pulse_in(uint32_t duration_us) {
+    static_assert(Delta <= Expected, "pulse window starts below 0");
+    return duration_us - (Expected - Delta) <= 2 * Delta;
+}
+
+/**
+ * Check if pulse duration is within Expected +/- Percent %
  */
-inline bool pulse_matches(uint32_t duration_us, uint32_t expected_us, uint8_t tolerance_percent = 30) {
-    uint32_t tolerance = (expected_us * tolerance_percent) / 100;
-    return (duration_us >= expected_us - tolerance) && (duration_us <= expected_us + tolerance);
+template<uint32_t Expected, uint8_t Percent>
+inline bool pulse_in_pct(uint32_t duration_us) {
+    return pulse_in<Expected, Expected * Percent / 100>(duration_us);
 }
 
 /**
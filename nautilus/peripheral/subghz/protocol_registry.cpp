@@ -6,3 +6,5 @@
 
 // Initialize singleton instance
 ProtocolRegistry* ProtocolRegistry::instance = nullptr;
+
+SubGhzProtocolDesc* ProtocolRegistry::descriptors = nullptr;
@@ -3,6 +3,10 @@
  *
  * Manages registration and lookup of all available SubGHz protocols.
  * Provides auto-detection by attempting all registered decoders.
+ *
+ * Protocols register themselves with SUBGHZ_REGISTER_PROTOCOL() in their
+ * own .cpp, so compiling one out (see subghz_protocol_config.h) removes it
+ * from the registry without touching a central list.
  */
 
 #ifndef __PROTOCOL_REGISTRY_H__
@@ -11,17 +15,111 @@
 #include "protocol_base.h"
 #include <vector>
 
+#define SUBGHZ_PROTOCOL_SLOTS 16    // Name hash table size, power of two above the protocol count
+
+/**
+ * FNV-1a hash of a protocol name, evaluated at compile time for literals
+ */
+constexpr uint32_t subghz_name_hash(const char* name, uint32_t hash = 0x811C9DC5) {
+    return *name ? subghz_name_hash(name + 1, (hash ^ (uint8_t)*name) * 0x01000193) : hash;
+}
+
+/**
+ * Static protocol descriptor, one per SUBGHZ_REGISTER_PROTOCOL()
+ */
+struct SubGhzProtocolDesc {
+    const char* name;                // Must match getName()
+    uint32_t name_hash;
+    uint8_t priority;                // Auto-detect order, lowest first
+    SubGhzProtocol* (*create)();
+    SubGhzProtocolDesc* next;        // Linked at static init, sorted by priority
+};
+
+/**
+ * Register a protocol class from its .cpp
+ * The descriptor is constant-initialised; only linking it runs at startup,
+ * and instances are created by subghz_protocols_init()
+ *
+ * @param cls Protocol class, default-constructible
+ * @param name Protocol name as written to .sub files
+ * @param priority Auto-detect order; more specific decoders go first
+ */
+#define SUBGHZ_REGISTER_PROTOCOL(cls, name, priority) \
+    static SubGhzProtocol* cls##_create() { \
+        return new cls(); \
+    } \
+    static SubGhzProtocolDesc cls##_desc = { name, subghz_name_hash(name), priority, cls##_create, nullptr }; \
+    static const bool cls##_linked __attribute__((unused)) = ProtocolRegistry::link(&cls##_desc)
+
 /**
  * Protocol Registry - Singleton pattern
  */
 class ProtocolRegistry {
 private:
+    struct Slot {
+        uint32_t hash;
+        SubGhzProtocol* proto;       // nullptr = empty
+    };
+
     std::vector<SubGhzProtocol*> protocols;
+    Slot slots[SUBGHZ_PROTOCOL_SLOTS];
 
     // Singleton instance
     static ProtocolRegistry* instance;
 
-    ProtocolRegistry() {}
+    // Statically registered protocols; a plain pointer, so it is valid
+    // before any SUBGHZ_REGISTER_PROTOCOL() initialiser runs
+    static SubGhzProtocolDesc* descriptors;
+
+    ProtocolRegistry() {
+        memset(slots, 0, sizeof(slots));
+    }
+
+    /**
+     * Slot holding hash, or the empty slot where it would go
+     */
+    Slot* findSlot(uint32_t hash) {
+        size_t i = hash & (SUBGHZ_PROTOCOL_SLOTS - 1);
+        for (size_t n = 0; n < SUBGHZ_PROTOCOL_SLOTS; n++) {
+            Slot* slot = &slots[(i + n) & (SUBGHZ_PROTOCOL_SLOTS - 1)];
+            if (slot->proto == nullptr || slot->hash == hash) {
+                return slot;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Add to the detect order and the name table; takes ownership
+     */
+    void insert(SubGhzProtocol* protocol, uint32_t hash) {
+        Slot* slot = findSlot(hash);
+        if (slot == nullptr || slot->proto != nullptr) {
+            Serial.printf("[Registry] Cannot register %s: %s\n", protocol->getName(),
+                         slot == nullptr ? "table full" : "name hash in use");
+            delete protocol;
+            return;
+        }
+
+        slot->hash = hash;
+        slot->proto = protocol;
+        protocols.push_back(protocol);
+        Serial.printf("[Registry] Registered protocol: %s\n", protocol->getName());
+    }
+
+    /**
+     * Reject from the timing descriptor: RX-less protocols and captures
+     * shorter than the protocol's minimum. Protocols without a descriptor
+     * fall back to getMinimumLength().
+     * @param count RMT items or edges
+     */
+    static bool canDecode(const SubGhzProtocol* proto, size_t count) {
+        const SubGhzTiming* timing = proto->timing();
+        if (timing == nullptr) {
+            return count >= proto->getMinimumLength();
+        }
+        return timing->bit_count > 0 && count >= timing->min_items;
+    }
 
 public:
     /**
@@ -34,6 +132,20 @@ public:
         return instance;
     }
 
+    /**
+     * Link a static descriptor, keeping the list in priority order
+     * Called from SUBGHZ_REGISTER_PROTOCOL() during static initialisation
+     */
+    static bool link(SubGhzProtocolDesc* desc) {
+        SubGhzProtocolDesc** pos = &descriptors;
+        while (*pos != nullptr && (*pos)->priority <= desc->priority) {
+            pos = &(*pos)->next;
+        }
+        desc->next = *pos;
+        *pos = desc;
+        return true;
+    }
+
     /**
      * Register a protocol
      * Registry takes ownership of the pointer
@@ -42,8 +154,22 @@ public:
      */
     void registerProtocol(SubGhzProtocol* protocol) {
         if (protocol != nullptr) {
-            protocols.push_back(protocol);
-            Serial.printf("[Registry] Registered protocol: %s\n", protocol->getName());
+            insert(protocol, subghz_name_hash(protocol->getName()));
+        }
+    }
+
+    /**
+     * Instantiate every SUBGHZ_REGISTER_PROTOCOL() protocol, in priority order
+     */
+    void registerStatic() {
+        for (const SubGhzProtocolDesc* desc = descriptors; desc != nullptr; desc = desc->next) {
+            SubGhzProtocol* proto = desc->create();
+            if (strcmp(proto->getName(), desc->name) != 0) {
+                Serial.printf("[Registry] Skipping %s: registered as %s\n", proto->getName(), desc->name);
+                delete proto;
+                continue;
+            }
+            insert(proto, desc->name_hash);
         }
     }
 
@@ -54,12 +180,11 @@ public:
      * @return Protocol instance or nullptr if not found
      */
     SubGhzProtocol* getProtocol(const char* name) {
-        for (auto* proto : protocols) {
-            if (strcmp(proto->getName(), name) == 0) {
-                return proto;
-            }
+        Slot* slot = findSlot(subghz_name_hash(name));
+        if (slot == nullptr || slot->proto == nullptr || strcmp(slot->proto->getName(), name) != 0) {
+            return nullptr;
         }
-        return nullptr;
+        return slot->proto;
     }
 
     /**
@@ -79,9 +204,7 @@ public:
         // Try each protocol decoder
         for (auto* proto : protocols) {
             // Skip if signal is too short for this protocol
-            size_t min_len = proto->getMinimumLength();
-
-            if (len < min_len) {
+            if (!canDecode(proto, len)) {
                 continue;
             }
 
@@ -98,28 +221,26 @@ public:
 
     /**
      * Auto-detect protocol from edge events (Flipper Zero style)
-     * Feeds edges sequentially to each decoder's state machine
+     * Feeds the packed edges sequentially to each decoder's state machine
      */
-    SubGhzProtocol* autoDetectEdges(const std::pair<bool, uint32_t>* edges, size_t edge_count, ProtocolDecodeResult& result) {
-        if (edges == nullptr || edge_count == 0) {
+    SubGhzProtocol* autoDetectEdges(const SubGhzEdgeSpan& edges, ProtocolDecodeResult& result) {
+        if (edges.data == nullptr || edges.edges == 0) {
             return nullptr;
         }
 
         // Try each protocol decoder
         for (auto* proto : protocols) {
+            if (!canDecode(proto, edges.edges)) {
+                continue;
+            }
+
             // Reset decoder state
             proto->reset();
 
-            // Feed all edges to the decoder
-            for (size_t i = 0; i < edge_count; i++) {
-                proto->feed(edges[i].first, edges[i].second);
-
-                // Check if decoder has a result
-                if (proto->decode_check(result)) {
-                    Serial.printf("[Registry] Detected %s (key=0x%llX, bits=%d)\n",
-                                 proto->getName(), result.key, result.bit_count);
-                    return proto;
-                }
+            if (proto->feed_span(edges, result)) {
+                Serial.printf("[Registry] Detected %s (key=0x%llX, bits=%d)\n",
+                             proto->getName(), result.key, result.bit_count);
+                return proto;
             }
         }
 
@@ -153,6 +274,7 @@ public:
             delete proto;
         }
         protocols.clear();
+        memset(slots, 0, sizeof(slots));
     }
 
     /**
@@ -195,10 +317,10 @@ inline SubGhzProtocol* autoDetectProtocol(const rmt_item32_t* data, size_t len,
 
 /**
  * Auto-detect protocol from edge events (Flipper-style)
- * Edge format: pair<level (bool), duration (us)>
+ * Edge format: packed, see subghz_edges.h
  */
-inline SubGhzProtocol* autoDetectProtocolEdges(const std::pair<bool, uint32_t>* edges, size_t edge_count, ProtocolDecodeResult& result) {
-    return ProtocolRegistry::getInstance()->autoDetectEdges(edges, edge_count, result);
+inline SubGhzProtocol* autoDetectProtocolEdges(const SubGhzEdgeSpan& edges, ProtocolDecodeResult& result) {
+    return ProtocolRegistry::getInstance()->autoDetectEdges(edges, result);
 }
 
 #endif // __PROTOCOL_REGISTRY_H__
@@ -3,6 +3,11 @@
  */
 
 #include "protocol_binraw.h"
+#include "../protocol_registry.h"
+
+#if SUBGHZ_PROTOCOL_BINRAW
+
+constexpr SubGhzTiming BinRAWProtocol::TIMING;
 
 /**
  * BinRAW does not support RX decoding
@@ -46,12 +51,44 @@ bool BinRAWProtocol::getEncodedData(const rmt_item32_t** out_data, size_t* out_l
 }
 
 /**
- * BinRAW serialization not supported
+ * Serialize the loaded blocks to .sub file
  */
 bool BinRAWProtocol::serializeToFile(File& file, const ProtocolDecodeResult& result) {
-    (void)file;
     (void)result;
-    return false;
+
+    if (blocks.empty()) {
+        return false;
+    }
+
+    file.printf("Protocol: %s\n", getName());
+    file.printf("Bit: %lu\n", (unsigned long)total_bits);
+    file.printf("TE: %lu\n", (unsigned long)te);
+
+    for (size_t i = 0; i < blocks.size(); i++) {
+        const BinRAW_Block& block = blocks[i];
+        file.printf("Bit_RAW: %u\n", block.bit_count);
+        file.print("Data_RAW:");
+        for (uint16_t j = 0; j < block.byte_count; j++) {
+            file.printf(" %02X", block.data[j]);
+        }
+        file.println();
+    }
+
+    return true;
+}
+
+/**
+ * Replace the loaded blocks
+ */
+void BinRAWProtocol::setBlocks(uint32_t te_us, const std::vector<BinRAW_Block>& new_blocks) {
+    blocks.assign(new_blocks.begin(),
+                  new_blocks.begin() + min(new_blocks.size(), (size_t)BINRAW_MAX_BLOCKS));
+    te = te_us;
+    total_bits = 0;
+    for (const BinRAW_Block& block : blocks) {
+        total_bits += block.bit_count;
+    }
+    rmt_items.clear();
 }
 
 /**
@@ -209,3 +246,8 @@ void BinRAWProtocol::bitsToRMT(const uint8_t* data, uint16_t bit_count, uint32_t
         items.push_back(current_item);
     }
 }
+
+// Playback-only format, after every decoder
+SUBGHZ_REGISTER_PROTOCOL(BinRAWProtocol, "BinRAW", 90);
+
+#endif // SUBGHZ_PROTOCOL_BINRAW
@@ -67,6 +67,9 @@ private:
     // Default TE value (can be overridden from file)
     static const uint32_t BINRAW_TE_DEFAULT = 200;
 
+    // Playback only: bit_count 0 keeps it out of auto-detection
+    static constexpr SubGhzTiming TIMING = { BINRAW_TE_DEFAULT, 0, 0, 0, 0, 0 };
+
     // RMT encoded data for transmission
     std::vector<rmt_item32_t> rmt_items;
 
@@ -114,7 +117,7 @@ private:
     }
 
 public:
-    BinRAWProtocol() : te(BINRAW_TE_DEFAULT), total_bits(0) {}
+    BinRAWProtocol() : SubGhzProtocol(TIMING), te(BINRAW_TE_DEFAULT), total_bits(0) {}
 
     const char* getName() const override {
         return "BinRAW";
@@ -136,8 +139,8 @@ public:
     bool getEncodedData(const rmt_item32_t** out_data, size_t* out_len) override;
 
     /**
-     * BinRAW serialization not supported (use RAW protocol for capture)
-     * BinRAW files are generated by Flipper Zero from RAW captures
+     * Write the loaded blocks (from setBlocks() or deserializeFromFile());
+     * result is unused since BinRAW has no decoder
      */
     bool serializeToFile(File& file, const ProtocolDecodeResult& result) override;
 
@@ -153,7 +156,7 @@ public:
     bool decode_check(ProtocolDecodeResult& result) override { return false; }
 
     size_t getMinimumLength() const override {
-        return 0;  // Not used for RX
+        return TIMING.min_items;  // Not used for RX
     }
 
     const uint32_t* getCommonFrequencies() const override {
@@ -176,6 +179,12 @@ public:
         return total_bits * te;
     }
 
+    /**
+     * Replace the loaded blocks, e.g. with a RAW capture converted by
+     * subghz_binraw_convert()
+     */
+    void setBlocks(uint32_t te_us, const std::vector<BinRAW_Block>& new_blocks);
+
     /**
      * Get number of Data_RAW blocks loaded
      */
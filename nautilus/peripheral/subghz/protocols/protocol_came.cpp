@@ -4,6 +4,11 @@
 
 #include "protocol_came.h"
 #include "../../peripheral.h"  
+#include "../protocol_registry.h"
+
+#if SUBGHZ_PROTOCOL_CAME
+
+constexpr SubGhzTiming CAMEProtocol::TIMING;
 
 /**
  * Decode CAME signal from RMT items
@@ -32,7 +37,7 @@ bool CAMEProtocol::decode(const rmt_item32_t* data, size_t len, ProtocolDecodeRe
 
     // Check preamble pulse 
     uint32_t preamble_us = rmt_item_to_us(data[idx], true);
-    if (!pulse_matches(preamble_us, CAME_PREAMBLE, CAME_TOLERANCE_PERCENT)) {
+    if (!pulse_in_pct<CAME_PREAMBLE, CAME_TOLERANCE_PERCENT>(preamble_us)) {
         return false;
     }
 
@@ -46,10 +51,10 @@ bool CAMEProtocol::decode(const rmt_item32_t* data, size_t len, ProtocolDecodeRe
         uint32_t pulse_us = rmt_item_to_us(data[idx], true);   // dur0 = carrier ON
         uint32_t gap_us = rmt_item_to_us(data[idx], false);    // dur1 = carrier OFF
 
-        bool is_short_gap = pulse_matches(gap_us, CAME_TE_SHORT, CAME_TOLERANCE_PERCENT);
-        bool is_long_gap = pulse_matches(gap_us, CAME_TE_LONG, CAME_TOLERANCE_PERCENT);
-        bool is_short_pulse = pulse_matches(pulse_us, CAME_TE_SHORT, CAME_TOLERANCE_PERCENT);
-        bool is_long_pulse = pulse_matches(pulse_us, CAME_TE_LONG, CAME_TOLERANCE_PERCENT);
+        bool is_short_gap = pulse_in_pct<CAME_TE_SHORT, CAME_TOLERANCE_PERCENT>(gap_us);
+        bool is_long_gap = pulse_in_pct<CAME_TE_LONG, CAME_TOLERANCE_PERCENT>(gap_us);
+        bool is_short_pulse = pulse_in_pct<CAME_TE_SHORT, CAME_TOLERANCE_PERCENT>(pulse_us);
+        bool is_long_pulse = pulse_in_pct<CAME_TE_LONG, CAME_TOLERANCE_PERCENT>(pulse_us);
 
         if (is_short_gap && is_long_pulse) {
             // short gap + long pulse = 0
@@ -286,24 +291,17 @@ bool CAMEProtocol::decode_check(ProtocolDecodeResult& result) {
  * Based on Flipper Zero's came.c implementation
  */
 void CAMEProtocol::feed(bool level, uint32_t duration) {
-    // Timing constants (from Flipper Zero)
-    const uint32_t TE_SHORT = 320;      // us
-    const uint32_t TE_LONG = 640;       // us (2xTE_SHORT)
-    const uint32_t TE_DELTA = 150;      // Tolerance
-    const uint32_t HEADER_DURATION = 17920;  // 56xTE_SHORT
-    const uint32_t HEADER_TOLERANCE = 9450;  // 63xTE_DELTA
-
-    // Helper macro for duration comparison
-    #define DURATION_DIFF(x, y) ((x) > (y) ? ((x) - (y)) : ((y) - (x)))
+    // Windows fixed at compile time from TIMING (Flipper Zero values)
+    auto is_short = [](uint32_t d) { return pulse_in<TIMING.te_short, TIMING.te_delta>(d); };
+    auto is_long = [](uint32_t d) { return pulse_in<TIMING.te_long, TIMING.te_delta>(d); };
 
     switch(state) {
     case STATE_RESET:
-        if (!level && DURATION_DIFF(duration, HEADER_DURATION) < HEADER_TOLERANCE) {
+        if (!level && pulse_in<TIMING.preamble, CAME_HEADER_DELTA>(duration)) {
             state = STATE_FOUND_START_BIT;
         }
         // Fallback: Opportunistic detection 
-        else if (!level && (DURATION_DIFF(duration, TE_SHORT) < TE_DELTA ||
-                           DURATION_DIFF(duration, TE_LONG) < TE_DELTA)) {
+        else if (!level && (is_short(duration) || is_long(duration))) {
             te_last = duration;
             state = STATE_FOUND_FIRST_BIT;
             decode_data = 0;
@@ -314,14 +312,12 @@ void CAMEProtocol::feed(bool level, uint32_t duration) {
     case STATE_FOUND_FIRST_BIT:
         // Continuing opportunistic detection
         if (level) {
-            if (DURATION_DIFF(te_last, TE_SHORT) < TE_DELTA &&
-                DURATION_DIFF(duration, TE_LONG) < TE_DELTA) {
+            if (is_short(te_last) && is_long(duration)) {
                 decode_data = (decode_data << 1) | 0;
                 decode_count_bit++;
                 state = STATE_SAVE_DURATION;
             }
-            else if (DURATION_DIFF(te_last, TE_LONG) < TE_DELTA &&
-                     DURATION_DIFF(duration, TE_SHORT) < TE_DELTA) {
+            else if (is_long(te_last) && is_short(duration)) {
                 decode_data = (decode_data << 1) | 1;
                 decode_count_bit++;
                 state = STATE_SAVE_DURATION;
@@ -338,7 +334,7 @@ void CAMEProtocol::feed(bool level, uint32_t duration) {
         if (!level) {
             break;
         }
-        if (level && DURATION_DIFF(duration, TE_SHORT) < TE_DELTA) {
+        if (level && is_short(duration)) {
             state = STATE_SAVE_DURATION;
             decode_data = 0;
             decode_count_bit = 0;
@@ -349,12 +345,12 @@ void CAMEProtocol::feed(bool level, uint32_t duration) {
 
     case STATE_SAVE_DURATION:
         if (!level) {
-            if (duration >= TE_SHORT * 4) {
+            if (duration >= TIMING.te_short * 4) {
                 if (decode_count_bit == 12 || decode_count_bit == 24) {
                     current_result.valid = true;
                     current_result.key = decode_data;
                     current_result.bit_count = decode_count_bit;
-                    current_result.te = TE_SHORT;
+                    current_result.te = TIMING.te_short;
                     has_result = true;
 
                     Serial.printf("[CAME-SM] Decoded: key=0x%llX, bits=%d\n",
@@ -373,14 +369,12 @@ void CAMEProtocol::feed(bool level, uint32_t duration) {
 
     case STATE_CHECK_DURATION:
         if (level) {
-            if (DURATION_DIFF(te_last, TE_SHORT) < TE_DELTA &&
-                DURATION_DIFF(duration, TE_LONG) < TE_DELTA) {
+            if (is_short(te_last) && is_long(duration)) {
                 decode_data = (decode_data << 1) | 0;
                 decode_count_bit++;
                 state = STATE_SAVE_DURATION;
             }
-            else if (DURATION_DIFF(te_last, TE_LONG) < TE_DELTA &&
-                     DURATION_DIFF(duration, TE_SHORT) < TE_DELTA) {
+            else if (is_long(te_last) && is_short(duration)) {
                 decode_data = (decode_data << 1) | 1;
                 decode_count_bit++;
                 state = STATE_SAVE_DURATION;
@@ -393,6 +387,9 @@ void CAMEProtocol::feed(bool level, uint32_t duration) {
         }
         break;
     }
-
-    #undef DURATION_DIFF
 }
+
+// Last of the decoders: the opportunistic mode also matches other protocols
+SUBGHZ_REGISTER_PROTOCOL(CAMEProtocol, "CAME", 40);
+
+#endif // SUBGHZ_PROTOCOL_CAME
@@ -34,6 +34,18 @@ private:
     // Timing tolerance for decoder (+/-50% to handle variation)
     static const uint8_t CAME_TOLERANCE_PERCENT = 50;
 
+    // Edge decoder timing (Flipper Zero came.c): TE 320us +/-150us,
+    // header low 56xTE
+    static constexpr SubGhzTiming TIMING = {
+        320,        // te_short
+        640,        // te_long (2 x SHORT)
+        150,        // te_delta
+        17920,      // preamble (56 x SHORT)
+        12,         // bit_count (12- or 24-bit)
+        13          // min_items (preamble + 12 bits)
+    };
+    static const uint32_t CAME_HEADER_DELTA = 9450;   // 63 x te_delta
+
     // Encoded signal parameters (for direct GPIO transmission)
     uint64_t encoded_key = 0;
     uint8_t encoded_bits = 0;
@@ -56,7 +68,7 @@ private:
     ProtocolDecodeResult current_result;
 
 public:
-    CAMEProtocol() : state(STATE_RESET), decode_data(0), decode_count_bit(0),
+    CAMEProtocol() : SubGhzProtocol(TIMING), state(STATE_RESET), decode_data(0), decode_count_bit(0),
                      te_last(0), has_result(false) {
         current_result.valid = false;
     }
@@ -86,7 +98,7 @@ public:
     bool decode_check(ProtocolDecodeResult& result) override;
 
     size_t getMinimumLength() const override {
-        return 13;  // Preamble + 12 bits minimum
+        return TIMING.min_items;
     }
 
     const uint32_t* getCommonFrequencies() const override {
@@ -4,6 +4,11 @@
 
 #include "protocol_princeton.h"
 #include "../../peripheral.h"
+#include "../protocol_registry.h"
+
+#if SUBGHZ_PROTOCOL_PRINCETON
+
+constexpr SubGhzTiming PrincetonProtocol::TIMING;
 
 /**
  * Decode Princeton signal from RMT items
@@ -34,13 +39,14 @@ bool PrincetonProtocol::decode(const rmt_item32_t* data, size_t len, ProtocolDec
 
     // Check for sync pattern (36 x TE)
     uint32_t sync_us = rmt_item_to_us(data[idx], true);
-    uint32_t expected_sync = PRINCETON_TE_SHORT * 36;
 
-    if (!pulse_matches(sync_us, expected_sync, PRINCETON_TOLERANCE_PERCENT)) {
+    if (!pulse_in_pct<TIMING.preamble, PRINCETON_TOLERANCE_PERCENT>(sync_us)) {
         return false;
     }
 
     uint32_t detected_te = sync_us / 36;
+    const SubGhzPulseWindow te_short = pulse_window_pct(detected_te, PRINCETON_TOLERANCE_PERCENT);
+    const SubGhzPulseWindow te_long = pulse_window_pct(detected_te * 3, PRINCETON_TOLERANCE_PERCENT);
     idx++;
 
     uint64_t decoded_key = 0;
@@ -50,13 +56,10 @@ bool PrincetonProtocol::decode(const rmt_item32_t* data, size_t len, ProtocolDec
         uint32_t high_us = rmt_item_to_us(data[idx], true);
         uint32_t low_us = rmt_item_to_us(data[idx], false);
 
-        uint32_t te_short = detected_te;
-        uint32_t te_long = detected_te * 3;
-
-        bool is_short_high = pulse_matches(high_us, te_short, PRINCETON_TOLERANCE_PERCENT);
-        bool is_long_high = pulse_matches(high_us, te_long, PRINCETON_TOLERANCE_PERCENT);
-        bool is_short_low = pulse_matches(low_us, te_short, PRINCETON_TOLERANCE_PERCENT);
-        bool is_long_low = pulse_matches(low_us, te_long, PRINCETON_TOLERANCE_PERCENT);
+        bool is_short_high = te_short.contains(high_us);
+        bool is_long_high = te_long.contains(high_us);
+        bool is_short_low = te_short.contains(low_us);
+        bool is_long_low = te_long.contains(low_us);
 
         if (is_short_high && is_long_low) {
             // short high + long low = 0
@@ -302,9 +305,10 @@ void PrincetonProtocol::feed(bool level, uint32_t duration) {
     switch (state) {
         case STATE_RESET:
             if (!level) {
-                uint32_t expected_sync = PRINCETON_TE_SHORT * 36;
-                if (pulse_matches(duration, expected_sync, PRINCETON_TOLERANCE_PERCENT)) {
+                if (pulse_in_pct<TIMING.preamble, PRINCETON_TOLERANCE_PERCENT>(duration)) {
                     detected_te = duration / 36;
+                    short_window = pulse_window_pct(detected_te, PRINCETON_TOLERANCE_PERCENT);
+                    long_window = pulse_window_pct(detected_te * 3, PRINCETON_TOLERANCE_PERCENT);
                     decode_data = 0;
                     decode_count_bit = 0;
                     state = STATE_SAVE_DURATION;
@@ -323,13 +327,10 @@ void PrincetonProtocol::feed(bool level, uint32_t duration) {
 
         case STATE_CHECK_DURATION:
             if (!level) {
-                uint32_t te_short = detected_te;
-                uint32_t te_long = detected_te * 3;
-
-                bool is_short_high = pulse_matches(te_last, te_short, PRINCETON_TOLERANCE_PERCENT);
-                bool is_long_high = pulse_matches(te_last, te_long, PRINCETON_TOLERANCE_PERCENT);
-                bool is_short_low = pulse_matches(duration, te_short, PRINCETON_TOLERANCE_PERCENT);
-                bool is_long_low = pulse_matches(duration, te_long, PRINCETON_TOLERANCE_PERCENT);
+                bool is_short_high = short_window.contains(te_last);
+                bool is_long_high = long_window.contains(te_last);
+                bool is_short_low = short_window.contains(duration);
+                bool is_long_low = long_window.contains(duration);
 
                 if (is_short_high && is_long_low) {
                     decode_data = (decode_data << 1) | 0;
@@ -381,3 +382,8 @@ bool PrincetonProtocol::decode_check(ProtocolDecodeResult& result) {
     }
     return false;
 }
+
+// Before CAME, whose opportunistic mode would claim Princeton frames
+SUBGHZ_REGISTER_PROTOCOL(PrincetonProtocol, "Princeton", 30);
+
+#endif // SUBGHZ_PROTOCOL_PRINCETON
@@ -41,6 +41,15 @@ private:
     // CAME has 17.9ms header which would match Princeton's 14.4ms +/-30%
     static const uint8_t PRINCETON_TOLERANCE_PERCENT = 20;
 
+    static constexpr SubGhzTiming TIMING = {
+        PRINCETON_TE_SHORT,                 // te_short
+        PRINCETON_TE_LONG,                  // te_long
+        PRINCETON_TE_SHORT * PRINCETON_TOLERANCE_PERCENT / 100,  // te_delta at the default TE
+        PRINCETON_TE_SHORT * 36,            // preamble (sync, 36 x TE)
+        PRINCETON_BIT_COUNT,                // bit_count
+        50                                  // min_items: sync + 24 data bits (48) + stop bit
+    };
+
     // RMT encoded data for transmission
     std::vector<rmt_item32_t> rmt_items;
 
@@ -62,6 +71,8 @@ private:
     uint32_t decode_count_bit;     // Number of bits decoded
     uint32_t te_last;              // Last HIGH pulse duration (for bit decoding)
     uint32_t detected_te;          // Detected TE from signal
+    SubGhzPulseWindow short_window; // detected_te +/- tolerance, set at sync
+    SubGhzPulseWindow long_window;  // 3 x detected_te +/- tolerance, set at sync
     bool has_result;               // True when decode is complete
     ProtocolDecodeResult current_result;
 
@@ -79,8 +90,10 @@ private:
     }
 
 public:
-    PrincetonProtocol() : state(STATE_RESET), decode_data(0), decode_count_bit(0),
-                          te_last(0), detected_te(PRINCETON_TE_DEFAULT),
+    PrincetonProtocol() : SubGhzProtocol(TIMING), state(STATE_RESET), decode_data(0),
+                          decode_count_bit(0), te_last(0), detected_te(PRINCETON_TE_DEFAULT),
+                          short_window(pulse_window_pct(PRINCETON_TE_SHORT, PRINCETON_TOLERANCE_PERCENT)),
+                          long_window(pulse_window_pct(PRINCETON_TE_LONG, PRINCETON_TOLERANCE_PERCENT)),
                           has_result(false) {
         current_result.valid = false;
     }
@@ -110,7 +123,7 @@ public:
     bool decode_check(ProtocolDecodeResult& result) override;
 
     size_t getMinimumLength() const override {
-        return 50;  // Sync (1) + 24 data bits (48) + stop bit (1)
+        return TIMING.min_items;
     }
 
     const uint32_t* getCommonFrequencies() const override {
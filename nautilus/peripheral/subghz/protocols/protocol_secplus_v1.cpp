@@ -8,6 +8,11 @@
 
 #include "protocol_secplus_v1.h"
 #include <Arduino.h>
+#include "../protocol_registry.h"
+
+#if SUBGHZ_PROTOCOL_SECPLUS_V1
+
+constexpr SubGhzTiming SecPlusV1Protocol::TIMING;
 
 /**
  * Reverse bit order of a 32-bit value
@@ -21,13 +26,6 @@ static uint32_t reverse_bits_32(uint32_t value) {
     return result;
 }
 
-/**
- * Check if duration matches expected value within tolerance
- */
-static inline bool duration_match(uint32_t duration, uint32_t expected, uint32_t tolerance) {
-    return (duration >= (expected - tolerance)) && (duration <= (expected + tolerance));
-}
-
 /**
  * Encode 64-bit key into 40 ternary symbols using base-3 conversion
  * Based on Flipper Zero's subghz_protocol_secplus_v1_encode()
@@ -511,14 +509,14 @@ void SecPlusV1Protocol::feed(bool level, uint32_t duration) {
         case STEP_SEARCH_START_BIT:
             // Packet header HIGH pulse determines packet type
             if (level) {
-                if (duration_match(duration, SECPLUS_V1_TE_SHORT, SECPLUS_V1_TOLERANCE)) {
+                if (pulse_in<TIMING.te_short, TIMING.te_delta>(duration)) {
                     // Short HIGH = Packet 1 (500us)
                     base_packet_index = PACKET_1_INDEX_BASE;
                     data_array[PACKET_1_INDEX_BASE] = PACKET_1_HEADER;
                     decoder_step = STEP_SAVE_DURATION;
                     decode_count_bit = 1;  // Header counts as first symbol
                 }
-                else if (duration_match(duration, SECPLUS_V1_TE_LONG, SECPLUS_V1_TOLERANCE)) {
+                else if (pulse_in<TIMING.te_long, TIMING.te_delta>(duration)) {
                     // Long HIGH = Packet 2 (1500us)
                     base_packet_index = PACKET_2_INDEX_BASE;
                     data_array[PACKET_2_INDEX_BASE] = PACKET_2_HEADER;
@@ -551,18 +549,18 @@ void SecPlusV1Protocol::feed(bool level, uint32_t duration) {
                 uint8_t symbol = SYMBOL_INVALID;
 
                 // Symbol 0: 3L + 1H (1500us LOW, 500us HIGH)
-                if (duration_match(te_last, SECPLUS_V1_TE_SHORT * 3, SECPLUS_V1_TOLERANCE * 3) &&
-                    duration_match(duration, SECPLUS_V1_TE_SHORT, SECPLUS_V1_TOLERANCE)) {
+                if (pulse_in<TIMING.te_short * 3, TIMING.te_delta * 3>(te_last) &&
+                    pulse_in<TIMING.te_short, TIMING.te_delta>(duration)) {
                     symbol = SYMBOL_0;
                 }
                 // Symbol 1: 2L + 2H (1000us LOW, 1000us HIGH)
-                else if (duration_match(te_last, SECPLUS_V1_TE_SHORT * 2, SECPLUS_V1_TOLERANCE * 2) &&
-                         duration_match(duration, SECPLUS_V1_TE_SHORT * 2, SECPLUS_V1_TOLERANCE * 2)) {
+                else if (pulse_in<TIMING.te_short * 2, TIMING.te_delta * 2>(te_last) &&
+                         pulse_in<TIMING.te_short * 2, TIMING.te_delta * 2>(duration)) {
                     symbol = SYMBOL_1;
                 }
                 // Symbol 2: 1L + 3H (500us LOW, 1500us HIGH)
-                else if (duration_match(te_last, SECPLUS_V1_TE_SHORT, SECPLUS_V1_TOLERANCE) &&
-                         duration_match(duration, SECPLUS_V1_TE_SHORT * 3, SECPLUS_V1_TOLERANCE * 3)) {
+                else if (pulse_in<TIMING.te_short, TIMING.te_delta>(te_last) &&
+                         pulse_in<TIMING.te_short * 3, TIMING.te_delta * 3>(duration)) {
                     symbol = SYMBOL_2;
                 }
 
@@ -598,3 +596,7 @@ void SecPlusV1Protocol::feed(bool level, uint32_t duration) {
             break;
     }
 }
+
+SUBGHZ_REGISTER_PROTOCOL(SecPlusV1Protocol, "Security+ 1.0", 10);
+
+#endif // SUBGHZ_PROTOCOL_SECPLUS_V1
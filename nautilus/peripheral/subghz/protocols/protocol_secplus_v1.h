@@ -46,6 +46,15 @@ private:
     static const uint8_t SECPLUS_V1_SYMBOL_COUNT = 40;     // 40 data symbols total
     static const uint8_t SECPLUS_V1_SYMBOLS_PER_PACKET = 20; // 20 symbols per packet
 
+    static constexpr SubGhzTiming TIMING = {
+        SECPLUS_V1_TE_SHORT,        // te_short
+        SECPLUS_V1_TE_LONG,         // te_long
+        SECPLUS_V1_TOLERANCE,       // te_delta (scaled with the multiple of TE)
+        0,                          // preamble: header arrives fragmented, any low >= 3ms
+        SECPLUS_V1_SYMBOL_COUNT,    // bit_count (ternary symbols)
+        80                          // min_items: 40 symbols x 2
+    };
+
     // Preamble timing (wake-up pulse, sent once before first packet)
     static const uint16_t SECPLUS_V1_PREAMBLE_HIGH = 890;  // 890 us high
     static const uint16_t SECPLUS_V1_PREAMBLE_LOW = 135;   // 135 us low
@@ -136,6 +145,7 @@ private:
 
 public:
     SecPlusV1Protocol() :
+        SubGhzProtocol(TIMING),
         encoded_fixed(0),
         encoded_rolling(0),
         decoder_step(STEP_RESET),
@@ -243,8 +253,7 @@ public:
     }
 
     size_t getMinimumLength() const override {
-        // Approximate: 40 symbols x 2 items per symbol = 80 items minimum
-        return 80;
+        return TIMING.min_items;
     }
 
     const uint32_t* getCommonFrequencies() const override {
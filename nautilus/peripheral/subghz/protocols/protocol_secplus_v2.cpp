@@ -10,6 +10,11 @@
 
 #include "protocol_secplus_v2.h"
 #include <Arduino.h>
+#include "../protocol_registry.h"
+
+#if SUBGHZ_PROTOCOL_SECPLUS_V2
+
+constexpr SubGhzTiming SecPlusV2Protocol::TIMING;
 
 /**
  * Helper functions for Security+ 2.0 encoding/decoding
@@ -266,8 +271,8 @@ size_t SecPlusV2Protocol::manchester_decode(const rmt_item32_t* data, size_t len
         uint32_t dur0 = rmt_item_to_us(data[i], true);
         uint32_t dur1 = rmt_item_to_us(data[i], false);
 
-        bool is_short0 = pulse_matches(dur0, SECPLUS_V2_TE_SHORT, SECPLUS_V2_TOLERANCE);
-        bool is_short1 = pulse_matches(dur1, SECPLUS_V2_TE_SHORT, SECPLUS_V2_TOLERANCE);
+        bool is_short0 = pulse_in<TIMING.te_short, TIMING.te_delta>(dur0);
+        bool is_short1 = pulse_in<TIMING.te_short, TIMING.te_delta>(dur1);
 
         if (is_short0 && is_short1) {
             // Inverted Manchester: level0=HIGH => bit=1, level0=LOW => bit=0
@@ -989,10 +994,8 @@ bool SecPlusV2Protocol::manchester_advance(bool level, uint32_t duration, uint8_
     // Events: ShortLow=0, ShortHigh=2, LongLow=4, LongHigh=6
     static const uint8_t transitions[] = {0b00000001, 0b10010001, 0b10011011, 0b11111011};
 
-    bool is_short = (duration >= SECPLUS_V2_TE_SHORT - SECPLUS_V2_TOLERANCE &&
-                     duration <= SECPLUS_V2_TE_SHORT + SECPLUS_V2_TOLERANCE);
-    bool is_long = (duration >= SECPLUS_V2_TE_LONG - SECPLUS_V2_TOLERANCE &&
-                    duration <= SECPLUS_V2_TE_LONG + SECPLUS_V2_TOLERANCE);
+    bool is_short = pulse_in<TIMING.te_short, TIMING.te_delta>(duration);
+    bool is_long = pulse_in<TIMING.te_long, TIMING.te_delta>(duration);
 
     if (!is_short && !is_long) {
         return false;
@@ -1033,8 +1036,6 @@ bool SecPlusV2Protocol::manchester_advance(bool level, uint32_t duration, uint8_
  * Feed edge event to state machine
  */
 void SecPlusV2Protocol::feed(bool level, uint32_t duration) {
-    #define DURATION_DIFF(x, y) ((x) > (y) ? ((x) - (y)) : ((y) - (x)))
-
     switch(state) {
     case STATE_RESET:
         if (!level && duration >= 1000) {
@@ -1049,10 +1050,8 @@ void SecPlusV2Protocol::feed(bool level, uint32_t duration) {
             state = STATE_RESET;
             decode_count_bit = 0xFF;
         } else if (decode_count_bit == 0xFF) {
-            bool is_v2_timing = (duration >= SECPLUS_V2_TE_SHORT - SECPLUS_V2_TOLERANCE &&
-                                 duration <= SECPLUS_V2_TE_SHORT + SECPLUS_V2_TOLERANCE) ||
-                                (duration >= SECPLUS_V2_TE_LONG - SECPLUS_V2_TOLERANCE &&
-                                 duration <= SECPLUS_V2_TE_LONG + SECPLUS_V2_TOLERANCE);
+            bool is_v2_timing = pulse_in<TIMING.te_short, TIMING.te_delta>(duration) ||
+                                pulse_in<TIMING.te_long, TIMING.te_delta>(duration);
 
             if (!is_v2_timing) {
                 decode_count_bit = 0;
@@ -1203,6 +1202,8 @@ void SecPlusV2Protocol::feed(bool level, uint32_t duration) {
         break;
     }
     }
-
-    #undef DURATION_DIFF
 }
+
+SUBGHZ_REGISTER_PROTOCOL(SecPlusV2Protocol, "Security+ 2.0", 20);
+
+#endif // SUBGHZ_PROTOCOL_SECPLUS_V2
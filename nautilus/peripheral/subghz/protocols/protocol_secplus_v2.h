@@ -41,6 +41,15 @@ private:
     static const uint16_t SECPLUS_V2_TE_LONG = 500;       // Long pulse (2 x SHORT)
     static const uint16_t SECPLUS_V2_TOLERANCE = 110;     // Timing tolerance (us)
     static const uint8_t SECPLUS_V2_BIT_COUNT = 62;       // Total bits (v2.0)
+
+    static constexpr SubGhzTiming TIMING = {
+        SECPLUS_V2_TE_SHORT,        // te_short
+        SECPLUS_V2_TE_LONG,         // te_long
+        SECPLUS_V2_TOLERANCE,       // te_delta
+        0,                          // preamble: any low >= 1ms starts a packet
+        SECPLUS_V2_BIT_COUNT,       // bit_count
+        40                          // min_items: one Manchester packet (packets arrive 68ms apart)
+    };
     static const uint8_t SECPLUS_V2_REPEATS = 2;          // Default repeat count
 
     // Packet structure constants
@@ -153,7 +162,7 @@ private:
     bool manchester_advance(bool level, uint32_t duration, uint8_t& data);
 
 public:
-    SecPlusV2Protocol() : state(STATE_RESET), manchester_state(MANCHESTER_START0),
+    SecPlusV2Protocol() : SubGhzProtocol(TIMING), state(STATE_RESET), manchester_state(MANCHESTER_START0),
                          decode_data(0), decode_count_bit(0), has_result(false),
                          secplus_packet_1(0), secplus_packet_2(0) {
         current_result.valid = false;
@@ -178,7 +187,7 @@ public:
         // Manchester encoding: each bit requires ~2 RMT items (one for each half-bit)
         // Single packet: 42 bits x ~1.2 (Manchester overhead) ~= 50 RMT items
         // Accept single packets due to 68ms gap splitting transmission
-        return 40;  // Minimum RMT items for single packet (conservative)
+        return TIMING.min_items;
     }
 
     const uint32_t* getCommonFrequencies() const override {
@@ -0,0 +1,335 @@
+/**
+ * SubGHz RAW to BinRAW Conversion
+ */
+
+#include "subghz_binraw.h"
+#include <SD.h>
+
+uint32_t subghz_te_clusters(const std::vector<int> &timings, bool level, std::vector<SubGhzTeCluster> &out) {
+    const size_t bins = SUBGHZ_BINRAW_FRAME_GAP_US / SUBGHZ_TE_BIN_US;
+    std::vector<uint16_t> hist(bins, 0);
+    std::vector<uint32_t> hist_sum(bins, 0);
+    uint32_t samples = 0;
+
+    for (int t : timings) {
+        if (t == 0 || (t > 0) != level) {
+            continue;
+        }
+        uint32_t d = (uint32_t)abs(t);
+        if (d >= SUBGHZ_BINRAW_FRAME_GAP_US) {
+            continue;
+        }
+        size_t b = d / SUBGHZ_TE_BIN_US;
+        if (hist[b] < UINT16_MAX) {
+            hist[b]++;
+            hist_sum[b] += d;
+        }
+        samples++;
+    }
+
+    // A cluster is a run of occupied bins; empty stretches narrower than
+    // SUBGHZ_TE_CLUSTER_PCT of the duration are bridged, so jitter does not
+    // split one symbol length in two
+    uint64_t sum = 0;
+    uint32_t count = 0;
+    size_t last = 0;
+    auto close = [&]() {
+        if (count > 0 && count * 100 >= samples * SUBGHZ_TE_MIN_SHARE_PCT) {
+            out.push_back({(uint32_t)(sum / count), count, level});
+        }
+        sum = 0;
+        count = 0;
+    };
+
+    for (size_t b = 0; b < bins; b++) {
+        if (hist[b] == 0) {
+            continue;
+        }
+        size_t reach = max((size_t)1, b * SUBGHZ_TE_CLUSTER_PCT / 100);
+        if (count > 0 && b - last > reach) {
+            close();
+        }
+        sum += hist_sum[b];
+        count += hist[b];
+        last = b;
+    }
+    close();
+
+    return samples;
+}
+
+bool subghz_estimate_te(const std::vector<int> &timings, SubGhzTeEstimate *out) {
+    memset(out, 0, sizeof(*out));
+
+    std::vector<SubGhzTeCluster> clusters;
+    out->samples = subghz_te_clusters(timings, true, clusters);
+    size_t first_low = clusters.size();
+    out->samples += subghz_te_clusters(timings, false, clusters);
+
+    if (out->samples < SUBGHZ_TE_MIN_SAMPLES || first_low == 0 || first_low == clusters.size()) {
+        return false;
+    }
+
+    // First guess: the shortest high and the shortest low are both 1 TE
+    uint32_t h1 = clusters[0].mean_us;
+    uint32_t l1 = clusters[first_low].mean_us;
+    if (h1 > 2 * l1 || l1 > 2 * h1) {
+        return false;
+    }
+    float te = (h1 + l1) / 2.0f;
+    float bias = ((int32_t)h1 - (int32_t)l1) / 2.0f;
+
+    // Fit d = k*te + s*bias (s = +1 high, -1 low) over all clusters, weighted
+    // by count; the normal equations are 2x2
+    double skk = 0, sks = 0, ss = 0, skd = 0, ssd = 0;
+    for (const SubGhzTeCluster &c : clusters) {
+        float s = c.level ? 1.0f : -1.0f;
+        uint32_t k = (uint32_t)lroundf((c.mean_us - s * bias) / te);
+        if (k == 0) {
+            k = 1;
+        }
+        float err = fabsf(c.mean_us - s * bias - k * te);
+        if (err * 100 > te * SUBGHZ_BINRAW_TOL_PCT) {
+            return false;
+        }
+        skk += (double)c.count * k * k;
+        sks += (double)c.count * k * s;
+        ss += c.count;
+        skd += (double)c.count * k * c.mean_us;
+        ssd += (double)c.count * s * c.mean_us;
+    }
+    double det = skk * ss - sks * sks;
+    if (det > 0) {
+        te = (float)((skd * ss - sks * ssd) / det);
+        bias = (float)((skk * ssd - sks * skd) / det);
+    }
+
+    if (te < SUBGHZ_TE_MIN_US || te > SUBGHZ_TE_MAX_US) {
+        return false;
+    }
+
+    out->te_us = (uint32_t)lroundf(te);
+    out->bias_us = (int32_t)lroundf(bias);
+    out->clusters = clusters.size();
+    return true;
+}
+
+#if SUBGHZ_PROTOCOL_BINRAW
+
+// Consecutive same-level timings merged, idle before the first high dropped
+struct BinRawRun {
+    bool level;
+    uint32_t us;
+};
+
+static bool binraw_is_gap(const BinRawRun &run) {
+    return !run.level && run.us >= SUBGHZ_BINRAW_FRAME_GAP_US;
+}
+
+/**
+ * Merge and bias-correct the timings; gaps are capped, pulses never drop below 1us
+ */
+static void binraw_runs(const std::vector<int> &timings, int32_t bias_us, std::vector<BinRawRun> &runs) {
+    runs.clear();
+    for (int t : timings) {
+        if (t == 0) {
+            continue;
+        }
+        bool level = t > 0;
+        if (runs.empty() && !level) {
+            continue;
+        }
+        if (!runs.empty() && runs.back().level == level) {
+            runs.back().us += abs(t);
+        } else {
+            runs.push_back({level, (uint32_t)abs(t)});
+        }
+    }
+
+    for (BinRawRun &run : runs) {
+        if (binraw_is_gap(run)) {
+            run.us = min(run.us, (uint32_t)SUBGHZ_BINRAW_GAP_MAX_US);
+        } else {
+            int32_t corrected = (int32_t)run.us + (run.level ? -bias_us : bias_us);
+            run.us = (uint32_t)max(corrected, (int32_t)1);
+        }
+    }
+}
+
+/**
+ * Pack runs [from, to) into a new block, right-aligned the way bitsToRMT() reads it
+ */
+static bool binraw_pack(const std::vector<BinRawRun> &runs, const std::vector<uint16_t> &units,
+                        size_t from, size_t to, uint32_t bits, std::vector<BinRAW_Block> &blocks) {
+    if (blocks.size() >= BINRAW_MAX_BLOCKS) {
+        return false;
+    }
+
+    blocks.emplace_back();
+    BinRAW_Block &block = blocks.back();
+    memset(&block, 0, sizeof(block));
+    block.bit_count = bits;
+    block.byte_count = (bits + 7) / 8;
+
+    uint32_t pos = (8 - (bits & 0x7)) & 0x7;
+    for (size_t r = from; r < to; r++) {
+        for (uint16_t u = 0; u < units[r]; u++, pos++) {
+            if (runs[r].level) {
+                block.data[pos >> 3] |= 0x80 >> (pos & 0x7);
+            }
+        }
+    }
+    return true;
+}
+
+bool subghz_binraw_convert(const std::vector<int> &timings, std::vector<BinRAW_Block> &blocks,
+                           SubGhzBinRawStats *stats) {
+    blocks.clear();
+
+    SubGhzTeEstimate est;
+    if (!subghz_estimate_te(timings, &est)) {
+        return false;
+    }
+    uint32_t te = est.te_us;
+    if (stats != nullptr) {
+        memset(stats, 0, sizeof(*stats));
+        stats->te_us = te;
+        stats->bias_us = est.bias_us;
+    }
+
+    std::vector<BinRawRun> runs;
+    binraw_runs(timings, est.bias_us, runs);
+    if (runs.empty()) {
+        return false;
+    }
+
+    // Quantize; gaps only need rounding, pulses must sit close to a multiple
+    std::vector<uint16_t> units(runs.size());
+    for (size_t r = 0; r < runs.size(); r++) {
+        uint32_t n = max((uint32_t)1, (runs[r].us + te / 2) / te);
+        uint32_t err = (uint32_t)abs((int32_t)runs[r].us - (int32_t)(n * te));
+        if (!binraw_is_gap(runs[r]) && err * 100 > te * SUBGHZ_BINRAW_TOL_PCT) {
+            return false;
+        }
+        units[r] = n;
+    }
+
+    // Whole frames per block, a new block when the next frame would not fit
+    const uint32_t block_bits_max = BINRAW_MAX_DATA_SIZE * 8;
+    blocks.reserve(BINRAW_MAX_BLOCKS);
+    size_t from = 0;
+    size_t frame_start = 0;
+    uint32_t bits = 0;
+    uint32_t frame_bits = 0;
+    for (size_t r = 0; r < runs.size(); r++) {
+        frame_bits += units[r];
+        if (!binraw_is_gap(runs[r]) && r + 1 < runs.size()) {
+            continue;
+        }
+        if (frame_bits > block_bits_max) {
+            return false;
+        }
+        if (bits + frame_bits > block_bits_max) {
+            if (!binraw_pack(runs, units, from, frame_start, bits, blocks)) {
+                return false;
+            }
+            from = frame_start;
+            bits = 0;
+        }
+        bits += frame_bits;
+        frame_start = r + 1;
+        frame_bits = 0;
+    }
+    if (!binraw_pack(runs, units, from, runs.size(), bits, blocks)) {
+        return false;
+    }
+
+    // Re-synthesise through the transmit encoder and compare
+    BinRAWProtocol synth;
+    synth.setBlocks(te, blocks);
+    std::vector<int> replay;
+    if (!subghz_binraw_timings(synth, replay) || replay.size() != runs.size()) {
+        return false;
+    }
+
+    uint64_t err_sum = 0;
+    uint32_t err_max = 0;
+    for (size_t r = 0; r < runs.size(); r++) {
+        if ((replay[r] > 0) != runs[r].level) {
+            return false;
+        }
+        uint32_t err = (uint32_t)abs(abs(replay[r]) - (int32_t)runs[r].us);
+        uint32_t tol = binraw_is_gap(runs[r]) ? te / 2 + 1 : te * SUBGHZ_BINRAW_TOL_PCT / 100;
+        if (err > tol) {
+            return false;
+        }
+        err_sum += err;
+        err_max = max(err_max, err);
+    }
+
+    uint32_t err_mean = (uint32_t)(err_sum / runs.size());
+    if (stats != nullptr) {
+        stats->total_bits = 0;
+        for (const BinRAW_Block &block : blocks) {
+            stats->total_bits += block.bit_count;
+        }
+        stats->pulses = runs.size();
+        stats->max_err_us = err_max;
+        stats->mean_err_us = err_mean;
+    }
+    return err_mean * 100 <= te * SUBGHZ_BINRAW_MEAN_TOL_PCT;
+}
+
+bool subghz_binraw_timings(BinRAWProtocol &binraw, std::vector<int> &timings) {
+    ProtocolEncodeParams params = {};
+    const rmt_item32_t *items = nullptr;
+    size_t len = 0;
+
+    timings.clear();
+    if (!binraw.encode(params) || !binraw.getEncodedData(&items, &len)) {
+        return false;
+    }
+
+    // Blocks are encoded back to back; merge runs that continue across items
+    auto push = [&](uint32_t ticks, uint32_t level) {
+        int d = (int)RMT_TICKS_TO_US(ticks);
+        if (d == 0) {
+            return;
+        }
+        if (!timings.empty() && (timings.back() > 0) == (level != 0)) {
+            timings.back() += level ? d : -d;
+        } else {
+            timings.push_back(level ? d : -d);
+        }
+    };
+    for (size_t i = 0; i < len; i++) {
+        push(items[i].duration0, items[i].level0);
+        push(items[i].duration1, items[i].level1);
+    }
+    return !timings.empty();
+}
+
+bool subghz_binraw_file_timings(const char *filepath, std::vector<int> &timings) {
+    File file = SD.open(filepath);
+    if (!file) {
+        return false;
+    }
+
+    // deserializeFromFile() expects to start after the Protocol: line
+    while (file.available()) {
+        String line = file.readStringUntil('\n');
+        line.trim();
+        if (line.startsWith("Protocol:")) {
+            break;
+        }
+    }
+
+    BinRAWProtocol binraw;
+    ProtocolEncodeParams params = {};
+    bool loaded = binraw.deserializeFromFile(file, params);
+    file.close();
+
+    return loaded && subghz_binraw_timings(binraw, timings);
+}
+
+#endif // SUBGHZ_PROTOCOL_BINRAW
@@ -0,0 +1,94 @@
+/**
+ * SubGHz RAW to BinRAW Conversion
+ *
+ * Captures of fixed-rate OOK signals are a handful of TE multiples repeated
+ * thousands of times. The duration histogram is clustered to estimate TE,
+ * every pulse is quantized to a whole number of TEs and packed one bit per
+ * TE into BinRAW blocks. The blocks are then re-synthesised through
+ * BinRAWProtocol's transmit path and compared with the original timings, so
+ * a conversion is only kept if replaying it reproduces the capture.
+ */
+
+#ifndef __SUBGHZ_BINRAW_H__
+#define __SUBGHZ_BINRAW_H__
+
+#include <Arduino.h>
+#include <vector>
+#include "protocols/protocol_binraw.h"
+
+#define SUBGHZ_TE_BIN_US             10       // Histogram bin width
+#define SUBGHZ_TE_MIN_US             50
+#define SUBGHZ_TE_MAX_US             3000
+#define SUBGHZ_TE_MIN_SAMPLES        16       // Fewer durations than this give no estimate
+#define SUBGHZ_TE_MIN_SHARE_PCT      2        // Clusters holding fewer of the durations are noise
+#define SUBGHZ_TE_CLUSTER_PCT        8        // Bins closer than this (% of duration) join one cluster
+#define SUBGHZ_BINRAW_FRAME_GAP_US   5000     // Lows at least this long separate frames
+#define SUBGHZ_BINRAW_GAP_MAX_US     30000    // Longer gaps are shortened; an RMT duration is 15 bits
+#define SUBGHZ_BINRAW_TOL_PCT        30       // Per-pulse quantization error allowed, % of TE
+#define SUBGHZ_BINRAW_MEAN_TOL_PCT   10       // Mean quantization error allowed, % of TE
+
+struct SubGhzTeCluster {
+    uint32_t mean_us;
+    uint32_t count;
+    bool level;
+};
+
+struct SubGhzTeEstimate {
+    uint32_t te_us;
+    int32_t bias_us;         // Highs come out this much longer, lows this much shorter (OOK/AGC widening)
+    uint32_t samples;        // Durations below SUBGHZ_BINRAW_FRAME_GAP_US
+    uint8_t clusters;        // Significant histogram clusters, both levels
+};
+
+struct SubGhzBinRawStats {
+    uint32_t te_us;
+    uint32_t total_bits;
+    uint32_t pulses;         // Timings converted
+    int32_t bias_us;
+    uint32_t max_err_us;     // Largest |corrected original - re-synthesised|, gaps shortened first
+    uint32_t mean_err_us;
+};
+
+/**
+ * Cluster one level's duration histogram and append the clusters holding at
+ * least SUBGHZ_TE_MIN_SHARE_PCT of its durations, shortest first.
+ * TE estimation does not depend on SUBGHZ_PROTOCOL_BINRAW.
+ * @return Durations of this level below SUBGHZ_BINRAW_FRAME_GAP_US
+ */
+uint32_t subghz_te_clusters(const std::vector<int> &timings, bool level, std::vector<SubGhzTeCluster> &out);
+
+/**
+ * Estimate TE from signed RAW timings. Highs and lows get separate duration
+ * histograms, since OOK receivers stretch one at the expense of the other.
+ * Each histogram is clustered. The shortest cluster of each level is taken
+ * as 1 TE for a first guess. TE and bias are then fitted (least squares)
+ * against every significant cluster's whole TE multiple.
+ * @return false if there are too few pulses, or a significant cluster is not
+ *         within SUBGHZ_BINRAW_TOL_PCT of a whole multiple of the estimate
+ */
+bool subghz_estimate_te(const std::vector<int> &timings, SubGhzTeEstimate *out);
+
+/**
+ * Convert signed RAW timings (positive = high, negative = low, in RAW_Data
+ * order) to BinRAW blocks. Durations are bias-corrected before quantizing,
+ * so the blocks describe what was transmitted rather than what the receiver
+ * stretched it to. Frames are packed into blocks whole; each frame's
+ * trailing gap is kept as 0 bits, capped at SUBGHZ_BINRAW_GAP_MAX_US.
+ * @param stats Optional; filled whenever a TE was found
+ * @return false if TE estimation, quantization or re-synthesis fails, or the
+ *         capture does not fit in BINRAW_MAX_BLOCKS blocks
+ */
+bool subghz_binraw_convert(const std::vector<int> &timings, std::vector<BinRAW_Block> &blocks,
+                           SubGhzBinRawStats *stats = nullptr);
+
+/**
+ * Expand loaded BinRAW blocks to signed timings via the transmit encoder
+ */
+bool subghz_binraw_timings(BinRAWProtocol &binraw, std::vector<int> &timings);
+
+/**
+ * Read a BinRAW .sub file and expand it to signed timings
+ */
+bool subghz_binraw_file_timings(const char *filepath, std::vector<int> &timings);
+
+#endif // __SUBGHZ_BINRAW_H__
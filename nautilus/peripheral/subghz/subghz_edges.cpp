@@ -0,0 +1,70 @@
+/**
+ * SubGHz Packed Edges
+ */
+
+#include "subghz_edges.h"
+
+SubGhzEdgeWriter::SubGhzEdgeWriter(uint16_t* arena, size_t capacity, const SubGhzFilterConfig& cfg,
+                                   SubGhzFilterStats* stats)
+    : arena(arena), capacity(capacity), words(0), edges(0), overflow(false),
+      pending(false), pending_level(false), pending_duration(0), cfg(cfg), stats(stats) {}
+
+void SubGhzEdgeWriter::flush() {
+    if (!pending) {
+        return;
+    }
+    pending = false;
+
+    uint16_t level = pending_level ? SUBGHZ_EDGE_LEVEL : 0;
+    if (pending_duration < SUBGHZ_EDGE_ESCAPE) {
+        if (words + 1 > capacity) {
+            overflow = true;
+            return;
+        }
+        arena[words++] = level | (uint16_t)pending_duration;
+    } else {
+        if (words + SUBGHZ_EDGE_ESCAPE_WORDS > capacity) {
+            overflow = true;
+            return;
+        }
+        arena[words++] = level | SUBGHZ_EDGE_ESCAPE;
+        arena[words++] = (uint16_t)(pending_duration >> 16);
+        arena[words++] = (uint16_t)(pending_duration & 0xFFFF);
+    }
+    edges++;
+}
+
+void SubGhzEdgeWriter::push(bool level, uint32_t duration) {
+    if (duration == 0 || overflow) {
+        return;
+    }
+
+    if (duration < cfg.glitch_us) {
+        if (!pending) {
+            // Nothing to merge into yet: leading noise
+            if (stats) stats->trimmed++;
+        } else {
+            // Absorb the spike; the edge after it has the held-back level
+            // again and is collapsed into the same entry below
+            pending_duration += duration;
+            if (stats) stats->glitches++;
+        }
+        return;
+    }
+
+    if (pending && pending_level == level) {
+        pending_duration += duration;
+        return;
+    }
+
+    flush();
+    pending = true;
+    pending_level = level;
+    pending_duration = duration;
+}
+
+SubGhzEdgeSpan SubGhzEdgeWriter::finish() {
+    flush();
+    SubGhzEdgeSpan span = { arena, words, edges };
+    return span;
+}
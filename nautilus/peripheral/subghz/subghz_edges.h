@@ -0,0 +1,117 @@
+/**
+ * SubGHz Packed Edges
+ *
+ * Decoder input is one uint16_t per edge: bit 15 is the level, bits 14..0
+ * the duration in us. A duration field of SUBGHZ_EDGE_ESCAPE marks a long
+ * edge (inter-burst gaps, mostly) whose full 32-bit duration follows in two
+ * words, high half first. Edges are written once per recording into a
+ * caller-owned arena and handed to the decoders as a span, instead of being
+ * rebuilt into heap vectors of 8-byte pairs.
+ */
+
+#ifndef __SUBGHZ_EDGES_H__
+#define __SUBGHZ_EDGES_H__
+
+#include <Arduino.h>
+#include "subghz_filter.h"
+
+#define SUBGHZ_EDGE_LEVEL       0x8000
+#define SUBGHZ_EDGE_DURATION    0x7FFF
+#define SUBGHZ_EDGE_ESCAPE      0x7FFF    // Duration field value: 32-bit duration follows
+#define SUBGHZ_EDGE_ESCAPE_WORDS 3
+
+/**
+ * Read-only view of packed edges
+ */
+struct SubGhzEdgeSpan {
+    const uint16_t* data;
+    size_t words;
+    size_t edges;            // Edge count; escapes make this less than words
+};
+
+/**
+ * Sequential decoder over a span
+ */
+class SubGhzEdgeReader {
+private:
+    const uint16_t* p;
+    const uint16_t* end;
+
+public:
+    explicit SubGhzEdgeReader(const SubGhzEdgeSpan& span) : p(span.data), end(span.data + span.words) {}
+
+    /**
+     * @return false at the end of the span
+     */
+    inline bool next(bool& level, uint32_t& duration) {
+        if (p >= end) {
+            return false;
+        }
+        uint16_t w = *p++;
+        level = (w & SUBGHZ_EDGE_LEVEL) != 0;
+        duration = w & SUBGHZ_EDGE_DURATION;
+        if (duration == SUBGHZ_EDGE_ESCAPE) {
+            if (end - p < 2) {
+                return false;
+            }
+            duration = ((uint32_t)p[0] << 16) | p[1];
+            p += 2;
+        }
+        return true;
+    }
+};
+
+/**
+ * Packs edges into an arena, applying the capture glitch filter on the way:
+ *  - zero-length edges are dropped
+ *  - an edge shorter than glitch_us is added to the edge before it, so the
+ *    pulse it split is joined back together
+ *  - consecutive edges of the same level are collapsed into one
+ *  - short spikes before the first real edge are dropped
+ * The last edge is held back until the level changes so it can still grow.
+ * Edges that no longer fit are dropped and overflowed() turns true.
+ */
+class SubGhzEdgeWriter {
+private:
+    uint16_t* arena;
+    size_t capacity;
+    size_t words;
+    size_t edges;
+    bool overflow;
+    bool pending;
+    bool pending_level;
+    uint32_t pending_duration;
+    SubGhzFilterConfig cfg;
+    SubGhzFilterStats* stats;
+
+    void flush();
+
+public:
+    /**
+     * @param arena Word buffer, reused from the start
+     * @param capacity Size of arena in words
+     * @param stats Optional filter counters, accumulated
+     */
+    SubGhzEdgeWriter(uint16_t* arena, size_t capacity, const SubGhzFilterConfig& cfg,
+                     SubGhzFilterStats* stats = nullptr);
+
+    void push(bool level, uint32_t duration);
+
+    /**
+     * Write the held-back edge and return the packed result
+     */
+    SubGhzEdgeSpan finish();
+
+    /**
+     * Edges written so far, the held-back one included
+     */
+    size_t count() const {
+        return edges + (pending ? 1 : 0);
+    }
+
+    bool overflowed() const {
+        return overflow;
+    }
+};
+
+#endif // __SUBGHZ_EDGES_H__
@@ -0,0 +1,24 @@
+/**
+ * SubGHz Edge Filter
+ *
+ * Cleans captured edges before they reach the protocol decoders. The RMT
+ * hardware filter only rejects spikes of a few APB cycles, so RF noise that
+ * splits a pulse in two would otherwise make every decoder miss the frame.
+ * The filter runs in SubGhzEdgeWriter while edges are packed (subghz_edges.h).
+ */
+
+#ifndef __SUBGHZ_FILTER_H__
+#define __SUBGHZ_FILTER_H__
+
+#include <Arduino.h>
+
+struct SubGhzFilterConfig {
+    uint32_t glitch_us;      // Edges shorter than this are merged into their neighbours (0 = off)
+};
+
+struct SubGhzFilterStats {
+    uint32_t glitches;       // Short edges merged away
+    uint32_t trimmed;        // Leading edges dropped
+};
+
+#endif // __SUBGHZ_FILTER_H__
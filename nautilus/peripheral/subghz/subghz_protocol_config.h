@@ -0,0 +1,34 @@
+/**
+ * SubGHz Protocol Build Options
+ *
+ * Each protocol is compiled in unless its flag is set to 0 in the
+ * platformio.ini build_flags, e.g. -DSUBGHZ_PROTOCOL_CAME=0. A protocol
+ * that is compiled out is neither registered nor linked, and files using
+ * it are played back as unknown protocols.
+ */
+
+#ifndef __SUBGHZ_PROTOCOL_CONFIG_H__
+#define __SUBGHZ_PROTOCOL_CONFIG_H__
+
+#ifndef SUBGHZ_PROTOCOL_SECPLUS_V1
+#define SUBGHZ_PROTOCOL_SECPLUS_V1  1
+#endif
+
+#ifndef SUBGHZ_PROTOCOL_SECPLUS_V2
+#define SUBGHZ_PROTOCOL_SECPLUS_V2  1
+#endif
+
+#ifndef SUBGHZ_PROTOCOL_PRINCETON
+#define SUBGHZ_PROTOCOL_PRINCETON   1
+#endif
+
+#ifndef SUBGHZ_PROTOCOL_CAME
+#define SUBGHZ_PROTOCOL_CAME        1
+#endif
+
+// Also gates saving fixed-rate RAW captures as BinRAW
+#ifndef SUBGHZ_PROTOCOL_BINRAW
+#define SUBGHZ_PROTOCOL_BINRAW      1
+#endif
+
+#endif // __SUBGHZ_PROTOCOL_CONFIG_H__
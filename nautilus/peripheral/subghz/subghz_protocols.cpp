@@ -8,7 +8,7 @@ static bool protocols_initialized = false;
 
 /**
  * Initialize SubGHz protocol system
- * Registers all available protocols
+ * Instantiates every protocol compiled into this build
  */
 void subghz_protocols_init() {
     if (protocols_initialized) {
@@ -19,18 +19,10 @@ void subghz_protocols_init() {
 
     ProtocolRegistry* registry = getProtocolRegistry();
 
-    // Register all available protocols
-    // IMPORTANT: Registration order matters for auto-detection!
-    // More specific protocols should be registered before more permissive ones
-    // CAME has an opportunistic mode that can falsely match other protocols
-    registry->registerProtocol(new SecPlusV1Protocol());
-    registry->registerProtocol(new SecPlusV2Protocol());
-    registry->registerProtocol(new PrincetonProtocol());  // Before CAME
-    registry->registerProtocol(new CAMEProtocol());       // Last (most permissive)
-    registry->registerProtocol(new BinRAWProtocol());     // Playback-only format
-
-    // Future protocols:
-    // etc.
+    // Each protocol registers itself with SUBGHZ_REGISTER_PROTOCOL(); the
+    // priority given there sets the auto-detect order (more specific
+    // decoders first, CAME's permissive opportunistic mode last)
+    registry->registerStatic();
 
     Serial.printf("[SubGHz Protocols] Initialized with %d protocols\n",
                  registry->getProtocolCount());
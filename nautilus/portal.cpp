@@ -288,7 +288,7 @@ String ssid_POST() {
     strncpy(g_config.wifi.portal.ssid, ssid.c_str(), sizeof(g_config.wifi.portal.ssid) - 1);
     g_config.wifi.portal.ssid[sizeof(g_config.wifi.portal.ssid) - 1] = '\0';
 
-    config_save();
+    config_mark_dirty(CONFIG_DIRTY_WIFI);
 
     setPortalSSID(ssid);
     printPortalHomeToScreen();
@@ -1,5 +1,7 @@
 
 #include "ui.h"
+#include "ui_theme.h"
+#include "perf_hud.h"
 #include <Arduino.h>
 #include <IRremoteESP8266.h>
 #include <IRsend.h>
@@ -11,6 +13,8 @@
 #include "peripheral/peripheral.h"
 #include "peripheral/peri_config.h"
 #include "peripheral/rf_utils.h"
+#include "peripheral/rf_packet.h"
+#include "peripheral/rf_hopper.h"
 #include "peripheral/subghz/protocols/protocol_secplus_v1.h"
 #include "peripheral/subghz/protocols/protocol_secplus_v2.h"
 #include "utilities.h"
@@ -24,16 +28,6 @@
 #define UI_THEME_DARK  0
 #define UI_THEME_LIGHT 1
 
-// Theme color structure
-struct ColorTheme {
-    uint32_t bg;
-    uint32_t focus;
-    uint32_t text;
-    uint32_t border;
-    uint32_t prompt_bg;
-    uint32_t prompt_txt;
-};
-
 // Theme definitions
 const ColorTheme THEMES[] = {
     // Dark theme
@@ -68,7 +62,8 @@ lv_obj_t *prompt_label;
 
 const char * ui_get_battert_level()
 {
-    int percent = bq27220.getStateOfCharge();
+    PowerSnapshot pwr;
+    int percent = power_get(&pwr) ? pwr.soc : 0;
     char * str = NULL;
      if(percent < 20)
         str =  LV_SYMBOL_BATTERY_EMPTY;
@@ -96,13 +91,7 @@ void prompt_create(const char *str, uint16_t time)
     lv_obj_set_width(prompt_label, DISPALY_WIDTH * 0.8);
     lv_label_set_text(prompt_label, str);
     lv_label_set_long_mode(prompt_label, LV_LABEL_LONG_WRAP);
-    lv_obj_set_style_radius(prompt_label, 5, LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(prompt_label, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_pad_hor(prompt_label, 3, LV_PART_MAIN);
-    lv_obj_set_style_text_font(prompt_label, FONT_BOLD_14, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(prompt_label, lv_color_hex(EMBED_COLOR_PROMPT_BG), LV_PART_MAIN);
-    lv_obj_set_style_text_color(prompt_label, lv_color_hex(EMBED_COLOR_PROMPT_TXT), LV_PART_MAIN);
-    lv_obj_set_style_text_align(prompt_label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+    lv_obj_add_style(prompt_label, &ui_style_prompt, LV_PART_MAIN);
     lv_obj_center(prompt_label);
     prompt_time = lv_timer_create(prompt_label_timer, time, prompt_label);
     prompt_is_busy = true;
@@ -120,17 +109,28 @@ void prompt_info(const char *str, uint16_t time)
     }
 }
 
-// LVGL styling helper functions to reduce code duplication
+// LVGL styling helper functions to reduce code duplication.
+// These attach the shared styles from ui_theme.cpp rather than setting local
+// properties, so theme switches and focus colours follow ui_theme_apply().
+// The colour helpers are also used to restore the theme colour after a
+// temporary highlight, so they drop any local override first.
 inline void apply_bg_color(lv_obj_t* obj) {
-    lv_obj_set_style_bg_color(obj, lv_color_hex(EMBED_COLOR_BG), LV_PART_MAIN);
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_BG_COLOR, LV_PART_MAIN);
+    ui_theme_attach(obj, &ui_style_bg, LV_PART_MAIN);
 }
 
 inline void apply_text_color(lv_obj_t* obj) {
-    lv_obj_set_style_text_color(obj, lv_color_hex(EMBED_COLOR_TEXT), LV_PART_MAIN);
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_TEXT_COLOR, LV_PART_MAIN);
+    ui_theme_attach(obj, &ui_style_text, LV_PART_MAIN);
 }
 
 inline void apply_no_border(lv_obj_t* obj) {
-    lv_obj_set_style_border_width(obj, 0, LV_PART_MAIN);
+    ui_theme_attach(obj, &ui_style_no_border, LV_PART_MAIN);
+}
+
+// Themed 1 px border
+inline void apply_theme_border(lv_obj_t* obj) {
+    ui_theme_attach(obj, &ui_style_border, LV_PART_MAIN);
 }
 
 inline void apply_border(lv_obj_t* obj, int width) {
@@ -138,11 +138,11 @@ inline void apply_border(lv_obj_t* obj, int width) {
 }
 
 inline void apply_no_padding(lv_obj_t* obj) {
-    lv_obj_set_style_pad_all(obj, 0, LV_PART_MAIN);
+    ui_theme_attach(obj, &ui_style_no_padding, LV_PART_MAIN);
 }
 
 inline void apply_no_radius(lv_obj_t* obj) {
-    lv_obj_set_style_radius(obj, 0, LV_PART_MAIN);
+    ui_theme_attach(obj, &ui_style_no_radius, LV_PART_MAIN);
 }
 
 inline void apply_no_scrollbar(lv_obj_t* obj) {
@@ -151,25 +151,46 @@ inline void apply_no_scrollbar(lv_obj_t* obj) {
 
 inline void apply_focus_outline(lv_obj_t* obj) {
     lv_obj_remove_style(obj, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(obj, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(obj, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    lv_obj_add_style(obj, &ui_style_focus, LV_STATE_FOCUS_KEY);
+}
+
+// Focus outline with a 2 px gap, used by most push buttons
+inline void apply_btn_focus(lv_obj_t* obj) {
+    lv_obj_remove_style(obj, NULL, LV_STATE_FOCUS_KEY);
+    lv_obj_add_style(obj, &ui_style_btn_focus, LV_STATE_FOCUS_KEY);
 }
 
 inline void apply_no_shadow(lv_obj_t* obj) {
-    lv_obj_set_style_shadow_width(obj, 0, LV_PART_MAIN);
+    ui_theme_attach(obj, &ui_style_no_shadow, LV_PART_MAIN);
+}
+
+// Text colour + FONT_BOLD_14
+inline void apply_label_style(lv_obj_t* obj) {
+    ui_theme_attach(obj, &ui_style_label, LV_PART_MAIN);
+}
+
+// Text colour + FONT_BOLD_20 screen title
+inline void apply_title_style(lv_obj_t* obj) {
+    ui_theme_attach(obj, &ui_style_title, LV_PART_MAIN);
+}
+
+// lv_list button: background, text, FONT_BOLD_14 and a rounded focus outline
+inline void apply_list_btn_style(lv_obj_t* obj) {
+    ui_theme_attach(obj, &ui_style_list_btn, LV_PART_MAIN);
+    lv_obj_remove_style(obj, NULL, LV_STATE_FOCUS_KEY);
+    lv_obj_add_style(obj, &ui_style_list_btn_focus, LV_STATE_FOCUS_KEY);
 }
 
 // Composite helper for common container styling
 inline void apply_container_defaults(lv_obj_t* obj) {
-    apply_bg_color(obj);
-    apply_no_border(obj);
-    apply_no_padding(obj);
+    ui_theme_attach(obj, &ui_style_container, LV_PART_MAIN);
     apply_no_radius(obj);
 }
 
 // Helper for battery percentage display
 inline void update_battery_percent_label(lv_obj_t* label) {
-    lv_label_set_text_fmt(label, "#%x %d #", EMBED_COLOR_TEXT, bq27220.getStateOfCharge());
+    PowerSnapshot pwr;
+    lv_label_set_text_fmt(label, "#%x %d #", EMBED_COLOR_TEXT, power_get(&pwr) ? pwr.soc : 0);
 }
 
 // Helper for menu button event callbacks (CLICKED + FOCUSED)
@@ -182,10 +203,8 @@ inline void add_menu_button_events(lv_obj_t* btn, lv_event_cb_t cb, void* user_d
 inline lv_obj_t* create_screen_container(lv_obj_t* parent) {
     lv_obj_t* cont = lv_obj_create(parent);
     lv_obj_set_size(cont, lv_pct(100), lv_pct(100));
-    apply_bg_color(cont);
+    ui_theme_attach(cont, &ui_style_container, LV_PART_MAIN);
     apply_no_scrollbar(cont);
-    apply_no_border(cont);
-    apply_no_padding(cont);
     return cont;
 }
 
@@ -224,9 +243,17 @@ void ui_theme_setting(int ui_theme)
         EMBED_COLOR_BORDER     = theme.border;
         EMBED_COLOR_PROMPT_BG  = theme.prompt_bg;
         EMBED_COLOR_PROMPT_TXT = theme.prompt_txt;
+
+        // Recolours every object built from the shared styles in one pass
+        ui_theme_apply(&theme);
+        // Hidden screens still carry the old colours in recolor text and local styles
+        scr_mgr_evict_all();
     }
 
     default_bg_color = EMBED_COLOR_BG;
+    if (lv_scr_act()) {
+        lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(default_bg_color), LV_PART_MAIN);
+    }
 }
 
 lv_obj_t * scr5_add_info_lab(lv_obj_t *parent, lv_obj_t *label, const char *s)
@@ -587,8 +614,7 @@ void create0(lv_obj_t *parent)
         add_menu_button_events(btn, scr0_btn_event_cb, (void *)i);
 
         lv_obj_t * label = lv_label_create(btn);
-        apply_text_color(label);
-        lv_obj_set_style_text_font(label, FONT_BOLD_14, LV_PART_MAIN);
+        apply_label_style(label);
         lv_label_set_text(label, active_menu_items[i].name);
     }
 
@@ -661,12 +687,14 @@ lv_obj_t* create_status_bar(lv_obj_t *parent) {
     lv_obj_t *charge_icon = lv_label_create(taskbar);
     lv_obj_set_style_text_align(charge_icon, LV_TEXT_ALIGN_RIGHT, 0);
     lv_label_set_recolor(charge_icon, true);
-    if(bq27220.getCharingFinish()) {
+    PowerSnapshot pwr;
+    bool pwr_ok = power_get(&pwr);
+    if(pwr_ok && pwr.charge_done) {
         lv_label_set_text_fmt(charge_icon, "#%x %s #", EMBED_COLOR_TEXT, LV_SYMBOL_OK);
     } else {
         lv_label_set_text_fmt(charge_icon, "#%x %s #", EMBED_COLOR_TEXT, LV_SYMBOL_CHARGE);
     }
-    if(!PPM.isCharging()) {
+    if(!pwr_ok || pwr.chg_status == PowersBQ25896::CHARGE_STATE_NO_CHARGE) {
         lv_obj_add_flag(charge_icon, LV_OBJ_FLAG_HIDDEN);
     }
 
@@ -813,7 +841,7 @@ static void ws2812_mode_event_cb(lv_event_t * e)
 
         // Save mode to config
         g_config.ws2812.mode = ui_light_mode;
-		config_save();
+		config_mark_dirty(CONFIG_DIRTY_WS2812);
     }
 }
 
@@ -885,14 +913,10 @@ void create1(lv_obj_t *parent)
     lv_obj_set_style_pad_all(mode_btn, 0, 0);
     lv_obj_set_height(mode_btn, 30);
     lv_obj_align(mode_btn, LV_ALIGN_BOTTOM_MID, 0, -10);
-    lv_obj_set_style_border_color(mode_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(mode_btn, 1, LV_PART_MAIN);
+    apply_theme_border(mode_btn);
     apply_no_shadow(mode_btn);
     apply_bg_color(mode_btn);
-    lv_obj_remove_style(mode_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(mode_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(mode_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(mode_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(mode_btn);
     lv_obj_t * mode_lab = lv_label_create(mode_btn);
     apply_text_color(mode_lab);
     lv_obj_align(mode_lab, LV_ALIGN_LEFT_MID, 0, 0);
@@ -955,6 +979,7 @@ lv_obj_t *subg_menu_cont;
 lv_obj_t *subg_menu_icon;
 lv_obj_t *subg_menu_icon_lab;
 lv_obj_t *subg_first_btn = NULL;  // Store first button to focus it
+lv_obj_t *subg_status_bar = NULL;
 
 int subg_focus_item = 0;
 
@@ -965,6 +990,8 @@ const char *subg_menu_items[] = {
     "<- Spectrum",
     "<- Remotes",
     "<- Frequencies",
+    "<- Packets",
+    "<- Hopper",
     "<- Back"
 };
 
@@ -1038,7 +1065,13 @@ static void subg_btn_event_cb(lv_event_t * e)
             case 5: // Frequencies
                 scr_mgr_switch(SCREEN2_6_ID, false);
                 break;
-            case 6: // Back
+            case 6: // Packets
+                scr_mgr_switch(SCREEN2_7_ID, false);
+                break;
+            case 7: // Hopper
+                scr_mgr_switch(SCREEN2_8_ID, false);
+                break;
+            case 8: // Back
                 exit2_anim(SCREEN0_ID, scr2_cont);
                 break;
             default:
@@ -1078,7 +1111,17 @@ static void subg_btn_event_cb(lv_event_t * e)
                 lv_obj_set_style_img_recolor(subg_menu_icon, lv_palette_main(LV_PALETTE_YELLOW), LV_PART_MAIN);
                 lv_obj_set_style_img_recolor_opa(subg_menu_icon, LV_OPA_100, LV_PART_MAIN);
                 break;
-            case 6: // Back
+            case 6: // Packets
+                lv_img_set_src(subg_menu_icon, &img_sghz_32);
+                lv_obj_set_style_img_recolor(subg_menu_icon, lv_palette_main(LV_PALETTE_PURPLE), LV_PART_MAIN);
+                lv_obj_set_style_img_recolor_opa(subg_menu_icon, LV_OPA_100, LV_PART_MAIN);
+                break;
+            case 7: // Hopper
+                lv_img_set_src(subg_menu_icon, &img_sghz_32);
+                lv_obj_set_style_img_recolor(subg_menu_icon, lv_palette_main(LV_PALETTE_ORANGE), LV_PART_MAIN);
+                lv_obj_set_style_img_recolor_opa(subg_menu_icon, LV_OPA_100, LV_PART_MAIN);
+                break;
+            case 8: // Back
                 lv_img_set_src(subg_menu_icon, &img_dev_32);
                 lv_obj_set_style_img_recolor_opa(subg_menu_icon, LV_OPA_0, LV_PART_MAIN);
                 break;
@@ -1185,23 +1228,20 @@ void create2(lv_obj_t *parent){
     apply_no_scrollbar(subg_item_cont);
     lv_obj_set_style_pad_row(subg_item_cont, 10, LV_PART_MAIN);
 
-    // Create 7 menu item buttons (6 features + Back)
-    for(int i = 0; i < 7; i++) {
+    // Create 9 menu item buttons (8 features + Back)
+    for(int i = 0; i < 9; i++) {
         lv_obj_t *btn = lv_btn_create(subg_item_cont);
         lv_obj_set_width(btn, lv_pct(100));
         lv_obj_set_style_radius(btn, 10, LV_PART_MAIN);
         apply_bg_color(btn);
         apply_no_border(btn);
         apply_no_shadow(btn);
-        lv_obj_remove_style(btn, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(btn, 2, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+        apply_focus_outline(btn);
         lv_obj_set_style_bg_img_opa(btn, LV_OPA_100, LV_PART_MAIN);
         add_menu_button_events(btn, subg_btn_event_cb, (void *)(intptr_t)i);
 
         lv_obj_t *label = lv_label_create(btn);
-        apply_text_color(label);
-        lv_obj_set_style_text_font(label, FONT_BOLD_14, LV_PART_MAIN);
+        apply_label_style(label);
         lv_label_set_text(label, subg_menu_items[i]);
 
         lv_group_add_obj(lv_group_get_default(), btn);
@@ -1212,11 +1252,18 @@ void create2(lv_obj_t *parent){
         }
     }
 
-    // Add status bar last (on parent, not scr2_cont) so it appears on top
-    create_status_bar(parent);
+    // Status bar is added in entry2() so a retained screen shows current state
 }
 
 void entry2(void) {
+    // Retained between visits: undo exit2_anim's slide-out and refresh the status bar
+    lv_obj_set_x(subg_item_cont, 0);
+    lv_obj_set_x(subg_menu_cont, 0);
+    if(subg_status_bar) {
+        lv_obj_del(subg_status_bar);
+    }
+    subg_status_bar = create_status_bar(lv_obj_get_parent(scr2_cont));
+
     if(subg_first_btn) {
         lv_group_focus_obj(subg_first_btn);
     }
@@ -1228,7 +1275,7 @@ void exit2(void) {
 }
 
 void destroy2(void) {
-    // Cleanup if needed
+    subg_status_bar = NULL;
 }
 
 scr_lifecycle_t screen2 = {
@@ -1252,11 +1299,6 @@ const int subghz_mhz_count = 277;  // Must match the array size in rf_utils.cpp
 float selected_frequency = SUBGHZ_DEFAULT_FREQ;
 int freq_selector_return_screen = SCREEN2_1_ID;  // Track which screen to return to (reusable for all SubGHz features)
 
-// Custom range helper functions (from peri_subghz.cpp)
-extern bool subghz_is_freq_valid(float freq_mhz);
-extern float subghz_align_freq_to_step(float freq_mhz, float step_khz);
-extern float subghz_next_valid_freq(float current_freq_mhz, float step_khz);
-
 //************************************[ screen 2.1 ]****************************************** SubGHz Record Raw
 #if 1
 
@@ -1348,10 +1390,17 @@ static void recraw_btn_save_event(lv_event_t *e)
                 int lastSlash = savedFile.lastIndexOf('/');
                 String displayName = (lastSlash >= 0) ? savedFile.substring(lastSlash + 1) : savedFile;
 
-                lv_label_set_text(recraw_status_label, "Status: Saved!");
+                // A duplicate is reported by the name of the file it matched
+                const String &dup = subghz_last_save_duplicate();
+                if (!dup.isEmpty()) {
+                    displayName = dup;
+                }
+                bool kept_existing = !dup.isEmpty() && g_config.subghz.dedup == SUBGHZ_DEDUP_SKIP;
+
+                lv_label_set_text(recraw_status_label, kept_existing ? "Status: Already saved" : "Status: Saved!");
 
                 // Create message with filename (truncate if too long)
-                String msg = "  Saved:\n  ";
+                String msg = kept_existing ? "  Already saved:\n  " : (dup.isEmpty() ? "  Saved:\n  " : "  Saved, same as:\n  ");
                 if (displayName.length() > 20) {
                     msg += displayName.substring(0, 17) + "...";
                 } else {
@@ -1459,18 +1508,13 @@ static void create2_1(lv_obj_t *parent)
     recraw_freq_label = lv_btn_create(scr2_1_cont);
     lv_obj_set_size(recraw_freq_label, 80, 28);
     lv_obj_align(recraw_freq_label, LV_ALIGN_TOP_RIGHT, -10, 40);
-    lv_obj_set_style_border_color(recraw_freq_label, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(recraw_freq_label, 1, LV_PART_MAIN);
+    apply_theme_border(recraw_freq_label);
     apply_no_shadow(recraw_freq_label);
     apply_bg_color(recraw_freq_label);
-    lv_obj_remove_style(recraw_freq_label, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(recraw_freq_label, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(recraw_freq_label, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(recraw_freq_label, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(recraw_freq_label);
     lv_obj_add_event_cb(recraw_freq_label, recraw_freq_btn_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *freq_label = lv_label_create(recraw_freq_label);
-    apply_text_color(freq_label);
-    lv_obj_set_style_text_font(freq_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(freq_label);
     lv_label_set_text_fmt(freq_label, "%.2f", selected_frequency);
     lv_obj_center(freq_label);
     lv_group_add_obj(lv_group_get_default(), recraw_freq_label);
@@ -1491,22 +1535,19 @@ static void create2_1(lv_obj_t *parent)
 
     // RSSI Label
     recraw_rssi_label = lv_label_create(scr2_1_cont);
-    apply_text_color(recraw_rssi_label);
-    lv_obj_set_style_text_font(recraw_rssi_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(recraw_rssi_label);
     lv_label_set_text(recraw_rssi_label, "RSSI: --- dBm");
     lv_obj_align(recraw_rssi_label, LV_ALIGN_TOP_LEFT, 10, 100);
 
     // Pulse count label
     recraw_pulse_label = lv_label_create(scr2_1_cont);
-    apply_text_color(recraw_pulse_label);
-    lv_obj_set_style_text_font(recraw_pulse_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(recraw_pulse_label);
     lv_label_set_text(recraw_pulse_label, "Pulses: 0");
     lv_obj_align(recraw_pulse_label, LV_ALIGN_TOP_RIGHT, -10, 100);
 
     // Status label (moved to top, same level as LED and freq selector)
     recraw_status_label = lv_label_create(scr2_1_cont);
-    apply_text_color(recraw_status_label);
-    lv_obj_set_style_text_font(recraw_status_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(recraw_status_label);
     lv_label_set_text(recraw_status_label, "Status: Ready");
     lv_obj_align(recraw_status_label, LV_ALIGN_TOP_LEFT, 10, 46);
 
@@ -1514,18 +1555,13 @@ static void create2_1(lv_obj_t *parent)
     recraw_btn_save = lv_btn_create(scr2_1_cont);
     lv_obj_set_size(recraw_btn_save, 70, 32);
     lv_obj_align(recraw_btn_save, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
-    lv_obj_set_style_border_color(recraw_btn_save, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(recraw_btn_save, 1, LV_PART_MAIN);
+    apply_theme_border(recraw_btn_save);
     apply_no_shadow(recraw_btn_save);
     apply_bg_color(recraw_btn_save);
-    lv_obj_remove_style(recraw_btn_save, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(recraw_btn_save, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(recraw_btn_save, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(recraw_btn_save, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(recraw_btn_save);
     lv_obj_add_event_cb(recraw_btn_save, recraw_btn_save_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *btn_label = lv_label_create(recraw_btn_save);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Save");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), recraw_btn_save);
@@ -1534,18 +1570,13 @@ static void create2_1(lv_obj_t *parent)
     recraw_btn_capture = lv_btn_create(scr2_1_cont);
     lv_obj_set_size(recraw_btn_capture, 90, 32);
     lv_obj_align(recraw_btn_capture, LV_ALIGN_BOTTOM_RIGHT, -85, -10);  // -85 = -10 (margin) - 70 (save width) - 5 (gap)
-    lv_obj_set_style_border_color(recraw_btn_capture, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(recraw_btn_capture, 1, LV_PART_MAIN);
+    apply_theme_border(recraw_btn_capture);
     apply_no_shadow(recraw_btn_capture);
     apply_bg_color(recraw_btn_capture);
-    lv_obj_remove_style(recraw_btn_capture, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(recraw_btn_capture, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(recraw_btn_capture, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(recraw_btn_capture, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(recraw_btn_capture);
     lv_obj_add_event_cb(recraw_btn_capture, recraw_btn_capture_event, LV_EVENT_CLICKED, NULL);
     btn_label = lv_label_create(recraw_btn_capture);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Capture");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), recraw_btn_capture);
@@ -1554,18 +1585,13 @@ static void create2_1(lv_obj_t *parent)
     recraw_btn_preset = lv_btn_create(scr2_1_cont);
     lv_obj_set_size(recraw_btn_preset, 75, 32);
     lv_obj_align(recraw_btn_preset, LV_ALIGN_BOTTOM_LEFT, 10, -10);
-    lv_obj_set_style_border_color(recraw_btn_preset, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(recraw_btn_preset, 1, LV_PART_MAIN);
+    apply_theme_border(recraw_btn_preset);
     apply_no_shadow(recraw_btn_preset);
     apply_bg_color(recraw_btn_preset);
-    lv_obj_remove_style(recraw_btn_preset, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(recraw_btn_preset, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(recraw_btn_preset, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(recraw_btn_preset, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(recraw_btn_preset);
     lv_obj_add_event_cb(recraw_btn_preset, recraw_preset_btn_event, LV_EVENT_CLICKED, NULL);
     btn_label = lv_label_create(recraw_btn_preset);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, get_preset_short_name(subghz_current_preset));
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), recraw_btn_preset);
@@ -1656,7 +1682,7 @@ static void freq_list_event(lv_event_t *e)
         int idx = (int)(intptr_t)lv_event_get_user_data(e);
 
         // Update selected frequency (from combined list)
-        std::vector<float> freq_list_data = rf_get_combined_frequency_list();
+        const std::vector<float> &freq_list_data = rf_get_combined_frequency_list();
         selected_frequency = freq_list_data[idx];
 
         // Save to config (save to raw.last_frequency for Record Raw screen)
@@ -1699,14 +1725,13 @@ static void create2_1_1(lv_obj_t *parent)
     apply_no_shadow(freq_list);
 
     // Add all frequencies to the list (hardcoded + custom from config)
-    std::vector<float> freq_list_data = rf_get_combined_frequency_list();
+    const std::vector<float> &freq_list_data = rf_get_combined_frequency_list();
     for (size_t i = 0; i < freq_list_data.size(); i++) {
         char freq_str[32];
         snprintf(freq_str, sizeof(freq_str), " %.3f MHz", freq_list_data[i]);
 
         lv_obj_t *item = lv_list_add_btn(freq_list, NULL, freq_str);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-        apply_text_color(item);
+        apply_label_style(item);
         apply_bg_color(item);
         lv_obj_add_event_cb(item, freq_list_event, LV_EVENT_CLICKED, (void*)(intptr_t)i);
         lv_group_add_obj(lv_group_get_default(), item);
@@ -1717,9 +1742,7 @@ static void create2_1_1(lv_obj_t *parent)
         }
 
         // Style for focus
-        lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+        apply_focus_outline(item);
     }
 
     // Back button
@@ -1999,13 +2022,7 @@ void playback_load_directory(const char *path)
     // Apply theme colors to all list items
     for(int i = 0; i < lv_obj_get_child_cnt(playback_file_list); i++) {
         lv_obj_t *item = lv_obj_get_child(playback_file_list, i);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-        apply_bg_color(item);
-        apply_text_color(item);
-        lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_radius(item, 5, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+        apply_list_btn_style(item);
     }
 
     lv_led_off(playback_led);
@@ -2129,8 +2146,7 @@ static void create2_2(lv_obj_t *parent)
     lv_obj_align(label, LV_ALIGN_TOP_MID, 0, 10);
 
     playback_path_label = lv_label_create(scr2_2_cont);
-    apply_text_color(playback_path_label);
-    lv_obj_set_style_text_font(playback_path_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(playback_path_label);
     lv_label_set_text(playback_path_label, "Path: /rf");
     lv_obj_align(playback_path_label, LV_ALIGN_TOP_LEFT, 10, 40);
 
@@ -2144,12 +2160,10 @@ static void create2_2(lv_obj_t *parent)
     lv_obj_set_size(playback_file_list, 300, 105);
     lv_obj_align(playback_file_list, LV_ALIGN_TOP_MID, 0, 65);
     apply_bg_color(playback_file_list);
-    lv_obj_set_style_border_width(playback_file_list, 1, LV_PART_MAIN);
-    lv_obj_set_style_border_color(playback_file_list, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
+    apply_theme_border(playback_file_list);
 
     playback_info_label = lv_label_create(scr2_2_cont);
-    apply_text_color(playback_info_label);
-    lv_obj_set_style_text_font(playback_info_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(playback_info_label);
     lv_label_set_text(playback_info_label, "Select a .sub file to transmit");
     lv_obj_set_width(playback_info_label, 300);
     lv_label_set_long_mode(playback_info_label, LV_LABEL_LONG_WRAP);
@@ -2368,7 +2382,7 @@ static bool reencode_secplus_signal() {
         return false;
     }
 
-
+#if SUBGHZ_PROTOCOL_SECPLUS_V2
     // Reconstruct 40-bit fixed code from button (8 bits) + serial (32 bits)
     // Fixed structure: [button(8)] [serial(32)]
     uint64_t fixed = ((uint64_t)current_signal_codes.secplus_button << 32) |
@@ -2437,6 +2451,9 @@ static bool reencode_secplus_signal() {
     lv_label_set_text(details_metadata_label2, meta2);
 
     return true;
+#else
+    return false;
+#endif
 }
 
 /**
@@ -2447,7 +2464,7 @@ static bool reencode_secplus_v1_signal() {
         return false;
     }
 
-
+#if SUBGHZ_PROTOCOL_SECPLUS_V1
     uint32_t fixed = (current_signal_codes.key >> 32) & 0xFFFFFFFF;
     uint32_t rolling = current_signal_codes.key & 0xFFFFFFFF;
 
@@ -2497,6 +2514,9 @@ static bool reencode_secplus_v1_signal() {
     current_signal_codes.key = new_key;
 
     return true;
+#else
+    return false;
+#endif
 }
 
 /**
@@ -2702,15 +2722,13 @@ static void create2_2_1(lv_obj_t *parent) {
 
     // Protocol and frequency line (top)
     details_protocol_label = lv_label_create(scr2_2_1_cont);
-    apply_text_color(details_protocol_label);
-    lv_obj_set_style_text_font(details_protocol_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(details_protocol_label);
     lv_label_set_text(details_protocol_label, "Loading...");
     lv_obj_align(details_protocol_label, LV_ALIGN_TOP_MID, 0, 10);
 
     // Metadata line 1
     details_metadata_label1 = lv_label_create(scr2_2_1_cont);
-    apply_text_color(details_metadata_label1);
-    lv_obj_set_style_text_font(details_metadata_label1, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(details_metadata_label1);
     lv_label_set_text(details_metadata_label1, "");
     lv_obj_set_width(details_metadata_label1, 300);
     lv_label_set_long_mode(details_metadata_label1, LV_LABEL_LONG_WRAP);
@@ -2718,8 +2736,7 @@ static void create2_2_1(lv_obj_t *parent) {
 
     // Metadata line 2
     details_metadata_label2 = lv_label_create(scr2_2_1_cont);
-    apply_text_color(details_metadata_label2);
-    lv_obj_set_style_text_font(details_metadata_label2, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(details_metadata_label2);
     lv_label_set_text(details_metadata_label2, "");
     lv_obj_set_width(details_metadata_label2, 300);
     lv_label_set_long_mode(details_metadata_label2, LV_LABEL_LONG_WRAP);
@@ -2727,8 +2744,7 @@ static void create2_2_1(lv_obj_t *parent) {
 
     // Metadata line 3
     details_metadata_label3 = lv_label_create(scr2_2_1_cont);
-    apply_text_color(details_metadata_label3);
-    lv_obj_set_style_text_font(details_metadata_label3, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(details_metadata_label3);
     lv_label_set_text(details_metadata_label3, "");
     lv_obj_set_width(details_metadata_label3, 300);
     lv_label_set_long_mode(details_metadata_label3, LV_LABEL_LONG_WRAP);
@@ -2736,8 +2752,7 @@ static void create2_2_1(lv_obj_t *parent) {
 
     // Metadata line 4
     details_metadata_label4 = lv_label_create(scr2_2_1_cont);
-    apply_text_color(details_metadata_label4);
-    lv_obj_set_style_text_font(details_metadata_label4, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(details_metadata_label4);
     lv_label_set_text(details_metadata_label4, "");
     lv_obj_set_width(details_metadata_label4, 300);
     lv_label_set_long_mode(details_metadata_label4, LV_LABEL_LONG_WRAP);
@@ -2750,64 +2765,49 @@ static void create2_2_1(lv_obj_t *parent) {
     details_dec_btn = lv_btn_create(scr2_2_1_cont);
     lv_obj_set_size(details_dec_btn, 90, 35);
     lv_obj_align(details_dec_btn, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
-    lv_obj_set_style_border_color(details_dec_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(details_dec_btn, 1, LV_PART_MAIN);
+    apply_theme_border(details_dec_btn);
     apply_no_shadow(details_dec_btn);
     apply_bg_color(details_dec_btn);
-    lv_obj_remove_style(details_dec_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(details_dec_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(details_dec_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(details_dec_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(details_dec_btn);
     lv_obj_add_event_cb(details_dec_btn, dec_btn_event_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_add_flag(details_dec_btn, LV_OBJ_FLAG_HIDDEN);  // Hidden by default
 
     lv_obj_t *dec_label = lv_label_create(details_dec_btn);
     lv_label_set_text(dec_label, "Dec");
-    apply_text_color(dec_label);
-    lv_obj_set_style_text_font(dec_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(dec_label);
     lv_obj_center(dec_label);
 
     // Increment button (center - for rolling codes)
     details_inc_btn = lv_btn_create(scr2_2_1_cont);
     lv_obj_set_size(details_inc_btn, 90, 35);
     lv_obj_align(details_inc_btn, LV_ALIGN_BOTTOM_MID, 0, -10);
-    lv_obj_set_style_border_color(details_inc_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(details_inc_btn, 1, LV_PART_MAIN);
+    apply_theme_border(details_inc_btn);
     apply_no_shadow(details_inc_btn);
     apply_bg_color(details_inc_btn);
-    lv_obj_remove_style(details_inc_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(details_inc_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(details_inc_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(details_inc_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(details_inc_btn);
     lv_obj_add_event_cb(details_inc_btn, inc_btn_event_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_add_flag(details_inc_btn, LV_OBJ_FLAG_HIDDEN);  // Hidden by default
 
     lv_obj_t *inc_label = lv_label_create(details_inc_btn);
     lv_label_set_text(inc_label, "Inc");
-    apply_text_color(inc_label);
-    lv_obj_set_style_text_font(inc_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(inc_label);
     lv_obj_center(inc_label);
 
     // Send button (left)
     details_send_btn = lv_btn_create(scr2_2_1_cont);
     lv_obj_set_size(details_send_btn, 90, 35);
     lv_obj_align(details_send_btn, LV_ALIGN_BOTTOM_LEFT, 10, -10);
-    lv_obj_set_style_border_color(details_send_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(details_send_btn, 1, LV_PART_MAIN);
+    apply_theme_border(details_send_btn);
     apply_no_shadow(details_send_btn);
     apply_bg_color(details_send_btn);
-    lv_obj_remove_style(details_send_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(details_send_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(details_send_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(details_send_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(details_send_btn);
     lv_obj_add_event_cb(details_send_btn, send_btn_event_cb, LV_EVENT_PRESSED, NULL);
     lv_obj_add_event_cb(details_send_btn, send_btn_event_cb, LV_EVENT_LONG_PRESSED, NULL);
     lv_obj_add_event_cb(details_send_btn, send_btn_event_cb, LV_EVENT_CLICKED, NULL);
 
     details_send_label = lv_label_create(details_send_btn);
     lv_label_set_text(details_send_label, "Send");
-    apply_text_color(details_send_label);
-    lv_obj_set_style_text_font(details_send_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(details_send_label);
     lv_obj_center(details_send_label);
 }
 
@@ -2898,6 +2898,21 @@ struct {
 // Custom range scanning state
 float scan_custom_current_freq = 0.0f;
 bool scan_custom_mode = false;
+static RfFreqPlan scan_custom_plan;     // Valid channels of the custom range, built on Start
+static uint32_t scan_custom_idx = 0;    // Next channel to scan
+
+// Load plan channel idx (wrapping to the start) into scan_custom_current_freq
+static RfChannel scan_custom_channel(uint32_t idx)
+{
+    RfChannel ch;
+    if (idx >= scan_custom_plan.count) {
+        idx = 0;
+    }
+    scan_custom_idx = idx;
+    rf_freq_plan_get(&scan_custom_plan, idx, &ch);
+    scan_custom_current_freq = rf_freq_hz_to_mhz(ch.hz);
+    return ch;
+}
 
 // Auto-resume scanning state (for all modes)
 unsigned long scan_weak_signal_start = 0;  // When signal dropped below threshold
@@ -2928,43 +2943,24 @@ static void scan_update_timer_event(lv_timer_t *t)
             bool freq_changed = false;
 
             if (scan_custom_mode) {
-                // Custom range mode: use step-based navigation
+                // Custom range mode: step through the plan, which has no band gaps
                 // Note: encoder_diff direction is inverted (minus = up)
-                float step_mhz = scan_step_size_khz / 1000.0f;
-                int steps = -encoder_diff;  // Invert to match expected direction
-
-                // Calculate new frequency
-                new_freq = current_freq + (steps * step_mhz);
-
-                // Clamp to custom range bounds
-                if (new_freq < scan_custom_start_freq) {
-                    new_freq = scan_custom_start_freq;
-                } else if (new_freq > scan_custom_end_freq) {
-                    new_freq = scan_custom_end_freq;
-                }
+                int32_t cur_idx = rf_freq_plan_nearest(&scan_custom_plan, rf_freq_mhz_to_hz(current_freq));
+                if (cur_idx >= 0) {
+                    int32_t new_idx = cur_idx - encoder_diff;
+                    if (new_idx < 0) new_idx = 0;
+                    if (new_idx >= (int32_t)scan_custom_plan.count) new_idx = scan_custom_plan.count - 1;
 
-                // Ensure frequency is valid (handle CC1101 band gaps)
-                if (!subghz_is_freq_valid(new_freq)) {
-                    // Find next valid frequency in the direction we're moving
-                    if (steps > 0) {
-                        new_freq = subghz_next_valid_freq(new_freq - step_mhz, scan_step_size_khz);
-                    } else {
-                        // For backward movement, we need to find previous valid freq
-                        // Start from current and go backwards
-                        float test_freq = current_freq - step_mhz;
-                        while (test_freq >= scan_custom_start_freq && !subghz_is_freq_valid(test_freq)) {
-                            test_freq -= step_mhz;
-                        }
-                        new_freq = test_freq >= scan_custom_start_freq ? test_freq : current_freq;
+                    if (new_idx != cur_idx) {
+                        new_freq = rf_freq_hz_to_mhz(scan_custom_channel(new_idx).hz);
+                        freq_changed = true;
                     }
                 }
 
-                freq_changed = (fabs(new_freq - current_freq) > 0.001f);
-
             } else {
                 // Predefined list mode: use index-based navigation (with custom frequencies)
                 // Find current frequency index in the list
-                std::vector<float> freq_list_data = rf_get_combined_frequency_list();
+                const std::vector<float> &freq_list_data = rf_get_combined_frequency_list();
                 int freq_count = freq_list_data.size();
                 int current_idx = -1;
                 float min_diff = 999.0f;
@@ -3026,25 +3022,15 @@ static void scan_update_timer_event(lv_timer_t *t)
         // Scan one frequency per timer tick
         if (scan_attempt < 5) {  // FREQ_SCAN_MAX_TRIES
             float check_freq;
+            RfChannel check_ch;
 
             if (scan_custom_mode) {
-                // Custom range scanning with configurable step
+                // Custom range scanning: plan channels are exact Hz, wrapping at the end
+                check_ch = scan_custom_channel(scan_custom_idx);
                 check_freq = scan_custom_current_freq;
-
-                // Check if we've reached the end - wrap around to start
-                if (check_freq > scan_custom_end_freq || check_freq == 0.0f) {
-                    // Align start frequency to step boundary to prevent drift
-                    scan_custom_current_freq = subghz_align_freq_to_step(scan_custom_start_freq, scan_step_size_khz);
-
-                    // Ensure start frequency is valid
-                    if (!subghz_is_freq_valid(scan_custom_current_freq)) {
-                        scan_custom_current_freq = subghz_next_valid_freq(scan_custom_current_freq - (scan_step_size_khz / 1000.0f), scan_step_size_khz);
-                    }
-                    check_freq = scan_custom_current_freq;
-                }
             } else {
                 // Predefined frequency list scanning (with custom frequencies)
-                std::vector<float> freq_list_data = rf_get_combined_frequency_list();
+                const std::vector<float> &freq_list_data = rf_get_combined_frequency_list();
 
                 // Wrap around if we reach the end
                 if (scan_current_idx > scan_range_end) {
@@ -3052,6 +3038,8 @@ static void scan_update_timer_event(lv_timer_t *t)
                 }
 
                 check_freq = freq_list_data[scan_current_idx];
+                check_ch.hz = rf_freq_mhz_to_hz(check_freq);
+                check_ch.freq_word = rf_freq_word(check_ch.hz);
             }
 
             // Update status for display
@@ -3061,8 +3049,8 @@ static void scan_update_timer_event(lv_timer_t *t)
                 status->frequency = check_freq;
             }
 
-            // Configure radio and check RSSI
-            if (rf_initModule("rx", check_freq)) {
+            // Configure radio and check RSSI; same-band steps only rewrite FREQ
+            if (rf_retune_rx(&check_ch)) {
                 delay(5);  // Let radio settle
                 int rssi = ELECHOUSE_cc1101.getRssi();
 
@@ -3098,8 +3086,8 @@ static void scan_update_timer_event(lv_timer_t *t)
             }
 
             if (scan_custom_mode) {
-                // Move to next frequency in custom range, skipping invalid gaps
-                scan_custom_current_freq = subghz_next_valid_freq(scan_custom_current_freq, scan_step_size_khz);
+                // Move to next channel in the custom range plan
+                scan_custom_idx++;
             } else {
                 scan_current_idx++;
             }
@@ -3189,7 +3177,10 @@ static void scan_update_timer_event(lv_timer_t *t)
                     String protocol_name;
                     String filepath = subghz_save_last_signal(nullptr, &protocol_name);
                     if (filepath.length() > 0) {
-                        scan_saved_count++;  // Increment saved file counter
+                        // Repeats of an already-saved signal are not new files
+                        if (subghz_last_save_duplicate().isEmpty() || g_config.subghz.dedup != SUBGHZ_DEDUP_SKIP) {
+                            scan_saved_count++;  // Increment saved file counter
+                        }
 
                         // Display protocol notification
                         if (!protocol_name.isEmpty()) {
@@ -3292,8 +3283,8 @@ static void scan_update_timer_event(lv_timer_t *t)
 
                     // Skip to next frequency to avoid re-checking the same one
                     if (scan_custom_mode) {
-                        // Custom range mode: advance to next frequency
-                        scan_custom_current_freq = subghz_next_valid_freq(scan_custom_current_freq, scan_step_size_khz);
+                        // Custom range mode: advance past the channel we listened on
+                        scan_custom_idx++;
                     } else {
                         // Predefined list mode: advance index
                         scan_current_idx++;
@@ -3464,15 +3455,22 @@ static void scan_btn_start_event(lv_event_t *e)
                     return;
                 }
 
-                // Initialize custom range scanning
-                scan_custom_mode = true;
-                // Align start frequency to step boundary to prevent drift
-                scan_custom_current_freq = subghz_align_freq_to_step(scan_custom_start_freq, scan_step_size_khz);
+                // Initialize custom range scanning: channels snap to the step grid once, here
+                if (!rf_freq_plan_build(&scan_custom_plan, rf_freq_mhz_to_hz(scan_custom_start_freq),
+                                        rf_freq_mhz_to_hz(scan_custom_end_freq),
+                                        (uint32_t)lroundf(scan_step_size_khz * 1000.0f))) {
+                    prompt_info("Error: No valid channels in range", 2000);
+                    scan_is_active = false;
+                    lv_label_set_text(lv_obj_get_child(scan_btn_start, 0), "Start");
+                    apply_bg_color(scan_btn_start);
+                    apply_text_color(lv_obj_get_child(scan_btn_start, 0));
 
-                // Ensure start frequency is valid
-                if (!subghz_is_freq_valid(scan_custom_current_freq)) {
-                    scan_custom_current_freq = subghz_next_valid_freq(scan_custom_current_freq - (scan_step_size_khz / 1000.0f), scan_step_size_khz);
+                    extern volatile bool indev_encoder_enabled;
+                    indev_encoder_enabled = true;
+                    return;
                 }
+                scan_custom_mode = true;
+                scan_custom_channel(0);
 
                 scan_attempt = 0;
                 scan_in_progress = true;
@@ -3614,12 +3612,17 @@ static void scan_btn_save_event(lv_event_t *e)
             // Extract just the filename for display
             int lastSlash = filepath.lastIndexOf('/');
             String filename = (lastSlash >= 0) ? filepath.substring(lastSlash + 1) : filepath;
+            const String &dup = subghz_last_save_duplicate();
+            if (!dup.isEmpty()) {
+                filename = dup;
+            }
+            bool kept_existing = !dup.isEmpty() && g_config.subghz.dedup == SUBGHZ_DEDUP_SKIP;
 
             // Show success message with filename (truncate if too long)
             if (filename.length() > 16) {
                 filename = filename.substring(0, 13) + "...";
             }
-            String message = "  Saved:\n  " + filename;
+            String message = (kept_existing ? "  Already saved:\n  " : (dup.isEmpty() ? "  Saved:\n  " : "  Saved, same as:\n  ")) + filename;
             prompt_info(message.c_str(), 2000);
         } else {
             prompt_info("  Save failed\n  Check SD card", 2000);
@@ -3727,15 +3730,13 @@ static void create2_3(lv_obj_t *parent)
 
     // Status label (left side, under back button area)
     scan_status_label = lv_label_create(scr2_3_cont);
-    apply_text_color(scan_status_label);
-    lv_obj_set_style_text_font(scan_status_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(scan_status_label);
     lv_label_set_text(scan_status_label, "Status: Ready");
     lv_obj_align(scan_status_label, LV_ALIGN_TOP_LEFT, 35, 46);
 
     // Signal count label (right side, same row as status)
     scan_signal_label = lv_label_create(scr2_3_cont);
-    apply_text_color(scan_signal_label);
-    lv_obj_set_style_text_font(scan_signal_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(scan_signal_label);
     lv_label_set_text(scan_signal_label, "Sig: 0");
     lv_obj_align(scan_signal_label, LV_ALIGN_TOP_RIGHT, -10, 46);
 
@@ -3743,18 +3744,13 @@ static void create2_3(lv_obj_t *parent)
     scan_freq_btn = lv_btn_create(scr2_3_cont);
     lv_obj_set_size(scan_freq_btn, 90, 28);
     lv_obj_align(scan_freq_btn, LV_ALIGN_TOP_LEFT, 10, 70);
-    lv_obj_set_style_border_color(scan_freq_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(scan_freq_btn, 1, LV_PART_MAIN);
+    apply_theme_border(scan_freq_btn);
     apply_no_shadow(scan_freq_btn);
     apply_bg_color(scan_freq_btn);
-    lv_obj_remove_style(scan_freq_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(scan_freq_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(scan_freq_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(scan_freq_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(scan_freq_btn);
     lv_obj_add_event_cb(scan_freq_btn, scan_freq_btn_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *freq_label = lv_label_create(scan_freq_btn);
-    apply_text_color(freq_label);
-    lv_obj_set_style_text_font(freq_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(freq_label);
     char freq_text[32];
     get_freq_display_text(freq_text, sizeof(freq_text));
     lv_label_set_text(freq_label, freq_text);
@@ -3765,18 +3761,13 @@ static void create2_3(lv_obj_t *parent)
     scan_preset_btn = lv_btn_create(scr2_3_cont);
     lv_obj_set_size(scan_preset_btn, 75, 28);
     lv_obj_align(scan_preset_btn, LV_ALIGN_TOP_MID, 0, 70);
-    lv_obj_set_style_border_color(scan_preset_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(scan_preset_btn, 1, LV_PART_MAIN);
+    apply_theme_border(scan_preset_btn);
     apply_no_shadow(scan_preset_btn);
     apply_bg_color(scan_preset_btn);
-    lv_obj_remove_style(scan_preset_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(scan_preset_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(scan_preset_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(scan_preset_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(scan_preset_btn);
     lv_obj_add_event_cb(scan_preset_btn, scan_preset_btn_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *preset_label = lv_label_create(scan_preset_btn);
-    apply_text_color(preset_label);
-    lv_obj_set_style_text_font(preset_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(preset_label);
     lv_label_set_text(preset_label, get_preset_short_name(subghz_current_preset));
     lv_obj_center(preset_label);
     lv_group_add_obj(lv_group_get_default(), scan_preset_btn);
@@ -3785,18 +3776,13 @@ static void create2_3(lv_obj_t *parent)
     scan_thresh_btn = lv_btn_create(scr2_3_cont);
     lv_obj_set_size(scan_thresh_btn, 70, 28);
     lv_obj_align(scan_thresh_btn, LV_ALIGN_TOP_RIGHT, -10, 70);
-    lv_obj_set_style_border_color(scan_thresh_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(scan_thresh_btn, 1, LV_PART_MAIN);
+    apply_theme_border(scan_thresh_btn);
     apply_no_shadow(scan_thresh_btn);
     apply_bg_color(scan_thresh_btn);
-    lv_obj_remove_style(scan_thresh_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(scan_thresh_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(scan_thresh_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(scan_thresh_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(scan_thresh_btn);
     lv_obj_add_event_cb(scan_thresh_btn, scan_thresh_btn_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *thresh_label = lv_label_create(scan_thresh_btn);
-    apply_text_color(thresh_label);
-    lv_obj_set_style_text_font(thresh_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(thresh_label);
     lv_label_set_text_fmt(thresh_label, "%d dBm", scan_rssi_threshold);
     lv_obj_center(thresh_label);
     lv_group_add_obj(lv_group_get_default(), scan_thresh_btn);
@@ -3817,8 +3803,7 @@ static void create2_3(lv_obj_t *parent)
 
     // RSSI Label (overlaid on top of bar, centered)
     scan_rssi_label = lv_label_create(scr2_3_cont);
-    apply_text_color(scan_rssi_label);
-    lv_obj_set_style_text_font(scan_rssi_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(scan_rssi_label);
     lv_label_set_text(scan_rssi_label, "RSSI: --- dBm");
     lv_obj_align(scan_rssi_label, LV_ALIGN_TOP_MID, 0, 107);  // Centered vertically on bar
     // Add semi-transparent background for better readability
@@ -3839,18 +3824,13 @@ static void create2_3(lv_obj_t *parent)
     scan_btn_auto = lv_btn_create(scr2_3_cont);
     lv_obj_set_size(scan_btn_auto, btn_width, 32);
     lv_obj_align(scan_btn_auto, LV_ALIGN_BOTTOM_MID, start_x + (btn_width + btn_spacing) * 3, -10);
-    lv_obj_set_style_border_color(scan_btn_auto, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(scan_btn_auto, 1, LV_PART_MAIN);
+    apply_theme_border(scan_btn_auto);
     apply_no_shadow(scan_btn_auto);
     apply_bg_color(scan_btn_auto);
-    lv_obj_remove_style(scan_btn_auto, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(scan_btn_auto, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(scan_btn_auto, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(scan_btn_auto, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(scan_btn_auto);
     lv_obj_add_event_cb(scan_btn_auto, scan_btn_auto_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *auto_label = lv_label_create(scan_btn_auto);
-    apply_text_color(auto_label);
-    lv_obj_set_style_text_font(auto_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(auto_label);
     lv_label_set_text(auto_label, "Auto");
     lv_obj_center(auto_label);
     lv_group_add_obj(lv_group_get_default(), scan_btn_auto);
@@ -3859,18 +3839,13 @@ static void create2_3(lv_obj_t *parent)
     scan_btn_start = lv_btn_create(scr2_3_cont);
     lv_obj_set_size(scan_btn_start, btn_width, 32);
     lv_obj_align(scan_btn_start, LV_ALIGN_BOTTOM_MID, start_x + (btn_width + btn_spacing) * 2, -10);
-    lv_obj_set_style_border_color(scan_btn_start, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(scan_btn_start, 1, LV_PART_MAIN);
+    apply_theme_border(scan_btn_start);
     apply_no_shadow(scan_btn_start);
     apply_bg_color(scan_btn_start);
-    lv_obj_remove_style(scan_btn_start, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(scan_btn_start, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(scan_btn_start, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(scan_btn_start, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(scan_btn_start);
     lv_obj_add_event_cb(scan_btn_start, scan_btn_start_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *start_label = lv_label_create(scan_btn_start);
-    apply_text_color(start_label);
-    lv_obj_set_style_text_font(start_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(start_label);
     lv_label_set_text(start_label, "Start");
     lv_obj_center(start_label);
     lv_group_add_obj(lv_group_get_default(), scan_btn_start);
@@ -3879,18 +3854,13 @@ static void create2_3(lv_obj_t *parent)
     scan_btn_replay = lv_btn_create(scr2_3_cont);
     lv_obj_set_size(scan_btn_replay, btn_width, 32);
     lv_obj_align(scan_btn_replay, LV_ALIGN_BOTTOM_MID, start_x + (btn_width + btn_spacing) * 1, -10);
-    lv_obj_set_style_border_color(scan_btn_replay, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(scan_btn_replay, 1, LV_PART_MAIN);
+    apply_theme_border(scan_btn_replay);
     apply_no_shadow(scan_btn_replay);
     apply_bg_color(scan_btn_replay);
-    lv_obj_remove_style(scan_btn_replay, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(scan_btn_replay, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(scan_btn_replay, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(scan_btn_replay, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(scan_btn_replay);
     lv_obj_add_event_cb(scan_btn_replay, scan_btn_replay_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *replay_label = lv_label_create(scan_btn_replay);
-    apply_text_color(replay_label);
-    lv_obj_set_style_text_font(replay_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(replay_label);
     lv_label_set_text(replay_label, "Replay");
     lv_obj_center(replay_label);
     lv_group_add_obj(lv_group_get_default(), scan_btn_replay);
@@ -3899,18 +3869,13 @@ static void create2_3(lv_obj_t *parent)
     scan_btn_save = lv_btn_create(scr2_3_cont);
     lv_obj_set_size(scan_btn_save, btn_width, 32);
     lv_obj_align(scan_btn_save, LV_ALIGN_BOTTOM_MID, start_x, -10);
-    lv_obj_set_style_border_color(scan_btn_save, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(scan_btn_save, 1, LV_PART_MAIN);
+    apply_theme_border(scan_btn_save);
     apply_no_shadow(scan_btn_save);
     apply_bg_color(scan_btn_save);
-    lv_obj_remove_style(scan_btn_save, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(scan_btn_save, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(scan_btn_save, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(scan_btn_save, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(scan_btn_save);
     lv_obj_add_event_cb(scan_btn_save, scan_btn_save_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *save_label = lv_label_create(scan_btn_save);
-    apply_text_color(save_label);
-    lv_obj_set_style_text_font(save_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(save_label);
     lv_label_set_text(save_label, "Save");
     lv_obj_center(save_label);
     lv_group_add_obj(lv_group_get_default(), scan_btn_save);
@@ -4111,15 +4076,12 @@ static void create2_3_1(lv_obj_t *parent)
     const char* modes[] = {"Single Frequency", "Scan List", "Custom Range"};
     for (int i = 0; i < 3; i++) {
         lv_obj_t *item = lv_list_add_btn(freq_mode_list, NULL, modes[i]);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-        apply_text_color(item);
+        apply_label_style(item);
         apply_bg_color(item);
         lv_obj_add_event_cb(item, freq_mode_list_event, LV_EVENT_CLICKED, (void*)(intptr_t)i);
         lv_group_add_obj(lv_group_get_default(), item);
 
-        lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+        apply_focus_outline(item);
     }
 
     // Back button
@@ -4165,7 +4127,7 @@ static void scan_single_freq_list_event(lv_event_t *e)
 {
     if (e->code == LV_EVENT_CLICKED) {
         int idx = (int)(intptr_t)lv_event_get_user_data(e);
-        std::vector<float> freq_list_data = rf_get_combined_frequency_list();
+        const std::vector<float> &freq_list_data = rf_get_combined_frequency_list();
         float selected_freq = freq_list_data[idx];
 
         if (freq_selector_mode == 0) {
@@ -4233,14 +4195,13 @@ static void create2_3_1_1(lv_obj_t *parent)
     // Add all frequencies to the list (hardcoded + custom from config)
     lv_obj_t *selected_item = NULL;
     if (freq_selector_mode == 0){
-        std::vector<float> freq_list_data = rf_get_combined_frequency_list();
+        const std::vector<float> &freq_list_data = rf_get_combined_frequency_list();
     	for (size_t i = 0; i < freq_list_data.size(); i++) {
             char freq_str[32];
             snprintf(freq_str, sizeof(freq_str), " %.3f MHz", freq_list_data[i]);
 
             lv_obj_t *item = lv_list_add_btn(scan_single_freq_list, NULL, freq_str);
-            lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-            apply_text_color(item);
+            apply_label_style(item);
             apply_bg_color(item);
             lv_obj_add_event_cb(item, scan_single_freq_list_event, LV_EVENT_CLICKED, (void*)(intptr_t)i);
             lv_group_add_obj(lv_group_get_default(), item);
@@ -4255,9 +4216,7 @@ static void create2_3_1_1(lv_obj_t *parent)
                 selected_item = item;  // Remember this item to focus on it
             }
 
-            lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+            apply_focus_outline(item);
         }
 	}else{
         for (int i = 0; i < subghz_mhz_count; i++) {
@@ -4265,8 +4224,7 @@ static void create2_3_1_1(lv_obj_t *parent)
             snprintf(freq_str, sizeof(freq_str), " %.3f MHz", subghz_mhz_list[i]);
 
             lv_obj_t *item = lv_list_add_btn(scan_single_freq_list, NULL, freq_str);
-            lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-            apply_text_color(item);
+            apply_label_style(item);
             apply_bg_color(item);
             lv_obj_add_event_cb(item, scan_single_freq_list_event, LV_EVENT_CLICKED, (void*)(intptr_t)i);
             lv_group_add_obj(lv_group_get_default(), item);
@@ -4285,9 +4243,7 @@ static void create2_3_1_1(lv_obj_t *parent)
                 selected_item = item;  // Remember this item to focus on it
             }
 
-            lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+            apply_focus_outline(item);
         }
 	}
 
@@ -4388,8 +4344,7 @@ static void create2_3_1_2(lv_obj_t *parent)
     const char* ranges[] = {"300-348 MHz", "387-464 MHz", "779-928 MHz", "Full Range"};
     for (int i = 0; i < 4; i++) {
         lv_obj_t *item = lv_list_add_btn(scan_range_list, NULL, ranges[i]);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-        apply_text_color(item);
+        apply_label_style(item);
         apply_bg_color(item);
         lv_obj_add_event_cb(item, scan_range_list_event, LV_EVENT_CLICKED, (void*)(intptr_t)i);
         lv_group_add_obj(lv_group_get_default(), item);
@@ -4399,9 +4354,7 @@ static void create2_3_1_2(lv_obj_t *parent)
             lv_obj_set_style_text_color(item, lv_color_hex(0x00FF00), LV_PART_MAIN);
         }
 
-        lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+        apply_focus_outline(item);
     }
 
     // Back button
@@ -4507,15 +4460,12 @@ static void create2_3_1_3(lv_obj_t *parent)
     const char* options[] = {start_freq_str, end_freq_str, step_size_str};
     for (int i = 0; i < 3; i++) {
         lv_obj_t *item = lv_list_add_btn(custom_freq_list, NULL, options[i]);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-        apply_text_color(item);
+        apply_label_style(item);
         apply_bg_color(item);
         lv_obj_add_event_cb(item, custom_freq_list_event, LV_EVENT_CLICKED, (void*)(intptr_t)i);
         lv_group_add_obj(lv_group_get_default(), item);
 
-        lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+        apply_focus_outline(item);
     }
 
     // Back button
@@ -4604,15 +4554,12 @@ static void create2_3_1_4(lv_obj_t *parent)
     // Add all step sizes to the list
     for (int i = 0; i < num_step_sizes; i++) {
         lv_obj_t *item = lv_list_add_btn(step_size_list, NULL, step_size_labels[i]);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-        apply_text_color(item);
+        apply_label_style(item);
         apply_bg_color(item);
         lv_obj_add_event_cb(item, step_size_list_event, LV_EVENT_CLICKED, (void*)(intptr_t)i);
         lv_group_add_obj(lv_group_get_default(), item);
 
-        lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+        apply_focus_outline(item);
     }
 
     // Back button
@@ -4864,7 +4811,7 @@ static void spectrum_start_btn_event(lv_event_t *e)
             // Initialize frequency array
             if (spectrum_range_mode == 3) {
                 // Full range - use actual frequency list (includes custom frequencies)
-                std::vector<float> freq_list_data = rf_get_combined_frequency_list();
+                const std::vector<float> &freq_list_data = rf_get_combined_frequency_list();
                 spectrum_bar_count = freq_list_data.size();
                 for (int i = 0; i < spectrum_bar_count && i < SPECTRUM_MAX_BARS; i++) {
                     spectrum_frequencies[i] = freq_list_data[i];
@@ -4930,18 +4877,13 @@ static void create2_4(lv_obj_t *parent)
     spectrum_range_btn = lv_btn_create(scr2_4_cont);
     lv_obj_set_size(spectrum_range_btn, 90, 28);
     lv_obj_align(spectrum_range_btn, LV_ALIGN_TOP_LEFT, 35, 38);
-    lv_obj_set_style_border_color(spectrum_range_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(spectrum_range_btn, 1, LV_PART_MAIN);
+    apply_theme_border(spectrum_range_btn);
     apply_no_shadow(spectrum_range_btn);
     apply_bg_color(spectrum_range_btn);
-    lv_obj_remove_style(spectrum_range_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(spectrum_range_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(spectrum_range_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(spectrum_range_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(spectrum_range_btn);
     lv_obj_add_event_cb(spectrum_range_btn, spectrum_range_btn_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *range_label = lv_label_create(spectrum_range_btn);
-    apply_text_color(range_label);
-    lv_obj_set_style_text_font(range_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(range_label);
     lv_label_set_text(range_label, "Range");
     lv_obj_center(range_label);
     lv_group_add_obj(lv_group_get_default(), spectrum_range_btn);
@@ -4950,18 +4892,13 @@ static void create2_4(lv_obj_t *parent)
     spectrum_start_btn = lv_btn_create(scr2_4_cont);
     lv_obj_set_size(spectrum_start_btn, 70, 28);
     lv_obj_align(spectrum_start_btn, LV_ALIGN_TOP_RIGHT, -10, 38);
-    lv_obj_set_style_border_color(spectrum_start_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(spectrum_start_btn, 1, LV_PART_MAIN);
+    apply_theme_border(spectrum_start_btn);
     apply_no_shadow(spectrum_start_btn);
     apply_bg_color(spectrum_start_btn);
-    lv_obj_remove_style(spectrum_start_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(spectrum_start_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(spectrum_start_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(spectrum_start_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(spectrum_start_btn);
     lv_obj_add_event_cb(spectrum_start_btn, spectrum_start_btn_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *start_label = lv_label_create(spectrum_start_btn);
-    apply_text_color(start_label);
-    lv_obj_set_style_text_font(start_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(start_label);
     lv_label_set_text(start_label, "Start");
     lv_obj_center(start_label);
     lv_group_add_obj(lv_group_get_default(), spectrum_start_btn);
@@ -4975,28 +4912,24 @@ static void create2_4(lv_obj_t *parent)
 
     // Peak frequency label (drawn after canvas so it appears on top)
     spectrum_peak_label = lv_label_create(scr2_4_cont);
-    apply_text_color(spectrum_peak_label);
-    lv_obj_set_style_text_font(spectrum_peak_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(spectrum_peak_label);
     lv_label_set_text(spectrum_peak_label, "Peak: ---");
     lv_obj_align(spectrum_peak_label, LV_ALIGN_TOP_MID, 0, 73);
 
     // Frequency labels below canvas
     spectrum_freq_label_low = lv_label_create(scr2_4_cont);
-    apply_text_color(spectrum_freq_label_low);
-    lv_obj_set_style_text_font(spectrum_freq_label_low, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(spectrum_freq_label_low);
     lv_label_set_text(spectrum_freq_label_low, "300MHz");
     lv_obj_align(spectrum_freq_label_low, LV_ALIGN_BOTTOM_LEFT, 10, -10);
 
     spectrum_freq_label_high = lv_label_create(scr2_4_cont);
-    apply_text_color(spectrum_freq_label_high);
-    lv_obj_set_style_text_font(spectrum_freq_label_high, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(spectrum_freq_label_high);
     lv_label_set_text(spectrum_freq_label_high, "928MHz");
     lv_obj_align(spectrum_freq_label_high, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
 
     // Current frequency label
     spectrum_freq_current = lv_label_create(scr2_4_cont);
-    apply_text_color(spectrum_freq_current);
-    lv_obj_set_style_text_font(spectrum_freq_current, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(spectrum_freq_current);
     lv_label_set_text(spectrum_freq_current, "---");
     lv_obj_align(spectrum_freq_current, LV_ALIGN_BOTTOM_MID, 0, -10);
 
@@ -5136,8 +5069,7 @@ static void create2_4_1(lv_obj_t *parent)
     const char* ranges[] = {"300-348 MHz", "387-464 MHz", "779-928 MHz", "Scan List"};
     for (int i = 0; i < 4; i++) {
         lv_obj_t *item = lv_list_add_btn(spectrum_range_list, NULL, ranges[i]);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-        apply_text_color(item);
+        apply_label_style(item);
         apply_bg_color(item);
         lv_obj_add_event_cb(item, spectrum_range_list_event, LV_EVENT_CLICKED, (void*)(intptr_t)i);
         lv_group_add_obj(lv_group_get_default(), item);
@@ -5147,9 +5079,7 @@ static void create2_4_1(lv_obj_t *parent)
             lv_obj_set_style_text_color(item, lv_color_hex(0x00FF00), LV_PART_MAIN);
         }
 
-        lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+        apply_focus_outline(item);
     }
 
     // Back button
@@ -5868,16 +5798,13 @@ void subghz_remote_load_directory(const char *path)
         // Add file items to list
         for (const String& file : files) {
             lv_obj_t *item = lv_list_add_btn(subghz_remote_file_list, NULL, file.c_str());
-            lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-            apply_text_color(item);
+            apply_label_style(item);
             apply_bg_color(item);
             lv_obj_add_event_cb(item, subghz_remote_list_event, LV_EVENT_CLICKED, NULL);
             lv_obj_add_event_cb(item, subghz_remote_list_event, LV_EVENT_LONG_PRESSED, NULL);
             lv_obj_add_event_cb(item, subghz_remote_list_event, LV_EVENT_PRESSED, NULL);
             lv_group_add_obj(lv_group_get_default(), item);
-            lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+            apply_focus_outline(item);
         }
     } else {
     }
@@ -5889,9 +5816,7 @@ void subghz_remote_load_directory(const char *path)
     apply_bg_color(new_item);
     lv_obj_add_event_cb(new_item, subghz_remote_list_event, LV_EVENT_CLICKED, NULL);
     lv_group_add_obj(lv_group_get_default(), new_item);
-    lv_obj_remove_style(new_item, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(new_item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(new_item, 2, LV_STATE_FOCUS_KEY);
+    apply_focus_outline(new_item);
 
     // Set focus to the first item in the list
     if (lv_obj_get_child_cnt(subghz_remote_file_list) > 0) {
@@ -5940,17 +5865,14 @@ void subghz_remote_show_buttons()
         snprintf(item_text, sizeof(item_text), " %s", button.name.c_str());
 
         lv_obj_t *item = lv_list_add_btn(subghz_remote_file_list, NULL, item_text);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-        apply_text_color(item);
+        apply_label_style(item);
         apply_bg_color(item);
         lv_obj_set_user_data(item, (void*)(intptr_t)i);  // Store button index
         lv_obj_add_event_cb(item, subghz_remote_list_event, LV_EVENT_CLICKED, NULL);
         lv_obj_add_event_cb(item, subghz_remote_list_event, LV_EVENT_LONG_PRESSED, NULL);
         lv_obj_add_event_cb(item, subghz_remote_list_event, LV_EVENT_PRESSED, NULL);
         lv_group_add_obj(lv_group_get_default(), item);
-        lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+        apply_focus_outline(item);
     }
 
     // Add "(New Button)" item (only in normal button list mode, not in edit mode)
@@ -5961,9 +5883,7 @@ void subghz_remote_show_buttons()
         apply_bg_color(new_btn);
         lv_obj_add_event_cb(new_btn, subghz_remote_list_event, LV_EVENT_CLICKED, NULL);
         lv_group_add_obj(lv_group_get_default(), new_btn);
-        lv_obj_remove_style(new_btn, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(new_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(new_btn, 2, LV_STATE_FOCUS_KEY);
+        apply_focus_outline(new_btn);
     }
 
     // Set focus to the first button item
@@ -6022,8 +5942,7 @@ static void create2_5(lv_obj_t *parent)
 
     // Path label
     subghz_remote_path_label = lv_label_create(scr2_5_cont);
-    apply_text_color(subghz_remote_path_label);
-    lv_obj_set_style_text_font(subghz_remote_path_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(subghz_remote_path_label);
     lv_label_set_text(subghz_remote_path_label, "Path: /sgremotes");
     lv_obj_set_width(subghz_remote_path_label, 160);
     lv_label_set_long_mode(subghz_remote_path_label, LV_LABEL_LONG_DOT);
@@ -6134,10 +6053,12 @@ static void custom_freq_mgmt_list_event(lv_event_t *e)
                     if (txt && strcmp(txt, "Delete") == 0) {
                         if (custom_freq_selected_index >= 0 &&
                             custom_freq_selected_index < (int)g_config.subghz.custom_frequencies.size()) {
+                            config_lock();
                             g_config.subghz.custom_frequencies.erase(
                                 g_config.subghz.custom_frequencies.begin() + custom_freq_selected_index);
+                            config_unlock();
                             rf_invalidate_frequency_cache();
-                            config_save();
+                            config_mark_dirty(CONFIG_DIRTY_SUBGHZ);
                             prompt_info("  Frequency deleted", 1500);
 
                             lv_obj_clean(custom_freq_mgmt_list);
@@ -6147,16 +6068,13 @@ static void custom_freq_mgmt_list_event(lv_event_t *e)
                                 snprintf(freq_str, sizeof(freq_str), " %.3f MHz", g_config.subghz.custom_frequencies[i]);
 
                                 lv_obj_t *item = lv_list_add_btn(custom_freq_mgmt_list, NULL, freq_str);
-                                lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-                                apply_text_color(item);
+                                apply_label_style(item);
                                 apply_bg_color(item);
                                 lv_obj_add_event_cb(item, custom_freq_mgmt_list_event, LV_EVENT_CLICKED, (void*)(intptr_t)i);
                                 lv_obj_add_event_cb(item, custom_freq_mgmt_list_event, LV_EVENT_LONG_PRESSED, (void*)(intptr_t)i);
                                 lv_group_add_obj(lv_group_get_default(), item);
 
-                                lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-                                lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-                                lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+                                apply_focus_outline(item);
                             }
 
                             lv_obj_t *add_item = lv_list_add_btn(custom_freq_mgmt_list, NULL, " + Add Frequency");
@@ -6167,9 +6085,7 @@ static void custom_freq_mgmt_list_event(lv_event_t *e)
                                                 (void*)(intptr_t)g_config.subghz.custom_frequencies.size());
                             lv_group_add_obj(lv_group_get_default(), add_item);
 
-                            lv_obj_remove_style(add_item, NULL, LV_STATE_FOCUS_KEY);
-                            lv_obj_set_style_outline_color(add_item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-                            lv_obj_set_style_outline_width(add_item, 2, LV_STATE_FOCUS_KEY);
+                            apply_focus_outline(add_item);
                         }
                     }
 
@@ -6247,16 +6163,13 @@ static void create2_6(lv_obj_t *parent)
         snprintf(freq_str, sizeof(freq_str), " %.3f MHz", g_config.subghz.custom_frequencies[i]);
 
         lv_obj_t *item = lv_list_add_btn(custom_freq_mgmt_list, NULL, freq_str);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-        apply_text_color(item);
+        apply_label_style(item);
         apply_bg_color(item);
         lv_obj_add_event_cb(item, custom_freq_mgmt_list_event, LV_EVENT_CLICKED, (void*)(intptr_t)i);
         lv_obj_add_event_cb(item, custom_freq_mgmt_list_event, LV_EVENT_LONG_PRESSED, (void*)(intptr_t)i);
         lv_group_add_obj(lv_group_get_default(), item);
 
-        lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+        apply_focus_outline(item);
     }
 
     // Add "Add Frequency" button at the end
@@ -6268,9 +6181,7 @@ static void create2_6(lv_obj_t *parent)
                         (void*)(intptr_t)g_config.subghz.custom_frequencies.size());
     lv_group_add_obj(lv_group_get_default(), add_item);
 
-    lv_obj_remove_style(add_item, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(add_item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(add_item, 2, LV_STATE_FOCUS_KEY);
+    apply_focus_outline(add_item);
 
     // Back button
     scr_back_btn_create(scr2_6_cont, scr2_6_back_btn_event_cb);
@@ -6355,9 +6266,11 @@ static void add_freq_keyboard_event(lv_event_t *e)
             }
 
             if (!is_duplicate) {
+                config_lock();
                 g_config.subghz.custom_frequencies.push_back(freq);
+                config_unlock();
                 rf_invalidate_frequency_cache();
-                config_save();
+                config_mark_dirty(CONFIG_DIRTY_SUBGHZ);
                 prompt_info("  Frequency added", 1500);
             } else {
                 prompt_info("  Frequency already exists", 2000);
@@ -6695,14 +6608,11 @@ void subghz_fb_load_files()
 
     // Add back button
     lv_obj_t *back_item = lv_list_add_btn(subghz_fb_file_list, NULL, "<- Back");
-    lv_obj_set_style_text_font(back_item, FONT_BOLD_14, LV_PART_MAIN);
-    apply_text_color(back_item);
+    apply_label_style(back_item);
     apply_bg_color(back_item);
     lv_obj_add_event_cb(back_item, subghz_fb_list_event, LV_EVENT_CLICKED, NULL);
     lv_group_add_obj(lv_group_get_default(), back_item);
-    lv_obj_remove_style(back_item, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(back_item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(back_item, 2, LV_STATE_FOCUS_KEY);
+    apply_focus_outline(back_item);
 
     // Ensure /rf directory exists (create if needed)
     if (!SD.exists("/rf")) {
@@ -6756,15 +6666,12 @@ void subghz_fb_load_files()
         // Add file items to list
         for (const String& file : files) {
             lv_obj_t *item = lv_list_add_btn(subghz_fb_file_list, NULL, file.c_str());
-            lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-            apply_text_color(item);
+            apply_label_style(item);
             apply_bg_color(item);
             lv_obj_add_event_cb(item, subghz_fb_list_event, LV_EVENT_CLICKED, NULL);
             lv_obj_add_event_cb(item, subghz_fb_list_event, LV_EVENT_PRESSED, NULL);
             lv_group_add_obj(lv_group_get_default(), item);
-            lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+            apply_focus_outline(item);
         }
 
     } else {
@@ -6848,163 +6755,553 @@ void enter_subghz_file_browser(int button_index)
 }
 #endif
 
-//************************************[ screen 3 ]****************************************** NFC File Browser
+//************************************[ screen 2.7 ]************************************** SubGHz Packet Capture
 #if 1
-lv_obj_t *scr3_cont;
-lv_obj_t *nfc_file_list;
-lv_obj_t *nfc_path_label;
-lv_obj_t *nfc_status_led;
-char nfc_current_path[256] = "/nfc";
-NFCTag nfc_current_tag;
-char nfc_selected_file[128] = "";
+#define PKTCAP_MAX_ROWS     20      // Oldest rows are dropped past this
+#define PKTCAP_HEX_BYTES    12      // Payload bytes shown per row
 
-void entry3_anim(lv_obj_t *obj) { entry1_anim(obj); }
-void exit3_anim(int user_data, lv_obj_t *obj) { exit1_anim(user_data, obj); }
+lv_obj_t *scr2_7_cont = NULL;
+lv_obj_t *pktcap_status_label;
+lv_obj_t *pktcap_stats_label;
+lv_obj_t *pktcap_freq_btn;
+lv_obj_t *pktcap_list;
+lv_obj_t *pktcap_btn_start;
+lv_timer_t *pktcap_update_timer = NULL;
 
-// Forward declarations
-void nfc_load_directory(const char *path);
+void entry2_7_anim(lv_obj_t *obj) { entry1_anim(obj); }
+void exit2_7_anim(int user_data, lv_obj_t *obj) { exit1_anim(user_data, obj); }
 
-static void nfc_list_event_cb(lv_event_t *e)
+static void pktcap_add_row(const RfPacket *pkt)
 {
-    if (e->code == LV_EVENT_CLICKED) {
-        lv_obj_t *btn = lv_event_get_target(e);
-        const char *item_text = lv_list_get_btn_text(nfc_file_list, btn);
+    char row[64];
+    int n = snprintf(row, sizeof(row), "%c%4d %3u ", pkt->crc_ok ? ' ' : '!', pkt->rssi, (unsigned)pkt->len);
+    for (int i = 0; i < pkt->len && i < PKTCAP_HEX_BYTES && n < (int)sizeof(row) - 3; i++) {
+        n += snprintf(row + n, sizeof(row) - n, "%02X", pkt->data[i]);
+    }
 
-        if (item_text) {
+    lv_obj_t *item = lv_list_add_text(pktcap_list, row);
+    apply_label_style(item);
+    apply_bg_color(item);
+    if (!pkt->crc_ok) {
+        lv_obj_set_style_text_color(item, lv_palette_main(LV_PALETTE_RED), LV_PART_MAIN);
+    }
 
-            // Handle "(Read NFC Tag)" item
-            if (strcmp(item_text, "(Read NFC Tag)") == 0) {
-                scr_mgr_switch(SCREEN3_1_ID, false);
-                return;
-            }
+    if (lv_obj_get_child_cnt(pktcap_list) > PKTCAP_MAX_ROWS) {
+        lv_obj_del(lv_obj_get_child(pktcap_list, 0));
+    }
+    lv_obj_scroll_to_view(item, LV_ANIM_OFF);
+}
 
-            // Handle parent directory
-            if (strstr(item_text, ".. (Parent)")) {
-                // Go up one directory
-                char *last_slash = strrchr(nfc_current_path, '/');
-                if (last_slash && last_slash != nfc_current_path) {
-                    *last_slash = '\0';
-                } else {
-                    strcpy(nfc_current_path, "/nfc");
-                }
-                nfc_load_directory(nfc_current_path);
-                return;
-            }
+static void pktcap_update_timer_event(lv_timer_t *t)
+{
+    // Drain the ring; it keeps filling in the background between ticks
+    RfPacket pkt;
+    while (rf_packet_read(&pkt)) {
+        pktcap_add_row(&pkt);
+    }
 
-            // Handle file/folder (strip leading space)
-            const char *display_name = item_text + 1;
+    if (rf_packet_is_active()) {
+        RfPacketStats st;
+        rf_packet_get_stats(&st);
+        lv_label_set_text_fmt(pktcap_stats_label, "Rx: %lu  CRC: %lu  Lost: %lu",
+                              (unsigned long)st.received, (unsigned long)st.crc_errors,
+                              (unsigned long)(st.ring_drops + st.overflows));
+    }
+}
 
-            // Check if it's a folder
-            char test_path[512];
-            snprintf(test_path, sizeof(test_path), "%s/%s", nfc_current_path, display_name);
-            DIR *test_dir = opendir(test_path);
+static void pktcap_btn_start_event(lv_event_t *e)
+{
+    if (e->code == LV_EVENT_CLICKED) {
+        lv_obj_t *label = lv_obj_get_child(pktcap_btn_start, 0);
 
-            if (test_dir) {
-                // It's a folder
-                closedir(test_dir);
-                strncpy(nfc_current_path, test_path, sizeof(nfc_current_path) - 1);
-                nfc_load_directory(nfc_current_path);
-            } else {
-                // It's a file - add .nfc extension and load
-                char file_name[128];
-                snprintf(file_name, sizeof(file_name), "%s.nfc", display_name);
+        if (rf_packet_is_active()) {
+            rf_packet_stop();
+            lv_label_set_text(label, "Start");
+            lv_label_set_text(pktcap_status_label, "Status: Stopped");
+            return;
+        }
 
-                char full_path[512];
-                snprintf(full_path, sizeof(full_path), "%s/%s", nfc_current_path, file_name);
+        RfPacketConfig cfg;
+        rf_packet_default_config(&cfg);
+        cfg.freq_mhz = selected_frequency;
+        if (rf_packet_start(&cfg)) {
+            lv_label_set_text(label, "Stop");
+            lv_label_set_text(pktcap_status_label, "Status: Listening");
+        } else {
+            lv_label_set_text(pktcap_status_label, "Status: Radio busy");
+            prompt_info("  Packet capture\n  failed to start", 2000);
+        }
+    }
+}
 
-                // Parse NFC file
-                lv_led_on(nfc_status_led);
-                if (parseFlipperNFCFile(full_path, nfc_current_tag)) {
-                    lv_led_off(nfc_status_led);
-                    // Switch to tag detail screen
-                    scr_mgr_switch(SCREEN3_2_ID, false);
-                } else {
-                    lv_led_off(nfc_status_led);
-                    prompt_info("  Error parsing NFC file", 2000);
-                }
-            }
+static void pktcap_freq_btn_event(lv_event_t *e)
+{
+    if (e->code == LV_EVENT_CLICKED) {
+        if (rf_packet_is_active()) {
+            rf_packet_stop();
         }
+        freq_selector_return_screen = SCREEN2_7_ID;
+        exit2_7_anim(SCREEN2_1_1_ID, scr2_7_cont);
     }
 }
 
-static void scr3_back_btn_event_cb(lv_event_t *e)
+static void scr2_7_back_btn_event_cb(lv_event_t *e)
 {
     if (e->code == LV_EVENT_CLICKED) {
-        exit3_anim(SCREEN0_ID, scr3_cont);
+        if (rf_packet_is_active()) {
+            rf_packet_stop();
+        }
+        exit2_7_anim(SCREEN2_ID, scr2_7_cont);
     }
 }
 
-void nfc_load_directory(const char *path)
+static void create2_7(lv_obj_t *parent)
 {
-    lv_led_on(nfc_status_led);
-    lv_refr_now(NULL);
+    scr2_7_cont = create_screen_container(parent);
 
-    lv_obj_clean(nfc_file_list);
-    lv_label_set_text_fmt(nfc_path_label, "Path: %s", path);
+    // Title
+    lv_obj_t *label = lv_label_create(scr2_7_cont);
+    apply_text_color(label);
+    lv_obj_set_style_text_font(label, FONT_BOLD_18, LV_PART_MAIN);
+    lv_label_set_text(label, "Packets");
+    lv_obj_align(label, LV_ALIGN_TOP_MID, 0, 10);
 
-    // Add parent directory option if not at root
-    if (strcmp(path, "/nfc") != 0) {
-        lv_obj_t *parent_item = lv_list_add_btn(nfc_file_list, NULL, " .. (Parent)");
-        lv_obj_add_event_cb(parent_item, nfc_list_event_cb, LV_EVENT_CLICKED, NULL);
-    }
+    // Frequency button (shares the Record RAW frequency selector)
+    pktcap_freq_btn = lv_btn_create(scr2_7_cont);
+    lv_obj_set_size(pktcap_freq_btn, 80, 28);
+    lv_obj_align(pktcap_freq_btn, LV_ALIGN_TOP_RIGHT, -10, 40);
+    apply_theme_border(pktcap_freq_btn);
+    apply_no_shadow(pktcap_freq_btn);
+    apply_bg_color(pktcap_freq_btn);
+    apply_btn_focus(pktcap_freq_btn);
+    lv_obj_add_event_cb(pktcap_freq_btn, pktcap_freq_btn_event, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *freq_label = lv_label_create(pktcap_freq_btn);
+    apply_label_style(freq_label);
+    lv_label_set_text_fmt(freq_label, "%.2f", selected_frequency);
+    lv_obj_center(freq_label);
+    lv_group_add_obj(lv_group_get_default(), pktcap_freq_btn);
 
-    // Create directory if it doesn't exist
-    if (!SD.exists(path)) {
-        SD.mkdir(path);
-    }
+    // Status label
+    pktcap_status_label = lv_label_create(scr2_7_cont);
+    apply_label_style(pktcap_status_label);
+    lv_label_set_text(pktcap_status_label, "Status: Ready");
+    lv_obj_align(pktcap_status_label, LV_ALIGN_TOP_LEFT, 10, 46);
+
+    // Receive counters
+    pktcap_stats_label = lv_label_create(scr2_7_cont);
+    apply_label_style(pktcap_stats_label);
+    lv_label_set_text(pktcap_stats_label, "Rx: 0  CRC: 0  Lost: 0");
+    lv_obj_align(pktcap_stats_label, LV_ALIGN_TOP_LEFT, 10, 72);
+
+    // Received packets: CRC flag, RSSI, length, leading payload bytes
+    pktcap_list = lv_list_create(scr2_7_cont);
+    lv_obj_set_size(pktcap_list, LV_HOR_RES - 20, 62);
+    lv_obj_align(pktcap_list, LV_ALIGN_TOP_MID, 0, 94);
+    apply_bg_color(pktcap_list);
+    lv_obj_set_style_pad_row(pktcap_list, 0, LV_PART_MAIN);
+    apply_no_radius(pktcap_list);
+    apply_no_border(pktcap_list);
+    apply_no_shadow(pktcap_list);
+
+    // Start/Stop button
+    pktcap_btn_start = lv_btn_create(scr2_7_cont);
+    lv_obj_set_size(pktcap_btn_start, 90, 32);
+    lv_obj_align(pktcap_btn_start, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
+    apply_theme_border(pktcap_btn_start);
+    apply_no_shadow(pktcap_btn_start);
+    apply_bg_color(pktcap_btn_start);
+    apply_btn_focus(pktcap_btn_start);
+    lv_obj_add_event_cb(pktcap_btn_start, pktcap_btn_start_event, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *btn_label = lv_label_create(pktcap_btn_start);
+    apply_label_style(btn_label);
+    lv_label_set_text(btn_label, "Start");
+    lv_obj_center(btn_label);
+    lv_group_add_obj(lv_group_get_default(), pktcap_btn_start);
 
-    // Try multiple mount points (SD card VFS mount location)
-    const char* mount_points[] = {"/sd", "/sdcard", "/mnt/sd"};
-    DIR *dir = NULL;
+    // Back button
+    scr_back_btn_create(scr2_7_cont, scr2_7_back_btn_event_cb);
 
-    for (int i = 0; i < 3; i++) {
-        char test_path[512];
-        snprintf(test_path, sizeof(test_path), "%s%s", mount_points[i], path);
-        dir = opendir(test_path);
-        if (dir) {
-            break;
-        }
+    pktcap_update_timer = lv_timer_create(pktcap_update_timer_event, 100, NULL);
+    lv_timer_pause(pktcap_update_timer);
+}
+
+static void enter2_7(void)
+{
+    selected_frequency = g_config.subghz.raw.last_frequency;
+    lv_label_set_text_fmt(lv_obj_get_child(pktcap_freq_btn, 0), "%.2f MHz", selected_frequency);
+
+    entry2_7_anim(scr2_7_cont);
+    lv_timer_resume(pktcap_update_timer);
+    lv_group_set_wrap(lv_group_get_default(), true);
+}
+
+static void exit2_7(void)
+{
+    lv_group_set_wrap(lv_group_get_default(), false);
+}
+
+static void destroy2_7(void)
+{
+    if (pktcap_update_timer) {
+        lv_timer_del(pktcap_update_timer);
+        pktcap_update_timer = NULL;
     }
 
-    // Fallback: try direct path
-    if (!dir) {
-        dir = opendir(path);
-        if (dir) {
-        }
+    if (rf_packet_is_active()) {
+        rf_packet_stop();
     }
 
-    if (!dir) {
-        lv_obj_t *item = lv_list_add_btn(nfc_file_list, NULL, " Directory not found");
-        apply_text_color(item);
-        lv_led_off(nfc_status_led);
-        return;
+    if (scr2_7_cont) {
+        lv_obj_del(scr2_7_cont);
+        scr2_7_cont = NULL;
     }
+}
 
-    // Read directory contents
-    std::vector<String> folders;
-    std::vector<String> files;
+scr_lifecycle_t screen2_7 = {
+    .create = create2_7,
+    .entry = enter2_7,
+    .exit = exit2_7,
+    .destroy = destroy2_7,
+};
+#endif
+
+//************************************[ screen 2.8 ]************************************** SubGHz Frequency Hopper
+#if 1
+lv_obj_t *scr2_8_cont = NULL;
+lv_obj_t *hop_status_label;
+lv_obj_t *hop_saved_label;
+lv_obj_t *hop_chan_list;
+lv_obj_t *hop_btn_start;
+lv_timer_t *hop_update_timer = NULL;
+int hop_saved_count = 0;
+
+void entry2_8_anim(lv_obj_t *obj) { entry1_anim(obj); }
+void exit2_8_anim(int user_data, lv_obj_t *obj) { exit1_anim(user_data, obj); }
+
+static void hop_update_timer_event(lv_timer_t *t)
+{
+    // Save what the hopper recorded; it keeps listening meanwhile
+    RawRecording *rec;
+    while ((rec = rf_hop_take_capture()) != nullptr) {
+        String savedFile = rec->codes.empty() ? String() : subghz_save_capture(*rec);
+        if (savedFile.length() > 0) {
+            int lastSlash = savedFile.lastIndexOf('/');
+            hop_saved_count++;
+            lv_label_set_text_fmt(hop_saved_label, "Saved: %d  %s", hop_saved_count,
+                                  savedFile.substring(lastSlash + 1).c_str());
+        }
+        delete rec;
+    }
+
+    if (!rf_hop_is_active()) {
+        return;
+    }
+
+    lv_label_set_text_fmt(hop_status_label, "Status: %.2f MHz", rf_freq_hz_to_mhz(rf_hop_current_freq()));
+
+    RfHopChannelStats stats[RF_HOP_MAX_FREQS];
+    uint8_t n = rf_hop_get_stats(stats, RF_HOP_MAX_FREQS);
+    for (uint8_t i = 0; i < n && i < lv_obj_get_child_cnt(hop_chan_list); i++) {
+        lv_label_set_text_fmt(lv_obj_get_child(hop_chan_list, i), "%7.2f %4ddBm  trig %lu  %ums",
+                              rf_freq_hz_to_mhz(stats[i].freq_hz), stats[i].peak_rssi,
+                              (unsigned long)stats[i].triggers, (unsigned)stats[i].dwell_ms);
+    }
+}
+
+static void hop_btn_start_event(lv_event_t *e)
+{
+    if (e->code == LV_EVENT_CLICKED) {
+        lv_obj_t *label = lv_obj_get_child(hop_btn_start, 0);
+
+        if (rf_hop_is_active()) {
+            rf_hop_stop();
+            lv_label_set_text(label, "Start");
+            lv_label_set_text(hop_status_label, "Status: Stopped");
+            return;
+        }
+
+        // Channels and dwell come from subghz.hop, the trigger level from scan.threshold
+        RfHopConfig cfg;
+        rf_hop_default_config(&cfg);
+        if (cfg.count < RF_HOP_MIN_FREQS) {
+            prompt_info("  Need 3-8 frequencies\n  in subghz.hop", 2000);
+            return;
+        }
+        if (!rf_hop_start(&cfg)) {
+            lv_label_set_text(hop_status_label, "Status: Radio busy");
+            prompt_info("  Hopper failed\n  to start", 2000);
+            return;
+        }
+
+        lv_obj_clean(hop_chan_list);
+        for (uint8_t i = 0; i < cfg.count; i++) {
+            lv_obj_t *item = lv_list_add_text(hop_chan_list, "");
+            apply_label_style(item);
+            apply_bg_color(item);
+            lv_label_set_text_fmt(item, "%7.2f", rf_freq_hz_to_mhz(cfg.freq_hz[i]));
+        }
+        lv_label_set_text(label, "Stop");
+        lv_label_set_text(hop_status_label, "Status: Hopping");
+    }
+}
+
+static void scr2_8_back_btn_event_cb(lv_event_t *e)
+{
+    if (e->code == LV_EVENT_CLICKED) {
+        if (rf_hop_is_active()) {
+            rf_hop_stop();
+        }
+        exit2_8_anim(SCREEN2_ID, scr2_8_cont);
+    }
+}
+
+static void create2_8(lv_obj_t *parent)
+{
+    scr2_8_cont = create_screen_container(parent);
+
+    // Title
+    lv_obj_t *label = lv_label_create(scr2_8_cont);
+    apply_text_color(label);
+    lv_obj_set_style_text_font(label, FONT_BOLD_18, LV_PART_MAIN);
+    lv_label_set_text(label, "Hopper");
+    lv_obj_align(label, LV_ALIGN_TOP_MID, 0, 10);
+
+    // Status label
+    hop_status_label = lv_label_create(scr2_8_cont);
+    apply_label_style(hop_status_label);
+    lv_label_set_text(hop_status_label, "Status: Ready");
+    lv_obj_align(hop_status_label, LV_ALIGN_TOP_LEFT, 10, 46);
+
+    // Captures saved this visit and the latest file name
+    hop_saved_label = lv_label_create(scr2_8_cont);
+    apply_label_style(hop_saved_label);
+    lv_label_set_text(hop_saved_label, "Saved: 0");
+    lv_obj_align(hop_saved_label, LV_ALIGN_TOP_LEFT, 10, 72);
+
+    // One row per channel: frequency, peak RSSI, triggers, current dwell
+    hop_chan_list = lv_list_create(scr2_8_cont);
+    lv_obj_set_size(hop_chan_list, LV_HOR_RES - 20, 62);
+    lv_obj_align(hop_chan_list, LV_ALIGN_TOP_MID, 0, 94);
+    apply_bg_color(hop_chan_list);
+    lv_obj_set_style_pad_row(hop_chan_list, 0, LV_PART_MAIN);
+    apply_no_radius(hop_chan_list);
+    apply_no_border(hop_chan_list);
+    apply_no_shadow(hop_chan_list);
+
+    // Start/Stop button
+    hop_btn_start = lv_btn_create(scr2_8_cont);
+    lv_obj_set_size(hop_btn_start, 90, 32);
+    lv_obj_align(hop_btn_start, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
+    apply_theme_border(hop_btn_start);
+    apply_no_shadow(hop_btn_start);
+    apply_bg_color(hop_btn_start);
+    apply_btn_focus(hop_btn_start);
+    lv_obj_add_event_cb(hop_btn_start, hop_btn_start_event, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *btn_label = lv_label_create(hop_btn_start);
+    apply_label_style(btn_label);
+    lv_label_set_text(btn_label, "Start");
+    lv_obj_center(btn_label);
+    lv_group_add_obj(lv_group_get_default(), hop_btn_start);
+
+    // Back button
+    scr_back_btn_create(scr2_8_cont, scr2_8_back_btn_event_cb);
+
+    hop_update_timer = lv_timer_create(hop_update_timer_event, 100, NULL);
+    lv_timer_pause(hop_update_timer);
+}
+
+static void enter2_8(void)
+{
+    hop_saved_count = 0;
+    entry2_8_anim(scr2_8_cont);
+    lv_timer_resume(hop_update_timer);
+    lv_group_set_wrap(lv_group_get_default(), true);
+}
+
+static void exit2_8(void)
+{
+    lv_group_set_wrap(lv_group_get_default(), false);
+}
+
+static void destroy2_8(void)
+{
+    if (hop_update_timer) {
+        lv_timer_del(hop_update_timer);
+        hop_update_timer = NULL;
+    }
+
+    if (rf_hop_is_active()) {
+        rf_hop_stop();
+    }
+    // Captures finished after the last tick are not kept
+    RawRecording *rec;
+    while ((rec = rf_hop_take_capture()) != nullptr) {
+        delete rec;
+    }
+
+    if (scr2_8_cont) {
+        lv_obj_del(scr2_8_cont);
+        scr2_8_cont = NULL;
+    }
+}
+
+scr_lifecycle_t screen2_8 = {
+    .create = create2_8,
+    .entry = enter2_8,
+    .exit = exit2_8,
+    .destroy = destroy2_8,
+};
+#endif
+
+//************************************[ screen 3 ]****************************************** NFC File Browser
+#if 1
+lv_obj_t *scr3_cont;
+lv_obj_t *nfc_file_list;
+lv_obj_t *nfc_path_label;
+lv_obj_t *nfc_status_led;
+char nfc_current_path[256] = "/nfc";
+NFCTag nfc_current_tag;
+char nfc_selected_file[128] = "";
+
+void entry3_anim(lv_obj_t *obj) { entry1_anim(obj); }
+void exit3_anim(int user_data, lv_obj_t *obj) { exit1_anim(user_data, obj); }
+
+// Forward declarations
+void nfc_load_directory(const char *path);
+
+static void nfc_list_event_cb(lv_event_t *e)
+{
+    if (e->code == LV_EVENT_CLICKED) {
+        lv_obj_t *btn = lv_event_get_target(e);
+        const char *item_text = lv_list_get_btn_text(nfc_file_list, btn);
+
+        if (item_text) {
+
+            // Handle "(Read NFC Tag)" item
+            if (strcmp(item_text, "(Read NFC Tag)") == 0) {
+                scr_mgr_switch(SCREEN3_1_ID, false);
+                return;
+            }
+
+            // Handle parent directory
+            if (strstr(item_text, ".. (Parent)")) {
+                // Go up one directory
+                char *last_slash = strrchr(nfc_current_path, '/');
+                if (last_slash && last_slash != nfc_current_path) {
+                    *last_slash = '\0';
+                } else {
+                    strcpy(nfc_current_path, "/nfc");
+                }
+                nfc_load_directory(nfc_current_path);
+                return;
+            }
+
+            // Handle file/folder (strip leading space)
+            const char *display_name = item_text + 1;
+
+            // Check if it's a folder
+            char test_path[512];
+            snprintf(test_path, sizeof(test_path), "%s/%s", nfc_current_path, display_name);
+            DIR *test_dir = opendir(test_path);
+
+            if (test_dir) {
+                // It's a folder
+                closedir(test_dir);
+                strncpy(nfc_current_path, test_path, sizeof(nfc_current_path) - 1);
+                nfc_load_directory(nfc_current_path);
+            } else {
+                // It's a file - add .nfc extension and load
+                char file_name[128];
+                snprintf(file_name, sizeof(file_name), "%s.nfc", display_name);
+
+                char full_path[512];
+                snprintf(full_path, sizeof(full_path), "%s/%s", nfc_current_path, file_name);
+
+                // Parse NFC file
+                lv_led_on(nfc_status_led);
+                if (parseFlipperNFCFile(full_path, nfc_current_tag)) {
+                    lv_led_off(nfc_status_led);
+                    // Switch to tag detail screen
+                    scr_mgr_switch(SCREEN3_2_ID, false);
+                } else {
+                    lv_led_off(nfc_status_led);
+                    prompt_info("  Error parsing NFC file", 2000);
+                }
+            }
+        }
+    }
+}
+
+static void scr3_back_btn_event_cb(lv_event_t *e)
+{
+    if (e->code == LV_EVENT_CLICKED) {
+        exit3_anim(SCREEN0_ID, scr3_cont);
+    }
+}
+
+void nfc_load_directory(const char *path)
+{
+    lv_led_on(nfc_status_led);
+    lv_refr_now(NULL);
+
+    lv_obj_clean(nfc_file_list);
+    lv_label_set_text_fmt(nfc_path_label, "Path: %s", path);
+
+    // Add parent directory option if not at root
+    if (strcmp(path, "/nfc") != 0) {
+        lv_obj_t *parent_item = lv_list_add_btn(nfc_file_list, NULL, " .. (Parent)");
+        lv_obj_add_event_cb(parent_item, nfc_list_event_cb, LV_EVENT_CLICKED, NULL);
+    }
+
+    // Create directory if it doesn't exist
+    if (!SD.exists(path)) {
+        SD.mkdir(path);
+    }
+
+    // Try multiple mount points (SD card VFS mount location)
+    const char* mount_points[] = {"/sd", "/sdcard", "/mnt/sd"};
+    DIR *dir = NULL;
+
+    for (int i = 0; i < 3; i++) {
+        char test_path[512];
+        snprintf(test_path, sizeof(test_path), "%s%s", mount_points[i], path);
+        dir = opendir(test_path);
+        if (dir) {
+            break;
+        }
+    }
+
+    // Fallback: try direct path
+    if (!dir) {
+        dir = opendir(path);
+        if (dir) {
+        }
+    }
+
+    if (!dir) {
+        lv_obj_t *item = lv_list_add_btn(nfc_file_list, NULL, " Directory not found");
+        apply_text_color(item);
+        lv_led_off(nfc_status_led);
+        return;
+    }
+
+    // Read sub-folders; tags come from the directory index below
+    std::vector<String> folders;
 
     struct dirent *entry;
     while ((entry = readdir(dir)) != NULL) {
         if (entry->d_name[0] == '.') continue;  // Skip hidden files
 
-        // Check if it's a directory
-        char full_path[512];
-        snprintf(full_path, sizeof(full_path), "%s/%s", path, entry->d_name);
-
-        DIR *test_dir = opendir(full_path);
-        if (test_dir) {
-            closedir(test_dir);
+        if (entry->d_type == DT_DIR) {
             folders.push_back(String(entry->d_name));
-        } else if (strstr(entry->d_name, ".nfc")) {
-            // Remove .nfc extension for display
-            String fname = String(entry->d_name);
-            fname.replace(".nfc", "");
-            files.push_back(fname);
         }
     }
     closedir(dir);
 
+    // Header-only metadata, served from the cached index when files are unchanged
+    std::vector<NFCTagInfo> files;
+    loadNFCDirectoryInfo(path, files);
+
     // Add folders first
     for (const auto& folder : folders) {
         char item_text[128];
@@ -7013,12 +7310,19 @@ void nfc_load_directory(const char *path)
         lv_obj_add_event_cb(item, nfc_list_event_cb, LV_EVENT_CLICKED, NULL);
     }
 
-    // Add files
+    // Add files, with the tag type shown on the right
     for (const auto& file : files) {
         char item_text[128];
-        snprintf(item_text, sizeof(item_text), " %s", file.c_str());
+        snprintf(item_text, sizeof(item_text), " %s", file.name.c_str());
         lv_obj_t *item = lv_list_add_btn(nfc_file_list, NULL, item_text);
         lv_obj_add_event_cb(item, nfc_list_event_cb, LV_EVENT_CLICKED, NULL);
+
+        if (file.device_type[0] != '\0') {
+            lv_obj_t *type_label = lv_label_create(item);
+            apply_text_color(type_label);
+            lv_obj_set_style_text_font(type_label, FONT_LIGHT_14, LV_PART_MAIN);
+            lv_label_set_text(type_label, file.device_type);
+        }
     }
 
     // Add "(Read NFC Tag)" option at the end
@@ -7029,8 +7333,7 @@ void nfc_load_directory(const char *path)
     for(int i = 0; i < lv_obj_get_child_cnt(nfc_file_list); i++) {
         lv_obj_t *item = lv_obj_get_child(nfc_file_list, i);
         apply_bg_color(item);
-        apply_text_color(item);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
+        apply_label_style(item);
         lv_obj_set_style_bg_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
         lv_group_add_obj(lv_group_get_default(), item);
     }
@@ -7044,8 +7347,7 @@ static void create3(lv_obj_t *parent)
 
     // Title label
     lv_obj_t *label = lv_label_create(scr3_cont);
-    apply_text_color(label);
-    lv_obj_set_style_text_font(label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(label);
     lv_label_set_text(label, "NFC Tags (beta)");
     lv_obj_align(label, LV_ALIGN_TOP_MID, 0, 10);
 
@@ -7058,8 +7360,7 @@ static void create3(lv_obj_t *parent)
 
     // Path label
     nfc_path_label = lv_label_create(scr3_cont);
-    apply_text_color(nfc_path_label);
-    lv_obj_set_style_text_font(nfc_path_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(nfc_path_label);
     lv_label_set_text(nfc_path_label, "Path: /nfc");
     lv_obj_set_width(nfc_path_label, 280);
     lv_label_set_long_mode(nfc_path_label, LV_LABEL_LONG_DOT);
@@ -7086,6 +7387,9 @@ static void entry3(void)
 {
     lv_group_set_wrap(lv_group_get_default(), true);
 
+    // PN532 is brought up on first visit rather than at boot
+    nfc_ensure_init();
+
     // Reload directory
     nfc_load_directory(nfc_current_path);
 }
@@ -7111,6 +7415,79 @@ scr_lifecycle_t screen3 = {
 };
 #endif
 
+// Background NFC emulation progress, shared by the Read and Detail screens
+static lv_timer_t *nfc_emu_timer = NULL;
+static lv_obj_t *nfc_emu_status_label = NULL;
+static bool nfc_emu_full = false;
+
+static void nfc_emu_timer_event(lv_timer_t *t)
+{
+    NFCEmuEvent evt;
+    while (nfcEmulationPoll(evt)) {
+        switch (evt.type) {
+            case NFC_EMU_EVT_READER:
+                lv_label_set_text(nfc_emu_status_label, "Status: Reader found");
+                break;
+            case NFC_EMU_EVT_COMMAND:
+                lv_label_set_text_fmt(nfc_emu_status_label, "Status: %lu cmds", (unsigned long)evt.commands);
+                break;
+            case NFC_EMU_EVT_DONE:
+                Serial.printf("[NFC] Emulation done: %lu cmds, avg %lu us, max %lu us\n",
+                              (unsigned long)evt.commands, (unsigned long)evt.turnaround_us,
+                              (unsigned long)evt.max_turnaround_us);
+                if (evt.success) {
+                    lv_label_set_text(nfc_emu_status_label, nfc_emu_full ? "Status: Emulation done" : "Status: UID emulated");
+                    prompt_info(nfc_emu_full ? "  Full emulation completed" : "  UID emulation completed", 2000);
+                } else {
+                    lv_label_set_text(nfc_emu_status_label, "Status: No reader");
+                    prompt_info("  No reader detected", 2000);
+                }
+                lv_timer_del(nfc_emu_timer);
+                nfc_emu_timer = NULL;
+                nfc_emu_status_label = NULL;
+                return;
+            default:
+                break;
+        }
+    }
+}
+
+// Start emulating a tag, or stop the running emulation if pressed again
+static void nfc_emu_ui_start(const NFCTag &tag, lv_obj_t *status_label)
+{
+    if (nfcEmulationIsRunning()) {
+        // Returns once the task has let go of the PN532; DONE updates the label
+        nfcEmulationStop();
+        return;
+    }
+
+    // Auto-detect emulation mode based on NDEF data
+    NFCTagType tag_type = tag.getTagType();
+    nfc_emu_full = (tag_type == NFC_TAG_NTAG_ULTRALIGHT && tag.pages_read > 4);
+
+    if (!nfcEmulationStart(tag, nfc_emu_full, 15000)) {  // 15 second timeout
+        prompt_info("  Emulation failed to start", 2000);
+        return;
+    }
+
+    lv_label_set_text(status_label, nfc_emu_full ? "Status: Emulating full..." : "Status: Emulating UID...");
+    nfc_emu_status_label = status_label;
+    if (!nfc_emu_timer) {
+        nfc_emu_timer = lv_timer_create(nfc_emu_timer_event, 50, NULL);
+    }
+}
+
+// Stop emulation and detach from the screen that is going away
+static void nfc_emu_ui_cancel(void)
+{
+    nfcEmulationStop();
+    if (nfc_emu_timer) {
+        lv_timer_del(nfc_emu_timer);
+        nfc_emu_timer = NULL;
+    }
+    nfc_emu_status_label = NULL;
+}
+
 //************************************[ screen 3.1 ]****************************************** Read NFC Tag
 #if 1
 lv_obj_t *scr3_1_cont;
@@ -7193,6 +7570,12 @@ static void nfc_btn_read_event(lv_event_t *e)
 {
     if (e->code != LV_EVENT_CLICKED) return;
 
+    // The PN532 is busy answering a reader
+    if (nfcEmulationIsRunning()) {
+        prompt_info("  Stop emulation first", 2000);
+        return;
+    }
+
     // Start reading NFC tag
     lv_label_set_text(nfc_read_status_label, "Status: Reading...");
     lv_refr_now(NULL);
@@ -7240,44 +7623,7 @@ static void nfc_btn_emulate_event(lv_event_t *e)
         return;
     }
 
-    // Auto-detect emulation mode based on NDEF data
-    NFCTagType tag_type = nfc_current_tag.getTagType();
-    bool has_ndef_data = (tag_type == NFC_TAG_NTAG_ULTRALIGHT && nfc_current_tag.pages_read > 4);
-
-    if (has_ndef_data) {
-        // Has NDEF data - use full emulation
-        lv_label_set_text(nfc_read_status_label, "Status: Emulating full...");
-        lv_refr_now(NULL);
-
-        bool success = emulateNFCTagFull(nfc_current_tag, 15000);  // 15 second timeout
-
-        if (success) {
-            lv_label_set_text(nfc_read_status_label, "Status: Emulation done");
-            prompt_info("  Full emulation completed", 2000);
-        } else {
-            lv_label_set_text(nfc_read_status_label, "Status: No reader");
-            prompt_info("  No reader detected", 2000);
-        }
-    } else {
-        // No NDEF data - use UID only emulation
-        lv_label_set_text(nfc_read_status_label, "Status: Emulating UID...");
-        lv_refr_now(NULL);
-
-        bool success = emulateNFCTagUID(nfc_current_tag, 15000);  // 15 second timeout
-
-        if (success) {
-            lv_label_set_text(nfc_read_status_label, "Status: UID emulated");
-            prompt_info("  UID emulation completed", 2000);
-        } else {
-            lv_label_set_text(nfc_read_status_label, "Status: No reader");
-            prompt_info("  No reader detected", 2000);
-        }
-    }
-
-    // Re-enable input processing after emulation
-    lv_group_t *g = lv_group_get_default();
-    lv_group_set_editing(g, false);
-    lv_refr_now(NULL);
+    nfc_emu_ui_start(nfc_current_tag, nfc_read_status_label);
 }
 
 static void nfc_btn_name_event(lv_event_t *e)
@@ -7379,39 +7725,34 @@ static void create3_1(lv_obj_t *parent)
 
     // Status label
     nfc_read_status_label = lv_label_create(scr3_1_cont);
-    apply_text_color(nfc_read_status_label);
-    lv_obj_set_style_text_font(nfc_read_status_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(nfc_read_status_label);
     lv_label_set_text(nfc_read_status_label, "Status: Ready");
     lv_obj_align(nfc_read_status_label, LV_ALIGN_TOP_LEFT, 10, 46);
 
     // Protocol/Type label
     nfc_read_protocol_label = lv_label_create(scr3_1_cont);
-    apply_text_color(nfc_read_protocol_label);
-    lv_obj_set_style_text_font(nfc_read_protocol_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(nfc_read_protocol_label);
     lv_label_set_text(nfc_read_protocol_label, "Type: ---");
     lv_obj_align(nfc_read_protocol_label, LV_ALIGN_TOP_LEFT, 10, 70);
 
     // Data/UID label
     nfc_read_data_label = lv_label_create(scr3_1_cont);
     lv_obj_set_width(nfc_read_data_label, DISPALY_WIDTH - 20);
-    apply_text_color(nfc_read_data_label);
-    lv_obj_set_style_text_font(nfc_read_data_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(nfc_read_data_label);
     lv_label_set_text(nfc_read_data_label, "UID: ---");
     lv_obj_align(nfc_read_data_label, LV_ALIGN_TOP_LEFT, 10, 94);
 
     // Tag Name label
     nfc_read_name_label = lv_label_create(scr3_1_cont);
     lv_obj_set_width(nfc_read_name_label, DISPALY_WIDTH - 20);
-    apply_text_color(nfc_read_name_label);
-    lv_obj_set_style_text_font(nfc_read_name_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(nfc_read_name_label);
     lv_label_set_text(nfc_read_name_label, "Name: ---");
     lv_obj_align(nfc_read_name_label, LV_ALIGN_TOP_LEFT, 10, 118);
 
     // Pages label
     nfc_read_pages_label = lv_label_create(scr3_1_cont);
     lv_obj_set_width(nfc_read_pages_label, DISPALY_WIDTH - 20);
-    apply_text_color(nfc_read_pages_label);
-    lv_obj_set_style_text_font(nfc_read_pages_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(nfc_read_pages_label);
     lv_label_set_text(nfc_read_pages_label, "Pages: ---");
     lv_obj_align(nfc_read_pages_label, LV_ALIGN_TOP_LEFT, 10, 142);
 
@@ -7419,18 +7760,13 @@ static void create3_1(lv_obj_t *parent)
     nfc_btn_read = lv_btn_create(scr3_1_cont);
     lv_obj_set_size(nfc_btn_read, 100, 30);
     lv_obj_align(nfc_btn_read, LV_ALIGN_TOP_RIGHT, -10, 30);
-    lv_obj_set_style_border_color(nfc_btn_read, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(nfc_btn_read, 1, LV_PART_MAIN);
+    apply_theme_border(nfc_btn_read);
     apply_no_shadow(nfc_btn_read);
     apply_bg_color(nfc_btn_read);
-    lv_obj_remove_style(nfc_btn_read, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(nfc_btn_read, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(nfc_btn_read, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(nfc_btn_read, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(nfc_btn_read);
     lv_obj_add_event_cb(nfc_btn_read, nfc_btn_read_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *btn_label = lv_label_create(nfc_btn_read);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Read");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), nfc_btn_read);
@@ -7439,18 +7775,13 @@ static void create3_1(lv_obj_t *parent)
     nfc_btn_emulate = lv_btn_create(scr3_1_cont);
     lv_obj_set_size(nfc_btn_emulate, 100, 30);
     lv_obj_align(nfc_btn_emulate, LV_ALIGN_TOP_RIGHT, -10, 65);
-    lv_obj_set_style_border_color(nfc_btn_emulate, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(nfc_btn_emulate, 1, LV_PART_MAIN);
+    apply_theme_border(nfc_btn_emulate);
     apply_no_shadow(nfc_btn_emulate);
     apply_bg_color(nfc_btn_emulate);
-    lv_obj_remove_style(nfc_btn_emulate, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(nfc_btn_emulate, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(nfc_btn_emulate, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(nfc_btn_emulate, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(nfc_btn_emulate);
     lv_obj_add_event_cb(nfc_btn_emulate, nfc_btn_emulate_event, LV_EVENT_CLICKED, NULL);
     btn_label = lv_label_create(nfc_btn_emulate);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Emulate");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), nfc_btn_emulate);
@@ -7459,18 +7790,13 @@ static void create3_1(lv_obj_t *parent)
     nfc_btn_name = lv_btn_create(scr3_1_cont);
     lv_obj_set_size(nfc_btn_name, 100, 30);
     lv_obj_align(nfc_btn_name, LV_ALIGN_TOP_RIGHT, -10, 100);
-    lv_obj_set_style_border_color(nfc_btn_name, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(nfc_btn_name, 1, LV_PART_MAIN);
+    apply_theme_border(nfc_btn_name);
     apply_no_shadow(nfc_btn_name);
     apply_bg_color(nfc_btn_name);
-    lv_obj_remove_style(nfc_btn_name, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(nfc_btn_name, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(nfc_btn_name, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(nfc_btn_name, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(nfc_btn_name);
     lv_obj_add_event_cb(nfc_btn_name, nfc_btn_name_event, LV_EVENT_CLICKED, NULL);
     btn_label = lv_label_create(nfc_btn_name);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Name");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), nfc_btn_name);
@@ -7479,18 +7805,13 @@ static void create3_1(lv_obj_t *parent)
     nfc_btn_save = lv_btn_create(scr3_1_cont);
     lv_obj_set_size(nfc_btn_save, 100, 30);
     lv_obj_align(nfc_btn_save, LV_ALIGN_TOP_RIGHT, -10, 135);
-    lv_obj_set_style_border_color(nfc_btn_save, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(nfc_btn_save, 1, LV_PART_MAIN);
+    apply_theme_border(nfc_btn_save);
     apply_no_shadow(nfc_btn_save);
     apply_bg_color(nfc_btn_save);
-    lv_obj_remove_style(nfc_btn_save, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(nfc_btn_save, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(nfc_btn_save, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(nfc_btn_save, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(nfc_btn_save);
     lv_obj_add_event_cb(nfc_btn_save, nfc_btn_save_event, LV_EVENT_CLICKED, NULL);
     btn_label = lv_label_create(nfc_btn_save);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Save");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), nfc_btn_save);
@@ -7516,6 +7837,7 @@ static void entry3_1(void)
 
 static void exit3_1(void)
 {
+    nfc_emu_ui_cancel();
     lv_group_set_wrap(lv_group_get_default(), false);
 }
 
@@ -7628,44 +7950,7 @@ static void nfc_btn_emulate_detail_event(lv_event_t *e)
 {
     if (e->code != LV_EVENT_CLICKED) return;
 
-    // Auto-detect emulation mode based on NDEF data
-    NFCTagType tag_type = nfc_current_tag.getTagType();
-    bool has_ndef_data = (tag_type == NFC_TAG_NTAG_ULTRALIGHT && nfc_current_tag.pages_read > 4);
-
-    if (has_ndef_data) {
-        // Has NDEF data - use full emulation
-        lv_label_set_text(nfc_detail_status_label, "Status: Emulating full...");
-        lv_refr_now(NULL);
-
-        bool success = emulateNFCTagFull(nfc_current_tag, 15000);  // 15 second timeout
-
-        if (success) {
-            lv_label_set_text(nfc_detail_status_label, "Status: Emulation done");
-            prompt_info("  Full emulation completed", 2000);
-        } else {
-            lv_label_set_text(nfc_detail_status_label, "Status: No reader");
-            prompt_info("  No reader detected", 2000);
-        }
-    } else {
-        // No NDEF data - use UID only emulation
-        lv_label_set_text(nfc_detail_status_label, "Status: Emulating UID...");
-        lv_refr_now(NULL);
-
-        bool success = emulateNFCTagUID(nfc_current_tag, 15000);  // 15 second timeout
-
-        if (success) {
-            lv_label_set_text(nfc_detail_status_label, "Status: UID emulated");
-            prompt_info("  UID emulation completed", 2000);
-        } else {
-            lv_label_set_text(nfc_detail_status_label, "Status: No reader");
-            prompt_info("  No reader detected", 2000);
-        }
-    }
-
-    // Re-enable input processing after emulation
-    lv_group_t *g = lv_group_get_default();
-    lv_group_set_editing(g, false);
-    lv_refr_now(NULL);
+    nfc_emu_ui_start(nfc_current_tag, nfc_detail_status_label);
 }
 
 static void nfc_btn_detail_event(lv_event_t *e)
@@ -7777,31 +8062,27 @@ static void create3_2(lv_obj_t *parent)
 
     // Status label
     nfc_detail_status_label = lv_label_create(scr3_2_cont);
-    apply_text_color(nfc_detail_status_label);
-    lv_obj_set_style_text_font(nfc_detail_status_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(nfc_detail_status_label);
     lv_label_set_text(nfc_detail_status_label, "Status: Ready");
     lv_obj_align(nfc_detail_status_label, LV_ALIGN_TOP_LEFT, 10, 46);
 
     // Type label
     nfc_detail_type_label = lv_label_create(scr3_2_cont);
-    apply_text_color(nfc_detail_type_label);
-    lv_obj_set_style_text_font(nfc_detail_type_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(nfc_detail_type_label);
     lv_label_set_text(nfc_detail_type_label, "Type: ---");
     lv_obj_align(nfc_detail_type_label, LV_ALIGN_TOP_LEFT, 10, 70);
 
     // UID label
     nfc_detail_uid_label = lv_label_create(scr3_2_cont);
     lv_obj_set_width(nfc_detail_uid_label, DISPALY_WIDTH - 20);
-    apply_text_color(nfc_detail_uid_label);
-    lv_obj_set_style_text_font(nfc_detail_uid_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(nfc_detail_uid_label);
     lv_label_set_text(nfc_detail_uid_label, "UID: ---");
     lv_obj_align(nfc_detail_uid_label, LV_ALIGN_TOP_LEFT, 10, 94);
 
     // Pages label
     nfc_detail_pages_label = lv_label_create(scr3_2_cont);
     lv_obj_set_width(nfc_detail_pages_label, DISPALY_WIDTH - 20);
-    apply_text_color(nfc_detail_pages_label);
-    lv_obj_set_style_text_font(nfc_detail_pages_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(nfc_detail_pages_label);
     lv_label_set_text(nfc_detail_pages_label, "Pages: ---");
     lv_obj_align(nfc_detail_pages_label, LV_ALIGN_TOP_LEFT, 10, 118);
 
@@ -7809,18 +8090,13 @@ static void create3_2(lv_obj_t *parent)
     nfc_btn_emulate_detail = lv_btn_create(scr3_2_cont);
     lv_obj_set_size(nfc_btn_emulate_detail, 100, 30);
     lv_obj_align(nfc_btn_emulate_detail, LV_ALIGN_TOP_RIGHT, -10, 30);
-    lv_obj_set_style_border_color(nfc_btn_emulate_detail, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(nfc_btn_emulate_detail, 1, LV_PART_MAIN);
+    apply_theme_border(nfc_btn_emulate_detail);
     apply_no_shadow(nfc_btn_emulate_detail);
     apply_bg_color(nfc_btn_emulate_detail);
-    lv_obj_remove_style(nfc_btn_emulate_detail, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(nfc_btn_emulate_detail, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(nfc_btn_emulate_detail, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(nfc_btn_emulate_detail, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(nfc_btn_emulate_detail);
     lv_obj_add_event_cb(nfc_btn_emulate_detail, nfc_btn_emulate_detail_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *btn_label = lv_label_create(nfc_btn_emulate_detail);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Emulate");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), nfc_btn_emulate_detail);
@@ -7829,18 +8105,13 @@ static void create3_2(lv_obj_t *parent)
     nfc_btn_detail = lv_btn_create(scr3_2_cont);
     lv_obj_set_size(nfc_btn_detail, 100, 30);
     lv_obj_align(nfc_btn_detail, LV_ALIGN_TOP_RIGHT, -10, 65);
-    lv_obj_set_style_border_color(nfc_btn_detail, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(nfc_btn_detail, 1, LV_PART_MAIN);
+    apply_theme_border(nfc_btn_detail);
     apply_no_shadow(nfc_btn_detail);
     apply_bg_color(nfc_btn_detail);
-    lv_obj_remove_style(nfc_btn_detail, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(nfc_btn_detail, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(nfc_btn_detail, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(nfc_btn_detail, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(nfc_btn_detail);
     lv_obj_add_event_cb(nfc_btn_detail, nfc_btn_detail_event, LV_EVENT_CLICKED, NULL);
     btn_label = lv_label_create(nfc_btn_detail);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Detail");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), nfc_btn_detail);
@@ -7849,18 +8120,13 @@ static void create3_2(lv_obj_t *parent)
     nfc_btn_rename = lv_btn_create(scr3_2_cont);
     lv_obj_set_size(nfc_btn_rename, 100, 30);
     lv_obj_align(nfc_btn_rename, LV_ALIGN_TOP_RIGHT, -10, 100);
-    lv_obj_set_style_border_color(nfc_btn_rename, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(nfc_btn_rename, 1, LV_PART_MAIN);
+    apply_theme_border(nfc_btn_rename);
     apply_no_shadow(nfc_btn_rename);
     apply_bg_color(nfc_btn_rename);
-    lv_obj_remove_style(nfc_btn_rename, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(nfc_btn_rename, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(nfc_btn_rename, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(nfc_btn_rename, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(nfc_btn_rename);
     lv_obj_add_event_cb(nfc_btn_rename, nfc_btn_rename_detail_event, LV_EVENT_CLICKED, NULL);
     btn_label = lv_label_create(nfc_btn_rename);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Rename");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), nfc_btn_rename);
@@ -7869,18 +8135,13 @@ static void create3_2(lv_obj_t *parent)
     nfc_btn_delete = lv_btn_create(scr3_2_cont);
     lv_obj_set_size(nfc_btn_delete, 100, 30);
     lv_obj_align(nfc_btn_delete, LV_ALIGN_TOP_RIGHT, -10, 135);
-    lv_obj_set_style_border_color(nfc_btn_delete, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(nfc_btn_delete, 1, LV_PART_MAIN);
+    apply_theme_border(nfc_btn_delete);
     apply_no_shadow(nfc_btn_delete);
     apply_bg_color(nfc_btn_delete);
-    lv_obj_remove_style(nfc_btn_delete, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(nfc_btn_delete, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(nfc_btn_delete, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(nfc_btn_delete, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(nfc_btn_delete);
     lv_obj_add_event_cb(nfc_btn_delete, nfc_btn_delete_event, LV_EVENT_CLICKED, NULL);
     btn_label = lv_label_create(nfc_btn_delete);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Delete");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), nfc_btn_delete);
@@ -7925,6 +8186,7 @@ static void entry3_2(void)
 
 static void exit3_2(void)
 {
+    nfc_emu_ui_cancel();
     lv_group_set_wrap(lv_group_get_default(), false);
 }
 
@@ -8010,8 +8272,7 @@ static void entry3_2_1(void)
         // No NDEF records found - add simple text item
         lv_obj_t *item = lv_list_add_btn(nfc_ndef_list, NULL, "No NDEF records found");
         apply_bg_color(item);
-        apply_text_color(item);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
+        apply_label_style(item);
         lv_group_add_obj(g, item);
     } else {
         // Display each NDEF record as a list item
@@ -8027,8 +8288,7 @@ static void entry3_2_1(void)
             // Create list item
             lv_obj_t *item = lv_list_add_btn(nfc_ndef_list, NULL, item_text.c_str());
             apply_bg_color(item);
-            apply_text_color(item);
-            lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
+            apply_label_style(item);
             lv_obj_set_style_bg_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
             lv_obj_set_height(item, LV_SIZE_CONTENT);
 
@@ -8155,6 +8415,7 @@ static scr_lifecycle_t screen4_1 = {
 lv_obj_t *scr4_cont;
 lv_obj_t *setting_list;
 lv_obj_t *theme_label;
+static lv_obj_t *perf_hud_mode_label;
 int rotation_setting = 0;
 static lv_obj_t *shutdown_up;
 static lv_obj_t *shutdown_dp;
@@ -8209,13 +8470,13 @@ void setting_scr_event(lv_event_t *e)
 
             // Save to config
             g_config.display.rotation = display_rotation;
-            config_save();
+            config_mark_dirty(CONFIG_DIRTY_DISPLAY);
 
             // lv_obj_invalidate(scr4_cont);
             break;
         case 1: { // "Deep Sleep"
-            // Save configuration before sleeping
-            config_save();
+            // Write any pending configuration before sleeping
+            config_flush();
 
             // Clear LVGL screen to prevent artifacts on wake
             lv_obj_t *scr = lv_scr_act();
@@ -8249,11 +8510,11 @@ void setting_scr_event(lv_event_t *e)
 
             // Save to config
             g_config.display.theme = setting_theme;
-            config_save();
+            config_mark_dirty(CONFIG_DIRTY_DISPLAY);
             break;
         case 3: // "Shutdown"
-                // Save configuration before shutdown
-                config_save();
+                // Write any pending configuration before shutdown
+                config_flush();
 
                 lv_obj_clear_flag(shutdown_up, LV_OBJ_FLAG_HIDDEN);
                 lv_obj_clear_flag(shutdown_dp, LV_OBJ_FLAG_HIDDEN);
@@ -8287,6 +8548,9 @@ void setting_scr_event(lv_event_t *e)
 		case 6: {// Config Reload
 				 config_load();
 			} break;
+        case 7: // "Perf HUD"
+            lv_label_set_text(perf_hud_mode_label, perf_hud_mode_name(perf_hud_cycle()));
+            break;
         default:
             break;
         }
@@ -8357,6 +8621,7 @@ void create4(lv_obj_t *parent){
     lv_obj_t *setting5 = lv_list_add_btn(setting_list, NULL, "- Create Config Example");
     lv_obj_t *setting6 = lv_list_add_btn(setting_list, NULL, "- About System");
     lv_obj_t *setting7 = lv_list_add_btn(setting_list, NULL, "- Config Reload");
+    lv_obj_t *setting8 = lv_list_add_btn(setting_list, NULL, "- Perf HUD");
 
     for(int i = 0; i < lv_obj_get_child_cnt(setting_list); i++) {
         lv_obj_t *item = lv_obj_get_child(setting_list, i);
@@ -8390,6 +8655,12 @@ void create4(lv_obj_t *parent){
             break;
     }
 
+    // setting8 - Perf HUD mode label
+    perf_hud_mode_label = lv_label_create(setting8);
+    lv_obj_set_style_text_font(perf_hud_mode_label, FONT_BOLD_14, LV_PART_MAIN);
+    lv_obj_align(perf_hud_mode_label, LV_ALIGN_RIGHT_MID, 0, 0);
+    lv_label_set_text(perf_hud_mode_label, perf_hud_mode_name(perf_hud_get_mode()));
+
     // setting5 - SD card status label
     lv_obj_t *sd_status_label = lv_label_create(setting5);
     lv_obj_set_style_text_font(sd_status_label, FONT_BOLD_14, LV_PART_MAIN);
@@ -8431,8 +8702,19 @@ lv_timer_t *batt_timer;
 
 lv_obj_t *batt_label;
 lv_obj_t *batt_trans;
-
-bool show_batt_type = true;
+lv_obj_t *batt_chart = NULL;
+lv_chart_series_t *batt_soc_ser = NULL;
+lv_chart_series_t *batt_cur_ser = NULL;
+uint32_t batt_shown_version = 0;
+
+// Pages cycled by the refresh button
+enum {
+    BATT_PAGE_PPM = 0,      // BQ25896 charger
+    BATT_PAGE_GAUGE,        // BQ27220 fuel gauge
+    BATT_PAGE_HISTORY,      // SOC / current graph from the power history ring
+    BATT_PAGE_MAX
+};
+int batt_page = BATT_PAGE_PPM;
 
 static void battery_set_line(lv_obj_t *label, const char *str1, const char *str2)
 {
@@ -8441,63 +8723,107 @@ static void battery_set_line(lv_obj_t *label, const char *str1, const char *str2
     lv_label_set_text_fmt(label, "%-*s%-*s", w1, str1, w2, str2);
 }
 
+static void batt_show_page(int page)
+{
+    if(page == BATT_PAGE_HISTORY) {
+        lv_obj_add_flag(batt_cont, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(batt_chart, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_clear_flag(batt_cont, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_flag(batt_chart, LV_OBJ_FLAG_HIDDEN);
+    }
+    batt_shown_version = 0;     // Force a redraw on the next tick
+}
+
 void batt_trans_event_cb(lv_event_t *e)
 {
     if(e->code == LV_EVENT_CLICKED) {
-        show_batt_type = !show_batt_type;
+        batt_page = (batt_page + 1) % BATT_PAGE_MAX;
+        batt_show_page(batt_page);
     }
 }
 
+static void batt_update_history(void)
+{
+    static PowerSample hist[POWER_HISTORY_LEN];
+    int n = power_history_get(hist, POWER_HISTORY_LEN);
+
+    lv_label_set_text_fmt(batt_label, "History %dmin", n * (POWER_HISTORY_MS / 1000) / 60);
+
+    // Right-align so the newest sample is at the right edge
+    int pad = POWER_HISTORY_LEN - n;
+    for(int i = 0; i < POWER_HISTORY_LEN; i++) {
+        if(i < pad) {
+            batt_soc_ser->y_points[i] = LV_CHART_POINT_NONE;
+            batt_cur_ser->y_points[i] = LV_CHART_POINT_NONE;
+        } else {
+            batt_soc_ser->y_points[i] = hist[i - pad].soc;
+            batt_cur_ser->y_points[i] = hist[i - pad].current_ma;
+        }
+    }
+    lv_chart_refresh(batt_chart);
+}
+
 void batt_timer_event(lv_timer_t *t)
 {
     char buf[16];
-    if(show_batt_type) {
+    PowerSnapshot pwr;
+
+    // Nothing new from power_task since the last redraw
+    if(!power_get(&pwr) || pwr.version == batt_shown_version) {
+        return;
+    }
+    batt_shown_version = pwr.version;
+
+    if(batt_page == BATT_PAGE_PPM) {
         lv_label_set_text(batt_label, "BQ25896");
 
-        lv_label_set_text_fmt(batt_line[0], "VBUS --- %3.2f | VSYS --- %3.2f", (PPM.getVbusVoltage() *1.0 / 1000.0), (PPM.getSystemVoltage() * 1.0 / 1000.0));
-        lv_label_set_text_fmt(batt_line[1], "VBAT --- %3.2f | ICHG --- %3.1f", (PPM.getBattVoltage() *1.0 / 1000.0), (PPM.getChargeCurrent() * 1.0));
+        lv_label_set_text_fmt(batt_line[0], "VBUS --- %3.2f | VSYS --- %3.2f", (pwr.vbus_mv *1.0 / 1000.0), (pwr.vsys_mv * 1.0 / 1000.0));
+        lv_label_set_text_fmt(batt_line[1], "VBAT --- %3.2f | ICHG --- %3.1f", (pwr.vbat_mv *1.0 / 1000.0), (pwr.ichg_ma * 1.0));
 
-        lv_snprintf(buf, 16, "%.2f", (PPM.getChargeTargetVoltage() * 1.0 / 1000.0));
+        lv_snprintf(buf, 16, "%.2f", (pwr.chg_target_mv * 1.0 / 1000.0));
         battery_set_line(batt_line[2], "VBAT Target:", buf);
 
-        lv_snprintf(buf, 16, "%s", (PPM.isVbusIn() == true ? "Charging" : "Not charged"));
+        lv_snprintf(buf, 16, "%s", (pwr.vbus_in == true ? "Charging" : "Not charged"));
         battery_set_line(batt_line[3], "Charging Statu:", buf);
 
-        lv_snprintf(buf, 16, "%.2fmA", PPM.getPrechargeCurr());
+        lv_snprintf(buf, 16, "%dmA", pwr.precharge_ma);
         battery_set_line(batt_line[4], "Precharge Curr:", buf);
 
-        lv_snprintf(buf, 16, "%s", PPM.getChargeStatusString());
+        lv_snprintf(buf, 16, "%s", power_chg_status_str(pwr.chg_status));
         battery_set_line(batt_line[5], "CHG Status:", buf);
 
-        lv_snprintf(buf, 16, "%s", PPM.getBusStatusString());
+        lv_snprintf(buf, 16, "%s", power_bus_status_str(pwr.bus_status));
         battery_set_line(batt_line[6], "VBUS Status:", buf);
-    } else {
+    } else if(batt_page == BATT_PAGE_GAUGE) {
         lv_label_set_text(batt_label, "BQ27220");
 
-        lv_snprintf(buf, 16, "%s", (bq27220.getIsCharging() == true ? "Connected" : "Disonnected"));
+        lv_snprintf(buf, 16, "%s", (pwr.charging == true ? "Connected" : "Disonnected"));
         battery_set_line(batt_line[0], "VBUS Input:", buf);
 
-        if(bq27220.getIsCharging() == true ){
-            lv_snprintf(buf, 16, "%s", (bq27220.getCharingFinish()? "Finsish":"Charging"));
+        if(pwr.charging == true ){
+            lv_snprintf(buf, 16, "%s", (pwr.charge_done? "Finsish":"Charging"));
         } else {
             lv_snprintf(buf, 16, "%s", "Discharge");
         }
         battery_set_line(batt_line[1], "Charing Status:", buf);
 
-        lv_snprintf(buf, 16, "%dmV", bq27220.getVoltage());
+        lv_snprintf(buf, 16, "%dmV", pwr.voltage_mv);
         battery_set_line(batt_line[2], "Voltage:", buf);
 
-        lv_snprintf(buf, 16, "%dmA", bq27220.getCurrent());
+        lv_snprintf(buf, 16, "%dmA", pwr.current_ma);
         battery_set_line(batt_line[3], "Current:", buf);
 
-        lv_snprintf(buf, 16, "%.2f", (float)(bq27220.getTemperature() / 10.0 - 273.0));
+        lv_snprintf(buf, 16, "%.2f", (float)(pwr.temperature_dk / 10.0 - 273.0));
         battery_set_line(batt_line[4], "Temperature:", buf);
 
-        lv_snprintf(buf, 16, "%d/%d", bq27220.getRemainingCapacity(), bq27220.getFullChargeCapacity());
+        lv_snprintf(buf, 16, "%d/%d", pwr.remaining_mah, pwr.full_mah);
         battery_set_line(batt_line[5], "Capacity:", buf);
 
-        lv_snprintf(buf, 16, "%d", bq27220.getStateOfCharge());
+        lv_snprintf(buf, 16, "%d", pwr.soc);
         battery_set_line(batt_line[6], "Capacity Percent:", buf);
+    } else {
+        batt_update_history();
     }
 }
 
@@ -8546,6 +8872,21 @@ void create5(lv_obj_t *parent)
         batt_line[i] = scr5_add_info_lab(batt_cont, label1, " ");
     }
 
+    // History graph: SOC (0-100 %) on the left axis, current (mA) on the right
+    batt_chart = lv_chart_create(scr5_cont);
+    lv_obj_set_size(batt_chart, DISPALY_WIDTH - 20, 120);
+    lv_obj_align(batt_chart, LV_ALIGN_BOTTOM_MID, 0, -5);
+    apply_bg_color(batt_chart);
+    lv_chart_set_type(batt_chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(batt_chart, POWER_HISTORY_LEN);
+    lv_chart_set_range(batt_chart, LV_CHART_AXIS_PRIMARY_Y, 0, 100);
+    lv_chart_set_range(batt_chart, LV_CHART_AXIS_SECONDARY_Y, -2000, 2000);
+    lv_chart_set_div_line_count(batt_chart, 5, 0);
+    lv_obj_set_style_size(batt_chart, 0, LV_PART_INDICATOR);   // No point markers
+    batt_soc_ser = lv_chart_add_series(batt_chart, lv_color_hex(0x00FF00), LV_CHART_AXIS_PRIMARY_Y);
+    batt_cur_ser = lv_chart_add_series(batt_chart, lv_color_hex(0xFFA500), LV_CHART_AXIS_SECONDARY_Y);
+    lv_obj_add_flag(batt_chart, LV_OBJ_FLAG_HIDDEN);
+
     batt_trans = lv_btn_create(parent);
     // lv_group_add_obj(lv_group_get_default(), btn);
     lv_obj_set_style_pad_all(batt_trans, 0, 0);
@@ -8569,10 +8910,13 @@ void create5(lv_obj_t *parent)
 }
 void entry5(void) {   
     entry5_anim(scr5_cont);
-    batt_timer = lv_timer_create(batt_timer_event, 1000, NULL);
+    batt_show_page(batt_page);
+    power_set_rate(POWER_POLL_FAST_MS);
+    batt_timer = lv_timer_create(batt_timer_event, POWER_POLL_FAST_MS, NULL);
     lv_group_set_wrap(lv_group_get_default(), true);
 }
 void exit5(void) {
+    power_set_rate(POWER_POLL_MS);
     lv_timer_del(batt_timer);
     batt_timer = NULL;
     lv_group_set_wrap(lv_group_get_default(), false);
@@ -8596,6 +8940,7 @@ lv_obj_t *wifi_menu_icon;
 lv_obj_t *wifi_menu_icon_lab;
 lv_obj_t *wifi_config_status_lab = NULL;  // Status label for SmartConfig in left panel
 lv_obj_t *wifi_first_btn = NULL;  // Store first button to focus it
+lv_obj_t *wifi_status_bar = NULL;
 
 int wifi_focus_item = 0;
 
@@ -8747,7 +9092,7 @@ static void wifi_btn_event_cb(lv_event_t * e)
                                 g_config.wifi.password[0] = '\0';
                                 strncat(g_config.wifi.ssid, ssid.c_str(), sizeof(g_config.wifi.ssid) - 1);
                                 strncat(g_config.wifi.password, pwsd.c_str(), sizeof(g_config.wifi.password) - 1);
-                                config_save();
+                                config_mark_dirty(CONFIG_DIRTY_WIFI);
                             }
 
                             destory = true;
@@ -8882,8 +9227,7 @@ void create6(lv_obj_t *parent){
     wifi_config_status_lab = lv_label_create(wifi_menu_cont);
     lv_obj_set_width(wifi_config_status_lab, DISPALY_WIDTH * MENU_LAB_PROPORTION - 10);
     lv_obj_set_style_text_align(wifi_config_status_lab, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-    apply_text_color(wifi_config_status_lab);
-    lv_obj_set_style_text_font(wifi_config_status_lab, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(wifi_config_status_lab);
     lv_label_set_text(wifi_config_status_lab, "");
     lv_obj_align(wifi_config_status_lab, LV_ALIGN_TOP_MID, 0, 5);
 
@@ -8910,15 +9254,12 @@ void create6(lv_obj_t *parent){
         apply_bg_color(btn);
         apply_no_border(btn);
         apply_no_shadow(btn);
-        lv_obj_remove_style(btn, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(btn, 2, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+        apply_focus_outline(btn);
         lv_obj_set_style_bg_img_opa(btn, LV_OPA_100, LV_PART_MAIN);
         add_menu_button_events(btn, wifi_btn_event_cb, (void *)(intptr_t)i);
 
         lv_obj_t *label = lv_label_create(btn);
-        apply_text_color(label);
-        lv_obj_set_style_text_font(label, FONT_BOLD_14, LV_PART_MAIN);
+        apply_label_style(label);
         lv_label_set_text(label, wifi_menu_items[i]);
 
         lv_group_add_obj(lv_group_get_default(), btn);
@@ -8929,11 +9270,18 @@ void create6(lv_obj_t *parent){
         }
     }
 
-    // Add status bar last (on parent, not scr6_cont) so it appears on top
-    create_status_bar(parent);
+    // Status bar is added in entry6() so a retained screen shows current state
 }
 
 void entry6(void) {
+    // Retained between visits: undo exit6_anim's slide-out and refresh the status bar
+    lv_obj_set_x(wifi_item_cont, 0);
+    lv_obj_set_x(wifi_menu_cont, 0);
+    if(wifi_status_bar) {
+        lv_obj_del(wifi_status_bar);
+    }
+    wifi_status_bar = create_status_bar(lv_obj_get_parent(scr6_cont));
+
     if(wifi_first_btn) {
         lv_group_focus_obj(wifi_first_btn);
     }
@@ -8961,8 +9309,8 @@ void exit6(void) {
 }
 
 void destroy6(void) {
-    // Cleanup if needed
     wifi_config_status_lab = NULL;
+    wifi_status_bar = NULL;
 }
 
 scr_lifecycle_t screen6 = {
@@ -8978,6 +9326,8 @@ scr_lifecycle_t screen6 = {
 // WiFi Scanner UI elements
 lv_obj_t *scr6_1_cont;
 lv_obj_t *wifi_scan_list;
+lv_obj_t *wifi_scan_btn;
+lv_timer_t *wifi_scan_timer = NULL;
 
 // WiFi AP detail screen elements
 lv_obj_t *scr6_1_1_cont;
@@ -8987,21 +9337,18 @@ lv_obj_t *wifi_detail_bssid_label;
 lv_obj_t *wifi_detail_rssi_label;
 lv_obj_t *wifi_detail_channel_label;
 lv_obj_t *wifi_detail_encryption_label;
+lv_obj_t *wifi_detail_seen_label;
+lv_timer_t *wifi_detail_timer = NULL;
 
 // WiFi Scanner state
-bool wifi_scan_in_progress = false;
-int wifi_selected_ap_index = -1;
-
-// Structure to store AP information
-struct WiFiAPInfo {
-    String ssid;
-    String bssid;
-    int32_t rssi;
-    uint8_t channel;
-    uint8_t encryption;
-};
+int wifi_selected_ap_index = -1;            // Slot in the wifi_scan table
+uint8_t wifi_selected_bssid[6];             // Guards against the slot being reused
+lv_obj_t *wifi_scan_rows[WIFI_SCAN_MAX_APS]; // One list button per table slot
+uint32_t wifi_scan_rows_gen = 0;
+uint32_t wifi_scan_rows_age_ms = 0;
 
-std::vector<WiFiAPInfo> scanned_aps;
+#define WIFI_SCAN_UI_PERIOD     250     // Completion poll / row refresh
+#define WIFI_SCAN_AGE_MS        10000   // Show "last seen" once an AP is this quiet
 
 // Get encryption type as string
 const char* getEncryptionType(uint8_t encType) {
@@ -9018,115 +9365,124 @@ const char* getEncryptionType(uint8_t encType) {
     }
 }
 
-// WiFi scan list event handler
-static void wifi_scan_list_event(lv_event_t *e) {
-    lv_event_code_t code = lv_event_get_code(e);
-    lv_obj_t *obj = lv_event_get_target(e);
+// Compact row format: [dBm] SSID, plus the age once the AP has gone quiet
+static void wifi_scan_format_row(const WiFiScanEntry *ap, uint32_t now, char *buf, size_t len) {
+    char ssid[24];
+    if (ap->ssid[0] == '\0') {
+        strlcpy(ssid, "<Hidden>", sizeof(ssid));
+    } else if (strlen(ap->ssid) > 20) {
+        snprintf(ssid, sizeof(ssid), "%.17s...", ap->ssid);
+    } else {
+        strlcpy(ssid, ap->ssid, sizeof(ssid));
+    }
 
-    if (code == LV_EVENT_CLICKED) {
-        const char *item_text = lv_list_get_btn_text(wifi_scan_list, obj);
+    uint32_t age = now - ap->last_seen_ms;
+    if (age >= WIFI_SCAN_AGE_MS) {
+        snprintf(buf, len, " [%d] %s (%lus)", wifi_scan_rssi(ap), ssid, (unsigned long)(age / 1000));
+    } else {
+        snprintf(buf, len, " [%d] %s", wifi_scan_rssi(ap), ssid);
+    }
+}
 
-        if (item_text) {
-            // Check if it's the scan button
-            if (strcmp(item_text, " [Scan]") == 0) {
-                // Trigger scan
-                if (!wifi_scan_in_progress) {
-                    wifi_scan_in_progress = true;
-                    prompt_info("  Scanning...", 500);
-
-                    // Clear previous results
-                    scanned_aps.clear();
-                    lv_obj_clean(wifi_scan_list);
-
-                    // Add scanning message
-                    lv_obj_t *item = lv_list_add_btn(wifi_scan_list, NULL, " Scanning WiFi...");
-                    lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-                    apply_bg_color(item);
-                    apply_text_color(item);
-                    lv_refr_now(NULL);
+static void wifi_scan_update_btn_text(void) {
+    const char *text;
+    if (wifi_scan_is_continuous()) {
+        text = " [Stop]";
+    } else if (wifi_scan_is_running()) {
+        text = " Scanning...";
+    } else {
+        text = " [Scan]";
+    }
+    lv_obj_t *label = lv_obj_get_child(wifi_scan_btn, 0);
+    if (strcmp(lv_label_get_text(label), text) != 0) {
+        lv_label_set_text(label, text);
+    }
+}
+
+// Insert position that keeps new rows roughly sorted by smoothed RSSI;
+// existing rows are not reordered so the focused row never jumps
+static uint32_t wifi_scan_row_index(const WiFiScanEntry *ap) {
+    uint32_t idx = 1;   // After the scan button
+    for (int i = 0; i < WIFI_SCAN_MAX_APS; i++) {
+        const WiFiScanEntry *other = wifi_scan_get(i);
+        if (wifi_scan_rows[i] && other && other->rssi_x16 >= ap->rssi_x16) {
+            idx++;
+        }
+    }
+    return idx;
+}
 
-                    // Perform scan
-                    int n = WiFi.scanNetworks();
+static void wifi_scan_list_event(lv_event_t *e);
 
-                    // Clear scanning message
-                    lv_obj_clean(wifi_scan_list);
+// Bring the list in line with the table: add/remove rows for new/expired slots
+// and only relabel rows whose text actually changed
+static void wifi_scan_sync_rows(void) {
+    uint32_t now = millis();
+    char buf[64];
 
-                    if (n == 0) {
-                        lv_obj_t *no_nets = lv_list_add_btn(wifi_scan_list, NULL, " No networks found");
-                        lv_obj_set_style_text_font(no_nets, FONT_BOLD_14, LV_PART_MAIN);
-                        apply_bg_color(no_nets);
-                        apply_text_color(no_nets);
-                    } else {
-                        // Store AP information
-                        for (int i = 0; i < n; i++) {
-                            WiFiAPInfo ap;
-                            ap.ssid = WiFi.SSID(i);
-                            ap.bssid = WiFi.BSSIDstr(i);
-                            ap.rssi = WiFi.RSSI(i);
-                            ap.channel = WiFi.channel(i);
-                            ap.encryption = WiFi.encryptionType(i);
-                            scanned_aps.push_back(ap);
-                        }
+    for (int i = 0; i < WIFI_SCAN_MAX_APS; i++) {
+        const WiFiScanEntry *ap = wifi_scan_get(i);
 
-                        // Sort by RSSI (strongest first)
-                        std::sort(scanned_aps.begin(), scanned_aps.end(),
-                            [](const WiFiAPInfo& a, const WiFiAPInfo& b) {
-                                return a.rssi > b.rssi;
-                            });
-
-                        // Create list items with compact format: [dBm] SSID
-                        for (size_t i = 0; i < scanned_aps.size(); i++) {
-                            char buf[128];
-                            String ssid_display = scanned_aps[i].ssid;
-                            if (ssid_display.length() == 0) {
-                                ssid_display = "<Hidden>";
-                            }
-                            // Limit SSID length for display
-                            if (ssid_display.length() > 20) {
-                                ssid_display = ssid_display.substring(0, 17) + "...";
-                            }
-                            snprintf(buf, sizeof(buf), " [%d] %s",
-                                     scanned_aps[i].rssi, ssid_display.c_str());
+        if (!ap) {
+            if (wifi_scan_rows[i]) {
+                lv_obj_del(wifi_scan_rows[i]);
+                wifi_scan_rows[i] = NULL;
+            }
+            continue;
+        }
 
-                            lv_obj_t *item = lv_list_add_btn(wifi_scan_list, NULL, buf);
-                            lv_obj_add_event_cb(item, wifi_scan_list_event, LV_EVENT_ALL, (void*)(intptr_t)i);
-                        }
+        wifi_scan_format_row(ap, now, buf, sizeof(buf));
+        if (!wifi_scan_rows[i]) {
+            lv_obj_t *item = lv_list_add_btn(wifi_scan_list, NULL, buf);
+            lv_obj_add_event_cb(item, wifi_scan_list_event, LV_EVENT_CLICKED, (void*)(intptr_t)i);
+            apply_list_btn_style(item);
+            lv_obj_move_to_index(item, wifi_scan_row_index(ap));
+            wifi_scan_rows[i] = item;
+        } else {
+            lv_obj_t *label = lv_obj_get_child(wifi_scan_rows[i], 0);
+            if (strcmp(lv_label_get_text(label), buf) != 0) {
+                lv_label_set_text(label, buf);
+            }
+        }
+    }
+}
 
-                        // Style all list items
-                        for (int i = 0; i < lv_obj_get_child_cnt(wifi_scan_list); i++) {
-                            lv_obj_t *item = lv_obj_get_child(wifi_scan_list, i);
-                            lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-                            apply_bg_color(item);
-                            apply_text_color(item);
-                            lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-                            lv_obj_set_style_radius(item, 5, LV_STATE_FOCUS_KEY);
-                            lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-                            lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
-                        }
-                    }
+static void wifi_scan_timer_event(lv_timer_t *t) {
+    bool changed = wifi_scan_poll();
+    uint32_t gen = wifi_scan_get_generation();
+    uint32_t now = millis();
 
-                    WiFi.scanDelete();
+    // Ages tick even without a new pass, but a 1 s refresh is plenty for them
+    if (changed || gen != wifi_scan_rows_gen || now - wifi_scan_rows_age_ms >= 1000) {
+        wifi_scan_sync_rows();
+        wifi_scan_rows_gen = gen;
+        wifi_scan_rows_age_ms = now;
+    }
+    wifi_scan_update_btn_text();
+}
 
-                    // Add scan button at the end
-                    lv_obj_t *scan_item = lv_list_add_btn(wifi_scan_list, NULL, " [Scan]");
-                    lv_obj_add_event_cb(scan_item, wifi_scan_list_event, LV_EVENT_ALL, NULL);
-                    lv_obj_set_style_text_font(scan_item, FONT_BOLD_14, LV_PART_MAIN);
-                    apply_bg_color(scan_item);
-                    apply_text_color(scan_item);
-                    lv_obj_remove_style(scan_item, NULL, LV_STATE_FOCUS_KEY);
-                    lv_obj_set_style_radius(scan_item, 5, LV_STATE_FOCUS_KEY);
-                    lv_obj_set_style_outline_color(scan_item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-                    lv_obj_set_style_outline_width(scan_item, 2, LV_STATE_FOCUS_KEY);
+// WiFi scan list event handler
+static void wifi_scan_list_event(lv_event_t *e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t *obj = lv_event_get_target(e);
 
-                    wifi_scan_in_progress = false;
-                }
-            } else {
-                // It's an AP item - get the index from user_data
-                int idx = (int)(intptr_t)e->user_data;
-                if (idx >= 0 && idx < (int)scanned_aps.size()) {
-                    wifi_selected_ap_index = idx;
-                    scr_mgr_switch(SCREEN6_1_1_ID, false);
-                }
+    if (code == LV_EVENT_CLICKED) {
+        if (obj == wifi_scan_btn) {
+            // Toggle continuous async scanning; results merge into the BSSID table
+            if (wifi_scan_is_continuous()) {
+                wifi_scan_stop();
+            } else if (!wifi_scan_start(true)) {
+                prompt_info("  Scan failed", 1000);
+            }
+            wifi_scan_update_btn_text();
+        } else {
+            // It's an AP item - get the table slot from user_data
+            int idx = (int)(intptr_t)e->user_data;
+            const WiFiScanEntry *ap = wifi_scan_get(idx);
+            if (ap) {
+                wifi_selected_ap_index = idx;
+                memcpy(wifi_selected_bssid, ap->bssid, 6);
+                scr_mgr_switch(SCREEN6_1_1_ID, false);
             }
         }
     }
@@ -9134,6 +9490,7 @@ static void wifi_scan_list_event(lv_event_t *e) {
 
 // Back button callback for scanner
 static void wifi_scanner_back_btn_cb(lv_event_t *e) {
+    wifi_scan_stop();
     scr_mgr_switch(SCREEN6_ID, false);
 }
 
@@ -9156,8 +9513,7 @@ void create6_1(lv_obj_t *parent) {
     // Title
     lv_obj_t *title = lv_label_create(scr6_1_cont);
     lv_label_set_text(title, "WiFi Scanner");
-    lv_obj_set_style_text_font(title, FONT_BOLD_20, 0);
-    apply_text_color(title);
+    apply_title_style(title);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
 
     // Create list widget (like file browser)
@@ -9168,29 +9524,39 @@ void create6_1(lv_obj_t *parent) {
     apply_no_border(wifi_scan_list);
     apply_no_padding(wifi_scan_list);
 
-    // Add initial "Scan" button
-    lv_obj_t *scan_item = lv_list_add_btn(wifi_scan_list, NULL, " [Scan]");
-    lv_obj_add_event_cb(scan_item, wifi_scan_list_event, LV_EVENT_ALL, NULL);
-    lv_obj_set_style_text_font(scan_item, FONT_BOLD_14, LV_PART_MAIN);
-    apply_bg_color(scan_item);
-    apply_text_color(scan_item);
-    lv_obj_remove_style(scan_item, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_radius(scan_item, 5, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(scan_item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(scan_item, 2, LV_STATE_FOCUS_KEY);
+    // Scan/Stop toggle stays at the top; AP rows follow it
+    wifi_scan_btn = lv_list_add_btn(wifi_scan_list, NULL, " [Scan]");
+    lv_obj_add_event_cb(wifi_scan_btn, wifi_scan_list_event, LV_EVENT_CLICKED, NULL);
+    apply_list_btn_style(wifi_scan_btn);
+
+    // Rows for APs already in the table (e.g. coming back from the detail screen)
+    memset(wifi_scan_rows, 0, sizeof(wifi_scan_rows));
+    wifi_scan_sync_rows();
+    wifi_scan_rows_gen = wifi_scan_get_generation();
+    wifi_scan_rows_age_ms = millis();
+    wifi_scan_update_btn_text();
+
+    wifi_scan_timer = lv_timer_create(wifi_scan_timer_event, WIFI_SCAN_UI_PERIOD, NULL);
+    lv_timer_pause(wifi_scan_timer);
 }
 
 void entry6_1(void) {
     lv_group_set_wrap(lv_group_get_default(), true);
+    lv_timer_resume(wifi_scan_timer);
 }
 
 void exit6_1(void) {
     lv_group_set_wrap(lv_group_get_default(), false);
+    lv_timer_pause(wifi_scan_timer);
 }
 
 void destroy6_1(void) {
-    // Don't clear scanned_aps here - we need it for the detail screen
-    // It will be cleared when starting a new scan
+    // Keep the table (and a continuous scan) alive for the detail screen;
+    // the back button stops scanning
+    if (wifi_scan_timer) {
+        lv_timer_del(wifi_scan_timer);
+        wifi_scan_timer = NULL;
+    }
 }
 
 scr_lifecycle_t screen6_1 = {
@@ -9201,6 +9567,47 @@ scr_lifecycle_t screen6_1 = {
 };
 
 // --------------------- screen 6.1.1 --------------------- WiFi AP Details
+static void wifi_detail_refresh(void) {
+    const WiFiScanEntry *ap = wifi_scan_get(wifi_selected_ap_index);
+    char buf[256];
+
+    if (!ap || memcmp(ap->bssid, wifi_selected_bssid, 6) != 0) {
+        lv_label_set_text(wifi_detail_seen_label, "Expired from scan table");
+        return;
+    }
+
+    // SSID (two lines - label and value)
+    snprintf(buf, sizeof(buf), "SSID:\n  %s", ap->ssid[0] ? ap->ssid : "<Hidden SSID>");
+    lv_label_set_text(wifi_detail_ssid_label, buf);
+
+    // BSSID (one line)
+    snprintf(buf, sizeof(buf), "BSSID: %02x:%02x:%02x:%02x:%02x:%02x",
+             ap->bssid[0], ap->bssid[1], ap->bssid[2], ap->bssid[3], ap->bssid[4], ap->bssid[5]);
+    lv_label_set_text(wifi_detail_bssid_label, buf);
+
+    // Signal: smoothed value, last raw sample in brackets
+    snprintf(buf, sizeof(buf), "Signal: %d dBm (%d)", wifi_scan_rssi(ap), ap->rssi);
+    lv_label_set_text(wifi_detail_rssi_label, buf);
+
+    // Channel (one line)
+    snprintf(buf, sizeof(buf), "Channel: %d", ap->channel);
+    lv_label_set_text(wifi_detail_channel_label, buf);
+
+    // Encryption (one line, will wrap if needed)
+    snprintf(buf, sizeof(buf), "Encryption: %s", getEncryptionType(ap->encryption));
+    lv_label_set_text(wifi_detail_encryption_label, buf);
+
+    snprintf(buf, sizeof(buf), "Seen: %u passes, %lus ago", ap->seen,
+             (unsigned long)((millis() - ap->last_seen_ms) / 1000));
+    lv_label_set_text(wifi_detail_seen_label, buf);
+}
+
+// Keeps merging a continuous scan while the list screen is gone
+static void wifi_detail_timer_event(lv_timer_t *t) {
+    wifi_scan_poll();
+    wifi_detail_refresh();
+}
+
 void create6_1_1(lv_obj_t *parent) {
     scr6_1_1_cont = lv_obj_create(parent);
     lv_obj_set_size(scr6_1_1_cont, LV_PCT(100), LV_PCT(100));
@@ -9215,8 +9622,7 @@ void create6_1_1(lv_obj_t *parent) {
     // Title
     lv_obj_t *title = lv_label_create(scr6_1_1_cont);
     lv_label_set_text(title, "AP Details");
-    lv_obj_set_style_text_font(title, FONT_BOLD_20, 0);
-    apply_text_color(title);
+    apply_title_style(title);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
 
     // Details container - made tall enough to show all content
@@ -9234,78 +9640,59 @@ void create6_1_1(lv_obj_t *parent) {
     // SSID label
     wifi_detail_ssid_label = lv_label_create(wifi_detail_cont);
     lv_label_set_text(wifi_detail_ssid_label, "SSID: ");
-    lv_obj_set_style_text_font(wifi_detail_ssid_label, FONT_BOLD_14, 0);
-    apply_text_color(wifi_detail_ssid_label);
+    apply_label_style(wifi_detail_ssid_label);
     lv_label_set_long_mode(wifi_detail_ssid_label, LV_LABEL_LONG_WRAP);
     lv_obj_set_width(wifi_detail_ssid_label, LV_PCT(100));
 
     // BSSID label
     wifi_detail_bssid_label = lv_label_create(wifi_detail_cont);
     lv_label_set_text(wifi_detail_bssid_label, "BSSID: ");
-    lv_obj_set_style_text_font(wifi_detail_bssid_label, FONT_BOLD_14, 0);
-    apply_text_color(wifi_detail_bssid_label);
+    apply_label_style(wifi_detail_bssid_label);
 
     // RSSI label
     wifi_detail_rssi_label = lv_label_create(wifi_detail_cont);
     lv_label_set_text(wifi_detail_rssi_label, "Signal: ");
-    lv_obj_set_style_text_font(wifi_detail_rssi_label, FONT_BOLD_14, 0);
-    apply_text_color(wifi_detail_rssi_label);
+    apply_label_style(wifi_detail_rssi_label);
 
     // Channel label
     wifi_detail_channel_label = lv_label_create(wifi_detail_cont);
     lv_label_set_text(wifi_detail_channel_label, "Channel: ");
-    lv_obj_set_style_text_font(wifi_detail_channel_label, FONT_BOLD_14, 0);
-    apply_text_color(wifi_detail_channel_label);
+    apply_label_style(wifi_detail_channel_label);
 
     // Encryption label
     wifi_detail_encryption_label = lv_label_create(wifi_detail_cont);
     lv_label_set_text(wifi_detail_encryption_label, "Encryption: ");
-    lv_obj_set_style_text_font(wifi_detail_encryption_label, FONT_BOLD_14, 0);
-    apply_text_color(wifi_detail_encryption_label);
+    apply_label_style(wifi_detail_encryption_label);
     lv_label_set_long_mode(wifi_detail_encryption_label, LV_LABEL_LONG_WRAP);
     lv_obj_set_width(wifi_detail_encryption_label, LV_PCT(100));
+
+    // Last seen label
+    wifi_detail_seen_label = lv_label_create(wifi_detail_cont);
+    lv_label_set_text(wifi_detail_seen_label, "Seen: ");
+    apply_label_style(wifi_detail_seen_label);
+
+    wifi_detail_timer = lv_timer_create(wifi_detail_timer_event, 1000, NULL);
+    lv_timer_pause(wifi_detail_timer);
 }
 
 void entry6_1_1(void) {
     lv_group_set_wrap(lv_group_get_default(), true);
 
     // Update labels with selected AP info
-    if (wifi_selected_ap_index >= 0 && wifi_selected_ap_index < (int)scanned_aps.size()) {
-        WiFiAPInfo &ap = scanned_aps[wifi_selected_ap_index];
-
-        char buf[256];
-
-        // SSID (two lines - label and value)
-        String ssid_display = ap.ssid;
-        if (ssid_display.length() == 0) {
-            ssid_display = "<Hidden SSID>";
-        }
-        snprintf(buf, sizeof(buf), "SSID:\n  %s", ssid_display.c_str());
-        lv_label_set_text(wifi_detail_ssid_label, buf);
-
-        // BSSID (one line)
-        snprintf(buf, sizeof(buf), "BSSID: %s", ap.bssid.c_str());
-        lv_label_set_text(wifi_detail_bssid_label, buf);
-
-        // Signal (one line)
-        snprintf(buf, sizeof(buf), "Signal: %d dBm", ap.rssi);
-        lv_label_set_text(wifi_detail_rssi_label, buf);
-
-        // Channel (one line)
-        snprintf(buf, sizeof(buf), "Channel: %d", ap.channel);
-        lv_label_set_text(wifi_detail_channel_label, buf);
-
-        // Encryption (one line, will wrap if needed)
-        snprintf(buf, sizeof(buf), "Encryption: %s", getEncryptionType(ap.encryption));
-        lv_label_set_text(wifi_detail_encryption_label, buf);
-    }
+    wifi_detail_refresh();
+    lv_timer_resume(wifi_detail_timer);
 }
 
 void exit6_1_1(void) {
     lv_group_set_wrap(lv_group_get_default(), false);
+    lv_timer_pause(wifi_detail_timer);
 }
 
 void destroy6_1_1(void) {
+    if (wifi_detail_timer) {
+        lv_timer_del(wifi_detail_timer);
+        wifi_detail_timer = NULL;
+    }
 }
 
 scr_lifecycle_t screen6_1_1 = {
@@ -9569,7 +9956,7 @@ static void deauth_btn_threshold_event(lv_event_t *e) {
 
         // Save to config
         g_config.wifi.deauth.packet_threshold = deauth_packet_threshold;
-        config_save();
+        config_mark_dirty(CONFIG_DIRTY_WIFI);
     }
 }
 
@@ -9585,7 +9972,7 @@ static void deauth_btn_rssi_scale_event(lv_event_t *e) {
 
         // Save to config
         g_config.wifi.deauth.rssi_scale_dbm = deauth_rssi_scale_dbm;
-        config_save();
+        config_mark_dirty(CONFIG_DIRTY_WIFI);
     }
 }
 
@@ -9626,38 +10013,31 @@ static void create6_2(lv_obj_t *parent) {
     apply_no_shadow(deauth_btn_start);
     lv_obj_set_style_radius(deauth_btn_start, 10, 0);
     lv_obj_set_style_bg_img_src(deauth_btn_start, &img_pause_32, 0);
-    lv_obj_remove_style(deauth_btn_start, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(deauth_btn_start, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(deauth_btn_start, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(deauth_btn_start, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(deauth_btn_start);
     lv_obj_add_event_cb(deauth_btn_start, deauth_btn_start_event, LV_EVENT_CLICKED, NULL);
     lv_group_add_obj(lv_group_get_default(), deauth_btn_start);
 
     // Channel label (top row, left)
     deauth_channel_label = lv_label_create(scr6_2_cont);
-    apply_text_color(deauth_channel_label);
-    lv_obj_set_style_text_font(deauth_channel_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(deauth_channel_label);
     lv_label_set_text(deauth_channel_label, "Channel: --");
     lv_obj_align(deauth_channel_label, LV_ALIGN_TOP_LEFT, 60, 45);
 
     // APs label (top row, center)
     deauth_aps_label = lv_label_create(scr6_2_cont);
-    apply_text_color(deauth_aps_label);
-    lv_obj_set_style_text_font(deauth_aps_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(deauth_aps_label);
     lv_label_set_text(deauth_aps_label, "APs: 0");
     lv_obj_align(deauth_aps_label, LV_ALIGN_TOP_LEFT, 60, 65);
 
     // Packets label (top row, right side)
     deauth_packets_label = lv_label_create(scr6_2_cont);
-    apply_text_color(deauth_packets_label);
-    lv_obj_set_style_text_font(deauth_packets_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(deauth_packets_label);
     lv_label_set_text(deauth_packets_label, "Packets: 0");
     lv_obj_align(deauth_packets_label, LV_ALIGN_TOP_RIGHT, -10, 45);
 
     // Row 2: "RSSI Scale:" label (left side, static text)
     lv_obj_t *rssi_scale_label_text = lv_label_create(scr6_2_cont);
-    apply_text_color(rssi_scale_label_text);
-    lv_obj_set_style_text_font(rssi_scale_label_text, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(rssi_scale_label_text);
     lv_label_set_text(rssi_scale_label_text, "Scale:");
     lv_obj_align(rssi_scale_label_text, LV_ALIGN_TOP_LEFT, 10, 95);
 
@@ -9665,27 +10045,21 @@ static void create6_2(lv_obj_t *parent) {
     deauth_btn_rssi_scale = lv_btn_create(scr6_2_cont);
     lv_obj_set_size(deauth_btn_rssi_scale, 70, 28);
     lv_obj_align(deauth_btn_rssi_scale, LV_ALIGN_TOP_LEFT, 70, 90);
-    lv_obj_set_style_border_color(deauth_btn_rssi_scale, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(deauth_btn_rssi_scale, 1, LV_PART_MAIN);
+    apply_theme_border(deauth_btn_rssi_scale);
     apply_no_shadow(deauth_btn_rssi_scale);
     apply_bg_color(deauth_btn_rssi_scale);
-    lv_obj_remove_style(deauth_btn_rssi_scale, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(deauth_btn_rssi_scale, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(deauth_btn_rssi_scale, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(deauth_btn_rssi_scale, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(deauth_btn_rssi_scale);
     lv_obj_add_event_cb(deauth_btn_rssi_scale, deauth_btn_rssi_scale_event, LV_EVENT_CLICKED, NULL);
     lv_group_add_obj(lv_group_get_default(), deauth_btn_rssi_scale);
 
     deauth_rssi_scale_label = lv_label_create(deauth_btn_rssi_scale);
-    apply_text_color(deauth_rssi_scale_label);
-    lv_obj_set_style_text_font(deauth_rssi_scale_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(deauth_rssi_scale_label);
     lv_label_set_text_fmt(deauth_rssi_scale_label, "%d dBm", deauth_rssi_scale_dbm);
     lv_obj_center(deauth_rssi_scale_label);
 
     // "Threshold:" label (right side, static text)
     lv_obj_t *threshold_label_text = lv_label_create(scr6_2_cont);
-    apply_text_color(threshold_label_text);
-    lv_obj_set_style_text_font(threshold_label_text, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(threshold_label_text);
     lv_label_set_text(threshold_label_text, "Threshold:");
     lv_obj_align(threshold_label_text, LV_ALIGN_TOP_RIGHT, -80, 95);
 
@@ -9693,20 +10067,15 @@ static void create6_2(lv_obj_t *parent) {
     deauth_btn_threshold = lv_btn_create(scr6_2_cont);
     lv_obj_set_size(deauth_btn_threshold, 60, 28);
     lv_obj_align(deauth_btn_threshold, LV_ALIGN_TOP_RIGHT, -10, 90);
-    lv_obj_set_style_border_color(deauth_btn_threshold, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(deauth_btn_threshold, 1, LV_PART_MAIN);
+    apply_theme_border(deauth_btn_threshold);
     apply_no_shadow(deauth_btn_threshold);
     apply_bg_color(deauth_btn_threshold);
-    lv_obj_remove_style(deauth_btn_threshold, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(deauth_btn_threshold, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(deauth_btn_threshold, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(deauth_btn_threshold, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(deauth_btn_threshold);
     lv_obj_add_event_cb(deauth_btn_threshold, deauth_btn_threshold_event, LV_EVENT_CLICKED, NULL);
     lv_group_add_obj(lv_group_get_default(), deauth_btn_threshold);
 
     deauth_threshold_label = lv_label_create(deauth_btn_threshold);
-    apply_text_color(deauth_threshold_label);
-    lv_obj_set_style_text_font(deauth_threshold_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(deauth_threshold_label);
     lv_label_set_text_fmt(deauth_threshold_label, "%d", deauth_packet_threshold);
     lv_obj_center(deauth_threshold_label);
 
@@ -9719,8 +10088,7 @@ static void create6_2(lv_obj_t *parent) {
 
     // RSSI Label (overlaid on top of bar, centered)
     deauth_rssi_label = lv_label_create(scr6_2_cont);
-    apply_text_color(deauth_rssi_label);
-    lv_obj_set_style_text_font(deauth_rssi_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(deauth_rssi_label);
     lv_label_set_text(deauth_rssi_label, "RSSI: --- dBm");
     lv_obj_align(deauth_rssi_label, LV_ALIGN_BOTTOM_MID, 0, -12);
     // Add semi-transparent background for better readability
@@ -9856,6 +10224,15 @@ int pineap_rssi_scale_dbm = -20;  // Default RSSI scale
 int pineap_ssid_threshold = 5;  // Default threshold for detection
 int pineap_selected_index = 0;  // Selected item in list
 
+// What pineap_list_cont currently holds, so redraws can update rows in place
+enum {
+    PINEAP_DRAWN_NONE,
+    PINEAP_DRAWN_EMPTY,
+    PINEAP_DRAWN_MAIN,
+    PINEAP_DRAWN_SSIDS,
+};
+int pineap_drawn = PINEAP_DRAWN_NONE;
+
 // Helper functions
 String bssid_to_string(const uint8_t* bssid) {
     char str[18];
@@ -9932,46 +10309,33 @@ void process_scan_results() {
         }
     }
 
-    if (new_pineaps.size() != pineap_stats.detected_pineaps.size()) {
-        pineap_stats.list_changed = true;
-    }
+    // Rows are updated in place, so a redraw per pass is cheap
+    pineap_stats.list_changed = true;
 
     pineap_stats.detected_pineaps = new_pineaps;
 }
 
+// wifi_scan sink: every raw record of a finished pass, BSSID+SSID pairs included
+static void pineap_scan_sink(const uint8_t *bssid, const char *ssid, int8_t rssi) {
+    if (ssid[0] != '\0') {
+        add_scan_result(bssid_to_string(bssid), String(ssid), rssi);
+    }
+}
+
 void scan_and_analyze_pineap() {
-    static uint32_t last_wifi_scan = 0;
+    // Passes run back to back in the background; results reach
+    // add_scan_result() through pineap_scan_sink() while merging
+    if (wifi_scan_poll()) {
+        pineap_stats.total_scans++;
+        process_scan_results();
+        maintain_buffer_size();
+    }
 
-    if (millis() - last_wifi_scan > 2000) {  // Scan every 2 seconds
-        // Turn LED on during scan
+    // LED follows the radio instead of forcing a redraw around a blocking scan
+    if (wifi_scan_is_running()) {
         lv_led_on(pineap_scan_led);
-        lv_refr_now(NULL);
-        tft.drawPixel(0, 0, 0);
-
-        int n = WiFi.scanNetworks();
-        if (n > 0) {
-            for (int i = 0; i < n; i++) {
-                String bssid_str = WiFi.BSSIDstr(i);
-                String essid = WiFi.SSID(i);
-                int32_t rssi = WiFi.RSSI(i);
-
-                if (essid.length() > 0 && bssid_str.length() > 0) {
-                    add_scan_result(bssid_str, essid, rssi);
-                }
-            }
-
-            pineap_stats.total_scans++;
-            process_scan_results();
-            maintain_buffer_size();
-        }
-
-        WiFi.scanDelete();
-        last_wifi_scan = millis();
-
-        // Turn LED off after scan
+    } else {
         lv_led_off(pineap_scan_led);
-        lv_refr_now(NULL);
-        tft.drawPixel(0, 0, 0);
     }
 }
 
@@ -9985,6 +10349,32 @@ int pineap_calculate_rssi_bars(int rssi, int scale_max) {
     return (100 * offset) / range;
 }
 
+// Switch pineap_list_cont to another kind of content.
+// Returns true if it was cleared and has to be filled from scratch
+static bool pineap_list_begin(int kind) {
+    if (pineap_drawn == kind) {
+        return false;
+    }
+    lv_obj_clean(pineap_list_cont);
+    pineap_drawn = kind;
+    return true;
+}
+
+// Drop trailing rows beyond `count`, return how many rows can be reused
+static uint32_t pineap_list_trim(uint32_t count) {
+    uint32_t have = lv_obj_get_child_cnt(pineap_list_cont);
+    while (have > count) {
+        lv_obj_del(lv_obj_get_child(pineap_list_cont, --have));
+    }
+    return have;
+}
+
+static void pineap_set_label(lv_obj_t *label, const char *text) {
+    if (strcmp(lv_label_get_text(label), text) != 0) {
+        lv_label_set_text(label, text);
+    }
+}
+
 // Update display for main list view
 void pineap_draw_main_list() {
     if (!pineap_list_cont) return;
@@ -9999,83 +10389,82 @@ void pineap_draw_main_list() {
     if (pineap_rssi_bar) lv_obj_add_flag(pineap_rssi_bar, LV_OBJ_FLAG_HIDDEN);
     if (pineap_rssi_label) lv_obj_add_flag(pineap_rssi_label, LV_OBJ_FLAG_HIDDEN);
 
-    // Clear existing list
-    lv_obj_clean(pineap_list_cont);
-
     if (pineap_stats.detected_pineaps.empty()) {
-        lv_obj_t *empty_label = lv_label_create(pineap_list_cont);
-        apply_text_color(empty_label);
-        lv_obj_set_style_text_font(empty_label, FONT_LIGHT_14, LV_PART_MAIN);
-        lv_label_set_text(empty_label, "No PineAPs detected");
-        lv_obj_align(empty_label, LV_ALIGN_TOP_LEFT, 5, 5);
-    } else {
-        // Create list items for detected PineAPs - show full BSSID and SSID count
-        lv_obj_t *first_btn = NULL;
-        for (size_t i = 0; i < pineap_stats.detected_pineaps.size(); i++) {
-            const auto& pine = pineap_stats.detected_pineaps[i];
-            String bssid_str = bssid_to_string(pine.bssid);
-
-            lv_obj_t *item_btn = lv_btn_create(pineap_list_cont);
-            lv_obj_set_size(item_btn, 295, 30);
-            apply_bg_color(item_btn);
-            lv_obj_set_style_border_color(item_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-            lv_obj_set_style_border_width(item_btn, 1, LV_PART_MAIN);
-            apply_no_shadow(item_btn);
-            lv_obj_remove_style(item_btn, NULL, LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_outline_pad(item_btn, 2, LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_outline_width(item_btn, 2, LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_outline_color(item_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-
-            lv_obj_t *item_label = lv_label_create(item_btn);
-            apply_text_color(item_label);
-            lv_obj_set_style_text_font(item_label, FONT_LIGHT_14, LV_PART_MAIN);
-
-            // Show full BSSID and SSID count: "00:aa:33:44:ee:44 17"
-            lv_label_set_text_fmt(item_label, "%s %d", bssid_str.c_str(), pine.essids.size());
-            lv_obj_center(item_label);
-
-            // Store index as user data
-            lv_obj_set_user_data(item_btn, (void*)(uintptr_t)i);
-
-            // Click event to show SSID list
-            lv_obj_add_event_cb(item_btn, [](lv_event_t *e) {
-                if (e->code == LV_EVENT_CLICKED) {
-                    lv_obj_t *btn = lv_event_get_target(e);
-                    pineap_selected_index = (int)(uintptr_t)lv_obj_get_user_data(btn);
-                    pineap_stats.view_mode = 1;  // Switch to SSID detail view
-                }
-            }, LV_EVENT_CLICKED, NULL);
+        if (pineap_list_begin(PINEAP_DRAWN_EMPTY)) {
+            lv_obj_t *empty_label = lv_label_create(pineap_list_cont);
+            apply_text_color(empty_label);
+            lv_obj_set_style_text_font(empty_label, FONT_LIGHT_14, LV_PART_MAIN);
+            lv_label_set_text(empty_label, "No PineAPs detected");
+            lv_obj_align(empty_label, LV_ALIGN_TOP_LEFT, 5, 5);
+        }
+        return;
+    }
 
-            lv_group_add_obj(lv_group_get_default(), item_btn);
+    // Existing rows keep their object (and focus); only changed labels are touched
+    bool fresh = pineap_list_begin(PINEAP_DRAWN_MAIN);
+    uint32_t have = pineap_list_trim(pineap_stats.detected_pineaps.size());
 
-            // Save first button for focus
-            if (i == 0) {
-                first_btn = item_btn;
-            }
+    // Show full BSSID and SSID count: "00:aa:33:44:ee:44 17"
+    for (size_t i = 0; i < pineap_stats.detected_pineaps.size(); i++) {
+        const auto& pine = pineap_stats.detected_pineaps[i];
+        char text[32];
+        snprintf(text, sizeof(text), "%s %d", bssid_to_string(pine.bssid).c_str(), (int)pine.essids.size());
+
+        if (i < have) {
+            pineap_set_label(lv_obj_get_child(lv_obj_get_child(pineap_list_cont, i), 0), text);
+            continue;
         }
 
-        // Focus on first item in the list when PineAPs are detected
-        if (first_btn) {
-            lv_group_focus_obj(first_btn);
+        lv_obj_t *item_btn = lv_btn_create(pineap_list_cont);
+        lv_obj_set_size(item_btn, 295, 30);
+        apply_bg_color(item_btn);
+        apply_theme_border(item_btn);
+        apply_no_shadow(item_btn);
+        apply_btn_focus(item_btn);
+
+        lv_obj_t *item_label = lv_label_create(item_btn);
+        apply_text_color(item_label);
+        lv_obj_set_style_text_font(item_label, FONT_LIGHT_14, LV_PART_MAIN);
+        lv_label_set_text(item_label, text);
+        lv_obj_center(item_label);
+
+        // Store index as user data
+        lv_obj_set_user_data(item_btn, (void*)(uintptr_t)i);
+
+        // Click event to show SSID list
+        lv_obj_add_event_cb(item_btn, [](lv_event_t *e) {
+            if (e->code == LV_EVENT_CLICKED) {
+                lv_obj_t *btn = lv_event_get_target(e);
+                pineap_selected_index = (int)(uintptr_t)lv_obj_get_user_data(btn);
+                pineap_stats.view_mode = 1;  // Switch to SSID detail view
+                pineap_stats.list_changed = true;
+            }
+        }, LV_EVENT_CLICKED, NULL);
+
+        lv_group_add_obj(lv_group_get_default(), item_btn);
+
+        // Focus on first item only when the list first appears
+        if (fresh && i == 0) {
+            lv_group_focus_obj(item_btn);
         }
+    }
 
-        // Trigger beep when PineAP detected on main screen
-        if (pineap_hunter_active) {
-            static unsigned long last_beep_time = 0;
-            static const unsigned long BEEP_INTERVAL = 1000;  // Beep every 1 second
-            unsigned long now = millis();
+    // Trigger beep when PineAP detected on main screen
+    if (pineap_hunter_active) {
+        static unsigned long last_beep_time = 0;
+        static const unsigned long BEEP_INTERVAL = 1000;  // Beep every 1 second
+        unsigned long now = millis();
 
-            if (now - last_beep_time >= BEEP_INTERVAL) {
-                // Simple beep using LEDC PWM - 1000Hz tone for 100ms
-                ledcSetup(0, 1000, 8);    // channel, freq, resolution
-                ledcAttachPin(7, 0);       // pin 7 (BOARD_VOICE_DIN), channel 0
-                ledcWrite(0, 128);         // 50% duty cycle
-                delay(100);
-                ledcWrite(0, 0);           // Stop tone
-                ledcDetachPin(7);          // Detach pin
+        if (now - last_beep_time >= BEEP_INTERVAL) {
+            // Simple beep using LEDC PWM - 1000Hz tone for 100ms
+            ledcSetup(0, 1000, 8);    // channel, freq, resolution
+            ledcAttachPin(7, 0);       // pin 7 (BOARD_VOICE_DIN), channel 0
+            ledcWrite(0, 128);         // 50% duty cycle
+            delay(100);
+            ledcWrite(0, 0);           // Stop tone
+            ledcDetachPin(7);          // Detach pin
 
-                last_beep_time = now;
-            }
+            last_beep_time = now;
         }
     }
 }
@@ -10093,7 +10482,7 @@ void pineap_draw_ssid_list() {
     String bssid_str = bssid_to_string(pine.bssid);
 
     // Update BSSID header
-    lv_label_set_text(pineap_detail_header, bssid_str.c_str());
+    pineap_set_label(pineap_detail_header, bssid_str.c_str());
 
     // Hide threshold button, show RSSI bar and label in detail view
     if (pineap_btn_threshold) lv_obj_add_flag(pineap_btn_threshold, LV_OBJ_FLAG_HIDDEN);
@@ -10108,15 +10497,24 @@ void pineap_draw_ssid_list() {
         lv_label_set_text_fmt(pineap_rssi_label, "RSSI: %d dBm", pine.rssi);
     }
 
-    // Clear existing list
-    lv_obj_clean(pineap_list_cont);
+    pineap_list_begin(PINEAP_DRAWN_SSIDS);
+    uint32_t have = pineap_list_trim(pine.essids.size());
 
     // List all SSIDs with RSSI - format: "[dBm] SSID_Name"
-    for (const auto& ssid_rec : pine.essids) {
+    for (size_t i = 0; i < pine.essids.size(); i++) {
+        const auto& ssid_rec = pine.essids[i];
+        char text[48];
+        snprintf(text, sizeof(text), "[%d] %s", ssid_rec.rssi, ssid_rec.essid.c_str());
+
+        if (i < have) {
+            pineap_set_label(lv_obj_get_child(pineap_list_cont, i), text);
+            continue;
+        }
+
         lv_obj_t *ssid_label = lv_label_create(pineap_list_cont);
         apply_text_color(ssid_label);
         lv_obj_set_style_text_font(ssid_label, FONT_LIGHT_14, LV_PART_MAIN);
-        lv_label_set_text_fmt(ssid_label, "[%d] %s", ssid_rec.rssi, ssid_rec.essid.c_str());
+        lv_label_set_text(ssid_label, text);
         lv_obj_set_width(ssid_label, lv_pct(100));
     }
 }
@@ -10151,15 +10549,16 @@ static void pineap_btn_start_event(lv_event_t *e) {
             lv_obj_set_style_bg_img_src(pineap_btn_start, &img_play_32, 0);
             WiFi.mode(WIFI_STA);
             WiFi.disconnect();
+            wifi_scan_set_sink(pineap_scan_sink);
+            wifi_scan_start(true);
             lv_timer_resume(pineap_update_timer);
         } else {
             // Stopped - show play icon
             lv_obj_set_style_bg_img_src(pineap_btn_start, &img_pause_32, 0);
+            wifi_scan_stop();
             lv_timer_pause(pineap_update_timer);
             // Turn LED off when stopped
             lv_led_off(pineap_scan_led);
-            lv_refr_now(NULL);
-            tft.drawPixel(0, 0, 0);
         }
     }
 }
@@ -10197,7 +10596,7 @@ static void pineap_btn_rssi_scale_event(lv_event_t *e) {
 
         // Save to config
         g_config.wifi.pineap.rssi_scale_dbm = pineap_rssi_scale_dbm;
-        config_save();
+        config_mark_dirty(CONFIG_DIRTY_WIFI);
     }
 }
 
@@ -10236,14 +10635,10 @@ static void create6_3(lv_obj_t *parent) {
     lv_obj_set_size(pineap_btn_start, 50, 50);
     lv_obj_align(pineap_btn_start, LV_ALIGN_TOP_LEFT, 8, 35);
     apply_bg_color(pineap_btn_start);
-    lv_obj_set_style_border_color(pineap_btn_start, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(pineap_btn_start, 1, LV_PART_MAIN);
+    apply_theme_border(pineap_btn_start);
     apply_no_shadow(pineap_btn_start);
     lv_obj_set_style_bg_img_src(pineap_btn_start, &img_pause_32, 0);
-    lv_obj_remove_style(pineap_btn_start, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(pineap_btn_start, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(pineap_btn_start, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(pineap_btn_start, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(pineap_btn_start);
     lv_obj_add_event_cb(pineap_btn_start, pineap_btn_start_event, LV_EVENT_CLICKED, NULL);
     lv_group_add_obj(lv_group_get_default(), pineap_btn_start);
 
@@ -10256,28 +10651,22 @@ static void create6_3(lv_obj_t *parent) {
 
     // Threshold label and button (right side, upper)
     lv_obj_t *thresh_label_text = lv_label_create(scr6_3_cont);
-    apply_text_color(thresh_label_text);
-    lv_obj_set_style_text_font(thresh_label_text, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(thresh_label_text);
     lv_label_set_text(thresh_label_text, "Threshold:");
     lv_obj_align(thresh_label_text, LV_ALIGN_TOP_RIGHT, -80, 38);
 
     pineap_btn_threshold = lv_btn_create(scr6_3_cont);
     lv_obj_set_size(pineap_btn_threshold, 50, 28);
     lv_obj_align(pineap_btn_threshold, LV_ALIGN_TOP_RIGHT, -15, 33);
-    lv_obj_set_style_border_color(pineap_btn_threshold, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(pineap_btn_threshold, 1, LV_PART_MAIN);
+    apply_theme_border(pineap_btn_threshold);
     apply_no_shadow(pineap_btn_threshold);
     apply_bg_color(pineap_btn_threshold);
-    lv_obj_remove_style(pineap_btn_threshold, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(pineap_btn_threshold, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(pineap_btn_threshold, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(pineap_btn_threshold, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(pineap_btn_threshold);
     lv_obj_add_event_cb(pineap_btn_threshold, pineap_btn_threshold_event, LV_EVENT_CLICKED, NULL);
     lv_group_add_obj(lv_group_get_default(), pineap_btn_threshold);
 
     pineap_threshold_label = lv_label_create(pineap_btn_threshold);
-    apply_text_color(pineap_threshold_label);
-    lv_obj_set_style_text_font(pineap_threshold_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(pineap_threshold_label);
     lv_label_set_text_fmt(pineap_threshold_label, "%d", pineap_ssid_threshold);
     lv_obj_center(pineap_threshold_label);
 
@@ -10289,14 +10678,12 @@ static void create6_3(lv_obj_t *parent) {
     lv_bar_set_value(pineap_rssi_bar, 0, LV_ANIM_OFF);
     apply_bg_color(pineap_rssi_bar);
     lv_obj_set_style_bg_color(pineap_rssi_bar, lv_color_hex(0x00FF00), LV_PART_INDICATOR);
-    lv_obj_set_style_border_color(pineap_rssi_bar, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(pineap_rssi_bar, 1, LV_PART_MAIN);
+    apply_theme_border(pineap_rssi_bar);
     lv_obj_add_flag(pineap_rssi_bar, LV_OBJ_FLAG_HIDDEN);  // Hidden initially
 
     // RSSI dBm label overlay (centered on the RSSI bar)
     pineap_rssi_label = lv_label_create(scr6_3_cont);
-    apply_text_color(pineap_rssi_label);
-    lv_obj_set_style_text_font(pineap_rssi_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(pineap_rssi_label);
     lv_label_set_text(pineap_rssi_label, "RSSI: --- dBm");
     lv_obj_align(pineap_rssi_label, LV_ALIGN_TOP_LEFT, 150, 40);
     // Add semi-transparent background for better readability
@@ -10308,28 +10695,22 @@ static void create6_3(lv_obj_t *parent) {
 
     // Scale label and button (right side, lower - 4px down from threshold)
     lv_obj_t *scale_label_text = lv_label_create(scr6_3_cont);
-    apply_text_color(scale_label_text);
-    lv_obj_set_style_text_font(scale_label_text, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(scale_label_text);
     lv_label_set_text(scale_label_text, "Scale:");
     lv_obj_align(scale_label_text, LV_ALIGN_TOP_RIGHT, -95, 70);
 
     pineap_btn_rssi_scale = lv_btn_create(scr6_3_cont);
     lv_obj_set_size(pineap_btn_rssi_scale, 70, 28);
     lv_obj_align(pineap_btn_rssi_scale, LV_ALIGN_TOP_RIGHT, -15, 65);
-    lv_obj_set_style_border_color(pineap_btn_rssi_scale, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(pineap_btn_rssi_scale, 1, LV_PART_MAIN);
+    apply_theme_border(pineap_btn_rssi_scale);
     apply_no_shadow(pineap_btn_rssi_scale);
     apply_bg_color(pineap_btn_rssi_scale);
-    lv_obj_remove_style(pineap_btn_rssi_scale, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(pineap_btn_rssi_scale, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(pineap_btn_rssi_scale, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(pineap_btn_rssi_scale, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(pineap_btn_rssi_scale);
     lv_obj_add_event_cb(pineap_btn_rssi_scale, pineap_btn_rssi_scale_event, LV_EVENT_CLICKED, NULL);
     lv_group_add_obj(lv_group_get_default(), pineap_btn_rssi_scale);
 
     pineap_rssi_scale_label = lv_label_create(pineap_btn_rssi_scale);
-    apply_text_color(pineap_rssi_scale_label);
-    lv_obj_set_style_text_font(pineap_rssi_scale_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(pineap_rssi_scale_label);
     lv_label_set_text_fmt(pineap_rssi_scale_label, "%d dBm", pineap_rssi_scale_dbm);
     lv_obj_center(pineap_rssi_scale_label);
 
@@ -10338,8 +10719,7 @@ static void create6_3(lv_obj_t *parent) {
     lv_obj_set_size(pineap_list_cont, 305, 145);  // Extended height to reach bottom
     lv_obj_align(pineap_list_cont, LV_ALIGN_TOP_MID, 0, 95);
     apply_bg_color(pineap_list_cont);
-    lv_obj_set_style_border_color(pineap_list_cont, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(pineap_list_cont, 1, LV_PART_MAIN);
+    apply_theme_border(pineap_list_cont);
     lv_obj_set_flex_flow(pineap_list_cont, LV_FLEX_FLOW_COLUMN);
     lv_obj_set_flex_align(pineap_list_cont, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
     lv_obj_set_style_pad_all(pineap_list_cont, 2, LV_PART_MAIN);
@@ -10369,6 +10749,7 @@ static void enter6_3(void) {
     if (pineap_list_cont) {
         lv_obj_clean(pineap_list_cont);
     }
+    pineap_drawn = PINEAP_DRAWN_NONE;
 
     lv_group_set_wrap(lv_group_get_default(), true);
     lv_group_focus_obj(pineap_btn_start);
@@ -10381,8 +10762,9 @@ static void exit6_3(void) {
     // Stop monitoring if active
     if (pineap_hunter_active) {
         pineap_hunter_active = false;
-        WiFi.scanDelete();
+        wifi_scan_stop();
     }
+    wifi_scan_set_sink(NULL);
 
     // Pause timer
     if (pineap_update_timer) {
@@ -10401,13 +10783,16 @@ static void destroy6_3(void) {
     // Stop monitoring
     if (pineap_hunter_active) {
         pineap_hunter_active = false;
-        WiFi.scanDelete();
+        wifi_scan_stop();
     }
+    wifi_scan_set_sink(NULL);
 
     // Clear data
     pineap_stats.detected_pineaps.clear();
     pineap_stats.scan_buffer.clear();
 
+    pineap_drawn = PINEAP_DRAWN_NONE;
+
     if (scr6_3_cont) {
         lv_obj_del(scr6_3_cont);
         scr6_3_cont = NULL;
@@ -10638,15 +11023,12 @@ void create7(lv_obj_t *parent){
         apply_bg_color(btn);
         apply_no_border(btn);
         apply_no_shadow(btn);
-        lv_obj_remove_style(btn, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(btn, 2, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+        apply_focus_outline(btn);
         lv_obj_set_style_bg_img_opa(btn, LV_OPA_100, LV_PART_MAIN);
         add_menu_button_events(btn, ir_btn_event_cb, (void *)(intptr_t)i);
 
         lv_obj_t *label = lv_label_create(btn);
-        apply_text_color(label);
-        lv_obj_set_style_text_font(label, FONT_BOLD_14, LV_PART_MAIN);
+        apply_label_style(label);
         lv_label_set_text(label, ir_menu_items[i]);
 
         lv_group_add_obj(lv_group_get_default(), btn);
@@ -10852,8 +11234,7 @@ static void create7_1(lv_obj_t *parent)
 
     // Progress label (above progress bar)
     tvbg_progress_label = lv_label_create(scr7_1_cont);
-    apply_text_color(tvbg_progress_label);
-    lv_obj_set_style_text_font(tvbg_progress_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(tvbg_progress_label);
     lv_label_set_text(tvbg_progress_label, "Ready");
     lv_obj_align(tvbg_progress_label, LV_ALIGN_CENTER, 0, -50);
 
@@ -10861,18 +11242,13 @@ static void create7_1(lv_obj_t *parent)
     tvbg_btn_emea = lv_btn_create(scr7_1_cont);
     lv_obj_set_size(tvbg_btn_emea, 100, 40);
     lv_obj_align(tvbg_btn_emea, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
-    lv_obj_set_style_border_color(tvbg_btn_emea, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(tvbg_btn_emea, 1, LV_PART_MAIN);
+    apply_theme_border(tvbg_btn_emea);
     apply_no_shadow(tvbg_btn_emea);
     apply_bg_color(tvbg_btn_emea);
-    lv_obj_remove_style(tvbg_btn_emea, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(tvbg_btn_emea, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(tvbg_btn_emea, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(tvbg_btn_emea, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(tvbg_btn_emea);
     lv_obj_add_event_cb(tvbg_btn_emea, tvbg_btn_emea_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *btn_label = lv_label_create(tvbg_btn_emea);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "EMEA");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), tvbg_btn_emea);
@@ -10881,18 +11257,13 @@ static void create7_1(lv_obj_t *parent)
     tvbg_btn_americas = lv_btn_create(scr7_1_cont);
     lv_obj_set_size(tvbg_btn_americas, 100, 40);
     lv_obj_align(tvbg_btn_americas, LV_ALIGN_BOTTOM_LEFT, 10, -10);
-    lv_obj_set_style_border_color(tvbg_btn_americas, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(tvbg_btn_americas, 1, LV_PART_MAIN);
+    apply_theme_border(tvbg_btn_americas);
     apply_no_shadow(tvbg_btn_americas);
     apply_bg_color(tvbg_btn_americas);
-    lv_obj_remove_style(tvbg_btn_americas, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(tvbg_btn_americas, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(tvbg_btn_americas, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(tvbg_btn_americas, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(tvbg_btn_americas);
     lv_obj_add_event_cb(tvbg_btn_americas, tvbg_btn_americas_event, LV_EVENT_CLICKED, NULL);
     btn_label = lv_label_create(tvbg_btn_americas);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Americas");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), tvbg_btn_americas);
@@ -11351,8 +11722,7 @@ void ir_playback_show_buttons()
     for(int i = 0; i < lv_obj_get_child_cnt(ir_playback_file_list); i++) {
         lv_obj_t *item = lv_obj_get_child(ir_playback_file_list, i);
         apply_bg_color(item);
-        apply_text_color(item);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
+        apply_label_style(item);
         lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
         lv_obj_set_style_radius(item, 5, LV_STATE_FOCUS_KEY);
         lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
@@ -11635,13 +12005,7 @@ void ir_playback_load_directory(const char *path)
     // Apply theme colors to all list items and add to group
     for(int i = 0; i < lv_obj_get_child_cnt(ir_playback_file_list); i++) {
         lv_obj_t *item = lv_obj_get_child(ir_playback_file_list, i);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-        apply_bg_color(item);
-        apply_text_color(item);
-        lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_radius(item, 5, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+        apply_list_btn_style(item);
         lv_group_add_obj(lv_group_get_default(), item);
     }
 
@@ -11685,8 +12049,7 @@ static void create7_3(lv_obj_t *parent)
 
     // Path label
     ir_playback_path_label = lv_label_create(scr7_3_cont);
-    apply_text_color(ir_playback_path_label);
-    lv_obj_set_style_text_font(ir_playback_path_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(ir_playback_path_label);
     lv_label_set_text(ir_playback_path_label, "Path: /ir");
     //lv_obj_set_width(ir_playback_path_label, 200);
     lv_obj_set_width(ir_playback_path_label, 160);
@@ -12064,31 +12427,27 @@ static void create7_4(lv_obj_t *parent)
 
     // Status label
     capture_status_label = lv_label_create(scr7_4_cont);
-    apply_text_color(capture_status_label);
-    lv_obj_set_style_text_font(capture_status_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(capture_status_label);
     lv_label_set_text(capture_status_label, "Status: Ready");
     lv_obj_align(capture_status_label, LV_ALIGN_TOP_LEFT, 10, 46);
 
     // Protocol label
     capture_protocol_label = lv_label_create(scr7_4_cont);
-    apply_text_color(capture_protocol_label);
-    lv_obj_set_style_text_font(capture_protocol_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(capture_protocol_label);
     lv_label_set_text(capture_protocol_label, "Protocol: ---");
     lv_obj_align(capture_protocol_label, LV_ALIGN_TOP_LEFT, 10, 70);
 
     // Data label
     capture_data_label = lv_label_create(scr7_4_cont);
     lv_obj_set_width(capture_data_label, DISPALY_WIDTH - 20);
-    apply_text_color(capture_data_label);
-    lv_obj_set_style_text_font(capture_data_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(capture_data_label);
     lv_label_set_text(capture_data_label, "Data: ---");
     lv_obj_align(capture_data_label, LV_ALIGN_TOP_LEFT, 10, 94);
 
     // Button Name label
     capture_name_label = lv_label_create(scr7_4_cont);
     lv_obj_set_width(capture_name_label, DISPALY_WIDTH - 20);
-    apply_text_color(capture_name_label);
-    lv_obj_set_style_text_font(capture_name_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(capture_name_label);
     lv_label_set_text(capture_name_label, "Name: ---");
     lv_obj_align(capture_name_label, LV_ALIGN_TOP_LEFT, 10, 118);
 
@@ -12096,18 +12455,13 @@ static void create7_4(lv_obj_t *parent)
     capture_btn_capture = lv_btn_create(scr7_4_cont);
     lv_obj_set_size(capture_btn_capture, 100, 30);
     lv_obj_align(capture_btn_capture, LV_ALIGN_TOP_RIGHT, -10, 30);
-    lv_obj_set_style_border_color(capture_btn_capture, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(capture_btn_capture, 1, LV_PART_MAIN);
+    apply_theme_border(capture_btn_capture);
     apply_no_shadow(capture_btn_capture);
     apply_bg_color(capture_btn_capture);
-    lv_obj_remove_style(capture_btn_capture, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(capture_btn_capture, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(capture_btn_capture, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(capture_btn_capture, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(capture_btn_capture);
     lv_obj_add_event_cb(capture_btn_capture, capture_btn_capture_event, LV_EVENT_CLICKED, NULL);
     lv_obj_t *btn_label = lv_label_create(capture_btn_capture);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Capture");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), capture_btn_capture);
@@ -12116,18 +12470,13 @@ static void create7_4(lv_obj_t *parent)
     capture_btn_test = lv_btn_create(scr7_4_cont);
     lv_obj_set_size(capture_btn_test, 100, 30);
     lv_obj_align(capture_btn_test, LV_ALIGN_TOP_RIGHT, -10, 65);
-    lv_obj_set_style_border_color(capture_btn_test, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(capture_btn_test, 1, LV_PART_MAIN);
+    apply_theme_border(capture_btn_test);
     apply_no_shadow(capture_btn_test);
     apply_bg_color(capture_btn_test);
-    lv_obj_remove_style(capture_btn_test, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(capture_btn_test, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(capture_btn_test, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(capture_btn_test, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(capture_btn_test);
     lv_obj_add_event_cb(capture_btn_test, capture_btn_test_event, LV_EVENT_CLICKED, NULL);
     btn_label = lv_label_create(capture_btn_test);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Test");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), capture_btn_test);
@@ -12136,18 +12485,13 @@ static void create7_4(lv_obj_t *parent)
     capture_btn_name = lv_btn_create(scr7_4_cont);
     lv_obj_set_size(capture_btn_name, 100, 30);
     lv_obj_align(capture_btn_name, LV_ALIGN_TOP_RIGHT, -10, 100);
-    lv_obj_set_style_border_color(capture_btn_name, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(capture_btn_name, 1, LV_PART_MAIN);
+    apply_theme_border(capture_btn_name);
     apply_no_shadow(capture_btn_name);
     apply_bg_color(capture_btn_name);
-    lv_obj_remove_style(capture_btn_name, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(capture_btn_name, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(capture_btn_name, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(capture_btn_name, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(capture_btn_name);
     lv_obj_add_event_cb(capture_btn_name, capture_btn_name_event, LV_EVENT_CLICKED, NULL);
     btn_label = lv_label_create(capture_btn_name);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Name");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), capture_btn_name);
@@ -12156,18 +12500,13 @@ static void create7_4(lv_obj_t *parent)
     capture_btn_save = lv_btn_create(scr7_4_cont);
     lv_obj_set_size(capture_btn_save, 100, 30);
     lv_obj_align(capture_btn_save, LV_ALIGN_TOP_RIGHT, -10, 135);
-    lv_obj_set_style_border_color(capture_btn_save, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(capture_btn_save, 1, LV_PART_MAIN);
+    apply_theme_border(capture_btn_save);
     apply_no_shadow(capture_btn_save);
     apply_bg_color(capture_btn_save);
-    lv_obj_remove_style(capture_btn_save, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(capture_btn_save, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(capture_btn_save, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(capture_btn_save, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(capture_btn_save);
     lv_obj_add_event_cb(capture_btn_save, capture_btn_save_event, LV_EVENT_CLICKED, NULL);
     btn_label = lv_label_create(capture_btn_save);
-    apply_text_color(btn_label);
-    lv_obj_set_style_text_font(btn_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(btn_label);
     lv_label_set_text(btn_label, "Save");
     lv_obj_center(btn_label);
     lv_group_add_obj(lv_group_get_default(), capture_btn_save);
@@ -12307,33 +12646,9 @@ static void scr11_btn_event_cb(lv_event_t * e)
     }
 }
 
-// Read audio samples from I2S microphone
+// Latest microphone samples from the mic task's ring (peri_mic.cpp)
 bool read_audio_samples(float *buffer, size_t num_samples) {
-    size_t bytes_read = 0;
-    int16_t *i2s_buffer = (int16_t *)malloc(num_samples * sizeof(int16_t));
-    if (!i2s_buffer) {
-        return false;
-    }
-
-    esp_err_t result = i2s_read(
-        (i2s_port_t)EXAMPLE_I2S_CH,
-        i2s_buffer,
-        num_samples * sizeof(int16_t),
-        &bytes_read,
-        pdMS_TO_TICKS(100)
-    );
-
-    if (result == ESP_OK && bytes_read > 0) {
-        size_t samples_read = bytes_read / sizeof(int16_t);
-        // Convert int16_t to float and normalize to -1.0 to 1.0
-        for (size_t i = 0; i < samples_read && i < num_samples; i++) {
-            buffer[i] = (float)i2s_buffer[i] / 32768.0f;
-        }
-        free(i2s_buffer);
-        return true;
-    }
-    free(i2s_buffer);
-    return false;
+    return mic_get_samples(buffer, num_samples) == num_samples;
 }
 
 // Convert FFT magnitude to color (heatmap style)
@@ -12487,15 +12802,13 @@ void create11(lv_obj_t *parent)
 
     // Frequency range label (bottom left)
     audio_freq_label = lv_label_create(scr11_cont);
-    apply_text_color(audio_freq_label);
-    lv_obj_set_style_text_font(audio_freq_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(audio_freq_label);
     lv_label_set_text(audio_freq_label, "20 Hz - 16 kHz");
     lv_obj_align(audio_freq_label, LV_ALIGN_BOTTOM_LEFT, 10, -5);
 
     // Amplitude label (bottom right)
     audio_amplitude_label = lv_label_create(scr11_cont);
-    apply_text_color(audio_amplitude_label);
-    lv_obj_set_style_text_font(audio_amplitude_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(audio_amplitude_label);
     lv_label_set_text(audio_amplitude_label, "Peak: 0.0");
     lv_obj_align(audio_amplitude_label, LV_ALIGN_BOTTOM_RIGHT, -10, -5);
 
@@ -12653,8 +12966,7 @@ void create10(lv_obj_t *parent)
 
     sd_err_info = lv_label_create(scr10_cont);
     lv_obj_set_width(sd_err_info, DISPALY_WIDTH * 0.9);
-    apply_text_color(sd_err_info);
-    lv_obj_set_style_text_font(sd_err_info, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(sd_err_info);
     lv_label_set_long_mode(sd_err_info, LV_LABEL_LONG_WRAP);
 
     static lv_style_t style_bg;
@@ -12679,24 +12991,21 @@ void create10(lv_obj_t *parent)
 
     sd_used = lv_label_create(scr10_cont);
     lv_obj_set_width(sd_used, DISPALY_WIDTH * 0.42);
-    apply_text_color(sd_used);
-    lv_obj_set_style_text_font(sd_used, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(sd_used);
     lv_label_set_long_mode(sd_used, LV_LABEL_LONG_CLIP);
     lv_obj_set_style_text_align(sd_used, LV_TEXT_ALIGN_LEFT, LV_PART_MAIN);
     lv_obj_align_to(sd_used, sd_slider, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 8);
 
     sd_total = lv_label_create(scr10_cont);
     lv_obj_set_width(sd_total, DISPALY_WIDTH * 0.42);
-    apply_text_color(sd_total);
-    lv_obj_set_style_text_font(sd_total, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(sd_total);
     lv_label_set_long_mode(sd_total, LV_LABEL_LONG_CLIP);
     lv_obj_set_style_text_align(sd_total, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN);
     lv_obj_align_to(sd_total, sd_slider, LV_ALIGN_OUT_BOTTOM_RIGHT, 0, 8);
 
     // Status label (positioned below title)
     sd_status_label = lv_label_create(scr10_cont);
-    apply_text_color(sd_status_label);
-    lv_obj_set_style_text_font(sd_status_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(sd_status_label);
     lv_obj_align(sd_status_label, LV_ALIGN_TOP_MID, 0, 45);
 
     // Mount button (lower left corner when unmounted)
@@ -12709,8 +13018,7 @@ void create10(lv_obj_t *parent)
     lv_obj_set_style_outline_width(sd_mount_btn, 2, LV_STATE_FOCUS_KEY);
     lv_obj_t *mount_lab = lv_label_create(sd_mount_btn);
     lv_label_set_text(mount_lab, "Mount");
-    apply_text_color(mount_lab);
-    lv_obj_set_style_text_font(mount_lab, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(mount_lab);
     lv_obj_center(mount_lab);
     lv_obj_add_event_cb(sd_mount_btn, sd_mount_event_cb, LV_EVENT_CLICKED, NULL);
 
@@ -12724,8 +13032,7 @@ void create10(lv_obj_t *parent)
     lv_obj_set_style_outline_width(sd_browse_btn, 2, LV_STATE_FOCUS_KEY);
     lv_obj_t *browse_lab = lv_label_create(sd_browse_btn);
     lv_label_set_text(browse_lab, "Browse");
-    apply_text_color(browse_lab);
-    lv_obj_set_style_text_font(browse_lab, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(browse_lab);
     lv_obj_center(browse_lab);
     lv_obj_add_event_cb(sd_browse_btn, sd_browse_event_cb, LV_EVENT_CLICKED, NULL);
 
@@ -12739,8 +13046,7 @@ void create10(lv_obj_t *parent)
     lv_obj_set_style_outline_width(sd_unmount_btn, 2, LV_STATE_FOCUS_KEY);
     lv_obj_t *unmount_lab = lv_label_create(sd_unmount_btn);
     lv_label_set_text(unmount_lab, "Unmount");
-    apply_text_color(unmount_lab);
-    lv_obj_set_style_text_font(unmount_lab, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(unmount_lab);
     lv_obj_center(unmount_lab);
     lv_obj_add_event_cb(sd_unmount_btn, sd_unmount_event_cb, LV_EVENT_CLICKED, NULL);
 
@@ -12814,9 +13120,6 @@ scr_lifecycle_t screen10 = {
 #endif
 // --------------------- screen 11.1 --------------------- File Browser
 #if 1
-#include "Audio.h"
-extern Audio audio;
-
 lv_obj_t *scr10_1_cont;
 lv_obj_t *fb_path_label;
 lv_obj_t *fb_file_list;
@@ -13391,10 +13694,10 @@ static void fb_list_event(lv_event_t *e)
                         // MP3 file - navigate to audio playback screen
 
                         // Stop any currently playing audio
-                        audio.stopSong();
+                        audio_stop();
 
                         // Start playing the selected file
-                        if(audio.connecttoFS(SD, full_path)) {
+                        if(audio_play(SD, full_path)) {
                             // Remember which file is playing
                             strncpy(fb_playing_file, full_path, sizeof(fb_playing_file) - 1);
                             fb_playing_file[sizeof(fb_playing_file) - 1] = '\0';
@@ -13584,13 +13887,7 @@ void fb_load_directory(const char *path)
     // Style all list items
     for(int i = 0; i < lv_obj_get_child_cnt(fb_file_list); i++) {
         lv_obj_t *item = lv_obj_get_child(fb_file_list, i);
-        lv_obj_set_style_text_font(item, FONT_BOLD_14, LV_PART_MAIN);
-        apply_bg_color(item);
-        apply_text_color(item);
-        lv_obj_remove_style(item, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_radius(item, 5, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(item, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(item, 2, LV_STATE_FOCUS_KEY);
+        apply_list_btn_style(item);
     }
 
     // Turn off activity LED
@@ -13615,8 +13912,7 @@ void create10_1(lv_obj_t *parent)
 
     fb_path_label = lv_label_create(scr10_1_cont);
     lv_obj_set_width(fb_path_label, DISPALY_WIDTH * 0.9);
-    apply_text_color(fb_path_label);
-    lv_obj_set_style_text_font(fb_path_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(fb_path_label);
     lv_label_set_long_mode(fb_path_label, LV_LABEL_LONG_SCROLL_CIRCULAR);
     lv_obj_align(fb_path_label, LV_ALIGN_TOP_LEFT, 10, 35);
 
@@ -13668,7 +13964,7 @@ static void scr10_2_btn_event_cb(lv_event_t * e)
 {
     if(e->code == LV_EVENT_CLICKED){
         // Stop playback and return to file browser
-        audio.stopSong();
+        audio_stop();
         fb_audio_playing_file[0] = '\0';
         fb_playing_file[0] = '\0';  // Clear file browser tracking too
 
@@ -13677,7 +13973,7 @@ static void scr10_2_btn_event_cb(lv_event_t * e)
         extern uint8_t current_volume;
         if(volume_changed_during_playback) {
             g_config.audio.volume = current_volume;
-            config_save();
+            config_mark_dirty(CONFIG_DIRTY_AUDIO);
             volume_changed_during_playback = false;
         }
 
@@ -13690,8 +13986,7 @@ void create10_2(lv_obj_t *parent)
     scr10_2_cont = create_screen_container(parent);
 
     lv_obj_t *label = lv_label_create(scr10_2_cont);
-    apply_text_color(label);
-    lv_obj_set_style_text_font(label, FONT_BOLD_20, LV_PART_MAIN);
+    apply_title_style(label);
     lv_label_set_text(label, "Now Playing");
     lv_obj_align(label, LV_ALIGN_TOP_MID, 0, 10);
 
@@ -13950,10 +14245,6 @@ scr_lifecycle_t screen10_3 = {
 #endif
 //************************************[ screen 8 ]****************************************** music 
 #if 1
-#include "Audio.h"
-extern Audio audio;
-extern void scr8_read_music_from_SD(void);
-
 static lv_obj_t *scr8_cont;
 lv_obj_t *music_lab;
 lv_obj_t *pause_btn;
@@ -13962,10 +14253,9 @@ static lv_obj_t *prev_btn;
 static lv_obj_t *mic_led;
 bool music_is_running = false;
 static lv_timer_t *mic_chk_timer = NULL;
-static lv_timer_t *music_load_timer = NULL;
-static lv_timer_t *music_refresh_timer = NULL;
+static lv_timer_t *music_index_timer = NULL;
+static bool music_index_started = false;
 int music_idx = 0;
-std::vector<String> music_list;
 volatile bool music_label_needs_update = false;  // Flag for safe LVGL updates from audio callback
 
 void entry8_anim(lv_obj_t *obj)
@@ -13978,78 +14268,50 @@ void exit8_anim(int user_data, lv_obj_t *obj)
     exit1_anim(user_data, obj);
 }
 
-// Forward declarations
-void mic_chk_timer_event(lv_timer_t *t);
-
-// Timer to force display refresh after loading completes
-void music_refresh_timer_event(lv_timer_t *t)
-{
-    if(music_refresh_timer) {
-        lv_timer_del(music_refresh_timer);
-        music_refresh_timer = NULL;
-    }
-
-    // Force a complete display refresh
-    lv_obj_invalidate(lv_scr_act());
-}
-
-// Timer callback to load music files after screen is visible
-void music_load_timer_event(lv_timer_t *t)
+// Show the current track, or the indexing state while the list is unknown
+static void music_show_current(void)
 {
-    // This is a one-shot timer, delete it first
-    if(music_load_timer) {
-        lv_timer_del(music_load_timer);
-        music_load_timer = NULL;
-    }
+    char name[MUSIC_INDEX_NAME_LEN];
+    int count = music_index_count();
 
-    // Safety check: ensure widgets are created
-    if(!music_lab || !mic_led) {
+    if(count <= 0) {
+        if(music_index_is_busy()) {
+            lv_label_set_text_fmt(music_lab, "Indexing... %d", music_index_progress());
+        } else {
+            lv_label_set_text(music_lab, "NO MUSIC FILES");
+        }
         return;
     }
 
-    // Delete mic_chk_timer temporarily to prevent interference
-    if(mic_chk_timer) {
-        lv_timer_del(mic_chk_timer);
-        mic_chk_timer = NULL;
+    if(music_idx >= count) {
+        music_idx = 0;
     }
+    if(music_index_get_name(music_idx, name, sizeof(name))) {
+        lv_label_set_text(music_lab, name);
+    }
+}
 
-    // Show loading indicator
-    lv_led_on(mic_led);
-
-    // Load files
-    scr8_read_music_from_SD();
-
-    // Update label
-    if(music_list.empty()) {
-        lv_label_set_text(music_lab, "NO MUSIC FILES");
-    } else {
-        if(music_idx >= music_list.size()) {
-            music_idx = 0;
-        }
-        if(music_idx < music_list.size()) {
-            lv_label_set_text(music_lab, music_list[music_idx].c_str());
+// Polls the background indexer; the cached list stays usable meanwhile
+static void music_index_timer_event(lv_timer_t *t)
+{
+    if(music_index_is_busy()) {
+        if(music_index_count() <= 0) {
+            music_show_current();
         }
+        return;
     }
 
-    // Turn off indicator
-    lv_led_off(mic_led);
-
-    // Recreate mic_chk_timer to resume normal operation
-    mic_chk_timer = lv_timer_create(mic_chk_timer_event, 10, NULL);
-
-    // Create a one-shot timer to force refresh after we exit this callback
-    // This ensures refresh happens outside of the timer handler call stack
-    music_refresh_timer = lv_timer_create(music_refresh_timer_event, 50, NULL);
-    lv_timer_set_repeat_count(music_refresh_timer, 1);
-
+    if(!music_is_running) {
+        music_show_current();
+    }
+    lv_timer_del(music_index_timer);
+    music_index_timer = NULL;
 }
 
-extern int i2s_mic_cnt;
 void mic_chk_timer_event(lv_timer_t *t)
 {
-    if(i2s_mic_cnt > 3)
+    if(mic_is_active())
     {
-        i2s_mic_cnt = 0;
         lv_led_on(mic_led);
     } else 
     {
@@ -14065,31 +14327,34 @@ void save_volume_if_changed()
 
     if(volume_changed_during_playback) {
         g_config.audio.volume = current_volume;
-        config_save();
+        config_mark_dirty(CONFIG_DIRTY_AUDIO);
         volume_changed_during_playback = false;
     }
 }
 
 void music_player_event(lv_event_t * e)
 {
-    char buf[64];
+    char buf[MUSIC_INDEX_NAME_LEN + 32];
     lv_obj_t *tgt = (lv_obj_t *)e->target;
+    int count = music_index_count();
 
-    // Safety check: don't process events if music_list is empty
-    if(music_list.empty()) {
+    // Safety check: don't process events until the playlist is known
+    if(count <= 0) {
         return;
     }
 
     // Ensure music_idx is valid
-    if(music_idx >= music_list.size()) {
+    if(music_idx >= count) {
         music_idx = 0;
     }
 
     if(e->code == LV_EVENT_CLICKED) {
         if(tgt == pause_btn) {
             if(music_is_running == false) {
-                lv_snprintf(buf, 64, "/music/%s", music_list[music_idx].c_str());
-                audio.connecttoFS(SD, buf);
+                if(!music_index_get_path(music_idx, buf, sizeof(buf))) {
+                    return;
+                }
+                audio_play(SD, buf);
                 music_is_running = true;
                 lv_obj_set_style_bg_img_src(pause_btn, &img_play_32, 0);
                 lv_port_indev_enabled(false);
@@ -14100,7 +14365,7 @@ void music_player_event(lv_event_t * e)
                 extern int indev_encoder_pos;
                 last_encoder_pos = indev_encoder_pos;
             } else {
-                audio.stopSong();
+                audio_stop();
                 music_is_running = false;
                 lv_port_indev_enabled(true);
                 lv_obj_set_style_bg_img_src(pause_btn, &img_pause_32, 0);
@@ -14108,16 +14373,16 @@ void music_player_event(lv_event_t * e)
                 save_volume_if_changed();
             }
         } else if(tgt == next_btn) {
-            if(music_idx + 1 < music_list.size()) {
+            if(music_idx + 1 < count) {
                 music_idx++;
-                lv_label_set_text(music_lab, music_list[music_idx].c_str());
+                music_show_current();
                 lv_obj_invalidate(music_lab);  // Force redraw
                 lv_refr_now(NULL);             // Immediate refresh
             }
         } else if(tgt == prev_btn) {
             if(music_idx > 0) {
                 music_idx--;
-                lv_label_set_text(music_lab, music_list[music_idx].c_str());
+                music_show_current();
                 lv_obj_invalidate(music_lab);  // Force redraw
                 lv_refr_now(NULL);             // Immediate refresh
             }
@@ -14128,7 +14393,7 @@ void music_player_event(lv_event_t * e)
 static void scr8_btn_event_cb(lv_event_t * e)
 {
     if(e->code == LV_EVENT_CLICKED){
-        audio.stopSong();
+        audio_stop();
         music_is_running = false;
         lv_port_indev_enabled(true);
         save_volume_if_changed();
@@ -14143,10 +14408,7 @@ static lv_obj_t * scr8_music_btn_create(void)
     apply_no_border(btn);
     apply_no_shadow(btn);
     lv_obj_set_style_radius(btn, 10, 0);
-    lv_obj_remove_style(btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(btn);
     lv_obj_add_event_cb(btn, music_player_event, LV_EVENT_CLICKED, NULL);
     return btn;
 }
@@ -14176,11 +14438,7 @@ static void create8(lv_obj_t *parent) {
         goto CREATE8_END;
     }
 
-    if(music_list.empty()) {
-        lv_label_set_text(music_lab, "Loading...");
-    } else {
-        lv_label_set_text(music_lab, music_list[music_idx].c_str());
-    }
+    lv_label_set_text(music_lab, "Loading...");
 
     next_btn = scr8_music_btn_create();
     lv_obj_set_style_bg_img_src(next_btn, &img_next_32, 0);
@@ -14203,19 +14461,23 @@ static void entry8(void) {
     music_is_running = false;
     mic_chk_timer = lv_timer_create(mic_chk_timer_event, 10, NULL);
 
-    // Load music files on first entry (use timer to wait for screen to be visible)
-    if(music_list.empty() && sd_is_valid()) {
-        // Create a one-shot timer to load music after 500ms (screen transition complete)
-        music_load_timer = lv_timer_create(music_load_timer_event, 500, NULL);
-        lv_timer_set_repeat_count(music_load_timer, 1);
-    } else if(!music_list.empty() && music_lab) {
-        // Update label on subsequent entries
-        if(music_idx >= music_list.size()) {
-            music_idx = 0;
-        }
-        if(music_idx < music_list.size()) {
-            lv_label_set_text(music_lab, music_list[music_idx].c_str());
-        }
+    if(!sd_is_valid() || !music_lab) {
+        return;
+    }
+
+    // Last session's index makes the list usable immediately; a fresh one
+    // is built in the background once per boot and swapped in when done
+    if(music_index_count() < 0) {
+        music_index_open();
+    }
+    if(!music_index_started) {
+        music_index_started = true;
+        music_index_rebuild();
+    }
+    music_show_current();
+
+    if(music_index_is_busy()) {
+        music_index_timer = lv_timer_create(music_index_timer_event, 200, NULL);
     }
 }
 static void exit8(void) {
@@ -14223,13 +14485,9 @@ static void exit8(void) {
         lv_timer_del(mic_chk_timer);
         mic_chk_timer = NULL;
     }
-    if(music_load_timer) {
-        lv_timer_del(music_load_timer);
-        music_load_timer = NULL;
-    }
-    if(music_refresh_timer) {
-        lv_timer_del(music_refresh_timer);
-        music_refresh_timer = NULL;
+    if(music_index_timer) {
+        lv_timer_del(music_index_timer);
+        music_index_timer = NULL;
     }
 }
 static void destroy8(void) { 
@@ -14253,11 +14511,29 @@ lv_timer_t *nrf24_timer;
 
 int nrf24_cont = 0;
 
+// Sweep view: occupancy bars on top, waterfall (one row per pass) below
+#define NRF24_SWEEP_PX          2       // Pixels per channel
+#define NRF24_SWEEP_WIDTH       (NRF24_CHANNELS * NRF24_SWEEP_PX)
+#define NRF24_BAR_HEIGHT        40
+#define NRF24_WF_HEIGHT         NRF24_WATERFALL_ROWS
+#define NRF24_SWEEP_UPDATE_MS   100
+
+lv_obj_t *nrf24_bar_canvas = NULL;
+lv_obj_t *nrf24_wf_canvas = NULL;
+lv_timer_t *nrf24_sweep_timer = NULL;
+uint8_t *nrf24_bar_buf = NULL;
+uint8_t *nrf24_wf_buf = NULL;
+uint32_t nrf24_sweep_drawn = 0;         // Last pass drawn into the waterfall
+int nrf24_wf_row = 0;                   // Waterfall cursor
+
 void entry9_anim(lv_obj_t *obj) { entry1_anim(obj); }
 void exit9_anim(int user_data, lv_obj_t *obj) { exit1_anim(user_data, obj); }
 
 void nrf_recv_event(lv_timer_t *t)
 {
+    if(nrf24_get_mode() == NRF24_MODE_SWEEP) {
+        return;
+    }
     if(nrf24_get_mode() == NRF24_MODE_SEND) {
         String str = "Hello World! #" + String(nrf24_cont++);
         nrf24_send(str.c_str());
@@ -14265,13 +14541,159 @@ void nrf_recv_event(lv_timer_t *t)
         ws2812_pos_demo(nrf24_cont);
     } else if(nrf24_get_mode() == NRF24_MODE_RECV)
     {
-        String str = "recv #" + String(nrf24_cont++);
-        // lv_label_set_text_fmt(nrf24_label, "%s", str.c_str());
-        // ws2812_pos_demo1();
+        static const char tag[] = "Hello World! #";
+        const size_t tag_len = sizeof(tag) - 1;
+        NRF24Packet pkt;
+        NRF24Stats st;
+        bool hit = false;
+
+        while(nrf24_read_packet(&pkt)) {
+            for(size_t i = 0; !hit && i + tag_len <= pkt.len; i++) {
+                hit = (memcmp(&pkt.data[i], tag, tag_len) == 0);
+            }
+        }
+        if(hit) {
+            ws2812_pos_demo1();
+        }
+
+        nrf24_get_stats(&st);
+        lv_label_set_text_fmt(nrf24_label, "Freq:2400 M \n"
+                                           "BitRate:1000 kbps\n"
+                                           "RX:%lu Drop:%lu",
+                              (unsigned long)st.received,
+                              (unsigned long)(st.ring_drops + st.fifo_full));
     }
     lv_timer_handler();
 }
 
+static lv_color_t nrf24_hits_color(uint8_t hits)
+{
+    if (hits == 0) return lv_color_hex(EMBED_COLOR_BG);
+    if (hits * 3 <= NRF24_SWEEP_SAMPLES) return lv_color_hex(0x0000FF);  // Occasional
+    if (hits < NRF24_SWEEP_SAMPLES) return lv_color_hex(0xFFFF00);       // Frequent
+    return lv_color_hex(0xFF0000);                                       // Every sample
+}
+
+static void nrf24_sweep_draw_bars(void)
+{
+    static uint32_t hits[NRF24_CHANNELS];
+    uint32_t samples, pass_us;
+    nrf24_sweep_get_hist(hits, &samples, &pass_us);
+    uint32_t max_hits = 0;
+    int busiest = 0;
+
+    for (int ch = 0; ch < NRF24_CHANNELS; ch++) {
+        if (hits[ch] > max_hits) {
+            max_hits = hits[ch];
+            busiest = ch;
+        }
+    }
+
+    lv_canvas_fill_bg(nrf24_bar_canvas, lv_color_hex(EMBED_COLOR_BG), LV_OPA_COVER);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_opa = LV_OPA_COVER;
+    rect_dsc.border_width = 0;
+
+    // Bars are scaled to the busiest channel; colour gives absolute occupancy
+    for (int ch = 0; max_hits && ch < NRF24_CHANNELS; ch++) {
+        int h = (int)((uint64_t)hits[ch] * NRF24_BAR_HEIGHT / max_hits);
+        if (h <= 0) continue;
+        uint8_t level = samples ? (uint8_t)((uint64_t)hits[ch] * NRF24_SWEEP_SAMPLES / samples) : 0;
+        rect_dsc.bg_color = nrf24_hits_color(max(level, (uint8_t)1));
+        lv_canvas_draw_rect(nrf24_bar_canvas, ch * NRF24_SWEEP_PX, NRF24_BAR_HEIGHT - h,
+                            NRF24_SWEEP_PX, h, &rect_dsc);
+    }
+    lv_obj_invalidate(nrf24_bar_canvas);
+
+    uint32_t pct = samples ? (uint32_t)((uint64_t)max_hits * 100 / samples) : 0;
+    lv_label_set_text_fmt(nrf24_label, "Peak ch%d (%d MHz) %lu%%  %lu ms/pass",
+                          busiest, 2400 + busiest, (unsigned long)pct,
+                          (unsigned long)(pass_us / 1000));
+}
+
+static void nrf24_sweep_draw_waterfall(void)
+{
+    uint8_t row[NRF24_CHANNELS];
+    uint32_t passes = nrf24_sweep_get_hist(NULL, NULL, NULL);
+    bool drew = false;
+
+    // Skip ahead if the UI fell behind the ring
+    if (passes - nrf24_sweep_drawn >= NRF24_WATERFALL_ROWS - 1) {
+        nrf24_sweep_drawn = passes - 1;
+    }
+
+    while (nrf24_sweep_drawn < passes) {
+        if (!nrf24_sweep_get_row(nrf24_sweep_drawn + 1, row)) {
+            break;
+        }
+        nrf24_sweep_drawn++;
+
+        for (int ch = 0; ch < NRF24_CHANNELS; ch++) {
+            lv_color_t c = nrf24_hits_color(row[ch]);
+            for (int px = 0; px < NRF24_SWEEP_PX; px++) {
+                lv_canvas_set_px(nrf24_wf_canvas, ch * NRF24_SWEEP_PX + px, nrf24_wf_row, c);
+            }
+        }
+
+        // Cursor line marks the newest row, as on the audio spectrogram
+        nrf24_wf_row = (nrf24_wf_row + 1) % NRF24_WF_HEIGHT;
+        for (int x = 0; x < NRF24_SWEEP_WIDTH; x++) {
+            lv_canvas_set_px(nrf24_wf_canvas, x, nrf24_wf_row, lv_color_hex(0xFFFFFF));
+        }
+        drew = true;
+    }
+
+    if (drew) {
+        lv_obj_invalidate(nrf24_wf_canvas);
+    }
+}
+
+static void nrf24_sweep_timer_event(lv_timer_t *t)
+{
+    if (!nrf24_bar_canvas || !nrf24_wf_canvas) {
+        return;
+    }
+    nrf24_sweep_draw_waterfall();
+    nrf24_sweep_draw_bars();
+}
+
+// Sweep mode swaps the info label and centred mode button for the canvases
+static void nrf24_layout(int mode)
+{
+    bool sweep = (mode == NRF24_MODE_SWEEP);
+
+    if (nrf24_bar_canvas && nrf24_wf_canvas) {
+        if (sweep) {
+            lv_obj_clear_flag(nrf24_bar_canvas, LV_OBJ_FLAG_HIDDEN);
+            lv_obj_clear_flag(nrf24_wf_canvas, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(nrf24_bar_canvas, LV_OBJ_FLAG_HIDDEN);
+            lv_obj_add_flag(nrf24_wf_canvas, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+
+    if (sweep) {
+        lv_obj_set_height(nrf24_mode_btn, 24);
+        lv_obj_align(nrf24_mode_btn, LV_ALIGN_TOP_RIGHT, -8, 4);
+        lv_obj_set_style_text_font(nrf24_label, FONT_BOLD_14, LV_PART_MAIN);
+        lv_label_set_text(nrf24_label, "Sweeping 2400-2525 MHz");
+        lv_obj_align(nrf24_label, LV_ALIGN_BOTTOM_MID, 0, -2);
+        nrf24_sweep_drawn = nrf24_sweep_get_hist(NULL, NULL, NULL);
+        if (nrf24_sweep_timer) lv_timer_resume(nrf24_sweep_timer);
+    } else {
+        if (nrf24_sweep_timer) lv_timer_pause(nrf24_sweep_timer);
+        lv_obj_set_height(nrf24_mode_btn, 50);
+        lv_obj_align(nrf24_mode_btn, LV_ALIGN_CENTER, 80, 0);
+        lv_obj_set_style_text_font(nrf24_label, FONT_BOLD_16, LV_PART_MAIN);
+        lv_label_set_text(nrf24_label, "Freq:2400 M \n"
+                                        "BitRate:1000 kbps\n"
+                                        "Power:0 dBm");
+        lv_obj_align(nrf24_label, LV_ALIGN_LEFT_MID, 10, 0);
+    }
+}
+
 static void scr9_btn_event_cb(lv_event_t * e)
 {
     if(e->code == LV_EVENT_CLICKED){
@@ -14296,6 +14718,12 @@ void nrf24_mode_sw_event(lv_event_t *e)
                 
                 // lv_label_set_text_fmt(sghz_label, "# Recv - 0");
             case NRF24_MODE_RECV: 
+                nrf24_sweep_reset();
+                nrf24_set_mode(NRF24_MODE_SWEEP); 
+                lv_label_set_text(data, "sweep"); 
+                break;
+
+            case NRF24_MODE_SWEEP: 
                 nrf24_set_mode(NRF24_MODE_SEND); 
                 lv_label_set_text(data, "send"); 
                 break;
@@ -14303,6 +14731,7 @@ void nrf24_mode_sw_event(lv_event_t *e)
                 // lv_label_set_text_fmt(sghz_label, "# Send - 0");
             default: break;
         }
+        nrf24_layout(nrf24_get_mode());
     }
 }
 
@@ -14332,10 +14761,7 @@ static void create9(lv_obj_t *parent) {
         lv_obj_set_height(nrf24_mode_btn, 50);
         apply_no_shadow(nrf24_mode_btn);
         lv_obj_set_style_pad_row(nrf24_mode_btn, 0, LV_PART_MAIN);
-        lv_obj_remove_style(nrf24_mode_btn, NULL, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_pad(nrf24_mode_btn, 2, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_width(nrf24_mode_btn, 2, LV_STATE_FOCUS_KEY);
-        lv_obj_set_style_outline_color(nrf24_mode_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+        apply_btn_focus(nrf24_mode_btn);
         // lv_obj_align(nrf24_mode_btn, LV_ALIGN_TOP_MID, 0, 6);
         lv_obj_align(nrf24_mode_btn, LV_ALIGN_CENTER, 80, 0);
         lv_obj_t *nrf24_info = lv_label_create(nrf24_mode_btn);
@@ -14344,10 +14770,32 @@ static void create9(lv_obj_t *parent) {
         {
             case NRF24_MODE_SEND: lv_label_set_text(nrf24_info, "send"); break;
             case NRF24_MODE_RECV: lv_label_set_text(nrf24_info, "recv"); break;
+            case NRF24_MODE_SWEEP: lv_label_set_text(nrf24_info, "sweep"); break;
             default: break;
         }
         lv_obj_add_event_cb(nrf24_mode_btn, nrf24_mode_sw_event, LV_EVENT_CLICKED, nrf24_info);
 
+        // Sweep canvases live in PSRAM; 2 px per channel across 126 channels
+        nrf24_bar_buf = (uint8_t *)ps_malloc(LV_CANVAS_BUF_SIZE_TRUE_COLOR(NRF24_SWEEP_WIDTH, NRF24_BAR_HEIGHT));
+        nrf24_wf_buf = (uint8_t *)ps_malloc(LV_CANVAS_BUF_SIZE_TRUE_COLOR(NRF24_SWEEP_WIDTH, NRF24_WF_HEIGHT));
+        if (nrf24_bar_buf && nrf24_wf_buf) {
+            nrf24_bar_canvas = lv_canvas_create(scr9_cont);
+            lv_canvas_set_buffer(nrf24_bar_canvas, nrf24_bar_buf, NRF24_SWEEP_WIDTH, NRF24_BAR_HEIGHT,
+                                 LV_IMG_CF_TRUE_COLOR);
+            lv_obj_align(nrf24_bar_canvas, LV_ALIGN_TOP_MID, 0, 32);
+            lv_canvas_fill_bg(nrf24_bar_canvas, lv_color_hex(EMBED_COLOR_BG), LV_OPA_COVER);
+
+            nrf24_wf_canvas = lv_canvas_create(scr9_cont);
+            lv_canvas_set_buffer(nrf24_wf_canvas, nrf24_wf_buf, NRF24_SWEEP_WIDTH, NRF24_WF_HEIGHT,
+                                 LV_IMG_CF_TRUE_COLOR);
+            lv_obj_align(nrf24_wf_canvas, LV_ALIGN_TOP_MID, 0, 32 + NRF24_BAR_HEIGHT + 2);
+            lv_canvas_fill_bg(nrf24_wf_canvas, lv_color_hex(EMBED_COLOR_BG), LV_OPA_COVER);
+            nrf24_wf_row = 0;
+        }
+        nrf24_sweep_timer = lv_timer_create(nrf24_sweep_timer_event, NRF24_SWEEP_UPDATE_MS, NULL);
+        lv_timer_pause(nrf24_sweep_timer);
+        nrf24_layout(nrf24_get_mode());
+
         // back btn
         scr_back_btn_create(scr9_cont, scr9_btn_event_cb);
         lv_group_set_wrap(lv_group_get_default(), true);
@@ -14356,16 +14804,40 @@ static void create9(lv_obj_t *parent) {
     }
 }
 static void entry9(void) {
-    vTaskResume(nrf24_handle);
+    // Park/unpark instead of vTaskSuspend: suspending the task while it
+    // holds radioLock would stall the display flush.
+    nrf24_rx_enable(true);
 }
 static void exit9(void) {
-    vTaskSuspend(nrf24_handle);
+    nrf24_rx_enable(false);
 }
 static void destroy9(void) { 
     if(nrf24_timer) {
         lv_timer_del(nrf24_timer);
         nrf24_timer = NULL;
     }
+    if(nrf24_sweep_timer) {
+        lv_timer_del(nrf24_sweep_timer);
+        nrf24_sweep_timer = NULL;
+    }
+    // The screen is deleted after destroy(); drop the canvases now so nothing
+    // can draw from their pixel buffers once those are freed
+    if(nrf24_bar_canvas) {
+        lv_obj_del(nrf24_bar_canvas);
+        nrf24_bar_canvas = NULL;
+    }
+    if(nrf24_wf_canvas) {
+        lv_obj_del(nrf24_wf_canvas);
+        nrf24_wf_canvas = NULL;
+    }
+    if(nrf24_bar_buf) {
+        free(nrf24_bar_buf);
+        nrf24_bar_buf = NULL;
+    }
+    if(nrf24_wf_buf) {
+        free(nrf24_wf_buf);
+        nrf24_wf_buf = NULL;
+    }
     ws2812_set_color(CRGB::Black);
 }
 
@@ -14583,8 +15055,7 @@ static void create12(lv_obj_t *parent) {
     // Title
     lv_obj_t *title = lv_label_create(scr12_cont);
     lv_label_set_text(title, "Nautilus Portal");
-    lv_obj_set_style_text_font(title, FONT_BOLD_20, 0);
-    apply_text_color(title);
+    apply_title_style(title);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
 
     // Status container with border
@@ -14606,37 +15077,29 @@ static void create12(lv_obj_t *parent) {
     // SSID label
     portal_ssid_lab = lv_label_create(status_cont);
     lv_label_set_text(portal_ssid_lab, "SSID: Nautilus WiFi");
-    lv_obj_set_style_text_font(portal_ssid_lab, FONT_BOLD_14, 0);
-    apply_text_color(portal_ssid_lab);
+    apply_label_style(portal_ssid_lab);
 
     // IP label
     portal_ip_lab = lv_label_create(status_cont);
     lv_label_set_text(portal_ip_lab, "IP: 172.0.0.1");
-    lv_obj_set_style_text_font(portal_ip_lab, FONT_BOLD_14, 0);
-    apply_text_color(portal_ip_lab);
+    apply_label_style(portal_ip_lab);
 
     // Victims label
     portal_victims_lab = lv_label_create(status_cont);
     lv_label_set_text(portal_victims_lab, "Victims: 0");
-    lv_obj_set_style_text_font(portal_victims_lab, FONT_BOLD_14, 0);
-    apply_text_color(portal_victims_lab);
+    apply_label_style(portal_victims_lab);
 
     // Edit SSID button (above View button)
     portal_edit_ssid_btn = lv_btn_create(scr12_cont);
     lv_obj_set_size(portal_edit_ssid_btn, 70, 32);
     lv_obj_align(portal_edit_ssid_btn, LV_ALIGN_BOTTOM_RIGHT, -10, -90);  // Above View button
-    lv_obj_set_style_border_color(portal_edit_ssid_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(portal_edit_ssid_btn, 1, LV_PART_MAIN);
+    apply_theme_border(portal_edit_ssid_btn);
     apply_no_shadow(portal_edit_ssid_btn);
     apply_bg_color(portal_edit_ssid_btn);
-    lv_obj_remove_style(portal_edit_ssid_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(portal_edit_ssid_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(portal_edit_ssid_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(portal_edit_ssid_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(portal_edit_ssid_btn);
     lv_obj_add_event_cb(portal_edit_ssid_btn, portal_edit_ssid_btn_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_t *edit_ssid_label = lv_label_create(portal_edit_ssid_btn);
-    apply_text_color(edit_ssid_label);
-    lv_obj_set_style_text_font(edit_ssid_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(edit_ssid_label);
     lv_label_set_text(edit_ssid_label, "Edit");
     lv_obj_center(edit_ssid_label);
     lv_group_add_obj(lv_group_get_default(), portal_edit_ssid_btn);
@@ -14645,18 +15108,13 @@ static void create12(lv_obj_t *parent) {
     portal_view_btn = lv_btn_create(scr12_cont);
     lv_obj_set_size(portal_view_btn, 70, 32);
     lv_obj_align(portal_view_btn, LV_ALIGN_BOTTOM_RIGHT, -10, -50);  // Above start/stop
-    lv_obj_set_style_border_color(portal_view_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(portal_view_btn, 1, LV_PART_MAIN);
+    apply_theme_border(portal_view_btn);
     apply_no_shadow(portal_view_btn);
     apply_bg_color(portal_view_btn);
-    lv_obj_remove_style(portal_view_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(portal_view_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(portal_view_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(portal_view_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(portal_view_btn);
     lv_obj_add_event_cb(portal_view_btn, portal_view_btn_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_t *view_label = lv_label_create(portal_view_btn);
-    apply_text_color(view_label);
-    lv_obj_set_style_text_font(view_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(view_label);
     lv_label_set_text(view_label, "View");
     lv_obj_center(view_label);
     lv_group_add_obj(lv_group_get_default(), portal_view_btn);
@@ -14665,18 +15123,13 @@ static void create12(lv_obj_t *parent) {
     portal_start_btn = lv_btn_create(scr12_cont);
     lv_obj_set_size(portal_start_btn, 70, 32);
     lv_obj_align(portal_start_btn, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
-    lv_obj_set_style_border_color(portal_start_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(portal_start_btn, 1, LV_PART_MAIN);
+    apply_theme_border(portal_start_btn);
     apply_no_shadow(portal_start_btn);
     apply_bg_color(portal_start_btn);
-    lv_obj_remove_style(portal_start_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(portal_start_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(portal_start_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(portal_start_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(portal_start_btn);
     lv_obj_add_event_cb(portal_start_btn, portal_start_btn_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_t *start_label = lv_label_create(portal_start_btn);
-    apply_text_color(start_label);
-    lv_obj_set_style_text_font(start_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(start_label);
     lv_label_set_text(start_label, "Start");
     lv_obj_center(start_label);
     lv_group_add_obj(lv_group_get_default(), portal_start_btn);
@@ -14685,18 +15138,13 @@ static void create12(lv_obj_t *parent) {
     portal_stop_btn = lv_btn_create(scr12_cont);
     lv_obj_set_size(portal_stop_btn, 70, 32);
     lv_obj_align(portal_stop_btn, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
-    lv_obj_set_style_border_color(portal_stop_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(portal_stop_btn, 1, LV_PART_MAIN);
+    apply_theme_border(portal_stop_btn);
     apply_no_shadow(portal_stop_btn);
     apply_bg_color(portal_stop_btn);
-    lv_obj_remove_style(portal_stop_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(portal_stop_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(portal_stop_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(portal_stop_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(portal_stop_btn);
     lv_obj_add_event_cb(portal_stop_btn, portal_stop_btn_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_t *stop_label = lv_label_create(portal_stop_btn);
-    apply_text_color(stop_label);
-    lv_obj_set_style_text_font(stop_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(stop_label);
     lv_label_set_text(stop_label, "Stop");
     lv_obj_center(stop_label);
     lv_group_add_obj(lv_group_get_default(), portal_stop_btn);
@@ -14853,23 +15301,20 @@ static void create12_1(lv_obj_t *parent) {
     // Title
     lv_obj_t *title = lv_label_create(scr12_1_cont);
     lv_label_set_text(title, "Portal Data");
-    lv_obj_set_style_text_font(title, FONT_BOLD_20, 0);
-    apply_text_color(title);
+    apply_title_style(title);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
 
     // Record counter label
     portal_record_label = lv_label_create(scr12_1_cont);
     lv_label_set_text(portal_record_label, "Record: 0/0");
-    lv_obj_set_style_text_font(portal_record_label, FONT_BOLD_14, 0);
-    apply_text_color(portal_record_label);
+    apply_label_style(portal_record_label);
     lv_obj_align(portal_record_label, LV_ALIGN_TOP_MID, 0, 35);
 
     // Data display area (scrollable)
     lv_obj_t *data_cont = lv_obj_create(scr12_1_cont);
     lv_obj_set_size(data_cont, LV_PCT(90), 90);
     lv_obj_align(data_cont, LV_ALIGN_TOP_MID, 0, 60);
-    lv_obj_set_style_border_width(data_cont, 1, LV_PART_MAIN);
-    lv_obj_set_style_border_color(data_cont, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
+    apply_theme_border(data_cont);
     apply_bg_color(data_cont);
     lv_obj_set_style_pad_all(data_cont, 8, LV_PART_MAIN);
 
@@ -14877,25 +15322,19 @@ static void create12_1(lv_obj_t *parent) {
     lv_label_set_text(portal_data_display, "Loading...");
     lv_label_set_long_mode(portal_data_display, LV_LABEL_LONG_WRAP);
     lv_obj_set_width(portal_data_display, LV_PCT(95));
-    lv_obj_set_style_text_font(portal_data_display, FONT_BOLD_14, 0);
-    apply_text_color(portal_data_display);
+    apply_label_style(portal_data_display);
 
     // Previous button (bottom left)
     lv_obj_t *prev_btn = lv_btn_create(scr12_1_cont);
     lv_obj_set_size(prev_btn, 70, 32);
     lv_obj_align(prev_btn, LV_ALIGN_BOTTOM_LEFT, 10, -10);
-    lv_obj_set_style_border_color(prev_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(prev_btn, 1, LV_PART_MAIN);
+    apply_theme_border(prev_btn);
     apply_no_shadow(prev_btn);
     apply_bg_color(prev_btn);
-    lv_obj_remove_style(prev_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(prev_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(prev_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(prev_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(prev_btn);
     lv_obj_add_event_cb(prev_btn, portal_data_prev_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_t *prev_label = lv_label_create(prev_btn);
-    apply_text_color(prev_label);
-    lv_obj_set_style_text_font(prev_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(prev_label);
     lv_label_set_text(prev_label, "Prev");
     lv_obj_center(prev_label);
     lv_group_add_obj(lv_group_get_default(), prev_btn);
@@ -14904,18 +15343,13 @@ static void create12_1(lv_obj_t *parent) {
     lv_obj_t *next_btn = lv_btn_create(scr12_1_cont);
     lv_obj_set_size(next_btn, 70, 32);
     lv_obj_align(next_btn, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
-    lv_obj_set_style_border_color(next_btn, lv_color_hex(EMBED_COLOR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(next_btn, 1, LV_PART_MAIN);
+    apply_theme_border(next_btn);
     apply_no_shadow(next_btn);
     apply_bg_color(next_btn);
-    lv_obj_remove_style(next_btn, NULL, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_pad(next_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_width(next_btn, 2, LV_STATE_FOCUS_KEY);
-    lv_obj_set_style_outline_color(next_btn, lv_color_hex(EMBED_COLOR_FOCUS_ON), LV_STATE_FOCUS_KEY);
+    apply_btn_focus(next_btn);
     lv_obj_add_event_cb(next_btn, portal_data_next_cb, LV_EVENT_CLICKED, NULL);
     lv_obj_t *next_label = lv_label_create(next_btn);
-    apply_text_color(next_label);
-    lv_obj_set_style_text_font(next_label, FONT_BOLD_14, LV_PART_MAIN);
+    apply_label_style(next_label);
     lv_label_set_text(next_label, "Next");
     lv_obj_center(next_label);
     lv_group_add_obj(lv_group_get_default(), next_btn);
@@ -14974,12 +15408,14 @@ void charge_detection_timer_cb(lv_timer_t *t)
     }
 
     // charge
-    if(PPM.isCharging()) {
+    PowerSnapshot pwr;
+    bool pwr_ok = power_get(&pwr);
+    if(pwr_ok && pwr.chg_status != PowersBQ25896::CHARGE_STATE_NO_CHARGE) {
         lv_obj_clear_flag(menu_taskbar_charge, LV_OBJ_FLAG_HIDDEN);
     } else {
         lv_obj_add_flag(menu_taskbar_charge, LV_OBJ_FLAG_HIDDEN);
     }
-    if(bq27220.getCharingFinish()){
+    if(pwr_ok && pwr.charge_done){
         lv_label_set_text_fmt(menu_taskbar_charge, "#%x %s #", EMBED_COLOR_TEXT, LV_SYMBOL_OK);
     } else {
         lv_label_set_text_fmt(menu_taskbar_charge, "#%x %s #", EMBED_COLOR_TEXT, LV_SYMBOL_CHARGE);
@@ -15000,8 +15436,10 @@ void ui_entry(void)
 
     taskbar_timer = lv_timer_create(charge_detection_timer_cb, 1000, NULL);
     lv_timer_pause(taskbar_timer);
+    perf_hud_init();
 
     scr_mgr_init();
+    ui_theme_init(&THEMES[UI_THEME_DARK]);
     ui_theme_setting(setting_theme);
     scr_mgr_register(SCREEN0_ID, &screen0);      // menu
     scr_mgr_register(SCREEN1_ID, &screen1);      // ws2812
@@ -15022,6 +15460,8 @@ void ui_entry(void)
     scr_mgr_register(SCREEN2_5_1_ID, &screen2_5_1);  //     -SubGHz File Browser
     scr_mgr_register(SCREEN2_6_ID, &screen2_6);  //   -Custom Frequencies
     scr_mgr_register(SCREEN2_6_1_ID, &screen2_6_1);  //     -Add Frequency (keyboard)
+    scr_mgr_register(SCREEN2_7_ID, &screen2_7);  //   -Packet Capture
+    scr_mgr_register(SCREEN2_8_ID, &screen2_8);  //   -Frequency Hopper
     scr_mgr_register(SCREEN3_ID, &screen3);      // nfc file browser
     scr_mgr_register(SCREEN3_1_ID, &screen3_1);  //   -Read NFC Tag
     scr_mgr_register(SCREEN3_2_ID, &screen3_2);  //   -NFC Tag Detail
@@ -15048,5 +15488,12 @@ void ui_entry(void)
     scr_mgr_register(SCREEN8_ID, &screen8);      // music
     scr_mgr_register(SCREEN9_ID, &screen9);      // nrf24
 
+    // Menus come back in one frame instead of being rebuilt on every return
+    scr_mgr_set_retain(SCREEN0_ID, true);
+    scr_mgr_set_retain(SCREEN2_ID, true);
+    scr_mgr_set_retain(SCREEN6_ID, true);
+
     scr_mgr_switch(SCREEN0_ID, false); // main scr
+    scr_mgr_prebuild(SCREEN2_ID);
+    scr_mgr_prebuild(SCREEN6_ID);
 }
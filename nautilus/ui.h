@@ -69,6 +69,8 @@ enum{
     SCREEN2_5_1_ID,   //   -SubGHz File Browser (for selecting .sub files)
     SCREEN2_6_ID,     // SubGHz Custom Frequencies screen
     SCREEN2_6_1_ID,   //   -Add Frequency (keyboard input)
+    SCREEN2_7_ID,     // SubGHz Packet Capture screen
+    SCREEN2_8_ID,     // SubGHz Frequency Hopper screen
     SCREEN12_ID,      // Portal screen
     SCREEN12_1_ID,    //   -Portal Data Viewer screen
     SCREEN_ID_MAX,
@@ -25,12 +25,8 @@ void ui_scr1_set_light(uint8_t light) {
 }
 
 void ui_scr1_set_mode(int mode) {
+    // ws2812_task parks itself in static mode; no suspend/resume needed
     ws2812_set_mode(mode);
-    if(mode == 0){
-        vTaskSuspend(ws2812_handle);
-    } else {
-        vTaskResume(ws2812_handle);
-    }
 }
 #endif
 //************************************[ screen 2 ]****************************************** sghz
@@ -44,13 +40,13 @@ void ui_scr1_set_mode(int mode) {
 //************************************[ screen 4 ]****************************************** setting
 #if 1
 bool ui_scr4_get_sghz_st(void) { 
-    return sghz_is_init();
+    return sghz_ensure_init();
 }
 bool ui_scr4_get_pmu_st(void) {
     return true;  // PMU always initialized
 }
 bool ui_scr4_get_nfc_st(void) {
-    return nfc_is_init();
+    return nfc_ensure_init();
 }
 bool ui_scr4_get_sd_st(void) {
     return sd_is_valid();
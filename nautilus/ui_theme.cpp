@@ -0,0 +1,109 @@
+// Nautilus UI Theme - shared static LVGL styles
+
+#include "ui_theme.h"
+#include "ui.h"
+
+lv_style_t ui_style_bg;
+lv_style_t ui_style_text;
+lv_style_t ui_style_border;
+lv_style_t ui_style_no_border;
+lv_style_t ui_style_no_padding;
+lv_style_t ui_style_no_radius;
+lv_style_t ui_style_no_shadow;
+lv_style_t ui_style_container;
+lv_style_t ui_style_label;
+lv_style_t ui_style_title;
+lv_style_t ui_style_list_btn;
+lv_style_t ui_style_list_btn_focus;
+lv_style_t ui_style_focus;
+lv_style_t ui_style_btn_focus;
+lv_style_t ui_style_prompt;
+
+// Only the colour properties depend on the theme; everything else is set once
+static void ui_theme_set_colors(const ColorTheme *theme)
+{
+    lv_color_t bg = lv_color_hex(theme->bg);
+    lv_color_t text = lv_color_hex(theme->text);
+    lv_color_t focus = lv_color_hex(theme->focus);
+
+    lv_style_set_bg_color(&ui_style_bg, bg);
+    lv_style_set_text_color(&ui_style_text, text);
+    lv_style_set_border_color(&ui_style_border, lv_color_hex(theme->border));
+    lv_style_set_bg_color(&ui_style_container, bg);
+    lv_style_set_text_color(&ui_style_label, text);
+    lv_style_set_text_color(&ui_style_title, text);
+    lv_style_set_bg_color(&ui_style_list_btn, bg);
+    lv_style_set_text_color(&ui_style_list_btn, text);
+    lv_style_set_outline_color(&ui_style_list_btn_focus, focus);
+    lv_style_set_outline_color(&ui_style_focus, focus);
+    lv_style_set_outline_color(&ui_style_btn_focus, focus);
+    lv_style_set_bg_color(&ui_style_prompt, lv_color_hex(theme->prompt_bg));
+    lv_style_set_text_color(&ui_style_prompt, lv_color_hex(theme->prompt_txt));
+}
+
+void ui_theme_init(const ColorTheme *theme)
+{
+    lv_style_init(&ui_style_bg);
+    lv_style_init(&ui_style_text);
+
+    lv_style_init(&ui_style_border);
+    lv_style_set_border_width(&ui_style_border, 1);
+
+    lv_style_init(&ui_style_no_border);
+    lv_style_set_border_width(&ui_style_no_border, 0);
+
+    lv_style_init(&ui_style_no_padding);
+    lv_style_set_pad_all(&ui_style_no_padding, 0);
+
+    lv_style_init(&ui_style_no_radius);
+    lv_style_set_radius(&ui_style_no_radius, 0);
+
+    lv_style_init(&ui_style_no_shadow);
+    lv_style_set_shadow_width(&ui_style_no_shadow, 0);
+
+    lv_style_init(&ui_style_container);
+    lv_style_set_border_width(&ui_style_container, 0);
+    lv_style_set_pad_all(&ui_style_container, 0);
+
+    lv_style_init(&ui_style_label);
+    lv_style_set_text_font(&ui_style_label, FONT_BOLD_14);
+
+    lv_style_init(&ui_style_title);
+    lv_style_set_text_font(&ui_style_title, FONT_BOLD_20);
+
+    lv_style_init(&ui_style_list_btn);
+    lv_style_set_text_font(&ui_style_list_btn, FONT_BOLD_14);
+
+    lv_style_init(&ui_style_list_btn_focus);
+    lv_style_set_radius(&ui_style_list_btn_focus, 5);
+    lv_style_set_outline_width(&ui_style_list_btn_focus, 2);
+
+    lv_style_init(&ui_style_focus);
+    lv_style_set_outline_width(&ui_style_focus, 2);
+
+    lv_style_init(&ui_style_btn_focus);
+    lv_style_set_outline_width(&ui_style_btn_focus, 2);
+    lv_style_set_outline_pad(&ui_style_btn_focus, 2);
+
+    lv_style_init(&ui_style_prompt);
+    lv_style_set_radius(&ui_style_prompt, 5);
+    lv_style_set_bg_opa(&ui_style_prompt, LV_OPA_COVER);
+    lv_style_set_pad_hor(&ui_style_prompt, 3);
+    lv_style_set_text_font(&ui_style_prompt, FONT_BOLD_14);
+    lv_style_set_text_align(&ui_style_prompt, LV_TEXT_ALIGN_CENTER);
+
+    ui_theme_set_colors(theme);
+}
+
+void ui_theme_apply(const ColorTheme *theme)
+{
+    ui_theme_set_colors(theme);
+    // NULL: walk every object once instead of once per changed style
+    lv_obj_report_style_change(NULL);
+}
+
+void ui_theme_attach(lv_obj_t *obj, lv_style_t *style, lv_style_selector_t selector)
+{
+    lv_obj_remove_style(obj, style, selector);
+    lv_obj_add_style(obj, style, selector);
+}
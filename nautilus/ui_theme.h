@@ -0,0 +1,54 @@
+// Nautilus UI Theme - shared static LVGL styles
+//
+// Objects attach these styles instead of carrying their own local style
+// properties. A theme switch rewrites the colours inside the styles and
+// refreshes every object with a single lv_obj_report_style_change().
+
+#pragma once
+
+#include "lvgl.h"
+
+// Theme color structure
+struct ColorTheme {
+    uint32_t bg;
+    uint32_t focus;
+    uint32_t text;
+    uint32_t border;
+    uint32_t prompt_bg;
+    uint32_t prompt_txt;
+};
+
+extern lv_style_t ui_style_bg;            // Theme background colour
+extern lv_style_t ui_style_text;          // Theme text colour
+extern lv_style_t ui_style_border;        // 1 px theme border
+extern lv_style_t ui_style_no_border;
+extern lv_style_t ui_style_no_padding;
+extern lv_style_t ui_style_no_radius;
+extern lv_style_t ui_style_no_shadow;
+extern lv_style_t ui_style_container;     // Background, no border, no padding
+extern lv_style_t ui_style_label;         // Text colour, FONT_BOLD_14
+extern lv_style_t ui_style_title;         // Text colour, FONT_BOLD_20 screen titles
+extern lv_style_t ui_style_list_btn;      // lv_list buttons: background, text, FONT_BOLD_14
+extern lv_style_t ui_style_list_btn_focus;// LV_STATE_FOCUS_KEY: rounded outline
+extern lv_style_t ui_style_focus;         // LV_STATE_FOCUS_KEY: outline
+extern lv_style_t ui_style_btn_focus;     // LV_STATE_FOCUS_KEY: outline with 2 px gap
+extern lv_style_t ui_style_prompt;        // Toast label on lv_layer_top()
+
+/**
+ * Build the styles with the given colours. Must run after lv_init() and
+ * before the first screen is created.
+ * @param theme Initial colours
+ */
+void ui_theme_init(const ColorTheme *theme);
+
+/**
+ * Switch colours. Every object using the styles is refreshed in one pass.
+ * @param theme New colours
+ */
+void ui_theme_apply(const ColorTheme *theme);
+
+/**
+ * Attach a shared style, dropping an earlier copy with the same selector so
+ * repeated helper calls do not grow the object's style list.
+ */
+void ui_theme_attach(lv_obj_t *obj, lv_style_t *style, lv_style_selector_t selector);